@@ -1,18 +1,46 @@
 from __future__ import annotations
 
+import itertools
+import os
 import sys
+import threading
+from concurrent.futures import Future, ThreadPoolExecutor
 
 from . import _wolvrix as _native
 
 __all__ = [
     "Design",
+    "attach_shm",
     "from_json_string",
     "list_passes",
+    "op_kind_names",
+    "read_grhb",
     "read_json",
     "read_sv",
+    "read_sv_async",
     "run_pipeline",
+    "submit",
+    "unlink_shm",
 ]
 
+_executor: ThreadPoolExecutor | None = None
+_shm_counter = itertools.count()
+_executor_lock = threading.Lock()
+
+
+def submit(fn, /, *args, **kwargs) -> Future:
+    """Run `fn(*args, **kwargs)` on the shared wolvrix worker pool.
+
+    The native calls release the GIL while they work, so reading, transforming and writing
+    different designs from the pool runs in parallel. Calls on the same design are serialized
+    by the design's own lock (passes exclusively, emit/store shared).
+    """
+    global _executor
+    with _executor_lock:
+        if _executor is None:
+            _executor = ThreadPoolExecutor(max_workers=os.cpu_count() or 1, thread_name_prefix="wolvrix")
+        return _executor.submit(fn, *args, **kwargs)
+
 
 class Design:
     def __init__(self, capsule):
@@ -28,7 +56,10 @@ class Design:
         *,
         print_diagnostics_level: str = "info",
         raise_diagnostics_level: str = "error",
+        on_diagnostic=None,
+        on_log=None,
     ) -> tuple[bool, list[dict]]:
+        forward, kept = _stream_diagnostics(on_diagnostic, raise_diagnostics_level)
         changed, ok, diag = _native.run_pass(
             self._capsule,
             name,
@@ -36,8 +67,13 @@ class Design:
             dryrun,
             diagnostics,
             log_level,
+            forward,
+            on_log,
         )
-        _print_diagnostics(diag, print_diagnostics_level)
+        if forward is None:
+            _print_diagnostics(diag, print_diagnostics_level)
+        else:
+            diag = kept
         if _should_raise(diag, raise_diagnostics_level) or (not ok and _should_raise(diag, "error")):
             _raise_with_diagnostics(diag)
         return bool(changed), list(diag)
@@ -51,19 +87,30 @@ class Design:
         *,
         print_diagnostics_level: str = "info",
         raise_diagnostics_level: str = "error",
+        on_diagnostic=None,
+        on_log=None,
     ) -> tuple[bool, list[dict]]:
+        forward, kept = _stream_diagnostics(on_diagnostic, raise_diagnostics_level)
         changed, ok, diag = _native.run_pipeline(
             self._capsule,
             pipeline,
             dryrun,
             diagnostics,
             log_level,
+            forward,
+            on_log,
         )
-        _print_diagnostics(diag, print_diagnostics_level)
+        if forward is None:
+            _print_diagnostics(diag, print_diagnostics_level)
+        else:
+            diag = kept
         if _should_raise(diag, raise_diagnostics_level) or (not ok and _should_raise(diag, "error")):
             _raise_with_diagnostics(diag)
         return bool(changed), list(diag)
 
+    def run_pipeline_async(self, pipeline: list[str | tuple[str, list[str]] | list], **kwargs) -> Future:
+        return submit(self.run_pipeline, pipeline, **kwargs)
+
     def write_sv(
         self,
         output: str,
@@ -72,6 +119,9 @@ class Design:
     ) -> None:
         _native.write_sv(self._capsule, output, top or [], split_modules)
 
+    def write_sv_async(self, output: str, **kwargs) -> Future:
+        return submit(self.write_sv, output, **kwargs)
+
     def write_verilator_repcut_package(
         self,
         output: str,
@@ -79,6 +129,9 @@ class Design:
     ) -> None:
         _native.write_verilator_repcut_package(self._capsule, output, top or [])
 
+    def write_verilator_repcut_package_async(self, output: str, **kwargs) -> Future:
+        return submit(self.write_verilator_repcut_package, output, **kwargs)
+
     def to_json(self, mode: str = "pretty-compact", top: list[str] | None = None) -> str:
         return _native.store_json_string(self._capsule, mode, top or [])
 
@@ -87,6 +140,31 @@ class Design:
         with open(output, "w", encoding="utf-8") as handle:
             handle.write(text)
 
+    def write_grhb(self, output: str, top: list[str] | None = None) -> None:
+        _native.write_grhb(self._capsule, output, top or [])
+
+    def export_shm(self, name: str | None = None, top: list[str] | None = None) -> str:
+        """Publish the design as a .grhb image in a new POSIX shared-memory object.
+
+        Returns the object name; pass it to `attach_shm` in other processes and call
+        `unlink_shm` once every worker has attached.
+        """
+        if name is None:
+            name = f"/wolvrix-{os.getpid()}-{next(_shm_counter)}"
+        _native.write_grhb_shm(self._capsule, name, top or [])
+        return name
+
+    def graph_view(self, name: str) -> dict[str, memoryview]:
+        """Zero-copy, read-only arrays of graph `name` (freezing it if needed).
+
+        Row i of the op_* / value_* arrays describes the operation / value with id index i + 1.
+        Ids are rows of four uint32 (index, generation, graph index, graph generation), use_list
+        rows add the operand index, and *_ranges rows are (offset, count) into operands, results
+        and use_list. `op_kinds` indexes `op_kind_names()`. Passes on this design raise
+        BufferError while any of the arrays are alive.
+        """
+        return _native.graph_view(self._capsule, name)
+
 
 def read_sv(
     path: str | None,
@@ -94,19 +172,59 @@ def read_sv(
     log_level: str = "info",
     diagnostics: str = "warn",
     *,
+    parse_threads: int = 1,
     print_diagnostics_level: str = "info",
     raise_diagnostics_level: str = "error",
+    on_diagnostic=None,
+    on_log=None,
 ) -> tuple[Design | None, list[dict]]:
-    capsule, ok, diag = _native.read_sv(path, slang_args or [], log_level, diagnostics)
-    _print_diagnostics(diag, print_diagnostics_level)
+    """Parse, elaborate and convert SystemVerilog sources.
+
+    `parse_threads=1` parses all files as one compilation unit, so a macro defined in one file
+    is visible in the files after it. Any other value (0 = one thread per core) parses each file
+    as its own compilation unit on a thread pool; macros then stay local to their file, and a
+    warning is logged when more than one file is read this way. Negative values raise ValueError.
+    """
+    forward, kept = _stream_diagnostics(on_diagnostic, raise_diagnostics_level)
+    capsule, ok, diag = _native.read_sv(
+        path, slang_args or [], log_level, diagnostics, parse_threads, forward, on_log
+    )
+    if forward is None:
+        _print_diagnostics(diag, print_diagnostics_level)
+    else:
+        diag = kept
     if _should_raise(diag, raise_diagnostics_level) or (not ok and _should_raise(diag, "error")):
         _raise_with_diagnostics(diag)
     design = Design(capsule) if capsule is not None else None
     return design, list(diag)
 
 
-def read_json(path: str) -> Design:
-    return Design(_native.read_json(path))
+def read_sv_async(path: str | None, *args, **kwargs) -> Future:
+    return submit(read_sv, path, *args, **kwargs)
+
+
+def read_json(path: str, *, use_mmap: bool = True) -> Design:
+    if use_mmap:
+        return Design(_native.read_json(path))
+    with open(path, encoding="utf-8") as handle:
+        return from_json_string(handle.read())
+
+
+def read_grhb(path: str, *, lazy: bool = False) -> Design:
+    return Design(_native.read_grhb(path, lazy))
+
+
+def attach_shm(name: str, *, lazy: bool = True) -> Design:
+    """Load a design published with `Design.export_shm`.
+
+    With `lazy=True` graphs are decoded from the shared pages only when first accessed, so a
+    worker pays only for the graphs it touches, and `write_grhb` copies untouched ones through.
+    """
+    return Design(_native.read_grhb_shm(name, lazy))
+
+
+def unlink_shm(name: str) -> None:
+    _native.unlink_shm(name)
 
 
 def from_json_string(text: str) -> Design:
@@ -117,6 +235,10 @@ def list_passes() -> list[str]:
     return list(_native.list_passes())
 
 
+def op_kind_names() -> list[str]:
+    return list(_native.op_kind_names())
+
+
 def run_pipeline(
     design: Design,
     pipeline: list[str | tuple[str, list[str]] | list],
@@ -126,6 +248,8 @@ def run_pipeline(
     *,
     print_diagnostics_level: str = "info",
     raise_diagnostics_level: str = "error",
+    on_diagnostic=None,
+    on_log=None,
 ) -> tuple[bool, list[dict]]:
     return design.run_pipeline(
         pipeline=pipeline,
@@ -134,6 +258,8 @@ def run_pipeline(
         log_level=log_level,
         print_diagnostics_level=print_diagnostics_level,
         raise_diagnostics_level=raise_diagnostics_level,
+        on_diagnostic=on_diagnostic,
+        on_log=on_log,
     )
 
 
@@ -155,6 +281,28 @@ def _level_rank(level: str) -> int | None:
     return ranks.get(name)
 
 
+def _stream_diagnostics(on_diagnostic, raise_level: str):
+    """Wrap `on_diagnostic` for the native call.
+
+    Streamed diagnostics are not collected; only those that can make the call raise are kept,
+    so the exception still carries them.
+    """
+    kept: list[dict] = []
+    if on_diagnostic is None:
+        return None, kept
+    ranks = [rank for rank in (_level_rank(raise_level), _level_rank("error")) if rank is not None]
+    keep_rank = min(ranks)
+
+    def forward(diag: dict) -> None:
+        kind = str(diag.get("kind", "")).lower()
+        kind_rank = _level_rank(kind)
+        if kind_rank is not None and kind_rank >= keep_rank:
+            kept.append(diag)
+        on_diagnostic(diag)
+
+    return forward, kept
+
+
 def _print_diagnostics(diags: list[dict], threshold: str) -> None:
     rank = _level_rank(threshold)
     if rank is None:
@@ -4,6 +4,7 @@
 #include "emit/verilator_repcut_package.hpp"
 #include "core/grh.hpp"
 #include "core/ingest.hpp"
+#include "core/load.hpp"
 #include "core/logging.hpp"
 #include "core/store.hpp"
 #include "core/transform.hpp"
@@ -14,8 +15,12 @@
 #include "slang/text/SourceManager.h"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <cctype>
 #include <exception>
 #include <filesystem>
@@ -23,11 +28,16 @@
 #include <iostream>
 #include <iterator>
 #include <memory>
+#include <mutex>
+#include <sys/mman.h>
 #include <unistd.h>
 #include <optional>
+#include <shared_mutex>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <utility>
+#include <variant>
 #include <vector>
 
 namespace
@@ -35,10 +45,55 @@ namespace
 
     constexpr const char *kDesignCapsuleName = "wolvrix.Design";
 
+    // Bindings drop the GIL while they work on a design, so each capsule carries its own lock:
+    // passes that edit the design take it exclusively, readers (emit, store, dryrun) share it.
+    // The slang compilation is gone once read_sv returns, so diagnostics raised on a stored
+    // design are formatted without a source manager.
     struct DesignHandle
     {
         wolvrix::lib::grh::Design design;
-        std::shared_ptr<slang::ast::Compilation> compilation;
+        std::shared_mutex mutex;
+        // Live graph_view() arrays pointing into frozen graphs of this design; passes refuse
+        // to edit the design while any exist. Only incremented with `mutex` held.
+        std::atomic<std::size_t> exportedArrays{0};
+        // Set once the graphs' lazily built lists are filled, cleared by every exclusive writer;
+        // read under the shared lock, written under the exclusive one.
+        bool readersPrepared = false;
+    };
+
+    // Takes the design's lock for a reader. Unfrozen graphs fill their operation/value/port
+    // lists on first const access, so after any edit the first reader fills them under the
+    // exclusive lock before readers may share the design.
+    std::shared_lock<std::shared_mutex> lockDesignForRead(DesignHandle &handle)
+    {
+        for (;;)
+        {
+            {
+                std::shared_lock lock(handle.mutex);
+                if (handle.readersPrepared)
+                {
+                    return lock;
+                }
+            }
+            std::unique_lock lock(handle.mutex);
+            handle.design.prepareConcurrentReads();
+            handle.readersPrepared = true;
+        }
+    }
+
+    // Releases the GIL for the lifetime of the scope; it is re-acquired on unwind as well, so
+    // exceptions thrown by the C++ work reach the caller's catch with the GIL held. Nothing
+    // inside the scope may touch Python objects.
+    class ScopedGilRelease
+    {
+    public:
+        ScopedGilRelease() : state_(PyEval_SaveThread()) {}
+        ~ScopedGilRelease() { PyEval_RestoreThread(state_); }
+        ScopedGilRelease(const ScopedGilRelease &) = delete;
+        ScopedGilRelease &operator=(const ScopedGilRelease &) = delete;
+
+    private:
+        PyThreadState *state_;
     };
 
     void destroyDesignCapsule(PyObject *capsule)
@@ -54,62 +109,76 @@ namespace
             PyCapsule_GetPointer(capsule, kDesignCapsuleName));
     }
 
-    wolvrix::lib::grh::Design *getDesign(PyObject *capsule)
+    // Designs whose run_pass/run_pipeline is streaming events on this thread. Callbacks run here
+    // while the worker may hold the design's exclusive lock and wait for the callback to drain
+    // the channel, so entering the same design from a callback would deadlock.
+    thread_local std::vector<const DesignHandle *> streamingDesigns;
+
+    class StreamingDesignScope
     {
-        auto *handle = getDesignHandle(capsule);
-        if (!handle)
-        {
-            return nullptr;
-        }
-        return &handle->design;
-    }
+    public:
+        explicit StreamingDesignScope(const DesignHandle &handle) { streamingDesigns.push_back(&handle); }
+        ~StreamingDesignScope() { streamingDesigns.pop_back(); }
+        StreamingDesignScope(const StreamingDesignScope &) = delete;
+        StreamingDesignScope &operator=(const StreamingDesignScope &) = delete;
+    };
 
-    const slang::SourceManager *getDesignSourceManager(PyObject *capsule)
+    // getDesignHandle for bindings that lock the design; raises instead of deadlocking when
+    // called from an on_diagnostic/on_log callback of a run on the same design.
+    DesignHandle *getDesignHandleForCall(PyObject *capsule)
     {
-        auto *handle = getDesignHandle(capsule);
-        if (!handle || !handle->compilation)
+        DesignHandle *handle = getDesignHandle(capsule);
+        if (handle && std::find(streamingDesigns.begin(), streamingDesigns.end(), handle) != streamingDesigns.end())
         {
+            PyErr_SetString(PyExc_RuntimeError,
+                            "design is busy: on_diagnostic/on_log callbacks must not use the design being processed");
             return nullptr;
         }
-        return handle->compilation->getSourceManager();
+        return handle;
     }
 
-    PyObject *makeDesignCapsule(wolvrix::lib::grh::Design design,
-                                std::shared_ptr<slang::ast::Compilation> compilation = {})
+    PyObject *makeDesignCapsule(wolvrix::lib::grh::Design design)
     {
-        auto *handle = new DesignHandle{std::move(design), std::move(compilation)};
+        auto *handle = new DesignHandle{std::move(design), {}, {}};
         return PyCapsule_New(handle, kDesignCapsuleName, destroyDesignCapsule);
     }
 
-    bool readFileText(const std::string &path, std::string &out, std::string &error)
+    struct ProcessRss
     {
-        std::ifstream input(path, std::ios::binary);
-        if (!input)
-        {
-            error = "open failed: " + path;
-            return false;
-        }
-        input.seekg(0, std::ios::end);
-        const std::streamoff endPos = input.tellg();
-        if (endPos <= 0)
-        {
-            error = "empty file: " + path;
-            return false;
-        }
-        out.resize(static_cast<std::size_t>(endPos));
-        input.seekg(0, std::ios::beg);
-        input.read(out.data(), static_cast<std::streamsize>(out.size()));
-        if (!input || static_cast<std::size_t>(input.gcount()) != out.size())
-        {
-            error = "read failed: " + path;
-            return false;
-        }
-        if (out.empty())
+        std::size_t currentKb = 0;
+        std::size_t peakKb = 0;
+    };
+
+    ProcessRss readProcessRss()
+    {
+        ProcessRss rss;
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line))
         {
-            error = "empty file: " + path;
-            return false;
+            auto parseKb = [&](std::string_view prefix, std::size_t &out) {
+                if (line.rfind(prefix, 0) != 0)
+                {
+                    return;
+                }
+                out = static_cast<std::size_t>(std::strtoull(line.c_str() + prefix.size(), nullptr, 10));
+            };
+            parseKb("VmRSS:", rss.currentKb);
+            parseKb("VmHWM:", rss.peakKb);
         }
-        return true;
+        return rss;
+    }
+
+    std::string formatRss(std::string_view stage, const ProcessRss &rss)
+    {
+        std::string out = "read_sv ";
+        out.append(stage);
+        out.append(" rss=");
+        out.append(std::to_string(rss.currentKb / 1024));
+        out.append("MB peak_rss=");
+        out.append(std::to_string(rss.peakKb / 1024));
+        out.append("MB");
+        return out;
     }
 
     bool parseStringList(PyObject *obj, std::vector<std::string> &out, std::string &error)
@@ -415,6 +484,49 @@ namespace
         }
     }
 
+    // The `diagnostics=` level of a binding. Errors are always kept so a failing call can still
+    // explain itself; everything else below the threshold is dropped before it is formatted.
+    bool keepDiagnostic(wolvrix::lib::diag::DiagnosticKind kind, wolvrix::lib::LogLevel threshold)
+    {
+        const auto level = diagnosticToLogLevel(kind);
+        return level == wolvrix::lib::LogLevel::Error || logLevelRank(level) >= logLevelRank(threshold);
+    }
+
+    wolvrix::lib::transform::PassVerbosity passVerbosity(wolvrix::lib::LogLevel threshold)
+    {
+        switch (threshold)
+        {
+        case wolvrix::lib::LogLevel::Trace:
+        case wolvrix::lib::LogLevel::Debug:
+            return wolvrix::lib::transform::PassVerbosity::Debug;
+        case wolvrix::lib::LogLevel::Info:
+            return wolvrix::lib::transform::PassVerbosity::Info;
+        case wolvrix::lib::LogLevel::Warn:
+            return wolvrix::lib::transform::PassVerbosity::Warning;
+        default:
+            return wolvrix::lib::transform::PassVerbosity::Error;
+        }
+    }
+
+    const char *logLevelName(wolvrix::lib::LogLevel level)
+    {
+        switch (level)
+        {
+        case wolvrix::lib::LogLevel::Trace:
+            return "trace";
+        case wolvrix::lib::LogLevel::Debug:
+            return "debug";
+        case wolvrix::lib::LogLevel::Info:
+            return "info";
+        case wolvrix::lib::LogLevel::Warn:
+            return "warn";
+        case wolvrix::lib::LogLevel::Error:
+            return "error";
+        default:
+            return "off";
+        }
+    }
+
     struct DiagnosticLocationInfo
     {
         slang::SourceLocation location;
@@ -686,89 +798,358 @@ namespace
         return out;
     }
 
-    PyObject *diagnosticsToPyList(const std::vector<wolvrix::lib::diag::Diagnostic> &messages,
-                                  const slang::SourceManager *sourceManager)
+    // A diagnostic with its location resolved and text formatted. Building these needs only the
+    // source manager, so it happens before the GIL is re-acquired.
+    struct DiagnosticRecord
+    {
+        wolvrix::lib::diag::DiagnosticKind kind = wolvrix::lib::diag::DiagnosticKind::Error;
+        std::string passName;
+        std::string message;
+        std::string context;
+        std::string originSymbol;
+        bool hasLocation = false;
+        std::string file;
+        std::size_t line = 0;
+        std::size_t column = 0;
+        std::string text;
+    };
+
+    DiagnosticRecord resolveDiagnostic(const wolvrix::lib::diag::Diagnostic &message,
+                                       const slang::SourceManager *sourceManager)
+    {
+        DiagnosticRecord record;
+        record.kind = message.kind;
+        record.passName = message.passName;
+        record.message = message.message;
+        record.context = message.context;
+        record.originSymbol = message.originSymbol;
+        if (message.location && sourceManager)
+        {
+            DiagnosticLocationInfo info;
+            if (getDiagnosticLocationInfo(sourceManager, *message.location, info))
+            {
+                record.hasLocation = true;
+                record.file = std::move(info.filename);
+                record.line = info.line;
+                record.column = info.column;
+            }
+        }
+        record.text = formatDiagnostic(message, sourceManager, false);
+        return record;
+    }
+
+    std::vector<DiagnosticRecord> resolveDiagnostics(const std::vector<wolvrix::lib::diag::Diagnostic> &messages,
+                                                     const slang::SourceManager *sourceManager,
+                                                     wolvrix::lib::LogLevel threshold)
+    {
+        std::vector<DiagnosticRecord> records;
+        for (const auto &message : messages)
+        {
+            if (keepDiagnostic(message.kind, threshold))
+            {
+                records.push_back(resolveDiagnostic(message, sourceManager));
+            }
+        }
+        return records;
+    }
+
+    PyObject *diagnosticToPyDict(const DiagnosticRecord &record)
+    {
+        PyObject *dict = PyDict_New();
+        if (!dict)
+        {
+            return nullptr;
+        }
+        const char *kindText = diagnosticKindName(record.kind);
+        auto *kind = PyUnicode_FromStringAndSize(kindText, static_cast<Py_ssize_t>(std::strlen(kindText)));
+        auto *pass = PyUnicode_FromStringAndSize(record.passName.data(),
+                                                 static_cast<Py_ssize_t>(record.passName.size()));
+        auto *msg = PyUnicode_FromStringAndSize(record.message.data(),
+                                                static_cast<Py_ssize_t>(record.message.size()));
+        auto *ctx = PyUnicode_FromStringAndSize(record.context.data(),
+                                                static_cast<Py_ssize_t>(record.context.size()));
+        auto *origin = PyUnicode_FromStringAndSize(record.originSymbol.data(),
+                                                   static_cast<Py_ssize_t>(record.originSymbol.size()));
+        if (!kind || !pass || !msg || !ctx || !origin)
+        {
+            Py_XDECREF(kind);
+            Py_XDECREF(pass);
+            Py_XDECREF(msg);
+            Py_XDECREF(ctx);
+            Py_XDECREF(origin);
+            Py_DECREF(dict);
+            return nullptr;
+        }
+        PyDict_SetItemString(dict, "kind", kind);
+        PyDict_SetItemString(dict, "pass", pass);
+        PyDict_SetItemString(dict, "message", msg);
+        PyDict_SetItemString(dict, "context", ctx);
+        PyDict_SetItemString(dict, "origin", origin);
+        Py_DECREF(kind);
+        Py_DECREF(pass);
+        Py_DECREF(msg);
+        Py_DECREF(ctx);
+        Py_DECREF(origin);
+
+        if (record.hasLocation)
+        {
+            PyObject *file = PyUnicode_FromStringAndSize(record.file.data(),
+                                                         static_cast<Py_ssize_t>(record.file.size()));
+            PyObject *line = PyLong_FromUnsignedLongLong(record.line);
+            PyObject *column = PyLong_FromUnsignedLongLong(record.column);
+            if (file && line && column)
+            {
+                PyDict_SetItemString(dict, "file", file);
+                PyDict_SetItemString(dict, "line", line);
+                PyDict_SetItemString(dict, "column", column);
+            }
+            Py_XDECREF(file);
+            Py_XDECREF(line);
+            Py_XDECREF(column);
+        }
+
+        PyObject *text_obj = PyUnicode_FromStringAndSize(record.text.data(),
+                                                         static_cast<Py_ssize_t>(record.text.size()));
+        if (!text_obj)
+        {
+            Py_DECREF(dict);
+            return nullptr;
+        }
+        PyDict_SetItemString(dict, "text", text_obj);
+        Py_DECREF(text_obj);
+        return dict;
+    }
+
+    PyObject *diagnosticsToPyList(const std::vector<DiagnosticRecord> &records)
     {
-        PyObject *list = PyList_New(static_cast<Py_ssize_t>(messages.size()));
+        PyObject *list = PyList_New(static_cast<Py_ssize_t>(records.size()));
         if (!list)
         {
             return nullptr;
         }
-        for (Py_ssize_t i = 0; i < static_cast<Py_ssize_t>(messages.size()); ++i)
+        for (Py_ssize_t i = 0; i < static_cast<Py_ssize_t>(records.size()); ++i)
         {
-            const auto &message = messages[static_cast<std::size_t>(i)];
-            PyObject *dict = PyDict_New();
+            PyObject *dict = diagnosticToPyDict(records[static_cast<std::size_t>(i)]);
             if (!dict)
             {
                 Py_DECREF(list);
                 return nullptr;
             }
-            const char *kindText = diagnosticKindName(message.kind);
-            auto *kind = PyUnicode_FromStringAndSize(kindText, static_cast<Py_ssize_t>(std::strlen(kindText)));
-            auto *pass = PyUnicode_FromStringAndSize(message.passName.data(),
-                                                     static_cast<Py_ssize_t>(message.passName.size()));
-            auto *msg = PyUnicode_FromStringAndSize(message.message.data(),
-                                                    static_cast<Py_ssize_t>(message.message.size()));
-            auto *ctx = PyUnicode_FromStringAndSize(message.context.data(),
-                                                    static_cast<Py_ssize_t>(message.context.size()));
-            auto *origin = PyUnicode_FromStringAndSize(message.originSymbol.data(),
-                                                       static_cast<Py_ssize_t>(message.originSymbol.size()));
-            if (!kind || !pass || !msg || !ctx || !origin)
-            {
-                Py_XDECREF(kind);
-                Py_XDECREF(pass);
-                Py_XDECREF(msg);
-                Py_XDECREF(ctx);
-                Py_XDECREF(origin);
-                Py_DECREF(dict);
-                Py_DECREF(list);
-                return nullptr;
+            PyList_SET_ITEM(list, i, dict);
+        }
+        return list;
+    }
+
+    PyObject *logEventToPyDict(const wolvrix::lib::LogEvent &event)
+    {
+        return Py_BuildValue("{s:s,s:s#,s:s#}", "level", logLevelName(event.level),
+                             "tag", event.tag.data(), static_cast<Py_ssize_t>(event.tag.size()),
+                             "message", event.message.data(), static_cast<Py_ssize_t>(event.message.size()));
+    }
+
+    void printLogLine(std::string_view tag, std::string_view message)
+    {
+        std::string out;
+        if (!tag.empty())
+        {
+            out.append(tag);
+            out.append(": ");
+        }
+        out.append(message);
+        std::cerr << out << '\n';
+    }
+
+    // Bounded FIFO between the thread doing the work and the Python thread running the
+    // callbacks. Producers block while it is full, so a noisy run never holds more than
+    // `capacity` undelivered events no matter how slow the callback is.
+    class EventChannel
+    {
+    public:
+        using Event = std::variant<DiagnosticRecord, wolvrix::lib::LogEvent>;
+        static constexpr std::size_t kDefaultCapacity = 1024;
+
+        explicit EventChannel(std::size_t capacity = kDefaultCapacity) : slots_(capacity) {}
+
+        void push(Event event)
+        {
+            std::unique_lock lock(mutex_);
+            notFull_.wait(lock, [&] { return count_ < slots_.size(); });
+            slots_[(head_ + count_) % slots_.size()] = std::move(event);
+            ++count_;
+            notEmpty_.notify_one();
+        }
+
+        void close()
+        {
+            std::lock_guard lock(mutex_);
+            closed_ = true;
+            notEmpty_.notify_all();
+        }
+
+        // Waits for events and moves every pending one into `out`; false once the channel is
+        // closed and empty.
+        bool drain(std::vector<Event> &out)
+        {
+            std::unique_lock lock(mutex_);
+            notEmpty_.wait(lock, [&] { return count_ != 0 || closed_; });
+            if (count_ == 0)
+            {
+                return false;
             }
-            PyDict_SetItemString(dict, "kind", kind);
-            PyDict_SetItemString(dict, "pass", pass);
-            PyDict_SetItemString(dict, "message", msg);
-            PyDict_SetItemString(dict, "context", ctx);
-            PyDict_SetItemString(dict, "origin", origin);
-            Py_DECREF(kind);
-            Py_DECREF(pass);
-            Py_DECREF(msg);
-            Py_DECREF(ctx);
-            Py_DECREF(origin);
-
-            if (message.location && sourceManager)
-            {
-                DiagnosticLocationInfo info;
-                if (getDiagnosticLocationInfo(sourceManager, *message.location, info))
-                {
-                    PyObject *file = PyUnicode_FromString(info.filename.c_str());
-                    PyObject *line = PyLong_FromUnsignedLongLong(info.line);
-                    PyObject *column = PyLong_FromUnsignedLongLong(info.column);
-                    if (file && line && column)
-                    {
-                        PyDict_SetItemString(dict, "file", file);
-                        PyDict_SetItemString(dict, "line", line);
-                        PyDict_SetItemString(dict, "column", column);
-                    }
-                    Py_XDECREF(file);
-                    Py_XDECREF(line);
-                    Py_XDECREF(column);
-                }
+            for (; count_ != 0; --count_)
+            {
+                out.push_back(std::move(slots_[head_]));
+                head_ = (head_ + 1) % slots_.size();
+            }
+            notFull_.notify_all();
+            return true;
+        }
+
+    private:
+        std::vector<Event> slots_;
+        std::size_t head_ = 0;
+        std::size_t count_ = 0;
+        bool closed_ = false;
+        std::mutex mutex_;
+        std::condition_variable notEmpty_;
+        std::condition_variable notFull_;
+    };
+
+    // Python callables receiving streamed diagnostics and log events; either may be null.
+    struct StreamCallbacks
+    {
+        PyObject *onDiagnostic = nullptr;
+        PyObject *onLog = nullptr;
+
+        bool active() const noexcept { return onDiagnostic || onLog; }
+    };
+
+    bool parseStreamCallbacks(PyObject *onDiagnostic, PyObject *onLog, StreamCallbacks &callbacks)
+    {
+        for (PyObject *callback : {onDiagnostic, onLog})
+        {
+            if (callback != Py_None && !PyCallable_Check(callback))
+            {
+                PyErr_SetString(PyExc_TypeError, "on_diagnostic and on_log must be callable or None");
+                return false;
+            }
+        }
+        callbacks.onDiagnostic = onDiagnostic == Py_None ? nullptr : onDiagnostic;
+        callbacks.onLog = onLog == Py_None ? nullptr : onLog;
+        return true;
+    }
+
+    // Log sink for PassManagerOptions: streams to `channel` when the caller asked for log events
+    // and prints to stderr otherwise.
+    std::function<void(wolvrix::lib::LogLevel, std::string_view, std::string_view)>
+    passLogSink(EventChannel *channel)
+    {
+        if (channel)
+        {
+            return [channel](wolvrix::lib::LogLevel level, std::string_view tag, std::string_view message) {
+                channel->push(wolvrix::lib::LogEvent{level, std::string(tag), std::string(message)});
+            };
+        }
+        return [](wolvrix::lib::LogLevel, std::string_view tag, std::string_view message) {
+            printLogLine(tag, message);
+        };
+    }
+
+    // Routes diagnostics that pass `threshold` into `channel` as they are recorded, resolved
+    // and formatted on the producing thread.
+    void streamDiagnostics(wolvrix::lib::diag::Diagnostics &diagnostics,
+                           EventChannel &channel,
+                           wolvrix::lib::LogLevel threshold,
+                           const slang::SourceManager *sourceManager)
+    {
+        diagnostics.setSink([&channel, threshold, sourceManager](wolvrix::lib::diag::Diagnostic &&message) {
+            if (keepDiagnostic(message.kind, threshold))
+            {
+                channel.push(resolveDiagnostic(message, sourceManager));
             }
+        });
+    }
 
-            const std::string text = formatDiagnostic(message, sourceManager, false);
-            PyObject *text_obj = PyUnicode_FromStringAndSize(text.data(), static_cast<Py_ssize_t>(text.size()));
-            if (!text_obj)
+    // Runs `work` on a helper thread while the calling thread hands the events it streams to the
+    // Python callbacks, a batch per GIL acquisition. Once a callback raises, later events are
+    // drained without delivery and the work still runs to completion, so no lock is abandoned
+    // midway; the function then returns false with that Python error set. Exceptions thrown by
+    // `work` are rethrown on the calling thread.
+    template <typename Work>
+    bool runStreaming(EventChannel &channel, const StreamCallbacks &callbacks, Work &&work)
+    {
+        std::exception_ptr failure;
+        std::thread worker([&]() {
+            try
             {
-                Py_DECREF(dict);
-                Py_DECREF(list);
-                return nullptr;
+                work();
+            }
+            catch (...)
+            {
+                failure = std::current_exception();
             }
-            PyDict_SetItemString(dict, "text", text_obj);
-            Py_DECREF(text_obj);
+            channel.close();
+        });
 
-            PyList_SET_ITEM(list, i, dict);
+        bool callbackFailed = false;
+        std::vector<EventChannel::Event> batch;
+        for (;;)
+        {
+            bool more = false;
+            {
+                ScopedGilRelease nogil;
+                more = channel.drain(batch);
+            }
+            if (!more)
+            {
+                break;
+            }
+            for (const auto &event : batch)
+            {
+                if (callbackFailed)
+                {
+                    break;
+                }
+                PyObject *callback = nullptr;
+                PyObject *arg = nullptr;
+                if (const auto *record = std::get_if<DiagnosticRecord>(&event))
+                {
+                    callback = callbacks.onDiagnostic;
+                    arg = callback ? diagnosticToPyDict(*record) : nullptr;
+                }
+                else
+                {
+                    callback = callbacks.onLog;
+                    arg = callback ? logEventToPyDict(std::get<wolvrix::lib::LogEvent>(event)) : nullptr;
+                }
+                if (!callback)
+                {
+                    continue;
+                }
+                PyObject *result = arg ? PyObject_CallOneArg(callback, arg) : nullptr;
+                Py_XDECREF(arg);
+                if (!result)
+                {
+                    callbackFailed = true;
+                    break;
+                }
+                Py_DECREF(result);
+            }
+            batch.clear();
         }
-        return list;
+        {
+            ScopedGilRelease nogil;
+            worker.join();
+        }
+        if (failure)
+        {
+            if (callbackFailed)
+            {
+                PyErr_Clear();
+            }
+            std::rethrow_exception(failure);
+        }
+        return !callbackFailed;
     }
 
     void emitDiagnostics(const std::vector<wolvrix::lib::diag::Diagnostic> &messages,
@@ -804,63 +1185,26 @@ namespace
         }
     }
 
-    PyObject *py_read_sv(PyObject * /*self*/, PyObject *args, PyObject *kwargs)
+    struct ReadSvOutcome
     {
-        PyObject *path_obj = nullptr;
-        PyObject *slang_args_obj = Py_None;
-        const char *log_level_text = "info";
-        const char *diag_text = "warn";
-        static const char *kwlist[] = {"path", "slang_args", "log_level", "diagnostics", nullptr};
-        if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|Oss",
-                                         const_cast<char **>(kwlist),
-                                         &path_obj, &slang_args_obj, &log_level_text, &diag_text))
-        {
-            return nullptr;
-        }
-
-        const char *path = nullptr;
-        if (path_obj == Py_None)
-        {
-            path = nullptr;
-        }
-        else if (PyUnicode_Check(path_obj))
-        {
-            path = PyUnicode_AsUTF8(path_obj);
-            if (!path)
-            {
-                return nullptr;
-            }
-        }
-        else
-        {
-            PyErr_SetString(PyExc_ValueError, "path must be a string or None");
-            return nullptr;
-        }
-
-        std::vector<std::string> slang_args;
+        // Set when slang rejected the options or sources; raised as RuntimeError.
         std::string error;
-        if (!parseStringList(slang_args_obj, slang_args, error))
-        {
-            PyErr_SetString(PyExc_ValueError, error.c_str());
-            return nullptr;
-        }
+        bool success = false;
+        std::optional<wolvrix::lib::grh::Design> design;
+        std::vector<DiagnosticRecord> diagnostics;
+    };
 
-        std::vector<std::string> argv_storage;
-        argv_storage.reserve(2 + slang_args.size());
-        argv_storage.emplace_back("read_sv");
-        if (path && path[0] != '\0')
-        {
-            argv_storage.emplace_back(path);
-        }
-        else if (path && path[0] == '\0')
-        {
-            PyErr_SetString(PyExc_ValueError, "path must be a non-empty string or None");
-            return nullptr;
-        }
-        for (const auto &arg : slang_args)
-        {
-            argv_storage.push_back(arg);
-        }
+    // Parses, elaborates and converts without touching Python, so callers run it with the GIL
+    // released. Non-null channels receive the diagnostics / log events as they happen instead
+    // of collecting them.
+    ReadSvOutcome runReadSv(const std::vector<std::string> &argv_storage,
+                            int parse_threads,
+                            wolvrix::lib::LogLevel log_level,
+                            wolvrix::lib::LogLevel diag_level,
+                            EventChannel *diagnosticChannel,
+                            EventChannel *logChannel)
+    {
+        ReadSvOutcome outcome;
         std::vector<const char *> argv;
         argv.reserve(argv_storage.size());
         for (const auto &arg : argv_storage)
@@ -868,40 +1212,52 @@ namespace
             argv.push_back(arg.c_str());
         }
 
-        slang::driver::Driver driver;
-        driver.addStandardArgs();
-        driver.options.singleUnit = true;
-        driver.options.compilationFlags.at(slang::ast::CompilationFlags::AllowTopLevelIfacePorts) = true;
+        auto driver = std::make_unique<slang::driver::Driver>();
+        driver->addStandardArgs();
+        // parse_threads == 1 keeps the historical single compilation unit. Any other value
+        // loads and parses every file as its own syntax tree on slang's thread pool (0 means
+        // one thread per core); macros then do not leak from one file into the next.
+        const bool parallelParse = parse_threads != 1;
+        driver->options.singleUnit = !parallelParse;
+        if (parallelParse)
+        {
+            driver->options.numThreads = static_cast<uint32_t>(parse_threads);
+        }
+        driver->options.compilationFlags.at(slang::ast::CompilationFlags::AllowTopLevelIfacePorts) = true;
 
         auto reportSlangDiagnostics = [&]() {
-            if (driver.diagEngine.getNumErrors() == 0 && driver.diagEngine.getNumWarnings() == 0)
+            if (driver->diagEngine.getNumErrors() == 0 && driver->diagEngine.getNumWarnings() == 0)
             {
                 return;
             }
-            (void)driver.reportDiagnostics(/* quiet */ true);
+            (void)driver->reportDiagnostics(/* quiet */ true);
         };
 
-        if (!driver.parseCommandLine(static_cast<int>(argv.size()), argv.data()))
+        if (!driver->parseCommandLine(static_cast<int>(argv.size()), argv.data()))
         {
             reportSlangDiagnostics();
-            PyErr_SetString(PyExc_RuntimeError, "failed to parse slang options");
-            return nullptr;
+            outcome.error = "failed to parse slang options";
+            return outcome;
         }
-        if (!driver.processOptions())
+        if (!driver->processOptions())
         {
             reportSlangDiagnostics();
-            PyErr_SetString(PyExc_RuntimeError, "failed to apply slang options");
-            return nullptr;
+            outcome.error = "failed to apply slang options";
+            return outcome;
         }
-        if (!driver.parseAllSources())
+        using ReadClock = std::chrono::steady_clock;
+        const auto parseStart = ReadClock::now();
+        if (!driver->parseAllSources())
         {
             reportSlangDiagnostics();
-            PyErr_SetString(PyExc_RuntimeError, "failed to parse sources");
-            return nullptr;
+            outcome.error = "failed to parse sources";
+            return outcome;
         }
+        const auto parseEnd = ReadClock::now();
+        const std::size_t syntaxTreeCount = driver->syntaxTrees.size();
 
-        auto compilation = std::shared_ptr<slang::ast::Compilation>(driver.createCompilation());
-        driver.runAnalysis(*compilation);
+        std::unique_ptr<slang::ast::Compilation> compilation = driver->createCompilation();
+        driver->runAnalysis(*compilation);
         const auto &allDiagnostics = compilation->getAllDiagnostics();
         bool hasSlangIssues = false;
         bool hasSlangErrors = false;
@@ -919,80 +1275,230 @@ namespace
         }
         if (hasSlangIssues)
         {
-            driver.reportCompilation(*compilation, /* quiet */ true);
+            driver->reportCompilation(*compilation, /* quiet */ true);
             reportSlangDiagnostics();
         }
         if (hasSlangErrors)
         {
-            PyErr_SetString(PyExc_RuntimeError, "slang reported errors; see diagnostics");
-            return nullptr;
-        }
-
-        bool ok = false;
-        const wolvrix::lib::LogLevel log_level = parseLogLevel(log_level_text, ok);
-        if (!ok)
-        {
-            PyErr_SetString(PyExc_ValueError, "unknown log_level");
-            return nullptr;
-        }
-        wolvrix::lib::LogLevel diag_level = wolvrix::lib::LogLevel::Warn;
-        if (!parseDiagnosticsLevel(diag_text, diag_level))
-        {
-            PyErr_SetString(PyExc_ValueError, "unknown diagnostics level");
-            return nullptr;
+            outcome.error = "slang reported errors; see diagnostics";
+            return outcome;
         }
-        (void)diag_level;
+        const auto elaborateEnd = ReadClock::now();
 
         wolvrix::lib::ingest::ConvertOptions convertOptions;
         convertOptions.abortOnError = true;
         convertOptions.enableLogging = log_level != wolvrix::lib::LogLevel::Off;
+        convertOptions.enableTiming = log_level == wolvrix::lib::LogLevel::Trace;
         convertOptions.logLevel = log_level;
 
         wolvrix::lib::ingest::ConvertDriver converter(convertOptions);
         if (convertOptions.enableLogging)
         {
-            converter.logger().setSink([](const wolvrix::lib::LogEvent &event) {
-                std::string message;
-                if (!event.tag.empty())
+            converter.logger().setSink([logChannel](const wolvrix::lib::LogEvent &event) {
+                if (logChannel)
                 {
-                    message.append(event.tag);
-                    message.append(": ");
+                    logChannel->push(event);
+                    return;
                 }
-                message.append(event.message);
-                std::cerr << message << '\n';
+                printLogLine(event.tag, event.message);
             });
         }
+        if (diagnosticChannel)
+        {
+            streamDiagnostics(converter.diagnostics(), *diagnosticChannel, diag_level,
+                              compilation->getSourceManager());
+        }
 
-        wolvrix::lib::grh::Design design;
+        auto logRss = [&](std::string_view stage) {
+            if (!convertOptions.enableTiming)
+            {
+                return;
+            }
+            converter.logger().log(wolvrix::lib::LogLevel::Trace, "timing",
+                                   formatRss(stage, readProcessRss()));
+        };
+        logRss("elaborated");
+        if (parallelParse && syntaxTreeCount > 1)
+        {
+            converter.logger().log(wolvrix::lib::LogLevel::Warn, "read_sv",
+                                   "parse_threads=" + std::to_string(parse_threads) + " parsed " +
+                                       std::to_string(syntaxTreeCount) +
+                                       " files as separate compilation units; macros defined in one "
+                                       "file are not visible in the others (parse_threads=1 keeps a "
+                                       "single unit)");
+        }
+
+        // The stage summary is logged after the slang state is dropped so that it can carry the
+        // final and peak RSS of the whole read_sv call.
+        auto logStageTiming = [&](ReadClock::time_point convertEnd) {
+            if (!convertOptions.enableTiming)
+            {
+                return;
+            }
+            auto ms = [](ReadClock::duration duration) {
+                return std::to_string(
+                    std::chrono::duration_cast<std::chrono::milliseconds>(duration).count());
+            };
+            const ProcessRss rss = readProcessRss();
+            std::string message = "read_sv files=" + std::to_string(syntaxTreeCount);
+            message.append(parallelParse ? " parse_mode=per-file" : " parse_mode=single-unit");
+            message.append(" parse=" + ms(parseEnd - parseStart) + "ms");
+            message.append(" elaborate=" + ms(elaborateEnd - parseEnd) + "ms");
+            message.append(" convert=" + ms(convertEnd - elaborateEnd) + "ms");
+            message.append(" final_rss=" + std::to_string(rss.currentKb / 1024) + "MB");
+            message.append(" peak_rss=" + std::to_string(rss.peakKb / 1024) + "MB");
+            converter.logger().log(wolvrix::lib::LogLevel::Trace, "timing", message);
+        };
+
+        ReadClock::time_point convertEnd;
         try
         {
-            design = converter.convert(compilation->getRoot());
+            wolvrix::lib::grh::Design design = converter.convert(compilation->getRoot());
+            converter.diagnostics().flushThreadLocal();
+            convertEnd = ReadClock::now();
+            logRss("converted");
+            outcome.success = !converter.diagnostics().hasError();
+            if (outcome.success)
+            {
+                outcome.design.emplace(std::move(design));
+            }
         }
         catch (const wolvrix::lib::ingest::ConvertAbort &)
         {
             converter.diagnostics().flushThreadLocal();
-            PyObject *diag_list = diagnosticsToPyList(converter.diagnostics().messages(),
-                                                      compilation->getSourceManager());
-            if (!diag_list)
+            convertEnd = ReadClock::now();
+        }
+        outcome.diagnostics = resolveDiagnostics(converter.diagnostics().messages(),
+                                                 compilation->getSourceManager(), diag_level);
+        // Slang state is only needed until diagnostics are formatted; drop it before
+        // the Design is handed to Python so the capsule holds nothing but the graphs.
+        compilation.reset();
+        driver.reset();
+        logStageTiming(convertEnd);
+        return outcome;
+    }
+
+    PyObject *py_read_sv(PyObject * /*self*/, PyObject *args, PyObject *kwargs)
+    {
+        PyObject *path_obj = nullptr;
+        PyObject *slang_args_obj = Py_None;
+        const char *log_level_text = "info";
+        const char *diag_text = "warn";
+        int parse_threads = 1;
+        PyObject *on_diagnostic_obj = Py_None;
+        PyObject *on_log_obj = Py_None;
+        static const char *kwlist[] = {"path", "slang_args", "log_level", "diagnostics",
+                                       "parse_threads", "on_diagnostic", "on_log", nullptr};
+        if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|OssiOO",
+                                         const_cast<char **>(kwlist),
+                                         &path_obj, &slang_args_obj, &log_level_text, &diag_text,
+                                         &parse_threads, &on_diagnostic_obj, &on_log_obj))
+        {
+            return nullptr;
+        }
+        StreamCallbacks callbacks;
+        if (!parseStreamCallbacks(on_diagnostic_obj, on_log_obj, callbacks))
+        {
+            return nullptr;
+        }
+        if (parse_threads < 0)
+        {
+            PyErr_SetString(PyExc_ValueError, "parse_threads must be >= 0");
+            return nullptr;
+        }
+
+        const char *path = nullptr;
+        if (path_obj == Py_None)
+        {
+            path = nullptr;
+        }
+        else if (PyUnicode_Check(path_obj))
+        {
+            path = PyUnicode_AsUTF8(path_obj);
+            if (!path)
             {
                 return nullptr;
             }
-            PyObject *result = PyTuple_New(3);
-            if (!result)
+        }
+        else
+        {
+            PyErr_SetString(PyExc_ValueError, "path must be a string or None");
+            return nullptr;
+        }
+
+        std::vector<std::string> slang_args;
+        std::string error;
+        if (!parseStringList(slang_args_obj, slang_args, error))
+        {
+            PyErr_SetString(PyExc_ValueError, error.c_str());
+            return nullptr;
+        }
+
+        std::vector<std::string> argv_storage;
+        argv_storage.reserve(2 + slang_args.size());
+        argv_storage.emplace_back("read_sv");
+        if (path && path[0] != '\0')
+        {
+            argv_storage.emplace_back(path);
+        }
+        else if (path && path[0] == '\0')
+        {
+            PyErr_SetString(PyExc_ValueError, "path must be a non-empty string or None");
+            return nullptr;
+        }
+        for (const auto &arg : slang_args)
+        {
+            argv_storage.push_back(arg);
+        }
+
+        bool ok = false;
+        const wolvrix::lib::LogLevel log_level = parseLogLevel(log_level_text, ok);
+        if (!ok)
+        {
+            PyErr_SetString(PyExc_ValueError, "unknown log_level");
+            return nullptr;
+        }
+        wolvrix::lib::LogLevel diag_level = wolvrix::lib::LogLevel::Warn;
+        if (!parseDiagnosticsLevel(diag_text, diag_level))
+        {
+            PyErr_SetString(PyExc_ValueError, "unknown diagnostics level");
+            return nullptr;
+        }
+
+        ReadSvOutcome outcome;
+        try
+        {
+            if (callbacks.active())
+            {
+                EventChannel channel;
+                EventChannel *diagnosticChannel = callbacks.onDiagnostic ? &channel : nullptr;
+                EventChannel *logChannel = callbacks.onLog ? &channel : nullptr;
+                if (!runStreaming(channel, callbacks, [&]() {
+                        outcome = runReadSv(argv_storage, parse_threads, log_level, diag_level,
+                                            diagnosticChannel, logChannel);
+                    }))
+                {
+                    return nullptr;
+                }
+            }
+            else
             {
-                Py_DECREF(diag_list);
-                return nullptr;
+                ScopedGilRelease nogil;
+                outcome = runReadSv(argv_storage, parse_threads, log_level, diag_level, nullptr, nullptr);
             }
-            Py_INCREF(Py_None);
-            PyTuple_SET_ITEM(result, 0, Py_None);
-            PyTuple_SET_ITEM(result, 1, PyBool_FromLong(0));
-            PyTuple_SET_ITEM(result, 2, diag_list);
-            return result;
-        }
-        converter.diagnostics().flushThreadLocal();
-        const bool success = !converter.diagnostics().hasError();
-        PyObject *diag_list = diagnosticsToPyList(converter.diagnostics().messages(),
-                                                  compilation->getSourceManager());
+        }
+        catch (const std::exception &ex)
+        {
+            PyErr_SetString(PyExc_RuntimeError, ex.what());
+            return nullptr;
+        }
+        if (!outcome.error.empty())
+        {
+            PyErr_SetString(PyExc_RuntimeError, outcome.error.c_str());
+            return nullptr;
+        }
+
+        PyObject *diag_list = diagnosticsToPyList(outcome.diagnostics);
         if (!diag_list)
         {
             return nullptr;
@@ -1003,9 +1509,9 @@ namespace
             Py_DECREF(diag_list);
             return nullptr;
         }
-        if (success)
+        if (outcome.design)
         {
-            PyObject *capsule = makeDesignCapsule(std::move(design), std::move(compilation));
+            PyObject *capsule = makeDesignCapsule(std::move(*outcome.design));
             if (!capsule)
             {
                 Py_DECREF(diag_list);
@@ -1019,7 +1525,7 @@ namespace
             Py_INCREF(Py_None);
             PyTuple_SET_ITEM(result, 0, Py_None);
         }
-        PyTuple_SET_ITEM(result, 1, PyBool_FromLong(success ? 1 : 0));
+        PyTuple_SET_ITEM(result, 1, PyBool_FromLong(outcome.success ? 1 : 0));
         PyTuple_SET_ITEM(result, 2, diag_list);
         return result;
     }
@@ -1032,16 +1538,13 @@ namespace
         {
             return nullptr;
         }
-        std::string contents;
-        std::string error;
-        if (!readFileText(path, contents, error))
-        {
-            PyErr_SetString(PyExc_RuntimeError, error.c_str());
-            return nullptr;
-        }
         try
         {
-            auto design = wolvrix::lib::grh::Design::fromJsonString(contents);
+            wolvrix::lib::grh::Design design;
+            {
+                ScopedGilRelease nogil;
+                design = wolvrix::lib::grh::Design::fromJsonFile(path);
+            }
             return makeDesignCapsule(std::move(design));
         }
         catch (const std::exception &ex)
@@ -1061,7 +1564,11 @@ namespace
         }
         try
         {
-            auto design = wolvrix::lib::grh::Design::fromJsonString(text);
+            wolvrix::lib::grh::Design design;
+            {
+                ScopedGilRelease nogil;
+                design = wolvrix::lib::grh::Design::fromJsonString(text);
+            }
             return makeDesignCapsule(std::move(design));
         }
         catch (const std::exception &ex)
@@ -1083,8 +1590,8 @@ namespace
             return nullptr;
         }
 
-        auto *design = getDesign(design_obj);
-        if (!design)
+        auto *handle = getDesignHandleForCall(design_obj);
+        if (!handle)
         {
             return nullptr;
         }
@@ -1111,11 +1618,19 @@ namespace
         options.jsonMode = mode;
         options.topOverrides = std::move(top_names);
 
-        auto text = store.storeToString(*design, options);
+        std::optional<std::string> text;
+        std::string diagText;
+        {
+            ScopedGilRelease nogil;
+            auto lock = lockDesignForRead(*handle);
+            text = store.storeToString(handle->design, options);
+            if (!text || diagnostics.hasError())
+            {
+                diagText = formatDiagnostics(diagnostics.messages(), nullptr);
+            }
+        }
         if (!text || diagnostics.hasError())
         {
-            const std::string diagText =
-                formatDiagnostics(diagnostics.messages(), getDesignSourceManager(design_obj));
             PyErr_SetString(PyExc_RuntimeError, diagText.c_str());
             return nullptr;
         }
@@ -1123,6 +1638,193 @@ namespace
         return PyUnicode_FromStringAndSize(text->data(), static_cast<Py_ssize_t>(text->size()));
     }
 
+    PyObject *py_read_grhb(PyObject * /*self*/, PyObject *args, PyObject *kwargs)
+    {
+        const char *path = nullptr;
+        int lazy = 0;
+        static const char *kwlist[] = {"path", "lazy", nullptr};
+        if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s|p", const_cast<char **>(kwlist), &path, &lazy))
+        {
+            return nullptr;
+        }
+        try
+        {
+            wolvrix::lib::grh::Design design;
+            {
+                ScopedGilRelease nogil;
+                wolvrix::lib::load::LoadGrhb loader;
+                design = lazy ? loader.loadLazy(path) : loader.loadFile(path);
+            }
+            return makeDesignCapsule(std::move(design));
+        }
+        catch (const std::exception &ex)
+        {
+            PyErr_SetString(PyExc_RuntimeError, ex.what());
+            return nullptr;
+        }
+    }
+
+    PyObject *py_write_grhb(PyObject * /*self*/, PyObject *args, PyObject *kwargs)
+    {
+        PyObject *design_obj = nullptr;
+        const char *output = nullptr;
+        PyObject *top_list_obj = Py_None;
+        static const char *kwlist[] = {"design", "output", "top", nullptr};
+        if (!PyArg_ParseTupleAndKeywords(args, kwargs, "Os|O", const_cast<char **>(kwlist),
+                                         &design_obj, &output, &top_list_obj))
+        {
+            return nullptr;
+        }
+        auto *handle = getDesignHandleForCall(design_obj);
+        if (!handle)
+        {
+            return nullptr;
+        }
+
+        std::vector<std::string> top_names;
+        std::string error;
+        if (!parseStringList(top_list_obj, top_names, error))
+        {
+            PyErr_SetString(PyExc_ValueError, error.c_str());
+            return nullptr;
+        }
+
+        const std::filesystem::path out_path(output);
+        if (out_path.filename().empty())
+        {
+            PyErr_SetString(PyExc_ValueError, "write_grhb expects an output file path");
+            return nullptr;
+        }
+        wolvrix::lib::store::StoreDiagnostics diagnostics;
+        wolvrix::lib::store::StoreGrhb store(&diagnostics);
+        wolvrix::lib::store::StoreOptions options;
+        options.outputFilename = out_path.filename().string();
+        if (!out_path.parent_path().empty())
+        {
+            options.outputDir = out_path.parent_path().string();
+        }
+        options.topOverrides = std::move(top_names);
+
+        bool success = false;
+        std::string diagText;
+        {
+            ScopedGilRelease nogil;
+            auto lock = lockDesignForRead(*handle);
+            success = store.store(handle->design, options).success && !diagnostics.hasError();
+            if (!success)
+            {
+                diagText = formatDiagnostics(diagnostics.messages(), nullptr);
+            }
+        }
+        if (!success)
+        {
+            PyErr_SetString(PyExc_RuntimeError, diagText.c_str());
+            return nullptr;
+        }
+
+        Py_RETURN_NONE;
+    }
+
+    PyObject *py_write_grhb_shm(PyObject * /*self*/, PyObject *args, PyObject *kwargs)
+    {
+        PyObject *design_obj = nullptr;
+        const char *name = nullptr;
+        PyObject *top_list_obj = Py_None;
+        static const char *kwlist[] = {"design", "name", "top", nullptr};
+        if (!PyArg_ParseTupleAndKeywords(args, kwargs, "Os|O", const_cast<char **>(kwlist),
+                                         &design_obj, &name, &top_list_obj))
+        {
+            return nullptr;
+        }
+        auto *handle = getDesignHandleForCall(design_obj);
+        if (!handle)
+        {
+            return nullptr;
+        }
+
+        std::vector<std::string> top_names;
+        std::string error;
+        if (!parseStringList(top_list_obj, top_names, error))
+        {
+            PyErr_SetString(PyExc_ValueError, error.c_str());
+            return nullptr;
+        }
+
+        wolvrix::lib::store::StoreDiagnostics diagnostics;
+        wolvrix::lib::store::StoreGrhb store(&diagnostics);
+        wolvrix::lib::store::StoreOptions options;
+        options.topOverrides = std::move(top_names);
+
+        bool success = false;
+        std::string diagText;
+        {
+            ScopedGilRelease nogil;
+            auto lock = lockDesignForRead(*handle);
+            success = store.storeToSharedMemory(handle->design, name, options) && !diagnostics.hasError();
+            if (!success)
+            {
+                diagText = formatDiagnostics(diagnostics.messages(), nullptr);
+            }
+        }
+        if (!success)
+        {
+            PyErr_SetString(PyExc_RuntimeError, diagText.c_str());
+            return nullptr;
+        }
+
+        Py_RETURN_NONE;
+    }
+
+    PyObject *py_read_grhb_shm(PyObject * /*self*/, PyObject *args, PyObject *kwargs)
+    {
+        const char *name = nullptr;
+        int lazy = 1;
+        static const char *kwlist[] = {"name", "lazy", nullptr};
+        if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s|p", const_cast<char **>(kwlist), &name, &lazy))
+        {
+            return nullptr;
+        }
+        try
+        {
+            wolvrix::lib::grh::Design design;
+            {
+                ScopedGilRelease nogil;
+                wolvrix::lib::load::LoadGrhb loader;
+                if (lazy)
+                {
+                    design = loader.loadLazy(wolvrix::lib::load::GrhbArchive::openSharedMemory(name));
+                }
+                else
+                {
+                    const auto mapping = wolvrix::lib::load::MappedFile::sharedMemory(name);
+                    design = loader.load(mapping.view());
+                }
+            }
+            return makeDesignCapsule(std::move(design));
+        }
+        catch (const std::exception &ex)
+        {
+            PyErr_SetString(PyExc_RuntimeError, ex.what());
+            return nullptr;
+        }
+    }
+
+    PyObject *py_unlink_shm(PyObject * /*self*/, PyObject *args, PyObject *kwargs)
+    {
+        const char *name = nullptr;
+        static const char *kwlist[] = {"name", nullptr};
+        if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s", const_cast<char **>(kwlist), &name))
+        {
+            return nullptr;
+        }
+        if (::shm_unlink(name) != 0)
+        {
+            PyErr_SetFromErrnoWithFilename(PyExc_OSError, name);
+            return nullptr;
+        }
+        Py_RETURN_NONE;
+    }
+
     PyObject *py_write_sv(PyObject * /*self*/, PyObject *args, PyObject *kwargs)
     {
         PyObject *design_obj = nullptr;
@@ -1135,8 +1837,8 @@ namespace
         {
             return nullptr;
         }
-        auto *design = getDesign(design_obj);
-        if (!design)
+        auto *handle = getDesignHandleForCall(design_obj);
+        if (!handle)
         {
             return nullptr;
         }
@@ -1181,11 +1883,19 @@ namespace
         }
         options.topOverrides = std::move(top_names);
 
-        const auto result = emitter.emit(*design, options);
-        if (diagnostics.hasError() || !result.success)
+        bool success = false;
+        std::string diagText;
+        {
+            ScopedGilRelease nogil;
+            auto lock = lockDesignForRead(*handle);
+            success = emitter.emit(handle->design, options).success && !diagnostics.hasError();
+            if (!success)
+            {
+                diagText = formatDiagnostics(diagnostics.messages(), nullptr);
+            }
+        }
+        if (!success)
         {
-            const std::string diagText =
-                formatDiagnostics(diagnostics.messages(), getDesignSourceManager(design_obj));
             PyErr_SetString(PyExc_RuntimeError, diagText.c_str());
             return nullptr;
         }
@@ -1204,8 +1914,8 @@ namespace
         {
             return nullptr;
         }
-        auto *design = getDesign(design_obj);
-        if (!design)
+        auto *handle = getDesignHandleForCall(design_obj);
+        if (!handle)
         {
             return nullptr;
         }
@@ -1231,11 +1941,19 @@ namespace
         options.outputDir = out_path.string();
         options.topOverrides = std::move(top_names);
 
-        const auto result = emitter.emit(*design, options);
-        if (diagnostics.hasError() || !result.success)
+        bool success = false;
+        std::string diagText;
+        {
+            ScopedGilRelease nogil;
+            auto lock = lockDesignForRead(*handle);
+            success = emitter.emit(handle->design, options).success && !diagnostics.hasError();
+            if (!success)
+            {
+                diagText = formatDiagnostics(diagnostics.messages(), nullptr);
+            }
+        }
+        if (!success)
         {
-            const std::string diagText =
-                formatDiagnostics(diagnostics.messages(), getDesignSourceManager(design_obj));
             PyErr_SetString(PyExc_RuntimeError, diagText.c_str());
             return nullptr;
         }
@@ -1251,9 +1969,18 @@ namespace
         int dryrun = 0;
         const char *diag_text = "warn";
         const char *log_text = "warn";
-        static const char *kwlist[] = {"design", "name", "args", "dryrun", "diagnostics", "log_level", nullptr};
-        if (!PyArg_ParseTupleAndKeywords(args, kwargs, "Os|Opss", const_cast<char **>(kwlist),
-                                         &design_obj, &pass_name, &pass_args_obj, &dryrun, &diag_text, &log_text))
+        PyObject *on_diagnostic_obj = Py_None;
+        PyObject *on_log_obj = Py_None;
+        static const char *kwlist[] = {"design", "name", "args", "dryrun", "diagnostics", "log_level",
+                                       "on_diagnostic", "on_log", nullptr};
+        if (!PyArg_ParseTupleAndKeywords(args, kwargs, "Os|OpssOO", const_cast<char **>(kwlist),
+                                         &design_obj, &pass_name, &pass_args_obj, &dryrun, &diag_text, &log_text,
+                                         &on_diagnostic_obj, &on_log_obj))
+        {
+            return nullptr;
+        }
+        StreamCallbacks callbacks;
+        if (!parseStreamCallbacks(on_diagnostic_obj, on_log_obj, callbacks))
         {
             return nullptr;
         }
@@ -1263,7 +1990,6 @@ namespace
             PyErr_SetString(PyExc_ValueError, "unknown diagnostics level");
             return nullptr;
         }
-        (void)diag_level;
         bool ok = false;
         const wolvrix::lib::LogLevel log_level = parseLogLevel(log_text, ok);
         if (!ok)
@@ -1276,8 +2002,8 @@ namespace
             PyErr_SetString(PyExc_ValueError, "pass name must be non-empty");
             return nullptr;
         }
-        auto *design = getDesign(design_obj);
-        if (!design)
+        auto *handle = getDesignHandleForCall(design_obj);
+        if (!handle)
         {
             return nullptr;
         }
@@ -1303,41 +2029,75 @@ namespace
             return nullptr;
         }
 
+        EventChannel channel;
         wolvrix::lib::transform::PassDiagnostics diagnostics;
+        if (callbacks.onDiagnostic)
+        {
+            streamDiagnostics(diagnostics, channel, diag_level, nullptr);
+        }
         wolvrix::lib::transform::PassManager manager;
+        manager.options().verbosity = passVerbosity(diag_level);
         if (log_level != wolvrix::lib::LogLevel::Off)
         {
             auto &options = manager.options();
             options.logLevel = log_level;
-            options.logSink = [](wolvrix::lib::LogLevel level,
-                                 std::string_view tag,
-                                 std::string_view message) {
-                (void)level;
-                std::string out;
-                if (!tag.empty())
-                {
-                    out.append(tag);
-                    out.append(": ");
-                }
-                out.append(message);
-                std::cerr << out << '\n';
-            };
+            options.logSink = passLogSink(callbacks.onLog ? &channel : nullptr);
         }
         manager.addPass(std::move(pass));
 
         wolvrix::lib::transform::PassManagerResult result;
-        if (dryrun)
+        std::vector<DiagnosticRecord> records;
+        bool exported = false;
+        auto work = [&]() {
+            if (dryrun)
+            {
+                wolvrix::lib::grh::Design temp = [&]() {
+                    auto lock = lockDesignForRead(*handle);
+                    return handle->design.clone();
+                }();
+                result = manager.run(temp, diagnostics);
+            }
+            else
+            {
+                std::unique_lock lock(handle->mutex);
+                exported = handle->exportedArrays.load() != 0;
+                if (!exported)
+                {
+                    handle->readersPrepared = false;
+                    result = manager.run(handle->design, diagnostics);
+                }
+            }
+            records = resolveDiagnostics(diagnostics.messages(), nullptr, diag_level);
+        };
+        try
         {
-            wolvrix::lib::grh::Design temp = design->clone();
-            result = manager.run(temp, diagnostics);
+            if (callbacks.active())
+            {
+                StreamingDesignScope streaming(*handle);
+                if (!runStreaming(channel, callbacks, work))
+                {
+                    return nullptr;
+                }
+            }
+            else
+            {
+                ScopedGilRelease nogil;
+                work();
+            }
         }
-        else
+        catch (const std::exception &ex)
+        {
+            PyErr_SetString(PyExc_RuntimeError, ex.what());
+            return nullptr;
+        }
+        if (exported)
         {
-            result = manager.run(*design, diagnostics);
+            PyErr_SetString(PyExc_BufferError,
+                            "design has live graph_view arrays; release them before running passes");
+            return nullptr;
         }
 
-        const auto *sourceManager = getDesignSourceManager(design_obj);
-        PyObject *diag_list = diagnosticsToPyList(diagnostics.messages(), sourceManager);
+        PyObject *diag_list = diagnosticsToPyList(records);
         if (!diag_list)
         {
             return nullptr;
@@ -1361,9 +2121,18 @@ namespace
         int dryrun = 0;
         const char *diag_text = "warn";
         const char *log_text = "warn";
-        static const char *kwlist[] = {"design", "pipeline", "dryrun", "diagnostics", "log_level", nullptr};
-        if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|pss", const_cast<char **>(kwlist),
-                                         &design_obj, &pipeline_obj, &dryrun, &diag_text, &log_text))
+        PyObject *on_diagnostic_obj = Py_None;
+        PyObject *on_log_obj = Py_None;
+        static const char *kwlist[] = {"design", "pipeline", "dryrun", "diagnostics", "log_level",
+                                       "on_diagnostic", "on_log", nullptr};
+        if (!PyArg_ParseTupleAndKeywords(args, kwargs, "OO|pssOO", const_cast<char **>(kwlist),
+                                         &design_obj, &pipeline_obj, &dryrun, &diag_text, &log_text,
+                                         &on_diagnostic_obj, &on_log_obj))
+        {
+            return nullptr;
+        }
+        StreamCallbacks callbacks;
+        if (!parseStreamCallbacks(on_diagnostic_obj, on_log_obj, callbacks))
         {
             return nullptr;
         }
@@ -1374,7 +2143,6 @@ namespace
             PyErr_SetString(PyExc_ValueError, "unknown diagnostics level");
             return nullptr;
         }
-        (void)diag_level;
         bool ok = false;
         const wolvrix::lib::LogLevel log_level = parseLogLevel(log_text, ok);
         if (!ok)
@@ -1383,8 +2151,8 @@ namespace
             return nullptr;
         }
 
-        auto *design = getDesign(design_obj);
-        if (!design)
+        auto *handle = getDesignHandleForCall(design_obj);
+        if (!handle)
         {
             return nullptr;
         }
@@ -1397,25 +2165,19 @@ namespace
             return nullptr;
         }
 
+        EventChannel channel;
         wolvrix::lib::transform::PassDiagnostics diagnostics;
+        if (callbacks.onDiagnostic)
+        {
+            streamDiagnostics(diagnostics, channel, diag_level, nullptr);
+        }
         wolvrix::lib::transform::PassManager manager;
+        manager.options().verbosity = passVerbosity(diag_level);
         if (log_level != wolvrix::lib::LogLevel::Off)
         {
             auto &options = manager.options();
             options.logLevel = log_level;
-            options.logSink = [](wolvrix::lib::LogLevel level,
-                                 std::string_view tag,
-                                 std::string_view message) {
-                (void)level;
-                std::string out;
-                if (!tag.empty())
-                {
-                    out.append(tag);
-                    out.append(": ");
-                }
-                out.append(message);
-                std::cerr << out << '\n';
-            };
+            options.logSink = passLogSink(callbacks.onLog ? &channel : nullptr);
         }
 
         for (const auto &spec : pipeline)
@@ -1439,18 +2201,58 @@ namespace
         }
 
         wolvrix::lib::transform::PassManagerResult result;
-        if (dryrun)
+        std::vector<DiagnosticRecord> records;
+        bool exported = false;
+        auto work = [&]() {
+            if (dryrun)
+            {
+                wolvrix::lib::grh::Design temp = [&]() {
+                    auto lock = lockDesignForRead(*handle);
+                    return handle->design.clone();
+                }();
+                result = manager.run(temp, diagnostics);
+            }
+            else
+            {
+                std::unique_lock lock(handle->mutex);
+                exported = handle->exportedArrays.load() != 0;
+                if (!exported)
+                {
+                    handle->readersPrepared = false;
+                    result = manager.run(handle->design, diagnostics);
+                }
+            }
+            records = resolveDiagnostics(diagnostics.messages(), nullptr, diag_level);
+        };
+        try
+        {
+            if (callbacks.active())
+            {
+                StreamingDesignScope streaming(*handle);
+                if (!runStreaming(channel, callbacks, work))
+                {
+                    return nullptr;
+                }
+            }
+            else
+            {
+                ScopedGilRelease nogil;
+                work();
+            }
+        }
+        catch (const std::exception &ex)
         {
-            wolvrix::lib::grh::Design temp = design->clone();
-            result = manager.run(temp, diagnostics);
+            PyErr_SetString(PyExc_RuntimeError, ex.what());
+            return nullptr;
         }
-        else
+        if (exported)
         {
-            result = manager.run(*design, diagnostics);
+            PyErr_SetString(PyExc_BufferError,
+                            "design has live graph_view arrays; release them before running passes");
+            return nullptr;
         }
 
-        const auto *sourceManager = getDesignSourceManager(design_obj);
-        PyObject *diag_list = diagnosticsToPyList(diagnostics.messages(), sourceManager);
+        PyObject *diag_list = diagnosticsToPyList(records);
         if (!diag_list)
         {
             return nullptr;
@@ -1467,6 +2269,249 @@ namespace
         return tuple;
     }
 
+    // Read-only buffer over one array of a frozen GraphView. It keeps the design capsule alive
+    // and counts as an export on the design until it is destroyed.
+    struct GraphArrayObject
+    {
+        PyObject_HEAD
+        PyObject *capsule;
+        const void *data;
+        const char *format;
+        Py_ssize_t itemsize;
+        int ndim;
+        Py_ssize_t shape[2];
+        Py_ssize_t strides[2];
+    };
+
+    void graphArrayDealloc(PyObject *self)
+    {
+        auto *array = reinterpret_cast<GraphArrayObject *>(self);
+        if (DesignHandle *handle = getDesignHandle(array->capsule))
+        {
+            handle->exportedArrays.fetch_sub(1);
+        }
+        Py_XDECREF(array->capsule);
+        Py_TYPE(self)->tp_free(self);
+    }
+
+    int graphArrayGetBuffer(PyObject *self, Py_buffer *view, int flags)
+    {
+        auto *array = reinterpret_cast<GraphArrayObject *>(self);
+        if ((flags & PyBUF_WRITABLE) == PyBUF_WRITABLE)
+        {
+            PyErr_SetString(PyExc_BufferError, "graph_view arrays are read-only");
+            view->obj = nullptr;
+            return -1;
+        }
+        static const char kEmpty = 0;
+        Py_ssize_t len = array->itemsize;
+        for (int i = 0; i < array->ndim; ++i)
+        {
+            len *= array->shape[i];
+        }
+        view->buf = const_cast<void *>(len != 0 ? array->data : &kEmpty);
+        Py_INCREF(self);
+        view->obj = self;
+        view->len = len;
+        view->readonly = 1;
+        view->itemsize = array->itemsize;
+        view->format = (flags & PyBUF_FORMAT) == PyBUF_FORMAT ? const_cast<char *>(array->format) : nullptr;
+        view->ndim = array->ndim;
+        // The arrays are C-contiguous, so shape and strides can be dropped when not requested.
+        view->shape = (flags & PyBUF_ND) == PyBUF_ND ? array->shape : nullptr;
+        view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? array->strides : nullptr;
+        view->suboffsets = nullptr;
+        view->internal = nullptr;
+        return 0;
+    }
+
+    PyBufferProcs GraphArrayBufferProcs = {graphArrayGetBuffer, nullptr};
+
+    PyTypeObject GraphArrayType = [] {
+        PyTypeObject type{PyVarObject_HEAD_INIT(nullptr, 0)};
+        type.tp_name = "wolvrix._wolvrix.GraphArray";
+        type.tp_basicsize = sizeof(GraphArrayObject);
+        type.tp_dealloc = graphArrayDealloc;
+        type.tp_as_buffer = &GraphArrayBufferProcs;
+        type.tp_flags = Py_TPFLAGS_DEFAULT;
+        type.tp_doc = "Read-only buffer over one GraphView array";
+        return type;
+    }();
+
+    // One exported array: `columns` 32/64-bit fields per row, or a plain vector when 0.
+    struct GraphArraySpec
+    {
+        const char *name;
+        const void *data;
+        std::size_t rows;
+        const char *format;
+        Py_ssize_t itemsize;
+        Py_ssize_t columns;
+    };
+
+    template <typename T, typename Field>
+    GraphArraySpec arraySpec(const char *name, std::span<const T> items, const char *format)
+    {
+        static_assert(sizeof(T) % sizeof(Field) == 0);
+        constexpr Py_ssize_t columns = sizeof(T) / sizeof(Field);
+        return GraphArraySpec{name, items.data(), items.size(), format, static_cast<Py_ssize_t>(sizeof(Field)),
+                              columns == 1 ? 0 : columns};
+    }
+
+    // Ids are exported as their four u32 fields (index, generation, graph index, graph
+    // generation); use lists add the operand index as a fifth column.
+    static_assert(sizeof(wolvrix::lib::grh::ValueId) == 4 * sizeof(uint32_t));
+    static_assert(sizeof(wolvrix::lib::grh::OperationId) == 4 * sizeof(uint32_t));
+    static_assert(sizeof(wolvrix::lib::grh::ValueUser) == 5 * sizeof(uint32_t));
+    static_assert(sizeof(wolvrix::lib::grh::Range) == 2 * sizeof(uint64_t));
+    static_assert(sizeof(wolvrix::lib::grh::SymbolId) == sizeof(uint32_t));
+    static_assert(sizeof(wolvrix::lib::grh::OperationKind) == sizeof(int32_t));
+
+    std::vector<GraphArraySpec> graphArraySpecs(const wolvrix::lib::grh::GraphView &view)
+    {
+        using namespace wolvrix::lib::grh;
+        return {
+            arraySpec<OperationKind, int32_t>("op_kinds", view.opKindArray(), "i"),
+            arraySpec<SymbolId, uint32_t>("op_symbols", view.opSymbolArray(), "I"),
+            arraySpec<Range, uint64_t>("op_operand_ranges", view.opOperandRangeArray(), "Q"),
+            arraySpec<ValueId, uint32_t>("operands", view.operandArray(), "I"),
+            arraySpec<Range, uint64_t>("op_result_ranges", view.opResultRangeArray(), "Q"),
+            arraySpec<ValueId, uint32_t>("results", view.resultArray(), "I"),
+            arraySpec<SymbolId, uint32_t>("value_symbols", view.valueSymbolArray(), "I"),
+            arraySpec<int32_t, int32_t>("value_widths", view.valueWidthArray(), "i"),
+            arraySpec<uint8_t, uint8_t>("value_signed", view.valueSignedArray(), "B"),
+            arraySpec<uint8_t, uint8_t>("value_types", view.valueTypeArray(), "B"),
+            arraySpec<OperationId, uint32_t>("value_defs", view.valueDefArray(), "I"),
+            arraySpec<Range, uint64_t>("value_user_ranges", view.valueUserRangeArray(), "Q"),
+            arraySpec<ValueUser, uint32_t>("use_list", view.useListArray(), "I"),
+        };
+    }
+
+    // Takes over one export pin of the design on success.
+    PyObject *makeGraphArray(PyObject *capsule, const GraphArraySpec &spec)
+    {
+        auto *array = PyObject_New(GraphArrayObject, &GraphArrayType);
+        if (!array)
+        {
+            return nullptr;
+        }
+        Py_INCREF(capsule);
+        array->capsule = capsule;
+        array->data = spec.data;
+        array->format = spec.format;
+        array->itemsize = spec.itemsize;
+        array->ndim = spec.columns == 0 ? 1 : 2;
+        array->shape[0] = static_cast<Py_ssize_t>(spec.rows);
+        array->shape[1] = spec.columns;
+        array->strides[0] = spec.itemsize * (spec.columns == 0 ? 1 : spec.columns);
+        array->strides[1] = spec.itemsize;
+        return reinterpret_cast<PyObject *>(array);
+    }
+
+    PyObject *py_graph_view(PyObject * /*self*/, PyObject *args, PyObject *kwargs)
+    {
+        PyObject *design_obj = nullptr;
+        const char *graph_name = nullptr;
+        static const char *kwlist[] = {"design", "graph", nullptr};
+        if (!PyArg_ParseTupleAndKeywords(args, kwargs, "Os", const_cast<char **>(kwlist),
+                                         &design_obj, &graph_name))
+        {
+            return nullptr;
+        }
+        auto *handle = getDesignHandleForCall(design_obj);
+        if (!handle)
+        {
+            return nullptr;
+        }
+
+        std::vector<GraphArraySpec> specs;
+        bool found = false;
+        try
+        {
+            ScopedGilRelease nogil;
+            // Freezing rewrites the graph's storage, so it needs the design exclusively. The
+            // arrays are pinned before the lock is dropped so no pass can thaw the graph
+            // between here and the point where each array object takes over its pin.
+            std::unique_lock lock(handle->mutex);
+            if (wolvrix::lib::grh::Graph *graph = handle->design.findGraph(graph_name))
+            {
+                found = true;
+                handle->readersPrepared = false;
+                graph->freeze();
+                specs = graphArraySpecs(graph->view());
+                handle->exportedArrays.fetch_add(specs.size());
+            }
+        }
+        catch (const std::exception &ex)
+        {
+            PyErr_SetString(PyExc_RuntimeError, ex.what());
+            return nullptr;
+        }
+        if (!found)
+        {
+            PyErr_Format(PyExc_KeyError, "graph not found: %s", graph_name);
+            return nullptr;
+        }
+
+        PyObject *dict = PyDict_New();
+        std::size_t adopted = 0;
+        for (const GraphArraySpec &spec : specs)
+        {
+            if (!dict)
+            {
+                break;
+            }
+            PyObject *array = makeGraphArray(design_obj, spec);
+            if (!array)
+            {
+                Py_CLEAR(dict);
+                break;
+            }
+            ++adopted;
+            PyObject *view = PyMemoryView_FromObject(array);
+            Py_DECREF(array);
+            if (!view || PyDict_SetItemString(dict, spec.name, view) != 0)
+            {
+                Py_XDECREF(view);
+                Py_CLEAR(dict);
+                break;
+            }
+            Py_DECREF(view);
+        }
+        if (adopted < specs.size())
+        {
+            handle->exportedArrays.fetch_sub(specs.size() - adopted);
+        }
+        return dict;
+    }
+
+    PyObject *py_op_kind_names(PyObject * /*self*/, PyObject * /*args*/)
+    {
+        PyObject *list = PyList_New(0);
+        if (!list)
+        {
+            return nullptr;
+        }
+        for (int32_t kind = 0;; ++kind)
+        {
+            const std::string_view name =
+                wolvrix::lib::grh::toString(static_cast<wolvrix::lib::grh::OperationKind>(kind));
+            if (name == "<unknown>")
+            {
+                break;
+            }
+            PyObject *item = PyUnicode_FromStringAndSize(name.data(), static_cast<Py_ssize_t>(name.size()));
+            if (!item || PyList_Append(list, item) != 0)
+            {
+                Py_XDECREF(item);
+                Py_DECREF(list);
+                return nullptr;
+            }
+            Py_DECREF(item);
+        }
+        return list;
+    }
+
     PyObject *py_list_passes(PyObject * /*self*/, PyObject * /*args*/)
     {
         const auto passes = wolvrix::lib::transform::availableTransformPasses();
@@ -1492,13 +2537,23 @@ namespace
 
 static PyMethodDef WolvrixMethods[] = {
     {"read_sv", reinterpret_cast<PyCFunction>(py_read_sv), METH_VARARGS | METH_KEYWORDS,
-     "read_sv(path, slang_args=None, log_level='info', diagnostics='warn') -> (Design capsule|None, ok, diagnostics)"},
+     "read_sv(path, slang_args=None, log_level='info', diagnostics='warn', parse_threads=1, on_diagnostic=None, on_log=None) -> (Design capsule|None, ok, diagnostics)"},
     {"read_json", reinterpret_cast<PyCFunction>(py_read_json), METH_VARARGS | METH_KEYWORDS,
      "read_json(path) -> Design capsule"},
     {"load_json_string", reinterpret_cast<PyCFunction>(py_load_json_string), METH_VARARGS | METH_KEYWORDS,
      "load_json_string(text) -> Design capsule"},
     {"store_json_string", reinterpret_cast<PyCFunction>(py_store_json_string), METH_VARARGS | METH_KEYWORDS,
      "store_json_string(design, mode='pretty-compact', top=None) -> str"},
+    {"read_grhb", reinterpret_cast<PyCFunction>(py_read_grhb), METH_VARARGS | METH_KEYWORDS,
+     "read_grhb(path, lazy=False) -> Design capsule"},
+    {"write_grhb", reinterpret_cast<PyCFunction>(py_write_grhb), METH_VARARGS | METH_KEYWORDS,
+     "write_grhb(design, output, top=None)"},
+    {"write_grhb_shm", reinterpret_cast<PyCFunction>(py_write_grhb_shm), METH_VARARGS | METH_KEYWORDS,
+     "write_grhb_shm(design, name, top=None)"},
+    {"read_grhb_shm", reinterpret_cast<PyCFunction>(py_read_grhb_shm), METH_VARARGS | METH_KEYWORDS,
+     "read_grhb_shm(name, lazy=True) -> Design capsule"},
+    {"unlink_shm", reinterpret_cast<PyCFunction>(py_unlink_shm), METH_VARARGS | METH_KEYWORDS,
+     "unlink_shm(name)"},
     {"write_sv", reinterpret_cast<PyCFunction>(py_write_sv), METH_VARARGS | METH_KEYWORDS,
      "write_sv(design, output, top=None, split_modules=False)"},
     {"write_verilator_repcut_package",
@@ -1506,11 +2561,15 @@ static PyMethodDef WolvrixMethods[] = {
      METH_VARARGS | METH_KEYWORDS,
      "write_verilator_repcut_package(design, output, top=None)"},
     {"run_pass", reinterpret_cast<PyCFunction>(py_run_pass), METH_VARARGS | METH_KEYWORDS,
-     "run_pass(design, name, args=None, dryrun=False, diagnostics='warn', log_level='warn') -> (changed, ok, diagnostics)"},
+     "run_pass(design, name, args=None, dryrun=False, diagnostics='warn', log_level='warn', on_diagnostic=None, on_log=None) -> (changed, ok, diagnostics)"},
     {"run_pipeline", reinterpret_cast<PyCFunction>(py_run_pipeline), METH_VARARGS | METH_KEYWORDS,
-     "run_pipeline(design, pipeline, dryrun=False, diagnostics='warn', log_level='warn') -> (changed, ok, diagnostics)"},
+     "run_pipeline(design, pipeline, dryrun=False, diagnostics='warn', log_level='warn', on_diagnostic=None, on_log=None) -> (changed, ok, diagnostics)"},
     {"list_passes", reinterpret_cast<PyCFunction>(py_list_passes), METH_NOARGS,
      "list_passes() -> list[str]"},
+    {"graph_view", reinterpret_cast<PyCFunction>(py_graph_view), METH_VARARGS | METH_KEYWORDS,
+     "graph_view(design, graph) -> dict[str, memoryview]"},
+    {"op_kind_names", reinterpret_cast<PyCFunction>(py_op_kind_names), METH_NOARGS,
+     "op_kind_names() -> list[str]"},
     {nullptr, nullptr, 0, nullptr},
 };
 
@@ -1524,5 +2583,9 @@ static PyModuleDef WolvrixModule = {
 
 PyMODINIT_FUNC PyInit__wolvrix(void)
 {
+    if (PyType_Ready(&GraphArrayType) < 0)
+    {
+        return nullptr;
+    }
     return PyModule_Create(&WolvrixModule);
 }
@@ -35,6 +35,8 @@ namespace wolvrix::lib::diag
     class Diagnostics
     {
     public:
+        using Sink = std::function<void(Diagnostic &&)>;
+
         void todo(std::string message, std::string context = {});
         void error(std::string message, std::string context = {});
         void warning(std::string message, std::string context = {});
@@ -42,6 +44,10 @@ namespace wolvrix::lib::diag
         void debug(std::string message, std::string context = {});
 
         void setOnError(std::function<void()> callback) { onError_ = std::move(callback); }
+        // Hands each diagnostic to `sink` as it is recorded (or flushed from a thread-local
+        // buffer) instead of keeping it in messages(). Calls are serialized; hasError() is
+        // still tracked.
+        void setSink(Sink sink) { sink_ = std::move(sink); }
         void enableThreadLocal(bool enable) noexcept { threadLocalEnabled_ = enable; }
         void flushThreadLocal();
         const std::vector<Diagnostic> &messages() const noexcept { return messages_; }
@@ -71,6 +77,7 @@ namespace wolvrix::lib::diag
         std::vector<Diagnostic> messages_;
         std::atomic<bool> hasError_{false};
         std::function<void()> onError_;
+        Sink sink_;
         mutable std::mutex mutex_;
     };
 
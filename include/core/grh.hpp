@@ -2,6 +2,7 @@
 #define WOLVRIX_GRH_HPP
 
 #include <array>
+#include <atomic>
 #include <cctype>
 #include <cstdint>
 #include <deque>
@@ -141,6 +142,8 @@ public:
     std::string_view text(SymbolId id) const;
     bool valid(SymbolId id) const noexcept;
     void reserve(std::size_t count);
+    // Number of interned symbols; ids run from 1 to size().
+    std::size_t size() const noexcept { return textById_.size() - 1; }
 
 private:
     struct StringHash {
@@ -166,14 +169,23 @@ struct GraphId;
 class DesignSymbolTable final : public SymbolTable {
 public:
     DesignSymbolTable();
+    DesignSymbolTable(DesignSymbolTable&& other) noexcept;
+    DesignSymbolTable& operator=(DesignSymbolTable&& other) noexcept;
 
     GraphId allocateGraphId(SymbolId symbol);
+    // Thread-safe: hands out a fresh graph index without binding it to a symbol.
+    GraphId reserveGraphId() noexcept;
+    // Thread-safe: provisional id for a staged graph. It never binds; adoption replaces it.
+    GraphId reserveStagedGraphId() noexcept;
+    static bool isStagedGraphId(GraphId graph) noexcept;
+    void bindGraphId(SymbolId symbol, GraphId graph);
     void releaseGraphId(SymbolId symbol);
     GraphId lookupGraphId(SymbolId symbol) const noexcept;
     SymbolId symbolForGraph(GraphId graph) const noexcept;
 
 private:
-    uint32_t nextGraphIndex_ = 1;
+    std::atomic<uint32_t> nextGraphIndex_{1};
+    std::atomic<uint32_t> nextStagedGraphIndex_{1};
     std::vector<SymbolId> symbolByGraph_;
     std::unordered_map<uint32_t, uint32_t> graphIndexBySymbol_;
 };
@@ -402,8 +414,26 @@ public:
     ValueId findValue(SymbolId symbol) const noexcept;
     OperationId findOperation(SymbolId symbol) const noexcept;
 
+    // Dense arrays behind the accessors above, for bulk readers. Entry i describes the
+    // operation or value whose id has index i + 1; ranges are offsets into operandArray(),
+    // resultArray() and useListArray().
+    std::span<const OperationKind> opKindArray() const noexcept { return opKinds_; }
+    std::span<const SymbolId> opSymbolArray() const noexcept { return opSymbols_; }
+    std::span<const Range> opOperandRangeArray() const noexcept { return opOperandRanges_; }
+    std::span<const ValueId> operandArray() const noexcept { return operands_; }
+    std::span<const Range> opResultRangeArray() const noexcept { return opResultRanges_; }
+    std::span<const ValueId> resultArray() const noexcept { return results_; }
+    std::span<const SymbolId> valueSymbolArray() const noexcept { return valueSymbols_; }
+    std::span<const int32_t> valueWidthArray() const noexcept { return valueWidths_; }
+    std::span<const uint8_t> valueSignedArray() const noexcept { return valueSigned_; }
+    std::span<const uint8_t> valueTypeArray() const noexcept { return valueTypes_; }
+    std::span<const OperationId> valueDefArray() const noexcept { return valueDefs_; }
+    std::span<const Range> valueUserRangeArray() const noexcept { return valueUserRanges_; }
+    std::span<const ValueUser> useListArray() const noexcept { return useList_; }
+
 private:
     friend class GraphBuilder;
+    friend class Graph;
 
     enum class SymbolKind {
         kValue,
@@ -445,6 +475,7 @@ private:
 
     std::size_t opIndex(OperationId op) const;
     std::size_t valueIndex(ValueId value) const;
+    void rebindGraphId(GraphId graphId);
 };
 
 class GraphBuilder {
@@ -544,6 +575,7 @@ private:
     void addOpUses(OperationId op, const std::vector<ValueId>& operands);
     void replaceAllUsesInternal(ValueId from, ValueId to, std::optional<OperationId> skipOp);
     void recomputePortFlags();
+    void rebindGraphId(GraphId graphId);
     void validateSymbol(SymbolId sym, std::string_view context) const;
     void bindSymbol(SymbolId sym, SymbolKind kind, uint32_t index, std::string_view context);
     void unbindSymbol(SymbolId sym, SymbolKind kind, uint32_t index);
@@ -632,6 +664,10 @@ private:
     std::optional<SrcLoc> srcLoc_;
 };
 
+// Binary design container (.grhb) identification, shared by StoreGrhb and LoadGrhb.
+inline constexpr std::array<char, 4> kGrhbMagic{'G', 'R', 'H', 'B'};
+inline constexpr uint32_t kGrhbVersion = 1;
+
 class Design;
 
 class Graph {
@@ -693,6 +729,9 @@ public:
 
     bool frozen() const noexcept { return !builder_.has_value(); }
     void freeze();
+    // Frozen representation; throws unless frozen(). Any write thaws the graph and
+    // invalidates references into the view.
+    const GraphView& view() const;
 
     std::span<const OperationId> operations() const;
     std::span<const ValueId> values() const;
@@ -766,11 +805,16 @@ public:
     void clearValueSymbol(ValueId value);
 
     void writeJson(slang::JsonWriter& writer) const;
+    // Appends this graph as a .grhb graph section (layout in docs/grh/grh-binary-spec.md).
+    void writeBinary(std::string& out) const;
+    // Rebuilds a freshly created, empty graph from a .grhb graph section; the result is frozen.
+    void readBinary(std::string_view section);
 
 private:
     friend class Design;
     friend class Value;
 
+    void rebindGraphId(GraphId graphId);
     void invalidateCaches() const;
     void invalidateValuesCache() const;
     void invalidateOperationsCache() const;
@@ -780,7 +824,6 @@ private:
     void ensureOperationsCache() const;
     void ensurePortsCache() const;
     GraphBuilder& ensureBuilder();
-    const GraphView& view() const;
     Value valueFromView(ValueId id) const;
     Value valueFromBuilder(ValueId id) const;
     Operation operationFromView(OperationId id) const;
@@ -807,20 +850,54 @@ private:
     uint32_t nextInternalValSym_ = 0;
 };
 
+// Backing store for graphs registered with Design::addLazyGraph(). loadGraph() may run
+// concurrently for different slots.
+class LazyGraphSource {
+public:
+    virtual ~LazyGraphSource() = default;
+
+    // Fills `graph`, which is still empty, with the stored contents of `slot`.
+    virtual void loadGraph(std::size_t slot, Graph& graph) const = 0;
+    // Stored .grhb section of `slot`, when the source keeps one.
+    virtual std::optional<std::string_view> grhbSection(std::size_t /*slot*/) const { return std::nullopt; }
+};
+
 class Design {
 public:
-    Design() = default;
+    Design();
+    ~Design();
     Design(Design&& other) noexcept;
     Design& operator=(Design&& other) noexcept;
     Design(const Design&) = delete;
     Design& operator=(const Design&) = delete;
 
     Graph& createGraph(std::string name);
+    // Detached graphs are owned by the caller and invisible to lookups until adopted.
+    // createDetachedGraph() may run concurrently; adoptGraph() must be serialized.
+    std::unique_ptr<Graph> createDetachedGraph(std::string name);
+    // Same, but the graph carries a provisional id until adoptGraph() assigns the next
+    // GraphId, so ids follow adoption order rather than which worker created the graph first.
+    std::unique_ptr<Graph> createStagedGraph(std::string name);
+    Graph& adoptGraph(std::unique_ptr<Graph> graph);
     Graph& cloneGraph(std::string_view sourceName, std::string newName);
     bool deleteGraph(std::string_view name);
+    // Lazy graphs stay empty until findGraph() or graphs() first reaches them; clone() keeps
+    // them lazy. Loading is thread-safe, so concurrent lookups on a const Design are fine.
+    void addLazyGraph(std::string name, std::shared_ptr<const LazyGraphSource> source, std::size_t slot);
     Design clone() const;
-    Graph* findGraph(std::string_view name) noexcept;
-    const Graph* findGraph(std::string_view name) const noexcept;
+    Graph* findGraph(std::string_view name);
+    const Graph* findGraph(std::string_view name) const;
+    // Same lookup as findGraph() without loading; only symbol() and id() of an unloaded graph
+    // are meaningful.
+    const Graph* peekGraph(std::string_view name) const noexcept;
+    bool isGraphLoaded(std::string_view name) const noexcept;
+    // Unfrozen graphs build their operation/value/port lists on first const access. Filling
+    // them here, for every loaded graph, lets several threads read the design at once until
+    // the next edit. Unloaded lazy graphs are skipped; they load frozen.
+    void prepareConcurrentReads() const;
+    // Section of a lazy graph that has not been loaded, and therefore not modified, since it
+    // was added; stores copy it through verbatim.
+    std::optional<std::string_view> unloadedGrhbSection(std::string_view name) const;
     SymbolId internSymbol(std::string_view text);
     SymbolId lookupSymbol(std::string_view text) const;
     std::string_view symbolText(SymbolId id) const;
@@ -831,19 +908,27 @@ public:
     std::span<const SymbolId> declaredSymbols() const noexcept;
     std::vector<std::string> aliasesForGraph(std::string_view name) const;
     void registerGraphAlias(std::string alias, Graph& graph);
+    void registerGraphAlias(std::string alias, std::string_view graphName);
 
     void markAsTop(std::string_view graphName);
     void unmarkAsTop(std::string_view graphName);
     const std::vector<std::string>& topGraphs() const noexcept { return topGraphs_; }
 
-    const std::unordered_map<std::string, std::unique_ptr<Graph>>& graphs() const noexcept { return graphs_; }
+    // Loads every lazy graph first.
+    const std::unordered_map<std::string, std::unique_ptr<Graph>>& graphs() const;
     const std::vector<std::string>& graphOrder() const noexcept { return graphOrder_; }
 
     static Design fromJsonString(std::string_view json);
+    // Memory-maps the file and parses it in place; no copy of the text is made.
+    static Design fromJsonFile(const std::string& path);
 
 private:
+    struct LazyGraphs;
+
     Graph& addGraphInternal(std::unique_ptr<Graph> graph);
     void resetGraphOwners();
+    Graph* lookupGraph(std::string_view name) const noexcept;
+    void ensureGraphLoaded(Graph& graph) const;
 
     DesignSymbolTable designSymbols_;
     std::unordered_map<std::string, std::unique_ptr<Graph>> graphs_;
@@ -852,6 +937,7 @@ private:
     std::vector<std::string> topGraphs_;
     std::vector<SymbolId> declaredSymbols_;
     std::unordered_set<uint32_t> declaredSymbolSet_;
+    std::unique_ptr<LazyGraphs> lazy_;
 };
 
 } // namespace wolvrix::lib::grh
@@ -13,6 +13,7 @@
 #include <exception>
 #include <functional>
 #include <limits>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <string>
@@ -118,6 +119,32 @@ struct ConvertOptions {
 class PlanCache;
 class PlanTaskQueue;
 
+// Canonical "name=value;..." parameter override list, interned once per distinct text.
+// The readable text is only consulted when naming graphs.
+struct ParamSignature {
+    uint64_t fingerprint = 0;
+    std::string text;
+};
+
+// Thread-safe interning of parameter signatures. Equal text always yields the same
+// pointer, so PlanKey equality is a pointer compare; fingerprint collisions between
+// different texts are resolved here and counted.
+class ParamSignatureTable {
+public:
+    // Returns nullptr for an empty signature (no parameter overrides).
+    const ParamSignature* intern(std::string_view text);
+    std::size_t size() const;
+    std::size_t collisions() const;
+
+    static uint64_t fingerprint(std::string_view text) noexcept;
+
+private:
+    mutable std::mutex mutex_;
+    std::unordered_map<uint64_t, std::vector<std::unique_ptr<ParamSignature>>> buckets_;
+    std::size_t size_ = 0;
+    std::size_t collisions_ = 0;
+};
+
 struct ConvertContext {
     const slang::ast::Compilation* compilation = nullptr;
     const slang::ast::RootSymbol* root = nullptr;
@@ -127,6 +154,9 @@ struct ConvertContext {
     PlanCache* planCache = nullptr;
     PlanTaskQueue* planQueue = nullptr;
     InstanceRegistry* instanceRegistry = nullptr;
+    // Shared by every copy of the context, so signatures interned through any copy compare
+    // equal by pointer. ConvertDriver installs a fresh table for each convert().
+    std::shared_ptr<ParamSignatureTable> paramSignatures = std::make_shared<ParamSignatureTable>();
     std::atomic<std::size_t>* taskCounter = nullptr;
     std::atomic<bool>* cancelFlag = nullptr;
 };
@@ -213,7 +243,7 @@ struct InstanceInfo {
     PlanSymbolId moduleSymbol;
     bool isBlackbox = false;
     std::vector<InstanceParameter> parameters;
-    std::string paramSignature;
+    const ParamSignature* paramSignature = nullptr;
 };
 
 struct ModulePlan {
@@ -459,7 +489,15 @@ struct PlanArtifacts {
 struct PlanKey {
     const slang::ast::DefinitionSymbol* definition = nullptr;
     const slang::ast::InstanceBodySymbol* body = nullptr;
-    std::string paramSignature;
+    // Interned via ParamSignatureTable; nullptr when the instance overrides nothing.
+    const ParamSignature* paramSignature = nullptr;
+
+    uint64_t paramFingerprint() const noexcept {
+        return paramSignature ? paramSignature->fingerprint : 0;
+    }
+    std::string_view paramText() const noexcept {
+        return paramSignature ? std::string_view(paramSignature->text) : std::string_view{};
+    }
 
     bool operator==(const PlanKey& other) const noexcept {
         if (definition || other.definition) {
@@ -474,7 +512,7 @@ struct PlanKeyHash {
         const void* defKey = key.definition ? static_cast<const void*>(key.definition)
                                             : static_cast<const void*>(key.body);
         const std::size_t h1 = std::hash<const void*>{}(defKey);
-        const std::size_t h2 = std::hash<std::string>{}(key.paramSignature);
+        const std::size_t h2 = static_cast<std::size_t>(key.paramFingerprint());
         return h1 ^ (h2 + 0x9e3779b97f4a7c15ULL + (h1 << 6) + (h1 >> 2));
     }
 };
@@ -496,6 +534,8 @@ class PlanCache {
 public:
     bool tryClaim(const PlanKey& key);
     void storePlan(const PlanKey& key, ModulePlan plan);
+    // Marks the key assembled and drops its plan/artifacts; claims stay blocked.
+    void markDone(const PlanKey& key);
     void markFailed(const PlanKey& key);
     std::optional<ModulePlan> findReady(const PlanKey& key) const;
     void clear();
@@ -521,10 +561,12 @@ private:
     std::unordered_map<PlanKey, PlanEntry, PlanKeyHash> entries_;
 };
 
+// Pops the highest estimated cost first (FIFO among equal costs), so large module
+// bodies discovered late do not end up as the tail of the parallel run.
 class PlanTaskQueue {
 public:
-    void push(PlanKey key);
-    bool tryPush(PlanKey key);
+    void push(PlanKey key, uint64_t cost = 0);
+    bool tryPush(PlanKey key, uint64_t cost = 0);
     bool tryPop(PlanKey& out);
     bool waitPop(PlanKey& out, const std::atomic<bool>* cancelFlag = nullptr);
     void close();
@@ -534,9 +576,27 @@ public:
     void reset();
 
 private:
+    struct Task {
+        PlanKey key;
+        uint64_t cost = 0;
+        uint64_t sequence = 0;
+    };
+
+    struct TaskOrder {
+        bool operator()(const Task& lhs, const Task& rhs) const noexcept {
+            if (lhs.cost != rhs.cost) {
+                return lhs.cost < rhs.cost;
+            }
+            return lhs.sequence > rhs.sequence;
+        }
+    };
+
+    PlanKey popLocked();
+
     mutable std::mutex mutex_;
     std::condition_variable cv_;
-    std::deque<PlanKey> queue_;
+    std::vector<Task> heap_;
+    uint64_t nextSequence_ = 0;
     bool closed_ = false;
 };
 
@@ -582,23 +642,34 @@ private:
 
 class GraphAssembler {
 public:
-    explicit GraphAssembler(ConvertContext& context, wolvrix::lib::grh::Design& design,
-                            std::mutex* designMutex = nullptr)
-        : context_(context), design_(design), designMutex_(designMutex) {}
+    explicit GraphAssembler(ConvertContext& context, wolvrix::lib::grh::Design& design)
+        : context_(context), design_(design) {}
 
     const std::string& resolveGraphName(const PlanKey& key, std::string_view moduleName);
 
+    // Builds into a detached graph staged inside the assembler; nothing touches the
+    // Design until commitGraphs(), so workers never contend on design state.
     wolvrix::lib::grh::Graph& build(const PlanKey& key, const ModulePlan& plan, LoweringPlan& lowering,
                           const WriteBackPlan& writeBack);
 
+    // Adopts staged graphs in breadth-first instance discovery order from roots, which
+    // matches the serial queue order independently of the worker count.
+    std::size_t commitGraphs(const std::vector<PlanKey>& roots);
+
 private:
+    struct StagedGraph {
+        std::unique_ptr<wolvrix::lib::grh::Graph> graph;
+        std::vector<PlanKey> children;
+    };
+
     ConvertContext& context_;
     wolvrix::lib::grh::Design& design_;
-    std::mutex* designMutex_ = nullptr;
     std::size_t nextAnonymousId_ = 0;
     std::unordered_map<PlanKey, std::string, PlanKeyHash> graphNames_{};
     std::unordered_set<std::string> reservedGraphNames_{};
     mutable std::mutex nameMutex_{};
+    std::unordered_map<PlanKey, StagedGraph, PlanKeyHash> stagedGraphs_{};
+    std::mutex stagedMutex_{};
 };
 
 class ConvertDriver {
@@ -614,6 +685,8 @@ private:
     ConvertOptions options_{};
     ConvertDiagnostics diagnostics_{};
     Logger logger_{};
+    // Kept until the next convert(): the plan cache holds pointers into it.
+    std::shared_ptr<ParamSignatureTable> paramSignatures_{};
     PlanCache planCache_{};
     PlanTaskQueue planQueue_{};
 };
@@ -0,0 +1,562 @@
+#ifndef WOLVRIX_JSON_CURSOR_HPP
+#define WOLVRIX_JSON_CURSOR_HPP
+
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace wolvrix::lib::load
+{
+
+    // Pull parser over the input bytes. Nothing is materialized: strings are returned as
+    // views into the input (or into a caller-provided scratch buffer when they contain
+    // escapes), and values that must be visited out of order are captured as spans.
+    class JsonCursor
+    {
+    public:
+        explicit JsonCursor(std::string_view text) : begin_(text.data()), current_(text.data()), end_(text.data() + text.size()) {}
+
+        void skipWhitespace()
+        {
+            while (current_ != end_ && isJsonSpace(*current_))
+            {
+                ++current_;
+            }
+        }
+
+        bool atEnd()
+        {
+            skipWhitespace();
+            return current_ == end_;
+        }
+
+        std::size_t offset() const noexcept { return static_cast<std::size_t>(current_ - begin_); }
+
+        void expectEnd()
+        {
+            if (!atEnd())
+            {
+                throw std::runtime_error("Trailing characters after JSON document");
+            }
+        }
+
+        void beginObject(std::string_view ctx)
+        {
+            skipWhitespace();
+            if (current_ == end_ || *current_ != '{')
+            {
+                throwExpected(ctx, "object");
+            }
+            ++current_;
+            first_ = true;
+        }
+
+        // Advances to the next key of the current object; false once '}' is consumed.
+        bool nextKey(std::string_view &key, std::string &scratch)
+        {
+            skipWhitespace();
+            if (consume('}'))
+            {
+                first_ = false;
+                return false;
+            }
+            if (!first_)
+            {
+                expect(',');
+                skipWhitespace();
+            }
+            first_ = false;
+            key = parseString(scratch);
+            skipWhitespace();
+            expect(':');
+            skipWhitespace();
+            return true;
+        }
+
+        void beginArray(std::string_view ctx)
+        {
+            skipWhitespace();
+            if (current_ == end_ || *current_ != '[')
+            {
+                throwExpected(ctx, "array");
+            }
+            ++current_;
+            first_ = true;
+        }
+
+        // Positions the cursor on the next array element; false once ']' is consumed.
+        bool nextElement()
+        {
+            skipWhitespace();
+            if (consume(']'))
+            {
+                first_ = false;
+                return false;
+            }
+            if (!first_)
+            {
+                expect(',');
+                skipWhitespace();
+            }
+            first_ = false;
+            return true;
+        }
+
+        std::string_view readString(std::string_view ctx, std::string &scratch)
+        {
+            skipWhitespace();
+            if (current_ == end_ || *current_ != '"')
+            {
+                throwExpected(ctx, "string");
+            }
+            return parseString(scratch);
+        }
+
+        bool readBool(std::string_view ctx)
+        {
+            skipWhitespace();
+            if (current_ != end_ && *current_ == 't')
+            {
+                parseLiteral("true");
+                return true;
+            }
+            if (current_ != end_ && *current_ == 'f')
+            {
+                parseLiteral("false");
+                return false;
+            }
+            throwExpected(ctx, "bool");
+        }
+
+        int64_t readInt(std::string_view ctx)
+        {
+            skipWhitespace();
+            if (!atNumber())
+            {
+                throwExpected(ctx, "integer");
+            }
+            bool isFloat = false;
+            const std::string_view text = scanNumber(isFloat);
+            if (!isFloat)
+            {
+                int64_t value = 0;
+                auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+                if (ec != std::errc())
+                {
+                    value = std::stoll(std::string(text));
+                }
+                return value;
+            }
+            const double value = toDouble(text);
+            if (std::trunc(value) != value)
+            {
+                throw std::runtime_error(std::string(ctx) + ": expected integer number");
+            }
+            return static_cast<int64_t>(value);
+        }
+
+        double readDouble(std::string_view ctx)
+        {
+            skipWhitespace();
+            if (!atNumber())
+            {
+                throwExpected(ctx, "number");
+            }
+            bool isFloat = false;
+            const std::string_view text = scanNumber(isFloat);
+            if (isFloat)
+            {
+                return toDouble(text);
+            }
+            int64_t value = 0;
+            auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+            if (ec != std::errc())
+            {
+                value = std::stoll(std::string(text));
+            }
+            return static_cast<double>(value);
+        }
+
+        // Skips the next value and returns its exact text. For arrays, elementCount (when
+        // given) receives the number of top-level elements.
+        std::string_view captureValue(std::size_t *elementCount = nullptr)
+        {
+            skipWhitespace();
+            const char *start = current_;
+            if (elementCount && current_ != end_ && *current_ == '[')
+            {
+                *elementCount = skipArray();
+            }
+            else
+            {
+                skipValue();
+            }
+            return std::string_view(start, static_cast<std::size_t>(current_ - start));
+        }
+
+        void skipValue()
+        {
+            skipWhitespace();
+            if (current_ == end_)
+            {
+                throw std::runtime_error("Unexpected end of JSON input");
+            }
+            switch (*current_)
+            {
+            case '{':
+            {
+                ++current_;
+                skipWhitespace();
+                if (consume('}'))
+                {
+                    return;
+                }
+                while (true)
+                {
+                    skipWhitespace();
+                    skipString();
+                    skipWhitespace();
+                    expect(':');
+                    skipValue();
+                    skipWhitespace();
+                    if (consume('}'))
+                    {
+                        return;
+                    }
+                    expect(',');
+                }
+            }
+            case '[':
+                skipArray();
+                return;
+            case '"':
+                skipString();
+                return;
+            case 't':
+                parseLiteral("true");
+                return;
+            case 'f':
+                parseLiteral("false");
+                return;
+            case 'n':
+                parseLiteral("null");
+                return;
+            default:
+                if (atNumber())
+                {
+                    bool isFloat = false;
+                    scanNumber(isFloat);
+                    return;
+                }
+                break;
+            }
+            throw std::runtime_error("Invalid JSON value");
+        }
+
+    private:
+        static bool isJsonSpace(char ch)
+        {
+            return ch == ' ' || ch == '\n' || ch == '\r' || ch == '\t' || ch == '\f' || ch == '\v';
+        }
+
+        [[noreturn]] static void throwExpected(std::string_view ctx, std::string_view what)
+        {
+            throw std::runtime_error(std::string(ctx) + ": expected " + std::string(what));
+        }
+
+        bool atNumber() const
+        {
+            return current_ != end_ &&
+                   (*current_ == '-' || std::isdigit(static_cast<unsigned char>(*current_)));
+        }
+
+        static double toDouble(std::string_view text)
+        {
+            double value = 0.0;
+            auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+            if (ec != std::errc())
+            {
+                value = std::stod(std::string(text));
+            }
+            return value;
+        }
+
+        std::size_t skipArray()
+        {
+            expect('[');
+            skipWhitespace();
+            if (consume(']'))
+            {
+                return 0;
+            }
+            std::size_t count = 0;
+            while (true)
+            {
+                skipValue();
+                ++count;
+                skipWhitespace();
+                if (consume(']'))
+                {
+                    return count;
+                }
+                expect(',');
+            }
+        }
+
+        std::string_view scanNumber(bool &isFloat)
+        {
+            const char *start = current_;
+            if (*current_ == '-')
+            {
+                ++current_;
+            }
+            if (current_ == end_)
+            {
+                throw std::runtime_error("Invalid JSON number");
+            }
+            if (*current_ == '0')
+            {
+                ++current_;
+            }
+            else
+            {
+                if (!std::isdigit(static_cast<unsigned char>(*current_)))
+                {
+                    throw std::runtime_error("Invalid JSON number");
+                }
+                while (current_ != end_ && std::isdigit(static_cast<unsigned char>(*current_)))
+                {
+                    ++current_;
+                }
+            }
+
+            isFloat = false;
+            if (current_ != end_ && *current_ == '.')
+            {
+                isFloat = true;
+                ++current_;
+                if (current_ == end_ || !std::isdigit(static_cast<unsigned char>(*current_)))
+                {
+                    throw std::runtime_error("Invalid JSON number");
+                }
+                while (current_ != end_ && std::isdigit(static_cast<unsigned char>(*current_)))
+                {
+                    ++current_;
+                }
+            }
+
+            if (current_ != end_ && (*current_ == 'e' || *current_ == 'E'))
+            {
+                isFloat = true;
+                ++current_;
+                if (current_ != end_ && (*current_ == '+' || *current_ == '-'))
+                {
+                    ++current_;
+                }
+                if (current_ == end_ || !std::isdigit(static_cast<unsigned char>(*current_)))
+                {
+                    throw std::runtime_error("Invalid JSON number");
+                }
+                while (current_ != end_ && std::isdigit(static_cast<unsigned char>(*current_)))
+                {
+                    ++current_;
+                }
+            }
+            return std::string_view(start, static_cast<std::size_t>(current_ - start));
+        }
+
+        void skipString()
+        {
+            expect('"');
+            while (current_ != end_)
+            {
+                const char ch = *current_++;
+                if (ch == '"')
+                {
+                    return;
+                }
+                if (ch == '\\')
+                {
+                    if (current_ == end_)
+                    {
+                        throw std::runtime_error("Invalid escape sequence");
+                    }
+                    ++current_;
+                }
+                else if (static_cast<unsigned char>(ch) < 0x20)
+                {
+                    throw std::runtime_error("Invalid control character in string");
+                }
+            }
+            throw std::runtime_error("Unterminated JSON string");
+        }
+
+        std::string_view parseString(std::string &scratch)
+        {
+            expect('"');
+            const char *segmentStart = current_;
+            while (current_ != end_)
+            {
+                const char ch = *current_;
+                if (ch == '"')
+                {
+                    std::string_view result(segmentStart, static_cast<std::size_t>(current_ - segmentStart));
+                    ++current_;
+                    return result;
+                }
+                if (ch == '\\')
+                {
+                    break;
+                }
+                if (static_cast<unsigned char>(ch) < 0x20)
+                {
+                    throw std::runtime_error("Invalid control character in string");
+                }
+                ++current_;
+            }
+
+            scratch.clear();
+            scratch.append(segmentStart, static_cast<std::size_t>(current_ - segmentStart));
+            while (current_ != end_)
+            {
+                char ch = *current_++;
+                if (ch == '"')
+                {
+                    return scratch;
+                }
+                if (ch == '\\')
+                {
+                    if (current_ == end_)
+                    {
+                        throw std::runtime_error("Invalid escape sequence");
+                    }
+
+                    char esc = *current_++;
+                    switch (esc)
+                    {
+                    case '"':
+                    case '\\':
+                    case '/':
+                        scratch.push_back(esc);
+                        break;
+                    case 'b':
+                        scratch.push_back('\b');
+                        break;
+                    case 'f':
+                        scratch.push_back('\f');
+                        break;
+                    case 'n':
+                        scratch.push_back('\n');
+                        break;
+                    case 'r':
+                        scratch.push_back('\r');
+                        break;
+                    case 't':
+                        scratch.push_back('\t');
+                        break;
+                    case 'u':
+                    {
+                        if (end_ - current_ < 4)
+                        {
+                            throw std::runtime_error("Invalid unicode escape");
+                        }
+                        unsigned value = 0;
+                        for (int i = 0; i < 4; ++i)
+                        {
+                            char hex = *current_++;
+                            value <<= 4;
+                            if (hex >= '0' && hex <= '9')
+                            {
+                                value |= static_cast<unsigned>(hex - '0');
+                            }
+                            else if (hex >= 'a' && hex <= 'f')
+                            {
+                                value |= static_cast<unsigned>(hex - 'a' + 10);
+                            }
+                            else if (hex >= 'A' && hex <= 'F')
+                            {
+                                value |= static_cast<unsigned>(hex - 'A' + 10);
+                            }
+                            else
+                            {
+                                throw std::runtime_error("Invalid unicode escape");
+                            }
+                        }
+                        if (value <= 0x7F)
+                        {
+                            scratch.push_back(static_cast<char>(value));
+                        }
+                        else if (value <= 0x7FF)
+                        {
+                            scratch.push_back(static_cast<char>(0xC0 | ((value >> 6) & 0x1F)));
+                            scratch.push_back(static_cast<char>(0x80 | (value & 0x3F)));
+                        }
+                        else
+                        {
+                            scratch.push_back(static_cast<char>(0xE0 | ((value >> 12) & 0x0F)));
+                            scratch.push_back(static_cast<char>(0x80 | ((value >> 6) & 0x3F)));
+                            scratch.push_back(static_cast<char>(0x80 | (value & 0x3F)));
+                        }
+                        break;
+                    }
+                    default:
+                        throw std::runtime_error("Invalid escape sequence");
+                    }
+                }
+                else
+                {
+                    if (static_cast<unsigned char>(ch) < 0x20)
+                    {
+                        throw std::runtime_error("Invalid control character in string");
+                    }
+                    scratch.push_back(ch);
+                }
+            }
+            throw std::runtime_error("Unterminated JSON string");
+        }
+
+        void parseLiteral(std::string_view literal)
+        {
+            for (char expected : literal)
+            {
+                if (current_ == end_ || *current_++ != expected)
+                {
+                    throw std::runtime_error("Invalid JSON literal");
+                }
+            }
+        }
+
+        bool consume(char ch)
+        {
+            if (current_ != end_ && *current_ == ch)
+            {
+                ++current_;
+                return true;
+            }
+            return false;
+        }
+
+        void expect(char ch)
+        {
+            if (current_ == end_ || *current_ != ch)
+            {
+                throw std::runtime_error("Unexpected character in JSON stream");
+            }
+            ++current_;
+        }
+
+        const char *begin_;
+        const char *current_;
+        const char *end_;
+        bool first_ = false;
+    };
+
+} // namespace wolvrix::lib::load
+
+#endif // WOLVRIX_JSON_CURSOR_HPP
@@ -3,23 +3,129 @@
 
 #include "core/grh.hpp"
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 namespace wolvrix::lib::load
 {
 
+    // Read-only memory mapping of a whole file. Throws std::runtime_error when the file
+    // cannot be opened, is empty, or cannot be mapped.
+    class MappedFile
+    {
+    public:
+        explicit MappedFile(const std::string &path);
+        // Maps the POSIX shared-memory object `name` (as passed to shm_open) read-only.
+        static MappedFile sharedMemory(const std::string &name);
+        ~MappedFile();
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+        MappedFile(MappedFile &&other) noexcept;
+        MappedFile &operator=(MappedFile &&other) noexcept;
+
+        std::string_view view() const noexcept { return {static_cast<const char *>(data_), size_}; }
+        std::size_t size() const noexcept { return size_; }
+
+    private:
+        MappedFile() = default;
+        // Takes ownership of `fd`; `what` names the object in error messages.
+        void mapDescriptor(int fd, const std::string &what);
+        void release() noexcept;
+
+        void *data_ = nullptr;
+        std::size_t size_ = 0;
+    };
+
     class Load
     {
     public:
         virtual ~Load() = default;
 
         virtual wolvrix::lib::grh::Design load(std::string_view data) = 0;
+        // Maps the file and loads straight from the mapped bytes.
+        virtual wolvrix::lib::grh::Design loadFile(const std::string &path);
     };
 
+    // Graph objects are built concurrently. threadCount == 0 uses WOLVRIX_JSON_THREADS when
+    // set and the hardware concurrency otherwise; the loaded design is the same either way.
     class LoadJson final : public Load
     {
     public:
+        explicit LoadJson(std::size_t threadCount = 0) : threadCount_(threadCount) {}
+
         wolvrix::lib::grh::Design load(std::string_view data) override;
+
+    private:
+        std::size_t threadCount_ = 0;
+    };
+
+    // Random access to a .grhb container (layout in docs/grh/grh-binary-spec.md). The header,
+    // string table and graph index are validated on construction; graph sections are decoded
+    // only when asked for.
+    class GrhbArchive
+    {
+    public:
+        // Borrows `data`, which must outlive the archive.
+        explicit GrhbArchive(std::string_view data);
+        // Maps the file; the mapping lives as long as the archive.
+        static GrhbArchive open(const std::string &path);
+        // Same for a shared-memory object written by StoreGrhb::storeToSharedMemory.
+        static GrhbArchive openSharedMemory(const std::string &name);
+
+        std::size_t graphCount() const noexcept { return graphs_.size(); }
+        std::string_view graphName(std::size_t index) const { return graphs_.at(index).name; }
+        std::optional<std::size_t> findGraph(std::string_view name) const;
+        std::string_view graphSection(std::size_t index) const { return graphs_.at(index).section; }
+
+        // Decodes one graph section into a detached graph of `design`; adopting it is up to
+        // the caller.
+        std::unique_ptr<wolvrix::lib::grh::Graph> decodeGraph(wolvrix::lib::grh::Design &design,
+                                                              std::size_t index) const;
+        // Decodes and adopts one graph.
+        wolvrix::lib::grh::Graph &loadGraph(wolvrix::lib::grh::Design &design, std::size_t index) const;
+        // Applies declared symbols, then the aliases and tops whose graphs are present in `design`.
+        void loadDesignInfo(wolvrix::lib::grh::Design &design) const;
+
+    private:
+        struct GraphEntry
+        {
+            std::string_view name;
+            std::string_view section;
+        };
+
+        std::optional<MappedFile> file_;
+        std::string_view data_;
+        std::vector<GraphEntry> graphs_;
+        std::vector<std::pair<std::string_view, uint32_t>> aliases_;
+        std::vector<std::string_view> declaredSymbols_;
+        std::vector<uint32_t> tops_;
+    };
+
+    // Loads every graph of a .grhb container, decoding sections concurrently. threadCount == 0
+    // follows the same rules as LoadJson.
+    class LoadGrhb final : public Load
+    {
+    public:
+        explicit LoadGrhb(std::size_t threadCount = 0) : threadCount_(threadCount) {}
+
+        wolvrix::lib::grh::Design load(std::string_view data) override;
+        // Maps the file and registers every graph lazily: a graph is decoded on first
+        // findGraph()/graphs() access, and StoreGrhb copies untouched ones through verbatim.
+        // The mapping stays open while the design or any clone of it refers to it.
+        wolvrix::lib::grh::Design loadLazy(const std::string &path);
+        // Same over an already opened archive, e.g. GrhbArchive::openSharedMemory(); the archive
+        // must own its mapping.
+        wolvrix::lib::grh::Design loadLazy(GrhbArchive archive);
+
+    private:
+        std::size_t threadCount_ = 0;
     };
 
 } // namespace wolvrix::lib::load
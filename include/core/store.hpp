@@ -4,6 +4,7 @@
 #include "core/diagnostics.hpp"
 #include "core/grh.hpp"
 
+#include <cstddef>
 #include <filesystem>
 #include <fstream>
 #include <memory>
@@ -43,6 +44,9 @@ namespace wolvrix::lib::store
         std::optional<std::string> outputFilename;
         JsonPrintMode jsonMode = JsonPrintMode::PrettyCompact;
         std::vector<std::string> topOverrides;
+        // Worker threads used to serialize graphs; 0 uses WOLVRIX_JSON_THREADS or the
+        // hardware concurrency.
+        std::size_t threadCount = 0;
     };
 
     struct StoreResult
@@ -96,6 +100,27 @@ namespace wolvrix::lib::store
                               const StoreOptions &options) override;
     };
 
+    // Binary design container (.grhb, layout in docs/grh/grh-binary-spec.md). Graph sections
+    // are encoded concurrently and streamed in graph order, like StoreJson.
+    class StoreGrhb : public Store
+    {
+    public:
+        using Store::Store;
+
+        std::optional<std::string> storeToString(const wolvrix::lib::grh::Design &design,
+                                                 const StoreOptions &options = StoreOptions());
+        // Writes the container into a new POSIX shared-memory object `name` (shm_open syntax,
+        // e.g. "/wolvrix-123"); fails if it already exists. Other processes attach with
+        // GrhbArchive::openSharedMemory(); the object lives until shm_unlink().
+        bool storeToSharedMemory(const wolvrix::lib::grh::Design &design, const std::string &name,
+                                 const StoreOptions &options = StoreOptions());
+
+    private:
+        StoreResult storeImpl(const wolvrix::lib::grh::Design &design,
+                              std::span<const wolvrix::lib::grh::Graph *const> topGraphs,
+                              const StoreOptions &options) override;
+    };
+
 } // namespace wolvrix::lib::store
 
 #endif // WOLVRIX_STORE_HPP
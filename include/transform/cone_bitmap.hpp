@@ -0,0 +1,409 @@
+#ifndef WOLVRIX_TRANSFORM_CONE_BITMAP_HPP
+#define WOLVRIX_TRANSFORM_CONE_BITMAP_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace wolvrix::lib::transform::detail
+{
+
+    // Compressed set of dense 32-bit indices (operation or value slots), laid out like a roaring
+    // bitmap: ids are grouped by their high 16 bits, and each group is stored either as a sorted
+    // array of low halves or, once it holds more than kArrayLimit ids, as a 65536-bit word array.
+    // Word-array unions and intersections are plain loops over uint64_t that the compiler
+    // vectorizes.
+    class ConeBitmap
+    {
+    public:
+        static constexpr std::size_t kArrayLimit = 4096;
+        static constexpr std::size_t kWordsPerContainer = 65536 / 64;
+
+        // Builds the set from ids sorted in ascending order without duplicates.
+        static ConeBitmap fromSorted(const std::vector<uint32_t> &ids)
+        {
+            ConeBitmap out;
+            std::size_t begin = 0;
+            while (begin < ids.size())
+            {
+                const uint16_t key = static_cast<uint16_t>(ids[begin] >> 16u);
+                std::size_t end = begin;
+                while (end < ids.size() && static_cast<uint16_t>(ids[end] >> 16u) == key)
+                {
+                    ++end;
+                }
+                Container container;
+                container.key = key;
+                container.cardinality = static_cast<uint32_t>(end - begin);
+                if (container.cardinality > kArrayLimit)
+                {
+                    container.words.assign(kWordsPerContainer, 0);
+                    for (std::size_t i = begin; i < end; ++i)
+                    {
+                        setWordBit(container.words, static_cast<uint16_t>(ids[i]));
+                    }
+                }
+                else
+                {
+                    container.array.reserve(container.cardinality);
+                    for (std::size_t i = begin; i < end; ++i)
+                    {
+                        container.array.push_back(static_cast<uint16_t>(ids[i]));
+                    }
+                }
+                out.cardinality_ += container.cardinality;
+                out.containers_.push_back(std::move(container));
+                begin = end;
+            }
+            return out;
+        }
+
+        // Returns true when `id` was not present before.
+        bool insert(uint32_t id)
+        {
+            Container &container = findOrCreate(static_cast<uint16_t>(id >> 16u));
+            const uint16_t low = static_cast<uint16_t>(id);
+            if (container.isWords())
+            {
+                if (testWordBit(container.words, low))
+                {
+                    return false;
+                }
+                setWordBit(container.words, low);
+            }
+            else
+            {
+                auto it = std::lower_bound(container.array.begin(), container.array.end(), low);
+                if (it != container.array.end() && *it == low)
+                {
+                    return false;
+                }
+                container.array.insert(it, low);
+                if (container.array.size() > kArrayLimit)
+                {
+                    promote(container);
+                }
+            }
+            ++container.cardinality;
+            ++cardinality_;
+            return true;
+        }
+
+        bool contains(uint32_t id) const
+        {
+            const Container *container = find(static_cast<uint16_t>(id >> 16u));
+            if (!container)
+            {
+                return false;
+            }
+            const uint16_t low = static_cast<uint16_t>(id);
+            if (container->isWords())
+            {
+                return testWordBit(container->words, low);
+            }
+            return std::binary_search(container->array.begin(), container->array.end(), low);
+        }
+
+        std::size_t size() const noexcept { return cardinality_; }
+        bool empty() const noexcept { return cardinality_ == 0; }
+
+        void clear() noexcept
+        {
+            containers_.clear();
+            cardinality_ = 0;
+        }
+
+        // Bytes held by the containers, for logging.
+        std::size_t memoryBytes() const noexcept
+        {
+            std::size_t bytes = containers_.capacity() * sizeof(Container);
+            for (const Container &container : containers_)
+            {
+                bytes += container.array.capacity() * sizeof(uint16_t);
+                bytes += container.words.capacity() * sizeof(uint64_t);
+            }
+            return bytes;
+        }
+
+        void unionWith(const ConeBitmap &other)
+        {
+            if (other.empty())
+            {
+                return;
+            }
+            std::vector<Container> merged;
+            merged.reserve(containers_.size() + other.containers_.size());
+            std::size_t i = 0;
+            std::size_t j = 0;
+            while (i < containers_.size() || j < other.containers_.size())
+            {
+                if (j == other.containers_.size() ||
+                    (i < containers_.size() && containers_[i].key < other.containers_[j].key))
+                {
+                    merged.push_back(std::move(containers_[i++]));
+                    continue;
+                }
+                if (i == containers_.size() || other.containers_[j].key < containers_[i].key)
+                {
+                    merged.push_back(other.containers_[j++]);
+                    continue;
+                }
+                Container container = std::move(containers_[i++]);
+                unionContainer(container, other.containers_[j++]);
+                merged.push_back(std::move(container));
+            }
+            containers_ = std::move(merged);
+            cardinality_ = 0;
+            for (const Container &container : containers_)
+            {
+                cardinality_ += container.cardinality;
+            }
+        }
+
+        std::size_t intersectionSize(const ConeBitmap &other) const
+        {
+            std::size_t count = 0;
+            forEachIntersectionContainer(other, [&](const Container &lhs, const Container &rhs) {
+                if (lhs.isWords() && rhs.isWords())
+                {
+                    for (std::size_t w = 0; w < kWordsPerContainer; ++w)
+                    {
+                        count += static_cast<std::size_t>(std::popcount(lhs.words[w] & rhs.words[w]));
+                    }
+                    return;
+                }
+                forEachCommonLow(lhs, rhs, [&](uint16_t) { ++count; });
+            });
+            return count;
+        }
+
+        // Calls fn(id) for every id present in both sets, in ascending order.
+        template <typename Fn>
+        void forEachIntersection(const ConeBitmap &other, Fn &&fn) const
+        {
+            forEachIntersectionContainer(other, [&](const Container &lhs, const Container &rhs) {
+                const uint32_t high = static_cast<uint32_t>(lhs.key) << 16u;
+                if (lhs.isWords() && rhs.isWords())
+                {
+                    for (std::size_t w = 0; w < kWordsPerContainer; ++w)
+                    {
+                        uint64_t word = lhs.words[w] & rhs.words[w];
+                        while (word != 0)
+                        {
+                            const uint32_t bit = static_cast<uint32_t>(std::countr_zero(word));
+                            fn(high | static_cast<uint32_t>(w * 64 + bit));
+                            word &= (word - 1);
+                        }
+                    }
+                    return;
+                }
+                forEachCommonLow(lhs, rhs, [&](uint16_t low) { fn(high | low); });
+            });
+        }
+
+        // Calls fn(id) for every id in ascending order.
+        template <typename Fn>
+        void forEach(Fn &&fn) const
+        {
+            for (const Container &container : containers_)
+            {
+                const uint32_t high = static_cast<uint32_t>(container.key) << 16u;
+                if (!container.isWords())
+                {
+                    for (const uint16_t low : container.array)
+                    {
+                        fn(high | low);
+                    }
+                    continue;
+                }
+                for (std::size_t w = 0; w < kWordsPerContainer; ++w)
+                {
+                    uint64_t word = container.words[w];
+                    while (word != 0)
+                    {
+                        const uint32_t bit = static_cast<uint32_t>(std::countr_zero(word));
+                        fn(high | static_cast<uint32_t>(w * 64 + bit));
+                        word &= (word - 1);
+                    }
+                }
+            }
+        }
+
+    private:
+        struct Container
+        {
+            uint16_t key = 0;
+            uint32_t cardinality = 0;
+            // Exactly one of these is in use; `words` is non-empty for word containers.
+            std::vector<uint16_t> array;
+            std::vector<uint64_t> words;
+
+            bool isWords() const noexcept { return !words.empty(); }
+        };
+
+        static void setWordBit(std::vector<uint64_t> &words, uint16_t low)
+        {
+            words[low >> 6u] |= (uint64_t{1} << (low & 63u));
+        }
+
+        static bool testWordBit(const std::vector<uint64_t> &words, uint16_t low)
+        {
+            return (words[low >> 6u] & (uint64_t{1} << (low & 63u))) != 0;
+        }
+
+        static void promote(Container &container)
+        {
+            container.words.assign(kWordsPerContainer, 0);
+            for (const uint16_t low : container.array)
+            {
+                setWordBit(container.words, low);
+            }
+            container.array.clear();
+            container.array.shrink_to_fit();
+        }
+
+        static void unionContainer(Container &lhs, const Container &rhs)
+        {
+            if (lhs.isWords() && rhs.isWords())
+            {
+                uint32_t cardinality = 0;
+                for (std::size_t w = 0; w < kWordsPerContainer; ++w)
+                {
+                    lhs.words[w] |= rhs.words[w];
+                    cardinality += static_cast<uint32_t>(std::popcount(lhs.words[w]));
+                }
+                lhs.cardinality = cardinality;
+                return;
+            }
+            if (lhs.isWords() || rhs.isWords())
+            {
+                if (!lhs.isWords())
+                {
+                    promote(lhs);
+                }
+                const std::vector<uint16_t> &lows = rhs.isWords() ? lhs.array : rhs.array;
+                if (rhs.isWords())
+                {
+                    for (std::size_t w = 0; w < kWordsPerContainer; ++w)
+                    {
+                        lhs.words[w] |= rhs.words[w];
+                    }
+                }
+                for (const uint16_t low : lows)
+                {
+                    setWordBit(lhs.words, low);
+                }
+                uint32_t cardinality = 0;
+                for (const uint64_t word : lhs.words)
+                {
+                    cardinality += static_cast<uint32_t>(std::popcount(word));
+                }
+                lhs.cardinality = cardinality;
+                return;
+            }
+            std::vector<uint16_t> merged;
+            merged.reserve(lhs.array.size() + rhs.array.size());
+            std::set_union(lhs.array.begin(), lhs.array.end(),
+                           rhs.array.begin(), rhs.array.end(),
+                           std::back_inserter(merged));
+            lhs.array = std::move(merged);
+            lhs.cardinality = static_cast<uint32_t>(lhs.array.size());
+            if (lhs.array.size() > kArrayLimit)
+            {
+                promote(lhs);
+            }
+        }
+
+        template <typename Fn>
+        static void forEachCommonLow(const Container &lhs, const Container &rhs, Fn &&fn)
+        {
+            if (lhs.isWords() || rhs.isWords())
+            {
+                const Container &arrayContainer = lhs.isWords() ? rhs : lhs;
+                const Container &wordContainer = lhs.isWords() ? lhs : rhs;
+                for (const uint16_t low : arrayContainer.array)
+                {
+                    if (testWordBit(wordContainer.words, low))
+                    {
+                        fn(low);
+                    }
+                }
+                return;
+            }
+            std::size_t i = 0;
+            std::size_t j = 0;
+            while (i < lhs.array.size() && j < rhs.array.size())
+            {
+                if (lhs.array[i] < rhs.array[j])
+                {
+                    ++i;
+                }
+                else if (rhs.array[j] < lhs.array[i])
+                {
+                    ++j;
+                }
+                else
+                {
+                    fn(lhs.array[i]);
+                    ++i;
+                    ++j;
+                }
+            }
+        }
+
+        template <typename Fn>
+        void forEachIntersectionContainer(const ConeBitmap &other, Fn &&fn) const
+        {
+            std::size_t i = 0;
+            std::size_t j = 0;
+            while (i < containers_.size() && j < other.containers_.size())
+            {
+                if (containers_[i].key < other.containers_[j].key)
+                {
+                    ++i;
+                }
+                else if (other.containers_[j].key < containers_[i].key)
+                {
+                    ++j;
+                }
+                else
+                {
+                    fn(containers_[i++], other.containers_[j++]);
+                }
+            }
+        }
+
+        const Container *find(uint16_t key) const
+        {
+            auto it = std::lower_bound(containers_.begin(), containers_.end(), key,
+                                       [](const Container &container, uint16_t k) { return container.key < k; });
+            if (it == containers_.end() || it->key != key)
+            {
+                return nullptr;
+            }
+            return &*it;
+        }
+
+        Container &findOrCreate(uint16_t key)
+        {
+            auto it = std::lower_bound(containers_.begin(), containers_.end(), key,
+                                       [](const Container &container, uint16_t k) { return container.key < k; });
+            if (it == containers_.end() || it->key != key)
+            {
+                Container container;
+                container.key = key;
+                it = containers_.insert(it, std::move(container));
+            }
+            return *it;
+        }
+
+        std::vector<Container> containers_;
+        std::size_t cardinality_ = 0;
+    };
+
+} // namespace wolvrix::lib::transform::detail
+
+#endif // WOLVRIX_TRANSFORM_CONE_BITMAP_HPP
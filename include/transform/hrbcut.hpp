@@ -12,11 +12,16 @@ namespace wolvrix::lib::transform
     struct HrbcutOptions
     {
         std::string targetGraphSymbol;
+        // Any count >= 1; a node that must produce k parts is split into floor(k / 2) and
+        // ceil(k / 2) parts with the weight shared in the same ratio.
         std::size_t partitionCount = 2;
         double balanceThreshold = 0.05;
         std::size_t targetCandidateCount = 8;
         std::size_t maxTrials = 32;
         std::size_t splitStopThreshold = 8;
+        // Worker threads for the split tree and its sampling trials; 0 uses the hardware thread
+        // count. The partition does not depend on this value.
+        std::size_t threads = 0;
     };
 
     class HrbcutPass : public Pass
@@ -5,6 +5,7 @@
 
 #include <cstddef>
 #include <string>
+#include <vector>
 
 namespace wolvrix::lib::transform
 {
@@ -18,7 +19,50 @@ namespace wolvrix::lib::transform
         std::string partitioner = "mt-kahypar";
         std::string mtKaHyParPreset = "deterministic-quality";
         std::size_t mtKaHyParThreads = 0;
+        // Threads for phase-b ASC and piece construction; 0 picks min(hardware threads, 8). The
+        // result does not depend on this value.
+        std::size_t phaseBThreads = 0;
+        // On graphs with combinational cycles, give every node of a cycle the complete cone of its
+        // strongly connected component when grouping sinks by memories and returned effects, and
+        // summarize in parallel. Off by default: cycles then use the serial memoized walk, whose
+        // ASCs depend on where the walk entered each cycle, as in earlier releases.
+        bool phaseBSccCones = false;
+        // Threads that build the partition graphs in phase-e; 0 picks min(hardware threads, 8).
+        // The rebuilt graphs do not depend on this value.
+        std::size_t phaseEThreads = 0;
         bool keepIntermediateFiles = false;
+        // Persist phase-b/c results and backend partitions, keyed by a structural hash of the
+        // target graph, and reuse them when the graph is unchanged. Off unless asked for; the
+        // file goes to cacheDir, or workDir when cacheDir is empty.
+        bool cache = false;
+        std::string cacheDir;
+        // When non-empty, phases a-c run once and the backend is called for every count listed
+        // here; the per-count report is emitted as an info diagnostic and `partitionCount` is
+        // ignored. The graph is only rebuilt, with the best count, when sweepRebuildBest is set.
+        std::vector<std::size_t> sweepPartitionCounts;
+        bool sweepRebuildBest = false;
+        // How hyperedges are weighted for the partitioner: "heuristic" scores cut pieces by width,
+        // fan-out and state-boundary terms, "comm" uses the 32-bit words a cut piece copies per
+        // step in the generated package, and "unit" weights every hyperedge 1.
+        std::string edgeWeighting = "heuristic";
+        // Also partition with the other edge weightings and report their predicted cross-partition
+        // traffic next to the selected one. Only the selected weighting's partition is rebuilt.
+        bool compareEdgeWeighting = false;
+        // Timing JSONL written by a previous run of the generated package (WOLVI_REPCUT_TIMING_JSONL).
+        // When set, the measured per-partition eval times rescale the ASC node weights of the ASCs
+        // recorded in the previous run's asc partition map.
+        std::string timingProfile;
+        // Write the asc partition map (<graph>.repcut-asc-parts) that a later timingProfile run
+        // reads. It is also written when timingProfile or keepIntermediateFiles is set.
+        bool ascPartitionMap = false;
+        // Hierarchical mode for NUMA hosts. When >= 2 the hypergraph is first split into this many
+        // domains and each domain is then split into partitionCount / numaDomains parts, so part p
+        // belongs to domain p / (partitionCount / numaDomains). The domain is recorded on every
+        // part instance as `repcutNumaDomain`.
+        std::size_t numaDomains = 0;
+        // Cost of a word that crosses domains relative to one exchanged inside a domain. Inside a
+        // domain, hyperedges that also reach other domains are weighted up by this factor.
+        double numaInterDomainCost = 4.0;
     };
 
     class RepcutPass : public Pass
@@ -92,7 +92,14 @@ namespace wolvrix::lib::diag
         else
         {
             std::lock_guard<std::mutex> lock(mutex_);
-            messages_.push_back(std::move(diag));
+            if (sink_)
+            {
+                sink_(std::move(diag));
+            }
+            else
+            {
+                messages_.push_back(std::move(diag));
+            }
         }
 
         if (isError)
@@ -112,7 +119,15 @@ namespace wolvrix::lib::diag
             return;
         }
         std::lock_guard<std::mutex> lock(mutex_);
-        if (!buffer.messages.empty())
+        if (!buffer.messages.empty() && sink_)
+        {
+            for (Diagnostic &diag : buffer.messages)
+            {
+                sink_(std::move(diag));
+            }
+            buffer.messages.clear();
+        }
+        else if (!buffer.messages.empty())
         {
             messages_.insert(messages_.end(),
                              std::make_move_iterator(buffer.messages.begin()),
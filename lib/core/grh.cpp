@@ -1,16 +1,21 @@
 #include "core/grh.hpp"
 
 #include <algorithm>
+#include <bit>
 #include <cctype>
 #include <charconv>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <functional>
+#include <limits>
+#include <mutex>
 #include <span>
 #include <stdexcept>
 #include <string>
 #include <system_error>
+#include <type_traits>
 #include <unordered_set>
 #include <utility>
 
@@ -261,6 +266,37 @@ namespace wolvrix::lib::grh
                 clone.addDeclaredSymbol(dstSym);
             }
         }
+
+        // Staged graphs rebind once, on adoption; every handle stored inside the graph follows.
+        template <typename Id>
+        void retargetId(Id &id, GraphId graphId) noexcept
+        {
+            if (id.valid())
+            {
+                id.graph = graphId;
+            }
+        }
+
+        void retargetPorts(std::vector<Port> &inputPorts,
+                           std::vector<Port> &outputPorts,
+                           std::vector<InoutPort> &inoutPorts,
+                           GraphId graphId) noexcept
+        {
+            for (Port &port : inputPorts)
+            {
+                retargetId(port.value, graphId);
+            }
+            for (Port &port : outputPorts)
+            {
+                retargetId(port.value, graphId);
+            }
+            for (InoutPort &port : inoutPorts)
+            {
+                retargetId(port.in, graphId);
+                retargetId(port.out, graphId);
+                retargetId(port.oe, graphId);
+            }
+        }
     } // namespace
 
     std::size_t SymbolTable::StringHash::operator()(std::string_view value) const noexcept
@@ -303,7 +339,63 @@ namespace wolvrix::lib::grh
         symbolByGraph_.push_back(SymbolId::invalid());
     }
 
+    DesignSymbolTable::DesignSymbolTable(DesignSymbolTable &&other) noexcept
+        : SymbolTable(std::move(other)),
+          nextGraphIndex_(other.nextGraphIndex_.load(std::memory_order_relaxed)),
+          nextStagedGraphIndex_(other.nextStagedGraphIndex_.load(std::memory_order_relaxed)),
+          symbolByGraph_(std::move(other.symbolByGraph_)),
+          graphIndexBySymbol_(std::move(other.graphIndexBySymbol_))
+    {
+    }
+
+    DesignSymbolTable &DesignSymbolTable::operator=(DesignSymbolTable &&other) noexcept
+    {
+        if (this != &other)
+        {
+            SymbolTable::operator=(std::move(other));
+            nextGraphIndex_.store(other.nextGraphIndex_.load(std::memory_order_relaxed),
+                                  std::memory_order_relaxed);
+            nextStagedGraphIndex_.store(other.nextStagedGraphIndex_.load(std::memory_order_relaxed),
+                                        std::memory_order_relaxed);
+            symbolByGraph_ = std::move(other.symbolByGraph_);
+            graphIndexBySymbol_ = std::move(other.graphIndexBySymbol_);
+        }
+        return *this;
+    }
+
     GraphId DesignSymbolTable::allocateGraphId(SymbolId symbol)
+    {
+        GraphId graphId = reserveGraphId();
+        bindGraphId(symbol, graphId);
+        return graphId;
+    }
+
+    GraphId DesignSymbolTable::reserveGraphId() noexcept
+    {
+        GraphId graphId;
+        graphId.index = nextGraphIndex_.fetch_add(1, std::memory_order_relaxed);
+        graphId.generation = 0;
+        return graphId;
+    }
+
+    // Staged ids share no index space with bound ids: the generation marks them, and
+    // bindGraphId() refuses them.
+    constexpr uint32_t kStagedGraphGeneration = std::numeric_limits<uint32_t>::max();
+
+    GraphId DesignSymbolTable::reserveStagedGraphId() noexcept
+    {
+        GraphId graphId;
+        graphId.index = nextStagedGraphIndex_.fetch_add(1, std::memory_order_relaxed);
+        graphId.generation = kStagedGraphGeneration;
+        return graphId;
+    }
+
+    bool DesignSymbolTable::isStagedGraphId(GraphId graph) noexcept
+    {
+        return graph.valid() && graph.generation == kStagedGraphGeneration;
+    }
+
+    void DesignSymbolTable::bindGraphId(SymbolId symbol, GraphId graph)
     {
         if (!symbol.valid())
         {
@@ -313,20 +405,24 @@ namespace wolvrix::lib::grh
         {
             throw std::runtime_error("Graph symbol is not in the symbol table");
         }
+        if (!graph.valid() || isStagedGraphId(graph) || graph.index >= nextGraphIndex_.load(std::memory_order_relaxed))
+        {
+            throw std::runtime_error("GraphId was not reserved by this symbol table");
+        }
         if (graphIndexBySymbol_.contains(symbol.value))
         {
             throw std::runtime_error("Graph symbol already has an assigned GraphId");
         }
-        GraphId graphId;
-        graphId.index = nextGraphIndex_++;
-        graphId.generation = 0;
-        if (symbolByGraph_.size() <= graphId.index)
+        if (symbolByGraph_.size() <= graph.index)
         {
-            symbolByGraph_.resize(graphId.index + 1);
+            symbolByGraph_.resize(graph.index + 1);
         }
-        symbolByGraph_[graphId.index] = symbol;
-        graphIndexBySymbol_[symbol.value] = graphId.index;
-        return graphId;
+        if (symbolByGraph_[graph.index].valid())
+        {
+            throw std::runtime_error("GraphId is already bound to a graph symbol");
+        }
+        symbolByGraph_[graph.index] = symbol;
+        graphIndexBySymbol_[symbol.value] = graph.index;
     }
 
     void DesignSymbolTable::releaseGraphId(SymbolId symbol)
@@ -659,6 +755,36 @@ namespace wolvrix::lib::grh
         return index - 1;
     }
 
+    void GraphView::rebindGraphId(GraphId graphId)
+    {
+        graphId_ = graphId;
+        for (OperationId &op : operations_)
+        {
+            retargetId(op, graphId);
+        }
+        for (ValueId &value : values_)
+        {
+            retargetId(value, graphId);
+        }
+        for (ValueId &value : operands_)
+        {
+            retargetId(value, graphId);
+        }
+        for (ValueId &value : results_)
+        {
+            retargetId(value, graphId);
+        }
+        for (OperationId &op : valueDefs_)
+        {
+            retargetId(op, graphId);
+        }
+        for (ValueUser &user : useList_)
+        {
+            retargetId(user.operation, graphId);
+        }
+        retargetPorts(inputPorts_, outputPorts_, inoutPorts_, graphId);
+    }
+
     GraphBuilder::GraphBuilder(GraphId graphId) : graphId_(graphId)
     {
         if (!graphId_.valid())
@@ -2425,6 +2551,34 @@ namespace wolvrix::lib::grh
         }
     }
 
+    void GraphBuilder::rebindGraphId(GraphId graphId)
+    {
+        graphId_ = graphId;
+        for (ValueData &value : values_)
+        {
+            retargetId(value.definingOp, graphId);
+        }
+        for (OperationData &op : operations_)
+        {
+            for (ValueId &value : op.operands)
+            {
+                retargetId(value, graphId);
+            }
+            for (ValueId &value : op.results)
+            {
+                retargetId(value, graphId);
+            }
+        }
+        for (std::vector<ValueUser> &users : valueUsers_)
+        {
+            for (ValueUser &user : users)
+            {
+                retargetId(user.operation, graphId);
+            }
+        }
+        retargetPorts(inputPorts_, outputPorts_, inoutPorts_, graphId);
+    }
+
     void GraphBuilder::recomputePortFlags()
     {
         for (auto &value : values_)
@@ -2530,6 +2684,30 @@ namespace wolvrix::lib::grh
         symbolIndex_.erase(it);
     }
 
+    struct Design::LazyGraphs
+    {
+        struct Entry
+        {
+            std::shared_ptr<const LazyGraphSource> source;
+            std::size_t slot = 0;
+            std::mutex mutex;
+            std::atomic<bool> loaded{false};
+        };
+
+        // Keyed by graph address, which is stable while the graph is owned by the design.
+        std::unordered_map<const Graph *, Entry> entries;
+        std::atomic<std::size_t> pending{0};
+
+        Entry *find(const Graph &graph)
+        {
+            auto it = entries.find(&graph);
+            return it == entries.end() ? nullptr : &it->second;
+        }
+    };
+
+    Design::Design() = default;
+    Design::~Design() = default;
+
     Design::Design(Design &&other) noexcept
     {
         *this = std::move(other);
@@ -2546,6 +2724,7 @@ namespace wolvrix::lib::grh
             declaredSymbols_ = std::move(other.declaredSymbols_);
             declaredSymbolSet_ = std::move(other.declaredSymbolSet_);
             designSymbols_ = std::move(other.designSymbols_);
+            lazy_ = std::move(other.lazy_);
             resetGraphOwners();
 
             other.graphAliasBySymbol_.clear();
@@ -4162,6 +4341,794 @@ namespace wolvrix::lib::grh
         writer.endObject();
     }
 
+    namespace
+    {
+        // .grhb graph sections are flat little-endian arrays, each padded to 8 bytes so that a
+        // section starting on an 8-byte boundary keeps every array aligned.
+        static_assert(std::endian::native == std::endian::little, ".grhb assumes a little-endian host");
+
+        constexpr std::size_t kGrhbSectionCounts = 16;
+        constexpr std::size_t kGrhbSrcLocFields = 8;
+
+        class GrhbWriter
+        {
+        public:
+            explicit GrhbWriter(std::string &out) : out_(out), base_(out.size()) {}
+
+            template <typename T>
+            void put(T value)
+            {
+                static_assert(std::is_trivially_copyable_v<T>);
+                const char *bytes = reinterpret_cast<const char *>(&value);
+                out_.append(bytes, sizeof(T));
+            }
+
+            template <typename T>
+            void putArray(const std::vector<T> &values)
+            {
+                static_assert(std::is_trivially_copyable_v<T>);
+                out_.append(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(T));
+                pad();
+            }
+
+            void putBytes(std::string_view bytes)
+            {
+                out_.append(bytes);
+                pad();
+            }
+
+            void pad()
+            {
+                while ((out_.size() - base_) % 8 != 0)
+                {
+                    out_.push_back('\0');
+                }
+            }
+
+        private:
+            std::string &out_;
+            std::size_t base_;
+        };
+
+        template <typename T>
+        class GrhbArray
+        {
+        public:
+            GrhbArray() = default;
+            GrhbArray(const char *data, std::size_t count) : data_(data), count_(count) {}
+
+            std::size_t size() const noexcept { return count_; }
+            T operator[](std::size_t index) const noexcept
+            {
+                T value;
+                std::memcpy(&value, data_ + index * sizeof(T), sizeof(T));
+                return value;
+            }
+            // Arrays stored exactly as GraphView keeps them are copied in one block.
+            void copyTo(std::vector<T> &out) const
+            {
+                out.resize(count_);
+                if (count_ != 0)
+                {
+                    std::memcpy(out.data(), data_, count_ * sizeof(T));
+                }
+            }
+
+        private:
+            const char *data_ = nullptr;
+            std::size_t count_ = 0;
+        };
+
+        class GrhbReader
+        {
+        public:
+            GrhbReader(std::string_view data, const std::string &graphSymbol)
+                : data_(data), graphSymbol_(graphSymbol)
+            {
+            }
+
+            template <typename T>
+            T get()
+            {
+                T value;
+                std::memcpy(&value, take(sizeof(T), false), sizeof(T));
+                return value;
+            }
+
+            template <typename T>
+            GrhbArray<T> getArray(std::size_t count)
+            {
+                if (count > data_.size() / sizeof(T))
+                {
+                    fail("array exceeds section");
+                }
+                return GrhbArray<T>(take(count * sizeof(T), true), count);
+            }
+
+            std::string_view getBytes(std::size_t size)
+            {
+                return std::string_view(take(size, true), size);
+            }
+
+            [[noreturn]] void fail(std::string_view reason) const
+            {
+                throw std::runtime_error("Invalid grhb graph section for " + graphSymbol_ + ": " + std::string(reason));
+            }
+
+        private:
+            const char *take(std::size_t size, bool padded)
+            {
+                if (size > data_.size() - offset_)
+                {
+                    fail("truncated section");
+                }
+                const char *ptr = data_.data() + offset_;
+                offset_ += size;
+                if (padded)
+                {
+                    offset_ = std::min(data_.size(), (offset_ + 7) & ~static_cast<std::size_t>(7));
+                }
+                return ptr;
+            }
+
+            std::string_view data_;
+            std::size_t offset_ = 0;
+            const std::string &graphSymbol_;
+        };
+
+        uint32_t grhbCount(std::size_t count, std::string_view what)
+        {
+            if (count > std::numeric_limits<uint32_t>::max())
+            {
+                throw std::runtime_error("Graph too large for grhb: " + std::string(what));
+            }
+            return static_cast<uint32_t>(count);
+        }
+
+        // Offsets of a CSR array built from per-row ranges; rows are contiguous in GraphView.
+        std::vector<uint32_t> grhbOffsets(const std::vector<Range> &ranges, std::string_view what)
+        {
+            std::vector<uint32_t> offsets;
+            offsets.reserve(ranges.size() + 1);
+            offsets.push_back(0);
+            for (const Range &range : ranges)
+            {
+                if (range.offset != offsets.back())
+                {
+                    throw std::runtime_error("Graph " + std::string(what) + " ranges are not contiguous");
+                }
+                offsets.push_back(grhbCount(range.offset + range.count, what));
+            }
+            return offsets;
+        }
+
+        // Extra strings follow the symbol table in the section string table. Reference 0 is the
+        // empty string and reference k names entry k - 1, so a SymbolId doubles as its reference.
+        class GrhbStringPool
+        {
+        public:
+            explicit GrhbStringPool(const GraphSymbolTable &symbols)
+            {
+                const std::size_t count = symbols.size();
+                entries_.reserve(count);
+                for (std::size_t i = 1; i <= count; ++i)
+                {
+                    const std::string_view text = symbols.text(SymbolId{static_cast<uint32_t>(i)});
+                    entries_.push_back(text);
+                    refs_.emplace(text, static_cast<uint32_t>(i));
+                }
+            }
+
+            uint32_t ref(std::string_view text)
+            {
+                if (text.empty())
+                {
+                    return 0;
+                }
+                auto [it, inserted] = refs_.emplace(text, 0);
+                if (inserted)
+                {
+                    entries_.push_back(text);
+                    it->second = grhbCount(entries_.size(), "strings");
+                }
+                return it->second;
+            }
+
+            const std::vector<std::string_view> &entries() const noexcept { return entries_; }
+
+        private:
+            std::vector<std::string_view> entries_;
+            std::unordered_map<std::string_view, uint32_t> refs_;
+        };
+
+        class GrhbAttrEncoder
+        {
+        public:
+            explicit GrhbAttrEncoder(GrhbStringPool &strings) : strings_(strings), writer_(data_) {}
+
+            uint64_t encode(const AttributeValue &value)
+            {
+                const uint64_t offset = data_.size();
+                std::visit(Overloaded{
+                               [&](bool v) { writer_.put<uint8_t>(v ? 1 : 0); },
+                               [&](int64_t v) { writer_.put<int64_t>(v); },
+                               [&](double v) { writer_.put<double>(v); },
+                               [&](const std::string &v) { writer_.put<uint32_t>(strings_.ref(v)); },
+                               [&](const std::vector<bool> &v) {
+                                   writer_.put<uint64_t>(v.size());
+                                   for (bool entry : v)
+                                   {
+                                       writer_.put<uint8_t>(entry ? 1 : 0);
+                                   }
+                               },
+                               [&](const std::vector<int64_t> &v) {
+                                   writer_.put<uint64_t>(v.size());
+                                   writer_.putArray(v);
+                               },
+                               [&](const std::vector<double> &v) {
+                                   writer_.put<uint64_t>(v.size());
+                                   writer_.putArray(v);
+                               },
+                               [&](const std::vector<std::string> &v) {
+                                   writer_.put<uint64_t>(v.size());
+                                   for (const std::string &entry : v)
+                                   {
+                                       writer_.put<uint32_t>(strings_.ref(entry));
+                                   }
+                               }},
+                           value);
+                writer_.pad();
+                return offset;
+            }
+
+            const std::string &data() const noexcept { return data_; }
+
+        private:
+            GrhbStringPool &strings_;
+            std::string data_;
+            GrhbWriter writer_;
+        };
+
+        uint32_t grhbSrcLocRef(const std::optional<SrcLoc> &loc, GrhbStringPool &strings, std::vector<uint32_t> &table)
+        {
+            if (!loc)
+            {
+                return 0;
+            }
+            table.push_back(strings.ref(loc->file));
+            table.push_back(loc->line);
+            table.push_back(loc->column);
+            table.push_back(loc->endLine);
+            table.push_back(loc->endColumn);
+            table.push_back(strings.ref(loc->origin));
+            table.push_back(strings.ref(loc->pass));
+            table.push_back(strings.ref(loc->note));
+            return grhbCount(table.size() / kGrhbSrcLocFields, "srclocs");
+        }
+
+        template <typename Id>
+        uint32_t grhbIdRef(Id id)
+        {
+            return id.valid() ? id.index : 0;
+        }
+    } // namespace
+
+    void Graph::writeBinary(std::string &out) const
+    {
+        std::optional<GraphView> builderView;
+        if (builder_)
+        {
+            builderView = builder_->freeze();
+        }
+        const GraphView &graphView = builderView ? *builderView : view();
+
+        GrhbStringPool strings(symbols_);
+        const std::size_t valueCount = graphView.values_.size();
+        const std::size_t opCount = graphView.operations_.size();
+
+        std::vector<uint32_t> declared;
+        declared.reserve(declaredSymbols_.size());
+        for (const SymbolId sym : declaredSymbols_)
+        {
+            declared.push_back(sym.value);
+        }
+
+        std::vector<uint32_t> srcLocs;
+        std::vector<uint32_t> valueSymbols(valueCount);
+        std::vector<uint32_t> valueDefs(valueCount);
+        std::vector<uint32_t> valueSrcLocs(valueCount);
+        for (std::size_t i = 0; i < valueCount; ++i)
+        {
+            valueSymbols[i] = graphView.valueSymbols_[i].value;
+            valueDefs[i] = grhbIdRef(graphView.valueDefs_[i]);
+            valueSrcLocs[i] = grhbSrcLocRef(graphView.valueSrcLocs_[i], strings, srcLocs);
+        }
+        std::vector<uint32_t> useList;
+        useList.reserve(graphView.useList_.size() * 2);
+        for (const ValueUser &user : graphView.useList_)
+        {
+            useList.push_back(grhbIdRef(user.operation));
+            useList.push_back(user.operandIndex);
+        }
+
+        std::vector<uint16_t> opKinds(opCount);
+        std::vector<uint32_t> opSymbols(opCount);
+        std::vector<uint32_t> opSrcLocs(opCount);
+        for (std::size_t i = 0; i < opCount; ++i)
+        {
+            opKinds[i] = static_cast<uint16_t>(graphView.opKinds_[i]);
+            opSymbols[i] = graphView.opSymbols_[i].value;
+            opSrcLocs[i] = grhbSrcLocRef(graphView.opSrcLocs_[i], strings, srcLocs);
+        }
+        auto valueRefs = [](const std::vector<ValueId> &ids) {
+            std::vector<uint32_t> refs;
+            refs.reserve(ids.size());
+            for (const ValueId id : ids)
+            {
+                refs.push_back(grhbIdRef(id));
+            }
+            return refs;
+        };
+        const std::vector<uint32_t> operands = valueRefs(graphView.operands_);
+        const std::vector<uint32_t> results = valueRefs(graphView.results_);
+
+        GrhbAttrEncoder attrEncoder(strings);
+        std::vector<uint32_t> attrKeys;
+        std::vector<uint8_t> attrTypes;
+        std::vector<uint64_t> attrPayloads;
+        attrKeys.reserve(graphView.opAttrs_.size());
+        attrTypes.reserve(graphView.opAttrs_.size());
+        attrPayloads.reserve(graphView.opAttrs_.size());
+        for (const AttrKV &attr : graphView.opAttrs_)
+        {
+            attrKeys.push_back(strings.ref(attr.key));
+            attrTypes.push_back(static_cast<uint8_t>(attr.value.index()));
+            attrPayloads.push_back(attrEncoder.encode(attr.value));
+        }
+
+        auto portRefs = [&](const std::vector<Port> &ports) {
+            std::vector<uint32_t> refs;
+            refs.reserve(ports.size() * 2);
+            for (const Port &port : ports)
+            {
+                refs.push_back(strings.ref(port.name));
+                refs.push_back(grhbIdRef(port.value));
+            }
+            return refs;
+        };
+        const std::vector<uint32_t> inputPorts = portRefs(graphView.inputPorts_);
+        const std::vector<uint32_t> outputPorts = portRefs(graphView.outputPorts_);
+        std::vector<uint32_t> inoutPorts;
+        inoutPorts.reserve(graphView.inoutPorts_.size() * 4);
+        for (const InoutPort &port : graphView.inoutPorts_)
+        {
+            inoutPorts.push_back(strings.ref(port.name));
+            inoutPorts.push_back(grhbIdRef(port.in));
+            inoutPorts.push_back(grhbIdRef(port.out));
+            inoutPorts.push_back(grhbIdRef(port.oe));
+        }
+
+        // All strings are known now; lay out the table.
+        std::vector<uint64_t> stringOffsets;
+        stringOffsets.reserve(strings.entries().size() + 1);
+        std::string stringBytes;
+        stringOffsets.push_back(0);
+        for (const std::string_view text : strings.entries())
+        {
+            stringBytes.append(text);
+            stringOffsets.push_back(stringBytes.size());
+        }
+
+        const std::array<uint32_t, kGrhbSectionCounts> counts{
+            grhbCount(symbols_.size(), "symbols"),
+            grhbCount(strings.entries().size() - symbols_.size(), "strings"),
+            grhbCount(declared.size(), "declared symbols"),
+            grhbCount(valueCount, "values"),
+            grhbCount(opCount, "operations"),
+            grhbCount(operands.size(), "operands"),
+            grhbCount(results.size(), "results"),
+            grhbCount(attrKeys.size(), "attrs"),
+            grhbCount(graphView.useList_.size(), "users"),
+            grhbCount(srcLocs.size() / kGrhbSrcLocFields, "srclocs"),
+            grhbCount(graphView.inputPorts_.size(), "input ports"),
+            grhbCount(graphView.outputPorts_.size(), "output ports"),
+            grhbCount(graphView.inoutPorts_.size(), "inout ports"),
+            0,
+            0,
+            0};
+
+        GrhbWriter writer(out);
+        for (const uint32_t count : counts)
+        {
+            writer.put<uint32_t>(count);
+        }
+        writer.put<uint64_t>(stringBytes.size());
+        writer.put<uint64_t>(attrEncoder.data().size());
+
+        writer.putArray(stringOffsets);
+        writer.putBytes(stringBytes);
+        writer.putArray(declared);
+
+        writer.putArray(valueSymbols);
+        writer.putArray(graphView.valueWidths_);
+        writer.putArray(graphView.valueSigned_);
+        writer.putArray(graphView.valueTypes_);
+        writer.putArray(graphView.valueIsInput_);
+        writer.putArray(graphView.valueIsOutput_);
+        writer.putArray(graphView.valueIsInout_);
+        writer.putArray(valueDefs);
+        writer.putArray(grhbOffsets(graphView.valueUserRanges_, "value user"));
+        writer.putArray(useList);
+        writer.putArray(valueSrcLocs);
+
+        writer.putArray(opKinds);
+        writer.putArray(opSymbols);
+        writer.putArray(grhbOffsets(graphView.opOperandRanges_, "operand"));
+        writer.putArray(operands);
+        writer.putArray(grhbOffsets(graphView.opResultRanges_, "result"));
+        writer.putArray(results);
+        writer.putArray(grhbOffsets(graphView.opAttrRanges_, "attr"));
+        writer.putArray(attrKeys);
+        writer.putArray(attrTypes);
+        writer.putArray(attrPayloads);
+        writer.putBytes(attrEncoder.data());
+        writer.putArray(opSrcLocs);
+        writer.putArray(srcLocs);
+
+        writer.putArray(inputPorts);
+        writer.putArray(outputPorts);
+        writer.putArray(inoutPorts);
+    }
+
+    void Graph::readBinary(std::string_view section)
+    {
+        if (builder_ || !view_ || !view_->values_.empty() || !view_->operations_.empty() || symbols_.size() != 0)
+        {
+            throw std::runtime_error("Graph::readBinary requires an empty graph: " + symbol_);
+        }
+
+        GrhbReader reader(section, symbol_);
+        std::array<uint32_t, kGrhbSectionCounts> counts{};
+        for (uint32_t &count : counts)
+        {
+            count = reader.get<uint32_t>();
+        }
+        const uint32_t symbolCount = counts[0];
+        const uint32_t extraStringCount = counts[1];
+        const uint32_t declaredCount = counts[2];
+        const uint32_t valueCount = counts[3];
+        const uint32_t opCount = counts[4];
+        const uint32_t operandCount = counts[5];
+        const uint32_t resultCount = counts[6];
+        const uint32_t attrCount = counts[7];
+        const uint32_t useCount = counts[8];
+        const uint32_t srcLocCount = counts[9];
+        const uint32_t inputPortCount = counts[10];
+        const uint32_t outputPortCount = counts[11];
+        const uint32_t inoutPortCount = counts[12];
+        const uint64_t stringBytesSize = reader.get<uint64_t>();
+        const uint64_t attrDataSize = reader.get<uint64_t>();
+
+        const std::size_t stringCount = static_cast<std::size_t>(symbolCount) + extraStringCount;
+        const GrhbArray<uint64_t> stringOffsets = reader.getArray<uint64_t>(stringCount + 1);
+        const std::string_view stringBytes = reader.getBytes(static_cast<std::size_t>(stringBytesSize));
+        if (stringOffsets[0] != 0 || stringOffsets[stringCount] != stringBytesSize)
+        {
+            reader.fail("string table offsets do not cover the string bytes");
+        }
+        auto stringAt = [&](uint32_t ref) -> std::string_view {
+            if (ref == 0)
+            {
+                return {};
+            }
+            if (ref > stringCount)
+            {
+                reader.fail("string reference out of range");
+            }
+            const uint64_t begin = stringOffsets[ref - 1];
+            const uint64_t end = stringOffsets[ref];
+            if (begin > end || end > stringBytesSize)
+            {
+                reader.fail("string table offsets are not monotonic");
+            }
+            return stringBytes.substr(static_cast<std::size_t>(begin), static_cast<std::size_t>(end - begin));
+        };
+
+        symbols_.reserve(symbolCount);
+        for (uint32_t i = 1; i <= symbolCount; ++i)
+        {
+            if (symbols_.intern(stringAt(i)).value != i)
+            {
+                reader.fail("duplicated symbol text");
+            }
+        }
+        auto symbolAt = [&](uint32_t value) -> SymbolId {
+            if (value > symbolCount)
+            {
+                reader.fail("symbol out of range");
+            }
+            return SymbolId{value};
+        };
+
+        const GrhbArray<uint32_t> declared = reader.getArray<uint32_t>(declaredCount);
+        reserveDeclaredSymbolCapacity(declaredCount);
+        for (std::size_t i = 0; i < declared.size(); ++i)
+        {
+            addDeclaredSymbol(symbolAt(declared[i]));
+        }
+
+        auto valueAt = [&](uint32_t ref) -> ValueId {
+            if (ref == 0 || ref > valueCount)
+            {
+                reader.fail("value reference out of range");
+            }
+            return ValueId{ref, 0, graphId_};
+        };
+        auto opAt = [&](uint32_t ref) -> OperationId {
+            if (ref > opCount)
+            {
+                reader.fail("operation reference out of range");
+            }
+            return ref == 0 ? OperationId::invalid() : OperationId{ref, 0, graphId_};
+        };
+        auto readRanges = [&](uint32_t rows, uint32_t total, std::vector<Range> &ranges) {
+            const GrhbArray<uint32_t> offsets = reader.getArray<uint32_t>(static_cast<std::size_t>(rows) + 1);
+            if (offsets[0] != 0 || offsets[rows] != total)
+            {
+                reader.fail("CSR offsets do not cover their array");
+            }
+            ranges.reserve(rows);
+            for (uint32_t i = 0; i < rows; ++i)
+            {
+                if (offsets[i] > offsets[i + 1])
+                {
+                    reader.fail("CSR offsets are not monotonic");
+                }
+                ranges.push_back(Range{offsets[i], offsets[i + 1] - offsets[i]});
+            }
+        };
+
+        const GrhbArray<uint32_t> valueSymbols = reader.getArray<uint32_t>(valueCount);
+        const GrhbArray<int32_t> valueWidths = reader.getArray<int32_t>(valueCount);
+        const GrhbArray<uint8_t> valueSigned = reader.getArray<uint8_t>(valueCount);
+        const GrhbArray<uint8_t> valueTypes = reader.getArray<uint8_t>(valueCount);
+        const GrhbArray<uint8_t> valueIsInput = reader.getArray<uint8_t>(valueCount);
+        const GrhbArray<uint8_t> valueIsOutput = reader.getArray<uint8_t>(valueCount);
+        const GrhbArray<uint8_t> valueIsInout = reader.getArray<uint8_t>(valueCount);
+        const GrhbArray<uint32_t> valueDefs = reader.getArray<uint32_t>(valueCount);
+
+        GraphView graphView;
+        graphView.graphId_ = graphId_;
+        readRanges(valueCount, useCount, graphView.valueUserRanges_);
+        const GrhbArray<uint32_t> useList = reader.getArray<uint32_t>(static_cast<std::size_t>(useCount) * 2);
+        const GrhbArray<uint32_t> valueSrcLocs = reader.getArray<uint32_t>(valueCount);
+
+        const GrhbArray<uint16_t> opKinds = reader.getArray<uint16_t>(opCount);
+        const GrhbArray<uint32_t> opSymbols = reader.getArray<uint32_t>(opCount);
+        readRanges(opCount, operandCount, graphView.opOperandRanges_);
+        const GrhbArray<uint32_t> operands = reader.getArray<uint32_t>(operandCount);
+        readRanges(opCount, resultCount, graphView.opResultRanges_);
+        const GrhbArray<uint32_t> results = reader.getArray<uint32_t>(resultCount);
+        readRanges(opCount, attrCount, graphView.opAttrRanges_);
+        const GrhbArray<uint32_t> attrKeys = reader.getArray<uint32_t>(attrCount);
+        const GrhbArray<uint8_t> attrTypes = reader.getArray<uint8_t>(attrCount);
+        const GrhbArray<uint64_t> attrPayloads = reader.getArray<uint64_t>(attrCount);
+        const std::string_view attrData = reader.getBytes(static_cast<std::size_t>(attrDataSize));
+        const GrhbArray<uint32_t> opSrcLocs = reader.getArray<uint32_t>(opCount);
+        const GrhbArray<uint32_t> srcLocs =
+            reader.getArray<uint32_t>(static_cast<std::size_t>(srcLocCount) * kGrhbSrcLocFields);
+
+        const GrhbArray<uint32_t> inputPorts = reader.getArray<uint32_t>(static_cast<std::size_t>(inputPortCount) * 2);
+        const GrhbArray<uint32_t> outputPorts = reader.getArray<uint32_t>(static_cast<std::size_t>(outputPortCount) * 2);
+        const GrhbArray<uint32_t> inoutPorts = reader.getArray<uint32_t>(static_cast<std::size_t>(inoutPortCount) * 4);
+
+        auto srcLocAt = [&](uint32_t ref) -> std::optional<SrcLoc> {
+            if (ref == 0)
+            {
+                return std::nullopt;
+            }
+            if (ref > srcLocCount)
+            {
+                reader.fail("srcloc reference out of range");
+            }
+            const std::size_t base = static_cast<std::size_t>(ref - 1) * kGrhbSrcLocFields;
+            SrcLoc loc;
+            loc.file = std::string(stringAt(srcLocs[base]));
+            loc.line = srcLocs[base + 1];
+            loc.column = srcLocs[base + 2];
+            loc.endLine = srcLocs[base + 3];
+            loc.endColumn = srcLocs[base + 4];
+            loc.origin = std::string(stringAt(srcLocs[base + 5]));
+            loc.pass = std::string(stringAt(srcLocs[base + 6]));
+            loc.note = std::string(stringAt(srcLocs[base + 7]));
+            return loc;
+        };
+        auto bindSymbol = [&](SymbolId sym, GraphView::SymbolKind kind, uint32_t index) {
+            if (!sym.valid())
+            {
+                return;
+            }
+            if (!graphView.symbolIndex_.emplace(sym.value, GraphView::SymbolBinding{kind, index}).second)
+            {
+                reader.fail("symbol bound twice");
+            }
+        };
+
+        // Plain per-value columns need no translation; reference columns are checked and turned
+        // into ids below.
+        valueWidths.copyTo(graphView.valueWidths_);
+        valueSigned.copyTo(graphView.valueSigned_);
+        valueTypes.copyTo(graphView.valueTypes_);
+        valueIsInput.copyTo(graphView.valueIsInput_);
+        valueIsOutput.copyTo(graphView.valueIsOutput_);
+        valueIsInout.copyTo(graphView.valueIsInout_);
+
+        graphView.symbolIndex_.reserve(static_cast<std::size_t>(valueCount) + opCount);
+        graphView.values_.reserve(valueCount);
+        graphView.valueSymbols_.reserve(valueCount);
+        graphView.valueDefs_.reserve(valueCount);
+        graphView.valueSrcLocs_.reserve(valueCount);
+        for (uint32_t i = 0; i < valueCount; ++i)
+        {
+            const ValueId id{i + 1, 0, graphId_};
+            const SymbolId sym = symbolAt(valueSymbols[i]);
+            if (graphView.valueTypes_[i] > static_cast<uint8_t>(ValueType::String))
+            {
+                reader.fail("unknown value type");
+            }
+            graphView.values_.push_back(id);
+            graphView.valueSymbols_.push_back(sym);
+            graphView.valueDefs_.push_back(opAt(valueDefs[i]));
+            graphView.valueSrcLocs_.push_back(srcLocAt(valueSrcLocs[i]));
+            bindSymbol(sym, GraphView::SymbolKind::kValue, id.index);
+        }
+        graphView.useList_.reserve(useCount);
+        for (uint32_t i = 0; i < useCount; ++i)
+        {
+            const OperationId user = opAt(useList[2 * static_cast<std::size_t>(i)]);
+            if (!user.valid())
+            {
+                reader.fail("value user refers to no operation");
+            }
+            graphView.useList_.push_back(ValueUser{user, useList[2 * static_cast<std::size_t>(i) + 1]});
+        }
+
+        graphView.operations_.reserve(opCount);
+        graphView.opKinds_.reserve(opCount);
+        graphView.opSymbols_.reserve(opCount);
+        graphView.opSrcLocs_.reserve(opCount);
+        for (uint32_t i = 0; i < opCount; ++i)
+        {
+            const OperationId id{i + 1, 0, graphId_};
+            if (opKinds[i] >= std::size(kOperationNames))
+            {
+                reader.fail("unknown operation kind");
+            }
+            const SymbolId sym = symbolAt(opSymbols[i]);
+            graphView.operations_.push_back(id);
+            graphView.opKinds_.push_back(static_cast<OperationKind>(opKinds[i]));
+            graphView.opSymbols_.push_back(sym);
+            graphView.opSrcLocs_.push_back(srcLocAt(opSrcLocs[i]));
+            bindSymbol(sym, GraphView::SymbolKind::kOperation, id.index);
+        }
+        graphView.operands_.reserve(operandCount);
+        for (std::size_t i = 0; i < operands.size(); ++i)
+        {
+            graphView.operands_.push_back(valueAt(operands[i]));
+        }
+        graphView.results_.reserve(resultCount);
+        for (std::size_t i = 0; i < results.size(); ++i)
+        {
+            graphView.results_.push_back(valueAt(results[i]));
+        }
+
+        graphView.opAttrs_.reserve(attrCount);
+        for (uint32_t i = 0; i < attrCount; ++i)
+        {
+            if (attrPayloads[i] > attrData.size())
+            {
+                reader.fail("attribute payload out of range");
+            }
+            GrhbReader payload(attrData.substr(static_cast<std::size_t>(attrPayloads[i])), symbol_);
+            AttrKV attr;
+            attr.key = std::string(stringAt(attrKeys[i]));
+            switch (attrTypes[i])
+            {
+            case 0:
+                attr.value = payload.get<uint8_t>() != 0;
+                break;
+            case 1:
+                attr.value = payload.get<int64_t>();
+                break;
+            case 2:
+                attr.value = payload.get<double>();
+                break;
+            case 3:
+                attr.value = std::string(stringAt(payload.get<uint32_t>()));
+                break;
+            case 4: {
+                const GrhbArray<uint8_t> entries = payload.getArray<uint8_t>(payload.get<uint64_t>());
+                std::vector<bool> values(entries.size());
+                for (std::size_t j = 0; j < entries.size(); ++j)
+                {
+                    values[j] = entries[j] != 0;
+                }
+                attr.value = std::move(values);
+                break;
+            }
+            case 5: {
+                const GrhbArray<int64_t> entries = payload.getArray<int64_t>(payload.get<uint64_t>());
+                std::vector<int64_t> values(entries.size());
+                for (std::size_t j = 0; j < entries.size(); ++j)
+                {
+                    values[j] = entries[j];
+                }
+                attr.value = std::move(values);
+                break;
+            }
+            case 6: {
+                const GrhbArray<double> entries = payload.getArray<double>(payload.get<uint64_t>());
+                std::vector<double> values(entries.size());
+                for (std::size_t j = 0; j < entries.size(); ++j)
+                {
+                    values[j] = entries[j];
+                }
+                attr.value = std::move(values);
+                break;
+            }
+            case 7: {
+                const GrhbArray<uint32_t> entries = payload.getArray<uint32_t>(payload.get<uint64_t>());
+                std::vector<std::string> values;
+                values.reserve(entries.size());
+                for (std::size_t j = 0; j < entries.size(); ++j)
+                {
+                    values.emplace_back(stringAt(entries[j]));
+                }
+                attr.value = std::move(values);
+                break;
+            }
+            default:
+                reader.fail("unknown attribute type");
+            }
+            graphView.opAttrs_.push_back(std::move(attr));
+        }
+
+        auto readPorts = [&](const GrhbArray<uint32_t> &refs, std::vector<Port> &ports) {
+            ports.reserve(refs.size() / 2);
+            for (std::size_t i = 0; i < refs.size(); i += 2)
+            {
+                ports.push_back(Port{std::string(stringAt(refs[i])), valueAt(refs[i + 1])});
+            }
+        };
+        readPorts(inputPorts, graphView.inputPorts_);
+        readPorts(outputPorts, graphView.outputPorts_);
+        graphView.inoutPorts_.reserve(inoutPortCount);
+        for (std::size_t i = 0; i < inoutPorts.size(); i += 4)
+        {
+            graphView.inoutPorts_.push_back(InoutPort{std::string(stringAt(inoutPorts[i])),
+                                                      valueAt(inoutPorts[i + 1]),
+                                                      valueAt(inoutPorts[i + 2]),
+                                                      valueAt(inoutPorts[i + 3])});
+        }
+
+        view_ = std::move(graphView);
+        invalidateCaches();
+    }
+
+    void Graph::rebindGraphId(GraphId graphId)
+    {
+        if (view_)
+        {
+            view_->rebindGraphId(graphId);
+        }
+        if (builder_)
+        {
+            builder_->rebindGraphId(graphId);
+        }
+        graphId_ = graphId;
+        invalidateCaches();
+    }
+
     void Graph::invalidateCaches() const
     {
         valuesCacheDirty_ = true;
@@ -4494,6 +5461,49 @@ namespace wolvrix::lib::grh
         return addGraphInternal(std::move(instance));
     }
 
+    std::unique_ptr<Graph> Design::createDetachedGraph(std::string symbol)
+    {
+        if (symbol.empty())
+        {
+            throw std::invalid_argument("Graph symbol must not be empty");
+        }
+        GraphId graphId = designSymbols_.reserveGraphId();
+        return std::make_unique<Graph>(*this, std::move(symbol), graphId);
+    }
+
+    std::unique_ptr<Graph> Design::createStagedGraph(std::string symbol)
+    {
+        if (symbol.empty())
+        {
+            throw std::invalid_argument("Graph symbol must not be empty");
+        }
+        GraphId graphId = designSymbols_.reserveStagedGraphId();
+        return std::make_unique<Graph>(*this, std::move(symbol), graphId);
+    }
+
+    Graph &Design::adoptGraph(std::unique_ptr<Graph> graph)
+    {
+        if (!graph)
+        {
+            throw std::invalid_argument("Cannot adopt a null graph");
+        }
+        if (graph->owner_ != this)
+        {
+            throw std::runtime_error("Cannot adopt graph created by another design: " + graph->symbol());
+        }
+        if (graphs_.contains(graph->symbol()))
+        {
+            throw std::runtime_error("Duplicated graph symbol: " + graph->symbol());
+        }
+        SymbolId graphSymbol = designSymbols_.intern(graph->symbol());
+        if (DesignSymbolTable::isStagedGraphId(graph->id()))
+        {
+            graph->rebindGraphId(designSymbols_.reserveGraphId());
+        }
+        designSymbols_.bindGraphId(graphSymbol, graph->id());
+        return addGraphInternal(std::move(graph));
+    }
+
     bool Design::deleteGraph(std::string_view name)
     {
         std::string key(name);
@@ -4518,6 +5528,17 @@ namespace wolvrix::lib::grh
             designSymbols_.releaseGraphId(declaredSymbol);
         }
 
+        if (auto it = graphs_.find(symbol); lazy_ && it != graphs_.end())
+        {
+            if (LazyGraphs::Entry *entry = lazy_->find(*it->second))
+            {
+                if (!entry->loaded.load(std::memory_order_acquire))
+                {
+                    lazy_->pending.fetch_sub(1, std::memory_order_relaxed);
+                }
+                lazy_->entries.erase(it->second.get());
+            }
+        }
         graphs_.erase(symbol);
         auto orderIt = std::remove(graphOrder_.begin(), graphOrder_.end(), symbol);
         if (orderIt != graphOrder_.end())
@@ -4572,30 +5593,84 @@ namespace wolvrix::lib::grh
         return clone;
     }
 
+    void Design::addLazyGraph(std::string symbol, std::shared_ptr<const LazyGraphSource> source, std::size_t slot)
+    {
+        if (!source)
+        {
+            throw std::invalid_argument("Lazy graph source must not be null");
+        }
+        Graph &graph = createGraph(std::move(symbol));
+        if (!lazy_)
+        {
+            lazy_ = std::make_unique<LazyGraphs>();
+        }
+        LazyGraphs::Entry &entry = lazy_->entries[&graph];
+        entry.source = std::move(source);
+        entry.slot = slot;
+        lazy_->pending.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void Design::ensureGraphLoaded(Graph &graph) const
+    {
+        if (!lazy_ || lazy_->pending.load(std::memory_order_acquire) == 0)
+        {
+            return;
+        }
+        LazyGraphs::Entry *entry = lazy_->find(graph);
+        if (!entry || entry->loaded.load(std::memory_order_acquire))
+        {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(entry->mutex);
+        if (entry->loaded.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+        entry->source->loadGraph(entry->slot, graph);
+        entry->loaded.store(true, std::memory_order_release);
+        lazy_->pending.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    const std::unordered_map<std::string, std::unique_ptr<Graph>> &Design::graphs() const
+    {
+        if (lazy_ && lazy_->pending.load(std::memory_order_acquire) != 0)
+        {
+            for (const auto &name : graphOrder_)
+            {
+                if (auto it = graphs_.find(name); it != graphs_.end())
+                {
+                    ensureGraphLoaded(*it->second);
+                }
+            }
+        }
+        return graphs_;
+    }
+
     Design Design::clone() const
     {
         Design cloned;
         for (const auto &name : graphOrder_)
         {
-            const Graph *source = findGraph(name);
+            Graph *source = lookupGraph(name);
             if (!source)
             {
                 throw std::runtime_error("Graph not found during design clone: " + name);
             }
+            if (LazyGraphs::Entry *entry = lazy_ ? lazy_->find(*source) : nullptr;
+                entry && !entry->loaded.load(std::memory_order_acquire))
+            {
+                cloned.addLazyGraph(name, entry->source, entry->slot);
+                continue;
+            }
             Graph &dest = cloned.createGraph(name);
             cloneGraphContents(*source, dest);
         }
 
         for (const auto &name : graphOrder_)
         {
-            Graph *dest = cloned.findGraph(name);
-            if (!dest)
-            {
-                throw std::runtime_error("Graph missing during design clone alias copy: " + name);
-            }
             for (const auto &alias : aliasesForGraph(name))
             {
-                cloned.registerGraphAlias(alias, *dest);
+                cloned.registerGraphAlias(alias, name);
             }
         }
 
@@ -4626,7 +5701,7 @@ namespace wolvrix::lib::grh
         return cloned;
     }
 
-    Graph *Design::findGraph(std::string_view symbol) noexcept
+    Graph *Design::lookupGraph(std::string_view symbol) const noexcept
     {
         std::string key(symbol);
         if (auto it = graphs_.find(key); it != graphs_.end())
@@ -4643,21 +5718,67 @@ namespace wolvrix::lib::grh
         return nullptr;
     }
 
-    const Graph *Design::findGraph(std::string_view symbol) const noexcept
+    Graph *Design::findGraph(std::string_view symbol)
     {
-        std::string key(symbol);
-        if (auto it = graphs_.find(key); it != graphs_.end())
+        Graph *graph = lookupGraph(symbol);
+        if (graph)
         {
-            return it->second.get();
+            ensureGraphLoaded(*graph);
         }
-        if (auto aliasIt = graphAliasBySymbol_.find(key); aliasIt != graphAliasBySymbol_.end())
+        return graph;
+    }
+
+    const Graph *Design::findGraph(std::string_view symbol) const
+    {
+        Graph *graph = lookupGraph(symbol);
+        if (graph)
         {
-            if (auto resolved = graphs_.find(aliasIt->second); resolved != graphs_.end())
+            ensureGraphLoaded(*graph);
+        }
+        return graph;
+    }
+
+    const Graph *Design::peekGraph(std::string_view symbol) const noexcept
+    {
+        return lookupGraph(symbol);
+    }
+
+    bool Design::isGraphLoaded(std::string_view symbol) const noexcept
+    {
+        const Graph *graph = lookupGraph(symbol);
+        if (!graph)
+        {
+            return false;
+        }
+        const LazyGraphs::Entry *entry = lazy_ ? lazy_->find(*graph) : nullptr;
+        return !entry || entry->loaded.load(std::memory_order_acquire);
+    }
+
+    void Design::prepareConcurrentReads() const
+    {
+        for (const auto &[symbol, graph] : graphs_)
+        {
+            const LazyGraphs::Entry *entry = lazy_ ? lazy_->find(*graph) : nullptr;
+            if (entry && !entry->loaded.load(std::memory_order_acquire))
             {
-                return resolved->second.get();
+                continue;
+            }
+            if (!graph->frozen())
+            {
+                graph->ensureCaches();
             }
         }
-        return nullptr;
+    }
+
+    std::optional<std::string_view> Design::unloadedGrhbSection(std::string_view symbol) const
+    {
+        const Graph *graph = lookupGraph(symbol);
+        const LazyGraphs::Entry *entry = graph && lazy_ ? lazy_->find(*graph) : nullptr;
+        if (!entry || entry->loaded.load(std::memory_order_acquire))
+        {
+            return std::nullopt;
+        }
+        return entry->source->grhbSection(entry->slot);
     }
 
     SymbolId Design::internSymbol(std::string_view text)
@@ -4762,9 +5883,23 @@ namespace wolvrix::lib::grh
         graphAliasBySymbol_[std::move(alias)] = graph.symbol();
     }
 
+    void Design::registerGraphAlias(std::string alias, std::string_view graphSymbol)
+    {
+        const Graph *graph = lookupGraph(graphSymbol);
+        if (!graph)
+        {
+            throw std::runtime_error("Cannot alias unknown graph: " + std::string(graphSymbol));
+        }
+        if (alias.empty())
+        {
+            return;
+        }
+        graphAliasBySymbol_[std::move(alias)] = graph->symbol();
+    }
+
     void Design::markAsTop(std::string_view graphSymbol)
     {
-        if (!findGraph(graphSymbol))
+        if (!lookupGraph(graphSymbol))
         {
             throw std::runtime_error("Cannot mark unknown graph as top: " + std::string(graphSymbol));
         }
@@ -4777,7 +5912,7 @@ namespace wolvrix::lib::grh
 
     void Design::unmarkAsTop(std::string_view graphSymbol)
     {
-        if (!findGraph(graphSymbol))
+        if (!lookupGraph(graphSymbol))
         {
             throw std::runtime_error("Cannot unmark unknown graph as top: " + std::string(graphSymbol));
         }
@@ -19,6 +19,7 @@
 #include "slang/ast/statements/MiscStatements.h"
 #include "slang/numeric/SVInt.h"
 #include "slang/numeric/ConstantValue.h"
+#include "slang/syntax/SyntaxNode.h"
 
 #include "slang/ast/symbols/AttributeSymbol.h"
 #include "slang/ast/symbols/BlockSymbols.h"
@@ -9128,8 +9129,36 @@ void collectInoutSignals(ModulePlan& plan)
     }
 }
 
+// Planning cost proxy: size of the module declaration in source bytes. Bodies
+// without syntax (e.g. synthesized ones) sort behind everything with a size.
+uint64_t estimatePlanCost(const slang::ast::InstanceBodySymbol& body)
+{
+    const slang::syntax::SyntaxNode* syntax = body.getDefinition().getSyntax();
+    if (!syntax)
+    {
+        return 0;
+    }
+    const slang::SourceRange range = syntax->sourceRange();
+    const uint64_t begin = range.start().offset();
+    const uint64_t end = range.end().offset();
+    return end > begin ? end - begin : 0;
+}
+
+const ParamSignature* internParamSignature(ConvertContext& context, std::string_view text)
+{
+    if (text.empty())
+    {
+        return nullptr;
+    }
+    if (!context.paramSignatures)
+    {
+        throw std::logic_error("ConvertContext has no parameter signature table");
+    }
+    return context.paramSignatures->intern(text);
+}
+
 void enqueuePlanKey(ConvertContext& context, const slang::ast::InstanceBodySymbol& body,
-                    std::string paramSignature = {})
+                    const ParamSignature* paramSignature = nullptr)
 {
     if (!context.planQueue)
     {
@@ -9142,7 +9171,7 @@ void enqueuePlanKey(ConvertContext& context, const slang::ast::InstanceBodySymbo
     PlanKey key;
     key.definition = &body.getDefinition();
     key.body = &body;
-    key.paramSignature = std::move(paramSignature);
+    key.paramSignature = paramSignature;
     if (context.instanceRegistry && !context.instanceRegistry->trySchedule(key))
     {
         return;
@@ -9151,7 +9180,8 @@ void enqueuePlanKey(ConvertContext& context, const slang::ast::InstanceBodySymbo
     {
         context.taskCounter->fetch_add(1, std::memory_order_relaxed);
     }
-    if (!context.planQueue->tryPush(std::move(key)) && context.taskCounter)
+    if (!context.planQueue->tryPush(std::move(key), estimatePlanCost(body)) &&
+        context.taskCounter)
     {
         context.taskCounter->fetch_sub(1, std::memory_order_relaxed);
     }
@@ -9183,10 +9213,11 @@ void collectInstance(const slang::ast::InstanceSymbol& instance, ModulePlan& pla
     {
         info.parameters = std::move(params.parameters);
     }
-    info.paramSignature = params.signature;
+    info.paramSignature = internParamSignature(context, params.signature);
+    const ParamSignature* paramSignature = info.paramSignature;
     plan.instances.push_back(std::move(info));
 
-    enqueuePlanKey(context, body, std::move(params.signature));
+    enqueuePlanKey(context, body, paramSignature);
 }
 
 void collectInstanceArray(const slang::ast::InstanceArraySymbol& array, ModulePlan& plan,
@@ -9396,6 +9427,58 @@ void ConvertDiagnostics::warn(const slang::SourceLocation& location, std::string
         location.valid() ? std::optional(location) : std::nullopt);
 }
 
+uint64_t ParamSignatureTable::fingerprint(std::string_view text) noexcept
+{
+    // FNV-1a, 64-bit: stable across runs so fingerprints can be compared in logs.
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (const char ch : text)
+    {
+        hash ^= static_cast<unsigned char>(ch);
+        hash *= 0x100000001b3ULL;
+    }
+    return hash == 0 ? 1 : hash;
+}
+
+const ParamSignature* ParamSignatureTable::intern(std::string_view text)
+{
+    if (text.empty())
+    {
+        return nullptr;
+    }
+    const uint64_t hash = fingerprint(text);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& bucket = buckets_[hash];
+    for (const auto& entry : bucket)
+    {
+        if (entry->text == text)
+        {
+            return entry.get();
+        }
+    }
+    if (!bucket.empty())
+    {
+        ++collisions_;
+    }
+    auto entry = std::make_unique<ParamSignature>();
+    entry->fingerprint = hash;
+    entry->text = std::string(text);
+    bucket.push_back(std::move(entry));
+    ++size_;
+    return bucket.back().get();
+}
+
+std::size_t ParamSignatureTable::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return size_;
+}
+
+std::size_t ParamSignatureTable::collisions() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return collisions_;
+}
+
 bool PlanCache::tryClaim(const PlanKey& key)
 {
     std::lock_guard<std::mutex> lock(mutex_);
@@ -9451,6 +9534,15 @@ void PlanCache::storePlan(const PlanKey& key, ModulePlan plan)
     entry.plan = std::move(plan);
 }
 
+void PlanCache::markDone(const PlanKey& key)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    PlanEntry& entry = entries_[key];
+    entry.status = PlanStatus::Done;
+    entry.plan.reset();
+    entry.artifacts = PlanArtifacts{};
+}
+
 void PlanCache::markFailed(const PlanKey& key)
 {
     std::lock_guard<std::mutex> lock(mutex_);
@@ -9583,32 +9675,40 @@ bool PlanCache::withWriteBackPlanMut(const PlanKey& key,
     return true;
 }
 
-void PlanTaskQueue::push(PlanKey key)
+void PlanTaskQueue::push(PlanKey key, uint64_t cost)
 {
-    (void)tryPush(std::move(key));
+    (void)tryPush(std::move(key), cost);
 }
 
-bool PlanTaskQueue::tryPush(PlanKey key)
+bool PlanTaskQueue::tryPush(PlanKey key, uint64_t cost)
 {
     std::lock_guard<std::mutex> lock(mutex_);
     if (closed_)
     {
         return false;
     }
-    queue_.push_back(std::move(key));
+    heap_.push_back(Task{std::move(key), cost, nextSequence_++});
+    std::push_heap(heap_.begin(), heap_.end(), TaskOrder{});
     cv_.notify_one();
     return true;
 }
 
+PlanKey PlanTaskQueue::popLocked()
+{
+    std::pop_heap(heap_.begin(), heap_.end(), TaskOrder{});
+    PlanKey key = std::move(heap_.back().key);
+    heap_.pop_back();
+    return key;
+}
+
 bool PlanTaskQueue::tryPop(PlanKey& out)
 {
     std::lock_guard<std::mutex> lock(mutex_);
-    if (queue_.empty())
+    if (heap_.empty())
     {
         return false;
     }
-    out = std::move(queue_.front());
-    queue_.pop_front();
+    out = popLocked();
     return true;
 }
 
@@ -9620,18 +9720,17 @@ bool PlanTaskQueue::waitPop(PlanKey& out, const std::atomic<bool>* cancelFlag)
         {
             return true;
         }
-        return closed_ || !queue_.empty();
+        return closed_ || !heap_.empty();
     });
     if (cancelFlag && cancelFlag->load(std::memory_order_relaxed))
     {
         return false;
     }
-    if (queue_.empty())
+    if (heap_.empty())
     {
         return false;
     }
-    out = std::move(queue_.front());
-    queue_.pop_front();
+    out = popLocked();
     return true;
 }
 
@@ -9645,8 +9744,8 @@ void PlanTaskQueue::close()
 std::size_t PlanTaskQueue::drain()
 {
     std::lock_guard<std::mutex> lock(mutex_);
-    const std::size_t dropped = queue_.size();
-    queue_.clear();
+    const std::size_t dropped = heap_.size();
+    heap_.clear();
     cv_.notify_all();
     return dropped;
 }
@@ -9660,13 +9759,14 @@ bool PlanTaskQueue::closed() const noexcept
 std::size_t PlanTaskQueue::size() const
 {
     std::lock_guard<std::mutex> lock(mutex_);
-    return queue_.size();
+    return heap_.size();
 }
 
 void PlanTaskQueue::reset()
 {
     std::lock_guard<std::mutex> lock(mutex_);
-    queue_.clear();
+    heap_.clear();
+    nextSequence_ = 0;
     closed_ = false;
     cv_.notify_all();
 }
@@ -16776,10 +16876,10 @@ const std::string& GraphAssembler::resolveGraphName(const PlanKey& key,
 
     std::string base = moduleName.empty() ? std::string("convert_graph") : std::string(moduleName);
     std::string candidate = base;
-    if (!key.paramSignature.empty())
+    if (key.paramSignature)
     {
         const std::string suffix =
-            buildReadableParamSuffix(key.paramSignature, base);
+            buildReadableParamSuffix(key.paramText(), base);
         candidate = suffix.empty() ? base : base + suffix;
     }
     std::string finalName = candidate;
@@ -16803,21 +16903,93 @@ wolvrix::lib::grh::Graph& GraphAssembler::build(const PlanKey& key, const Module
         moduleName = std::string(plan.symbolTable.text(plan.moduleSymbol));
     }
     const std::string& finalSymbol = resolveGraphName(key, moduleName);
-    wolvrix::lib::grh::Graph* graph = nullptr;
-    if (designMutex_)
+    StagedGraph staged;
+    staged.graph = design_.createStagedGraph(std::string(finalSymbol));
+    staged.children.reserve(plan.instances.size());
+    for (const InstanceInfo& instanceInfo : plan.instances)
     {
-        std::lock_guard<std::mutex> lock(*designMutex_);
-        graph = &design_.createGraph(std::string(finalSymbol));
-        design_.addDeclaredSymbol(design_.internSymbol(finalSymbol));
+        if (!instanceInfo.instance)
+        {
+            continue;
+        }
+        PlanKey childKey;
+        childKey.definition = &instanceInfo.instance->body.getDefinition();
+        childKey.body = &instanceInfo.instance->body;
+        childKey.paramSignature = instanceInfo.paramSignature;
+        staged.children.push_back(std::move(childKey));
     }
-    else
+
+    wolvrix::lib::grh::Graph& graph = *staged.graph;
+    GraphAssemblyState state(context_, *this, graph, plan, lowering, writeBack);
+    state.build();
+
+    std::lock_guard<std::mutex> lock(stagedMutex_);
+    stagedGraphs_.insert_or_assign(key, std::move(staged));
+    return graph;
+}
+
+std::size_t GraphAssembler::commitGraphs(const std::vector<PlanKey>& roots)
+{
+    std::lock_guard<std::mutex> lock(stagedMutex_);
+    std::vector<const PlanKey*> order;
+    order.reserve(stagedGraphs_.size());
+    std::unordered_set<PlanKey, PlanKeyHash> visited;
+    visited.reserve(stagedGraphs_.size());
+    std::deque<const PlanKey*> pending;
+    for (const PlanKey& root : roots)
+    {
+        if (visited.insert(root).second)
+        {
+            pending.push_back(&root);
+        }
+    }
+    while (!pending.empty())
     {
-        graph = &design_.createGraph(std::string(finalSymbol));
-        design_.addDeclaredSymbol(design_.internSymbol(finalSymbol));
+        const PlanKey* key = pending.front();
+        pending.pop_front();
+        auto it = stagedGraphs_.find(*key);
+        if (it == stagedGraphs_.end())
+        {
+            continue;
+        }
+        order.push_back(&it->first);
+        for (const PlanKey& child : it->second.children)
+        {
+            if (visited.insert(child).second)
+            {
+                pending.push_back(&child);
+            }
+        }
     }
-    GraphAssemblyState state(context_, *this, *graph, plan, lowering, writeBack);
-    state.build();
-    return *graph;
+
+    // Anything unreachable from the roots still lands in the design, in name order.
+    std::vector<const PlanKey*> orphans;
+    for (const auto& [key, staged] : stagedGraphs_)
+    {
+        if (!visited.contains(key))
+        {
+            orphans.push_back(&key);
+        }
+    }
+    std::sort(orphans.begin(), orphans.end(), [&](const PlanKey* lhs, const PlanKey* rhs) {
+        return stagedGraphs_.at(*lhs).graph->symbol() < stagedGraphs_.at(*rhs).graph->symbol();
+    });
+    order.insert(order.end(), orphans.begin(), orphans.end());
+
+    std::size_t committed = 0;
+    for (const PlanKey* key : order)
+    {
+        StagedGraph& staged = stagedGraphs_.at(*key);
+        if (!staged.graph)
+        {
+            continue;
+        }
+        wolvrix::lib::grh::Graph& graph = design_.adoptGraph(std::move(staged.graph));
+        design_.addDeclaredSymbol(design_.internSymbol(graph.symbol()));
+        ++committed;
+    }
+    stagedGraphs_.clear();
+    return committed;
 }
 
 namespace {
@@ -16962,7 +17134,7 @@ TopGraphInfo collectTopInstances(const slang::ast::RootSymbol& root, ConvertCont
         PlanKey topKey;
         topKey.definition = &topInstance->body.getDefinition();
         topKey.body = &topInstance->body;
-        topKey.paramSignature = params.signature;
+        topKey.paramSignature = internParamSignature(context, params.signature);
         if (seen.insert(topKey).second)
         {
             info.order.push_back(topKey);
@@ -16985,7 +17157,7 @@ TopGraphInfo collectTopInstances(const slang::ast::RootSymbol& root, ConvertCont
         {
             info.moduleNames.emplace(topKey, std::string(topInstance->name));
         }
-        enqueuePlanKey(context, topInstance->body, std::move(params.signature));
+        enqueuePlanKey(context, topInstance->body, topKey.paramSignature);
     }
 
     return info;
@@ -17074,9 +17246,9 @@ void processPlanKey(PlanKey key, ConvertContext& context, PlanCache& planCache,
                   "pass4-assembly", moduleName,
                   assemblyEnd - assemblyStart);
 
-    planCache.setLoweringPlan(key, std::move(lowering));
-    planCache.setWriteBackPlan(key, std::move(writeBackPlan));
-    planCache.storePlan(key, std::move(plan));
+    // A key is claimed and assembled exactly once; every other instance of it only
+    // needs the graph name, so the plans die here instead of living in the cache.
+    planCache.markDone(key);
     markInstanceReady(context, key);
 }
 
@@ -17099,16 +17271,40 @@ void runPlanQueueSerial(PlanTaskQueue& queue, ConvertDiagnostics* diagnostics,
     }
 }
 
+void logQueueIdle(Logger* logger, bool timingEnabled, std::size_t workers,
+                  ConvertClock::duration waitTotal, ConvertClock::duration tailTotal,
+                  ConvertClock::duration wall)
+{
+    if (!timingEnabled || !logger || !logger->enabled(LogLevel::Trace, "timing"))
+    {
+        return;
+    }
+    std::string message = "pass1-4-plan-queue idle workers=" + std::to_string(workers);
+    message.append(" wait=");
+    message.append(formatDuration(waitTotal));
+    message.append(" tail=");
+    message.append(formatDuration(tailTotal));
+    message.append(" wall=");
+    message.append(formatDuration(wall));
+    logger->log(LogLevel::Trace, "timing", message);
+}
+
 template <typename Processor>
 void runPlanQueueParallel(PlanTaskQueue& queue, std::size_t threadCount,
                           ConvertParallelState& state, ConvertDiagnostics* diagnostics,
                           AbortState* abortState, Processor&& processKey,
-                          bool abortOnError)
+                          bool abortOnError, Logger* logger, bool timingEnabled)
 {
     threadCount = std::max<std::size_t>(1, threadCount);
     std::vector<std::thread> threads;
     threads.reserve(threadCount);
 
+    // Per-worker time blocked in waitPop and the end of its last task; the gap between
+    // the last task and the run's end is the tail idle time cost-aware ordering targets.
+    const auto runStart = ConvertClock::now();
+    std::vector<ConvertClock::duration> waitTimes(threadCount, ConvertClock::duration::zero());
+    std::vector<ConvertClock::time_point> lastBusyEnd(threadCount, runStart);
+
     auto finishTask = [&]() {
         const std::size_t prev = state.pending.fetch_sub(1, std::memory_order_relaxed);
         if (prev <= 1)
@@ -17119,10 +17315,12 @@ void runPlanQueueParallel(PlanTaskQueue& queue, std::size_t threadCount,
         }
     };
 
-    auto worker = [&]() {
+    auto worker = [&](std::size_t workerIndex) {
         PlanKey key;
+        auto waitStart = ConvertClock::now();
         while (queue.waitPop(key, &state.cancel))
         {
+            waitTimes[workerIndex] += ConvertClock::now() - waitStart;
             try
             {
                 if (!state.cancel.load(std::memory_order_relaxed))
@@ -17154,8 +17352,11 @@ void runPlanQueueParallel(PlanTaskQueue& queue, std::size_t threadCount,
             {
                 diagnostics->flushThreadLocal();
             }
+            lastBusyEnd[workerIndex] = ConvertClock::now();
+            waitStart = lastBusyEnd[workerIndex];
             finishTask();
         }
+        waitTimes[workerIndex] += ConvertClock::now() - waitStart;
     };
 
     if (state.pending.load(std::memory_order_relaxed) == 0)
@@ -17165,7 +17366,7 @@ void runPlanQueueParallel(PlanTaskQueue& queue, std::size_t threadCount,
 
     for (std::size_t i = 0; i < threadCount; ++i)
     {
-        threads.emplace_back(worker);
+        threads.emplace_back(worker, i);
     }
 
     {
@@ -17180,6 +17381,15 @@ void runPlanQueueParallel(PlanTaskQueue& queue, std::size_t threadCount,
     {
         thread.join();
     }
+    const auto runEnd = ConvertClock::now();
+    ConvertClock::duration waitTotal = ConvertClock::duration::zero();
+    ConvertClock::duration tailTotal = ConvertClock::duration::zero();
+    for (std::size_t i = 0; i < threadCount; ++i)
+    {
+        waitTotal += waitTimes[i];
+        tailTotal += runEnd - lastBusyEnd[i];
+    }
+    logQueueIdle(logger, timingEnabled, threadCount, waitTotal, tailTotal, runEnd - runStart);
     if (diagnostics)
     {
         diagnostics->flushThreadLocal();
@@ -17191,8 +17401,7 @@ void runPlanQueueParallel(PlanTaskQueue& queue, std::size_t threadCount,
 }
 
 void finalizeTopGraphs(wolvrix::lib::grh::Design& design, GraphAssembler& graphAssembler,
-                       const TopGraphInfo& info, ConvertContext& context,
-                       std::mutex& designMutex)
+                       const TopGraphInfo& info, ConvertContext& context)
 {
     for (const PlanKey& topKey : info.order)
     {
@@ -17213,10 +17422,7 @@ void finalizeTopGraphs(wolvrix::lib::grh::Design& design, GraphAssembler& graphA
             }
             continue;
         }
-        {
-            std::lock_guard<std::mutex> lock(designMutex);
-            design.markAsTop(graph->symbol());
-        }
+        design.markAsTop(graph->symbol());
         auto aliasIt = info.aliases.find(topKey);
         if (aliasIt == info.aliases.end())
         {
@@ -17239,7 +17445,6 @@ void finalizeTopGraphs(wolvrix::lib::grh::Design& design, GraphAssembler& graphA
                 }
                 continue;
             }
-            std::lock_guard<std::mutex> lock(designMutex);
             design.registerGraphAlias(alias, *graph);
         }
     }
@@ -17263,6 +17468,9 @@ wolvrix::lib::grh::Design ConvertDriver::convert(const slang::ast::RootSymbol& r
 
     planCache_.clear();
     planQueue_.reset();
+    // Signatures interned by the previous convert are only referenced from its plans, which
+    // were just dropped.
+    paramSignatures_ = std::make_shared<ParamSignatureTable>();
 
     ConvertContext context{};
     context.compilation = &root.getCompilation();
@@ -17274,6 +17482,7 @@ wolvrix::lib::grh::Design ConvertDriver::convert(const slang::ast::RootSymbol& r
     context.planQueue = &planQueue_;
     InstanceRegistry instanceRegistry;
     context.instanceRegistry = &instanceRegistry;
+    context.paramSignatures = paramSignatures_;
 
     const bool useParallel = !options_.singleThread && options_.threadCount > 1;
     if (useParallel)
@@ -17287,8 +17496,7 @@ wolvrix::lib::grh::Design ConvertDriver::convert(const slang::ast::RootSymbol& r
         configureAbortHandler(diagnostics_, useParallel, options_.abortOnError,
                               planQueue_, parallel);
 
-    std::mutex designMutex;
-    GraphAssembler graphAssembler(context, design, &designMutex);
+    GraphAssembler graphAssembler(context, design);
     TopGraphInfo topInfo = collectTopInstances(root, context);
 
     auto processKey = [&](PlanKey key) {
@@ -17299,14 +17507,22 @@ wolvrix::lib::grh::Design ConvertDriver::convert(const slang::ast::RootSymbol& r
     {
         runPlanQueueParallel(planQueue_, static_cast<std::size_t>(options_.threadCount),
                              parallel, &diagnostics_, abortState.get(), processKey,
-                             options_.abortOnError);
+                             options_.abortOnError, context.logger,
+                             context.options.enableTiming);
     }
     else
     {
         runPlanQueueSerial(planQueue_, &diagnostics_, processKey);
     }
 
-    finalizeTopGraphs(design, graphAssembler, topInfo, context, designMutex);
+    logPassStart(context.logger, context.options.enableTiming, "pass5-graph-commit", {});
+    const auto commitStart = ConvertClock::now();
+    graphAssembler.commitGraphs(topInfo.order);
+    const auto commitEnd = ConvertClock::now();
+    logPassTiming(context.logger, context.options.enableTiming,
+                  "pass5-graph-commit", {}, commitEnd - commitStart);
+
+    finalizeTopGraphs(design, graphAssembler, topInfo, context);
     return design;
 }
 
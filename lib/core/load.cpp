@@ -1,26 +1,36 @@
 #include "core/load.hpp"
+#include "core/json_cursor.hpp"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cctype>
 #include <charconv>
 #include <chrono>
 #include <cmath>
 #include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <memory>
 #include <iomanip>
 #include <iostream>
-#include <map>
 #include <optional>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <string_view>
 #include <system_error>
-#include <unordered_map>
+#include <thread>
 #include <unordered_set>
 #include <utility>
-#include <variant>
 #include <vector>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 namespace wolvrix::lib::load
 {
 
@@ -105,459 +115,44 @@ namespace wolvrix::lib::load
             StringArray
         };
 
-        struct JsonValue
+        // Field spans captured from one object; the first occurrence of a key wins, which
+        // matches how the loader has always treated duplicate keys.
+        template <std::size_t N>
+        struct ObjectFields
         {
-            using Array = std::vector<JsonValue>;
-            using Object = std::map<std::string, JsonValue, std::less<>>;
-
-            std::variant<std::nullptr_t, bool, int64_t, double, std::string, Array, Object> value;
-
-            bool isNull() const { return std::holds_alternative<std::nullptr_t>(value); }
-            bool isBool() const { return std::holds_alternative<bool>(value); }
-            bool isInt() const { return std::holds_alternative<int64_t>(value); }
-            bool isDouble() const { return std::holds_alternative<double>(value); }
-            bool isString() const { return std::holds_alternative<std::string>(value); }
-            bool isArray() const { return std::holds_alternative<Array>(value); }
-            bool isObject() const { return std::holds_alternative<Object>(value); }
-
-            bool asBool(std::string_view ctx) const
-            {
-                if (!isBool())
-                {
-                    throw std::runtime_error(std::string(ctx) + ": expected bool");
-                }
-                return std::get<bool>(value);
-            }
-
-            int64_t asInt(std::string_view ctx) const
-            {
-                if (isInt())
-                {
-                    return std::get<int64_t>(value);
-                }
-                if (isDouble())
-                {
-                    double v = std::get<double>(value);
-                    if (std::trunc(v) != v)
-                    {
-                        throw std::runtime_error(std::string(ctx) + ": expected integer number");
-                    }
-                    return static_cast<int64_t>(v);
-                }
-                throw std::runtime_error(std::string(ctx) + ": expected integer");
-            }
-
-            double asDouble(std::string_view ctx) const
-            {
-                if (isDouble())
-                {
-                    return std::get<double>(value);
-                }
-                if (isInt())
-                {
-                    return static_cast<double>(std::get<int64_t>(value));
-                }
-                throw std::runtime_error(std::string(ctx) + ": expected number");
-            }
-
-            const std::string &asString(std::string_view ctx) const
-            {
-                if (!isString())
-                {
-                    throw std::runtime_error(std::string(ctx) + ": expected string");
-                }
-                return std::get<std::string>(value);
-            }
-
-            const Array &asArray(std::string_view ctx) const
-            {
-                if (!isArray())
-                {
-                    throw std::runtime_error(std::string(ctx) + ": expected array");
-                }
-                return std::get<Array>(value);
-            }
+            std::array<std::string_view, N> spans{};
+            std::array<std::size_t, N> counts{};
 
-            const Object &asObject(std::string_view ctx) const
-            {
-                if (!isObject())
-                {
-                    throw std::runtime_error(std::string(ctx) + ": expected object");
-                }
-                return std::get<Object>(value);
-            }
+            bool has(std::size_t index) const { return spans[index].data() != nullptr; }
         };
 
-        class JsonParser
+        template <std::size_t N>
+        ObjectFields<N> captureFields(JsonCursor &cursor, std::string_view ctx,
+                                      const std::array<std::string_view, N> &names)
         {
-        public:
-            explicit JsonParser(std::string_view text) : text_(text), current_(text_.data()), end_(text_.data() + text_.size()) {}
-
-            JsonValue parse()
-            {
-                skipWhitespace();
-                JsonValue value = parseValue();
-                skipWhitespace();
-                if (current_ != end_)
-                {
-                    throw std::runtime_error("Trailing characters after JSON document");
-                }
-                return value;
-            }
-
-        private:
-            JsonValue parseValue()
-            {
-                if (current_ == end_)
-                {
-                    throw std::runtime_error("Unexpected end of JSON input");
-                }
-
-                switch (*current_)
-                {
-                case '{':
-                    return parseObject();
-                case '[':
-                    return parseArray();
-                case '"':
-                    return JsonValue{parseString()};
-                case 't':
-                    return JsonValue{parseLiteral("true", true)};
-                case 'f':
-                    return JsonValue{parseLiteral("false", false)};
-                case 'n':
-                    parseLiteral("null");
-                    return JsonValue{std::nullptr_t{}};
-                default:
-                    if (*current_ == '-' || std::isdigit(static_cast<unsigned char>(*current_)))
-                    {
-                        return parseNumber();
-                    }
-                    break;
-                }
-
-                throw std::runtime_error("Invalid JSON value");
-            }
-
-            JsonValue parseObject()
-            {
-                JsonValue::Object obj;
-                expect('{');
-                skipWhitespace();
-                if (consume('}'))
-                {
-                    return JsonValue{std::move(obj)};
-                }
-
-                while (true)
-                {
-                    skipWhitespace();
-                    std::string key = parseString();
-                    skipWhitespace();
-                    expect(':');
-                    skipWhitespace();
-                    obj.emplace(std::move(key), parseValue());
-                    skipWhitespace();
-                    if (consume('}'))
-                    {
-                        break;
-                    }
-                    expect(',');
-                }
-
-                return JsonValue{std::move(obj)};
-            }
-
-            JsonValue parseArray()
-            {
-                JsonValue::Array arr;
-                expect('[');
-                skipWhitespace();
-                if (consume(']'))
-                {
-                    return JsonValue{std::move(arr)};
-                }
-
-                while (true)
-                {
-                    skipWhitespace();
-                    arr.push_back(parseValue());
-                    skipWhitespace();
-                    if (consume(']'))
-                    {
-                        break;
-                    }
-                    expect(',');
-                }
-
-                return JsonValue{std::move(arr)};
-            }
-
-            JsonValue parseNumber()
-            {
-                const char *start = current_;
-                if (*current_ == '-')
-                {
-                    ++current_;
-                }
-                if (current_ == end_)
-                {
-                    throw std::runtime_error("Invalid JSON number");
-                }
-                if (*current_ == '0')
-                {
-                    ++current_;
-                }
-                else
-                {
-                    if (!std::isdigit(static_cast<unsigned char>(*current_)))
-                    {
-                        throw std::runtime_error("Invalid JSON number");
-                    }
-                    while (current_ != end_ && std::isdigit(static_cast<unsigned char>(*current_)))
-                    {
-                        ++current_;
-                    }
-                }
-
-                bool isFloat = false;
-                if (current_ != end_ && *current_ == '.')
-                {
-                    isFloat = true;
-                    ++current_;
-                    if (current_ == end_ || !std::isdigit(static_cast<unsigned char>(*current_)))
-                    {
-                        throw std::runtime_error("Invalid JSON number");
-                    }
-                    while (current_ != end_ && std::isdigit(static_cast<unsigned char>(*current_)))
-                    {
-                        ++current_;
-                    }
-                }
-
-                if (current_ != end_ && (*current_ == 'e' || *current_ == 'E'))
-                {
-                    isFloat = true;
-                    ++current_;
-                    if (current_ != end_ && (*current_ == '+' || *current_ == '-'))
-                    {
-                        ++current_;
-                    }
-                    if (current_ == end_ || !std::isdigit(static_cast<unsigned char>(*current_)))
-                    {
-                        throw std::runtime_error("Invalid JSON number");
-                    }
-                    while (current_ != end_ && std::isdigit(static_cast<unsigned char>(*current_)))
-                    {
-                        ++current_;
-                    }
-                }
-
-                std::string_view numberView(start, static_cast<std::size_t>(current_ - start));
-                if (isFloat)
-                {
-                    double value = 0.0;
-                    auto [ptr, ec] = std::from_chars(numberView.data(), numberView.data() + numberView.size(), value);
-                    if (ec != std::errc())
-                    {
-                        value = std::stod(std::string(numberView));
-                    }
-                    return JsonValue{value};
-                }
-
-                int64_t intValue = 0;
-                auto [ptr, ec] = std::from_chars(numberView.data(), numberView.data() + numberView.size(), intValue);
-                if (ec != std::errc())
-                {
-                    intValue = std::stoll(std::string(numberView));
-                }
-                return JsonValue{intValue};
-            }
-
-            std::string parseString()
+            ObjectFields<N> fields;
+            std::string keyScratch;
+            std::string_view key;
+            cursor.beginObject(ctx);
+            while (cursor.nextKey(key, keyScratch))
             {
-                expect('"');
-                const char *segmentStart = current_;
-                while (current_ != end_)
+                std::size_t index = N;
+                for (std::size_t i = 0; i < N; ++i)
                 {
-                    const char ch = *current_;
-                    if (ch == '"')
-                    {
-                        std::string result(segmentStart, static_cast<std::size_t>(current_ - segmentStart));
-                        ++current_;
-                        return result;
-                    }
-                    if (ch == '\\')
+                    if (names[i] == key)
                     {
+                        index = i;
                         break;
                     }
-                    if (static_cast<unsigned char>(ch) < 0x20)
-                    {
-                        throw std::runtime_error("Invalid control character in string");
-                    }
-                    ++current_;
-                }
-
-                std::string result;
-                result.reserve(static_cast<std::size_t>(current_ - segmentStart) + 8);
-                result.append(segmentStart, static_cast<std::size_t>(current_ - segmentStart));
-                while (current_ != end_)
-                {
-                    char ch = *current_++;
-                    if (ch == '"')
-                    {
-                        return result;
-                    }
-                    if (ch == '\\')
-                    {
-                        if (current_ == end_)
-                        {
-                            throw std::runtime_error("Invalid escape sequence");
-                        }
-
-                        char esc = *current_++;
-                        switch (esc)
-                        {
-                        case '"':
-                        case '\\':
-                        case '/':
-                            result.push_back(esc);
-                            break;
-                        case 'b':
-                            result.push_back('\b');
-                            break;
-                        case 'f':
-                            result.push_back('\f');
-                            break;
-                        case 'n':
-                            result.push_back('\n');
-                            break;
-                        case 'r':
-                            result.push_back('\r');
-                            break;
-                        case 't':
-                            result.push_back('\t');
-                            break;
-                        case 'u':
-                        {
-                            if (end_ - current_ < 4)
-                            {
-                                throw std::runtime_error("Invalid unicode escape");
-                            }
-                            unsigned value = 0;
-                            for (int i = 0; i < 4; ++i)
-                            {
-                                char hex = *current_++;
-                                value <<= 4;
-                                if (hex >= '0' && hex <= '9')
-                                {
-                                    value |= static_cast<unsigned>(hex - '0');
-                                }
-                                else if (hex >= 'a' && hex <= 'f')
-                                {
-                                    value |= static_cast<unsigned>(hex - 'a' + 10);
-                                }
-                                else if (hex >= 'A' && hex <= 'F')
-                                {
-                                    value |= static_cast<unsigned>(hex - 'A' + 10);
-                                }
-                                else
-                                {
-                                    throw std::runtime_error("Invalid unicode escape");
-                                }
-                            }
-                            if (value <= 0x7F)
-                            {
-                                result.push_back(static_cast<char>(value));
-                            }
-                            else if (value <= 0x7FF)
-                            {
-                                result.push_back(static_cast<char>(0xC0 | ((value >> 6) & 0x1F)));
-                                result.push_back(static_cast<char>(0x80 | (value & 0x3F)));
-                            }
-                            else
-                            {
-                                result.push_back(static_cast<char>(0xE0 | ((value >> 12) & 0x0F)));
-                                result.push_back(static_cast<char>(0x80 | ((value >> 6) & 0x3F)));
-                                result.push_back(static_cast<char>(0x80 | (value & 0x3F)));
-                            }
-                            break;
-                        }
-                        default:
-                            throw std::runtime_error("Invalid escape sequence");
-                        }
-                    }
-                    else
-                    {
-                        if (static_cast<unsigned char>(ch) < 0x20)
-                        {
-                            throw std::runtime_error("Invalid control character in string");
-                        }
-                        result.push_back(ch);
-                    }
-                }
-                throw std::runtime_error("Unterminated JSON string");
-            }
-
-            JsonValue parseLiteral(std::string_view literal, bool value)
-            {
-                for (char expected : literal)
-                {
-                    if (current_ == end_ || *current_++ != expected)
-                    {
-                        throw std::runtime_error("Invalid JSON literal");
-                    }
-                }
-                return JsonValue{value};
-            }
-
-            void parseLiteral(std::string_view literal)
-            {
-                for (char expected : literal)
-                {
-                    if (current_ == end_ || *current_++ != expected)
-                    {
-                        throw std::runtime_error("Invalid JSON literal");
-                    }
-                }
-            }
-
-            void skipWhitespace()
-            {
-                while (current_ != end_ && std::isspace(static_cast<unsigned char>(*current_)))
-                {
-                    ++current_;
-                }
-            }
-
-            bool consume(char ch)
-            {
-                if (current_ != end_ && *current_ == ch)
-                {
-                    ++current_;
-                    return true;
                 }
-                return false;
-            }
-
-            void expect(char ch)
-            {
-                if (current_ == end_ || *current_ != ch)
+                if (index == N || fields.has(index))
                 {
-                    throw std::runtime_error("Unexpected character in JSON stream");
+                    cursor.skipValue();
+                    continue;
                 }
-                ++current_;
+                fields.spans[index] = cursor.captureValue(&fields.counts[index]);
             }
-
-            std::string_view text_;
-            const char *current_;
-            const char *end_;
-        };
-
-        JsonValue parseJson(std::string_view json)
-        {
-            JsonParser parser(json);
-            return parser.parse();
+            return fields;
         }
 
         AttributeKind parseAttributeKind(std::string_view text)
@@ -597,38 +192,27 @@ namespace wolvrix::lib::load
             throw std::runtime_error("Unknown attribute kind: " + std::string(text));
         }
 
-        AttributeValue parseAttributeValue(const JsonValue &jsonAttr)
+        AttributeValue parseAttributeValue(std::string_view json)
         {
-            const auto &object = jsonAttr.asObject("attribute");
-            auto kindIt = object.find("t");
-            if (kindIt == object.end())
-            {
-                kindIt = object.find("k");
-            }
-            if (kindIt == object.end())
-            {
-                kindIt = object.find("kind");
-            }
-            if (kindIt == object.end())
+            JsonCursor cursor(json);
+            const ObjectFields<7> fields = captureFields<7>(
+                cursor, "attribute", {"t", "k", "kind", "v", "value", "vs", "values"});
+            std::size_t kindIndex = fields.has(0) ? 0 : fields.has(1) ? 1
+                                                     : fields.has(2)   ? 2
+                                                                       : 7;
+            if (kindIndex == 7)
             {
                 throw std::runtime_error("Attribute object missing kind");
             }
-            const char *kindContext = kindIt->first == "t"   ? "attribute.t"
-                                     : kindIt->first == "k" ? "attribute.k"
-                                                            : "attribute.kind";
-            AttributeKind kind = parseAttributeKind(kindIt->second.asString(kindContext));
-
-            auto valueIt = object.find("v");
-            if (valueIt == object.end())
-            {
-                valueIt = object.find("value");
-            }
+            const char *kindContext = kindIndex == 0   ? "attribute.t"
+                                      : kindIndex == 1 ? "attribute.k"
+                                                       : "attribute.kind";
+            std::string scratch;
+            JsonCursor kindCursor(fields.spans[kindIndex]);
+            AttributeKind kind = parseAttributeKind(kindCursor.readString(kindContext, scratch));
 
-            auto valuesIt = object.find("vs");
-            if (valuesIt == object.end())
-            {
-                valuesIt = object.find("values");
-            }
+            const std::string_view valueSpan = fields.has(3) ? fields.spans[3] : fields.spans[4];
+            const std::string_view valuesSpan = fields.has(5) ? fields.spans[5] : fields.spans[6];
 
             auto validateAndReturn = [](AttributeValue attr) -> AttributeValue
             {
@@ -639,81 +223,90 @@ namespace wolvrix::lib::load
                 return attr;
             };
 
+            JsonCursor valueCursor(valueSpan);
+            JsonCursor valuesCursor(valuesSpan);
             switch (kind)
             {
             case AttributeKind::Bool:
-                if (valueIt == object.end())
+                if (valueSpan.data() == nullptr)
                 {
                     throw std::runtime_error("Bool attribute missing value");
                 }
-                return validateAndReturn(AttributeValue{valueIt->second.asBool("attribute.v")});
+                return validateAndReturn(AttributeValue{valueCursor.readBool("attribute.v")});
             case AttributeKind::Int:
-                if (valueIt == object.end())
+                if (valueSpan.data() == nullptr)
                 {
                     throw std::runtime_error("Int attribute missing value");
                 }
-                return validateAndReturn(AttributeValue{valueIt->second.asInt("attribute.v")});
+                return validateAndReturn(AttributeValue{valueCursor.readInt("attribute.v")});
             case AttributeKind::Double:
-                if (valueIt == object.end())
+                if (valueSpan.data() == nullptr)
                 {
                     throw std::runtime_error("Double attribute missing value");
                 }
-                return validateAndReturn(AttributeValue{valueIt->second.asDouble("attribute.v")});
+                return validateAndReturn(AttributeValue{valueCursor.readDouble("attribute.v")});
             case AttributeKind::String:
-                if (valueIt == object.end())
+                if (valueSpan.data() == nullptr)
                 {
                     throw std::runtime_error("String attribute missing value");
                 }
-                return validateAndReturn(AttributeValue{valueIt->second.asString("attribute.v")});
+                return validateAndReturn(AttributeValue{std::string(valueCursor.readString("attribute.v", scratch))});
             case AttributeKind::BoolArray:
             {
-                if (valuesIt == object.end())
+                if (valuesSpan.data() == nullptr)
                 {
                     throw std::runtime_error("Bool array attribute missing values");
                 }
                 std::vector<bool> arr;
-                for (const auto &entry : valuesIt->second.asArray("attribute.vs"))
+                valuesCursor.beginArray("attribute.vs");
+                while (valuesCursor.nextElement())
                 {
-                    arr.push_back(entry.asBool("attribute.vs[]"));
+                    arr.push_back(valuesCursor.readBool("attribute.vs[]"));
                 }
                 return validateAndReturn(AttributeValue{arr});
             }
             case AttributeKind::IntArray:
             {
-                if (valuesIt == object.end())
+                if (valuesSpan.data() == nullptr)
                 {
                     throw std::runtime_error("Int array attribute missing values");
                 }
                 std::vector<int64_t> arr;
-                for (const auto &entry : valuesIt->second.asArray("attribute.vs"))
+                arr.reserve(fields.has(5) ? fields.counts[5] : fields.counts[6]);
+                valuesCursor.beginArray("attribute.vs");
+                while (valuesCursor.nextElement())
                 {
-                    arr.push_back(entry.asInt("attribute.vs[]"));
+                    arr.push_back(valuesCursor.readInt("attribute.vs[]"));
                 }
                 return validateAndReturn(AttributeValue{arr});
             }
             case AttributeKind::DoubleArray:
             {
-                if (valuesIt == object.end())
+                if (valuesSpan.data() == nullptr)
                 {
                     throw std::runtime_error("Double array attribute missing values");
                 }
                 std::vector<double> arr;
-                for (const auto &entry : valuesIt->second.asArray("attribute.vs"))
+                arr.reserve(fields.has(5) ? fields.counts[5] : fields.counts[6]);
+                valuesCursor.beginArray("attribute.vs");
+                while (valuesCursor.nextElement())
                 {
-                    arr.push_back(entry.asDouble("attribute.vs[]"));
+                    arr.push_back(valuesCursor.readDouble("attribute.vs[]"));
                 }
                 return validateAndReturn(AttributeValue{arr});
             }
             case AttributeKind::StringArray:
             {
-                if (valuesIt == object.end())
+                if (valuesSpan.data() == nullptr)
                 {
                     throw std::runtime_error("String array attribute missing values");
                 }
                 std::vector<std::string> arr;
-                for (const auto &entry : valuesIt->second.asArray("attribute.vs"))
+                arr.reserve(fields.has(5) ? fields.counts[5] : fields.counts[6]);
+                valuesCursor.beginArray("attribute.vs");
+                while (valuesCursor.nextElement())
                 {
-                    arr.push_back(entry.asString("attribute.vs[]"));
+                    arr.emplace_back(valuesCursor.readString("attribute.vs[]", scratch));
                 }
                 return validateAndReturn(AttributeValue{arr});
             }
@@ -721,202 +314,186 @@ namespace wolvrix::lib::load
             throw std::runtime_error("Unhandled attribute kind");
         }
 
-        std::optional<SrcLoc> parseSrcLoc(const JsonValue &json, std::string_view context)
+        std::optional<SrcLoc> parseSrcLoc(std::string_view json, std::string_view context)
         {
-            const auto &object = json.asObject(context);
+            JsonCursor cursor(json);
+            const ObjectFields<8> fields = captureFields<8>(
+                cursor, context, {"file", "line", "col", "endLine", "endCol", "origin", "pass", "note"});
             SrcLoc info{};
+            std::string scratch;
+            auto readText = [&](std::size_t index, std::string_view field, std::string &out)
+            {
+                if (!fields.has(index))
+                {
+                    return;
+                }
+                JsonCursor fieldCursor(fields.spans[index]);
+                out = fieldCursor.readString(std::string(context) + "." + std::string(field), scratch);
+            };
+            auto readLine = [&](std::size_t index, std::string_view field, uint32_t &out)
+            {
+                if (!fields.has(index))
+                {
+                    return;
+                }
+                JsonCursor fieldCursor(fields.spans[index]);
+                out = static_cast<uint32_t>(fieldCursor.readInt(std::string(context) + "." + std::string(field)));
+            };
+            readText(0, "file", info.file);
+            readLine(1, "line", info.line);
+            readLine(2, "col", info.column);
+            readLine(3, "endLine", info.endLine);
+            readLine(4, "endCol", info.endColumn);
+            readText(5, "origin", info.origin);
+            readText(6, "pass", info.pass);
+            readText(7, "note", info.note);
 
-            if (auto fileIt = object.find("file"); fileIt != object.end())
+            if (info.file.empty() && info.line == 0 && info.column == 0 &&
+                info.endLine == 0 && info.endColumn == 0 &&
+                info.origin.empty() && info.pass.empty() && info.note.empty())
             {
-                info.file = fileIt->second.asString(std::string(context) + ".file");
+                return std::nullopt;
             }
+            return info;
+        }
+
+        // Byte spans of one graph object, captured in a single skip pass so the sections can
+        // be built in dependency order (values before ports/ops) whatever the key order is.
+        struct GraphSpans
+        {
+            std::string_view symbol;
+            std::string_view declaredSymbols;
+            std::string_view vals;
+            std::string_view ports;
+            std::string_view ops;
+            std::size_t declaredCount = 0;
+            std::size_t valsCount = 0;
+            std::size_t opsCount = 0;
+        };
+
+        GraphSpans scanGraph(JsonCursor &cursor)
+        {
+            const ObjectFields<5> fields = captureFields<5>(
+                cursor, "graph", {"symbol", "declaredSymbols", "vals", "ports", "ops"});
+            GraphSpans spans;
+            spans.symbol = fields.spans[0];
+            spans.declaredSymbols = fields.spans[1];
+            spans.vals = fields.spans[2];
+            spans.ports = fields.spans[3];
+            spans.ops = fields.spans[4];
+            spans.declaredCount = fields.counts[1];
+            spans.valsCount = fields.counts[2];
+            spans.opsCount = fields.counts[4];
+            return spans;
+        }
 
-            if (auto lineIt = object.find("line"); lineIt != object.end())
+        std::string readGraphSymbol(const GraphSpans &spans)
+        {
+            if (spans.symbol.data() == nullptr)
             {
-                info.line = static_cast<uint32_t>(lineIt->second.asInt(std::string(context) + ".line"));
+                throw std::runtime_error("Graph JSON missing symbol");
             }
-
-            if (auto colIt = object.find("col"); colIt != object.end())
+            std::string scratch;
+            JsonCursor cursor(spans.symbol);
+            std::string graphSymbol(cursor.readString("graph.symbol", scratch));
+            if (graphSymbol.empty())
             {
-                info.column = static_cast<uint32_t>(colIt->second.asInt(std::string(context) + ".col"));
+                throw std::runtime_error("Graph JSON symbol is empty");
             }
+            return graphSymbol;
+        }
+
+        struct GraphLoadStats
+        {
+            std::size_t declared = 0;
+            std::size_t values = 0;
+            std::size_t ops = 0;
+            std::size_t portsIn = 0;
+            std::size_t portsOut = 0;
+            std::size_t portsInout = 0;
+        };
 
-            if (auto endLineIt = object.find("endLine"); endLineIt != object.end())
+        GraphLoadStats populateGraph(Graph &graph, const GraphSpans &spans, const std::string &graphSymbol,
+                                     bool timingEnabled, std::size_t progressStep)
+        {
+            GraphLoadStats stats;
+            TimingClock::time_point graphStart;
+            TimingClock::time_point declaredEnd;
+            TimingClock::time_point valuesEnd;
+            TimingClock::time_point portsEnd;
+            TimingClock::time_point opsEnd;
+            if (timingEnabled)
             {
-                info.endLine = static_cast<uint32_t>(endLineIt->second.asInt(std::string(context) + ".endLine"));
+                graphStart = TimingClock::now();
+                std::ostringstream details;
+                details << "symbol=" << graphSymbol;
+                logJsonTiming("load_json.graph.start", 0.0, details.str());
             }
 
-            if (auto endColIt = object.find("endCol"); endColIt != object.end())
+            if (spans.declaredSymbols.data() == nullptr)
             {
-                info.endColumn = static_cast<uint32_t>(endColIt->second.asInt(std::string(context) + ".endCol"));
+                throw std::runtime_error("Graph JSON missing declaredSymbols");
             }
-
-            if (auto originIt = object.find("origin"); originIt != object.end())
+            if (spans.vals.data() == nullptr)
             {
-                info.origin = originIt->second.asString(std::string(context) + ".origin");
+                throw std::runtime_error("Graph JSON missing vals array");
             }
+            const std::size_t opReserve = spans.opsCount;
 
-            if (auto passIt = object.find("pass"); passIt != object.end())
+            const std::size_t symbolReserve = spans.declaredCount + spans.valsCount + opReserve + 64;
+            graph.reserveSymbolCapacity(symbolReserve);
+            graph.reserveDeclaredSymbolCapacity(spans.declaredCount);
+            graph.reserveValueCapacity(spans.valsCount);
+            graph.reserveOperationCapacity(opReserve);
+
+            std::string scratch;
+            std::size_t declaredCount = 0;
             {
-                info.pass = passIt->second.asString(std::string(context) + ".pass");
+                JsonCursor cursor(spans.declaredSymbols);
+                cursor.beginArray("graph.declaredSymbols");
+                while (cursor.nextElement())
+                {
+                    const std::string_view name = cursor.readString("graph.declaredSymbols[]", scratch);
+                    if (name.empty())
+                    {
+                        throw std::runtime_error("Graph declared symbol is empty");
+                    }
+                    SymbolId sym = graph.lookupSymbol(name);
+                    if (!sym.valid())
+                    {
+                        sym = graph.internSymbol(name);
+                    }
+                    if (!sym.valid())
+                    {
+                        throw std::runtime_error("Declared symbol is already bound to value/operation: " + std::string(name));
+                    }
+                    graph.addDeclaredSymbol(sym);
+                    ++declaredCount;
+                }
             }
-
-            if (auto noteIt = object.find("note"); noteIt != object.end())
+            stats.declared = declaredCount;
+            if (timingEnabled)
             {
-                info.note = noteIt->second.asString(std::string(context) + ".note");
+                declaredEnd = TimingClock::now();
             }
 
-            if (info.file.empty() && info.line == 0 && info.column == 0 &&
-                info.endLine == 0 && info.endColumn == 0 &&
-                info.origin.empty() && info.pass.empty() && info.note.empty())
-            {
-                return std::nullopt;
-            }
-            return info;
-        }
-
-    } // namespace
-
-    wolvrix::lib::grh::Design LoadJson::load(std::string_view json)
-    {
-        const bool timingEnabled = jsonTimingEnabled();
-        const std::size_t progressStep = timingEnabled ? jsonTimingStep() : 0;
-        TimingClock::time_point totalStart;
-        if (timingEnabled)
-        {
-            totalStart = TimingClock::now();
-        }
-
-        TimingClock::time_point parseStart;
-        if (timingEnabled)
-        {
-            parseStart = TimingClock::now();
-        }
-        JsonValue root = parseJson(json);
-        if (timingEnabled)
-        {
-            const auto parseEnd = TimingClock::now();
-            std::ostringstream details;
-            details << "bytes=" << json.size();
-            logJsonTiming("load_json.parse", toMillis(parseEnd - parseStart), details.str());
-        }
-        const auto &rootObj = root.asObject("design");
-
-        Design design;
-        auto graphsIt = rootObj.find("graphs");
-        if (graphsIt == rootObj.end())
-        {
-            throw std::runtime_error("Design JSON missing graphs field");
-        }
-        const auto &graphsArray = graphsIt->second.asArray("graphs");
-        std::size_t totalGraphs = 0;
-        std::size_t totalDeclared = 0;
-        std::size_t totalValues = 0;
-        std::size_t totalOps = 0;
-        std::size_t totalPortsIn = 0;
-        std::size_t totalPortsOut = 0;
-        std::size_t totalPortsInout = 0;
-        TimingClock::time_point graphsStart;
-        if (timingEnabled)
-        {
-            graphsStart = TimingClock::now();
-        }
-        for (const auto &graphValue : graphsArray)
-        {
-            TimingClock::time_point graphStart;
-            TimingClock::time_point declaredEnd;
-            TimingClock::time_point valuesEnd;
-            TimingClock::time_point portsEnd;
-            TimingClock::time_point opsEnd;
-            if (timingEnabled)
-            {
-                graphStart = TimingClock::now();
-            }
-            const auto &graphObj = graphValue.asObject("graph");
-            auto symbolIt = graphObj.find("symbol");
-            if (symbolIt == graphObj.end())
-            {
-                throw std::runtime_error("Graph JSON missing symbol");
-            }
-            const std::string graphSymbol = symbolIt->second.asString("graph.symbol");
-            if (graphSymbol.empty())
-            {
-                throw std::runtime_error("Graph JSON symbol is empty");
-            }
-            Graph &graph = design.createGraph(graphSymbol);
-            ++totalGraphs;
-            if (timingEnabled)
-            {
-                std::ostringstream details;
-                details << "symbol=" << graphSymbol;
-                logJsonTiming("load_json.graph.start", 0.0, details.str());
-            }
-
-            auto declaredIt = graphObj.find("declaredSymbols");
-            if (declaredIt == graphObj.end())
-            {
-                throw std::runtime_error("Graph JSON missing declaredSymbols");
-            }
-            const auto &declaredArray = declaredIt->second.asArray("graph.declaredSymbols");
-
-            const auto valuesIt = graphObj.find("vals");
-            if (valuesIt == graphObj.end())
-            {
-                throw std::runtime_error("Graph JSON missing vals array");
-            }
-            const auto &valuesArray = valuesIt->second.asArray("graph.vals");
-
-            const auto opsIt = graphObj.find("ops");
-            const JsonValue::Array *opsArray = nullptr;
-            if (opsIt != graphObj.end())
-            {
-                opsArray = &opsIt->second.asArray("graph.ops");
-            }
-            const std::size_t opReserve = opsArray ? opsArray->size() : 0;
-
-            const std::size_t symbolReserve = declaredArray.size() + valuesArray.size() + opReserve + 64;
-            graph.reserveSymbolCapacity(symbolReserve);
-            graph.reserveDeclaredSymbolCapacity(declaredArray.size());
-            graph.reserveValueCapacity(valuesArray.size());
-            graph.reserveOperationCapacity(opReserve);
-
-            std::size_t declaredCount = 0;
-            for (const auto &entry : declaredArray)
-            {
-                const std::string name = entry.asString("graph.declaredSymbols[]");
-                if (name.empty())
-                {
-                    throw std::runtime_error("Graph declared symbol is empty");
-                }
-                SymbolId sym = graph.lookupSymbol(name);
-                if (!sym.valid())
-                {
-                    sym = graph.internSymbol(name);
-                }
-                if (!sym.valid())
-                {
-                    throw std::runtime_error("Declared symbol is already bound to value/operation: " + name);
-                }
-                graph.addDeclaredSymbol(sym);
-                ++declaredCount;
-            }
-            totalDeclared += declaredCount;
-            if (timingEnabled)
-            {
-                declaredEnd = TimingClock::now();
-            }
-
-            std::unordered_map<std::string, ValueId> valueBySymbol;
             std::unordered_set<uint32_t> declaredInputs;
             std::unordered_set<uint32_t> declaredOutputs;
             std::unordered_set<uint32_t> declaredInouts;
 
-            valueBySymbol.reserve(valuesArray.size());
-            const std::size_t ioReserve = std::max<std::size_t>(32, valuesArray.size() / 32);
+            const std::size_t ioReserve = std::max<std::size_t>(32, spans.valsCount / 32);
             declaredInputs.reserve(ioReserve);
             declaredOutputs.reserve(ioReserve);
             declaredInouts.reserve(ioReserve);
 
+            // Value and operand references resolve through the graph's own symbol table, so
+            // no per-load name map is kept alongside it.
+            auto findValueBySymbol = [&](std::string_view symbol) -> ValueId
+            {
+                const SymbolId sym = graph.lookupSymbol(symbol);
+                return sym.valid() ? graph.findValue(sym) : ValueId::invalid();
+            };
+
             std::size_t valuesCount = 0;
             TimingClock::time_point valuesStart;
             double valuesSymbolMs = 0.0;
@@ -927,123 +504,125 @@ namespace wolvrix::lib::load
             {
                 valuesStart = TimingClock::now();
             }
-            for (const auto &valueEntry : valuesArray)
             {
-                const auto &valueObj = valueEntry.asObject("value");
-                const auto symIt = valueObj.find("sym");
-                const auto widthIt = valueObj.find("w");
-                const auto signIt = valueObj.find("sgn");
-                const auto inIt = valueObj.find("in");
-                const auto outIt = valueObj.find("out");
-                if (symIt == valueObj.end() || widthIt == valueObj.end() ||
-                    signIt == valueObj.end() || inIt == valueObj.end() || outIt == valueObj.end())
+                JsonCursor cursor(spans.vals);
+                std::string symScratch;
+                std::string typeScratch;
+                cursor.beginArray("graph.vals");
+                while (cursor.nextElement())
                 {
-                    throw std::runtime_error("Value entry missing required fields");
-                }
+                    const ObjectFields<8> fields = captureFields<8>(
+                        cursor, "value", {"sym", "w", "sgn", "in", "out", "inout", "type", "loc"});
+                    if (!fields.has(0) || !fields.has(1) || !fields.has(2) || !fields.has(3) || !fields.has(4))
+                    {
+                        throw std::runtime_error("Value entry missing required fields");
+                    }
 
-                const auto &symbol = symIt->second.asString("value.sym");
-                if (symbol.empty())
-                {
-                    throw std::runtime_error("Value symbol is empty");
-                }
-                int64_t width = widthIt->second.asInt("value.w");
-                bool isSigned = signIt->second.asBool("value.sgn");
-                wolvrix::lib::grh::ValueType valueType = wolvrix::lib::grh::ValueType::Logic;
-                if (auto typeIt = valueObj.find("type"); typeIt != valueObj.end())
-                {
-                    const std::string &typeName = typeIt->second.asString("value.type");
-                    if (auto parsed = wolvrix::lib::grh::parseValueType(typeName))
+                    JsonCursor symCursor(fields.spans[0]);
+                    const std::string_view symbol = symCursor.readString("value.sym", symScratch);
+                    if (symbol.empty())
                     {
-                        valueType = *parsed;
+                        throw std::runtime_error("Value symbol is empty");
                     }
-                    else
+                    int64_t width = JsonCursor(fields.spans[1]).readInt("value.w");
+                    bool isSigned = JsonCursor(fields.spans[2]).readBool("value.sgn");
+                    wolvrix::lib::grh::ValueType valueType = wolvrix::lib::grh::ValueType::Logic;
+                    if (fields.has(6))
                     {
-                        throw std::runtime_error("Unknown value type in JSON: " + typeName);
+                        JsonCursor typeCursor(fields.spans[6]);
+                        const std::string_view typeName = typeCursor.readString("value.type", typeScratch);
+                        if (auto parsed = wolvrix::lib::grh::parseValueType(typeName))
+                        {
+                            valueType = *parsed;
+                        }
+                        else
+                        {
+                            throw std::runtime_error("Unknown value type in JSON: " + std::string(typeName));
+                        }
                     }
-                }
-                TimingClock::time_point valueSymbolStart;
-                if (timingEnabled)
-                {
-                    valueSymbolStart = TimingClock::now();
-                }
-                SymbolId valueSym = graph.internSymbol(symbol);
-                if (timingEnabled)
-                {
-                    const auto now = TimingClock::now();
-                    valuesSymbolMs += toMillis(now - valueSymbolStart);
-                }
-                if (!valueSym.valid())
-                {
-                    throw std::runtime_error("Value symbol already bound to value/operation: " + symbol);
-                }
-                TimingClock::time_point valueCreateStart;
-                if (timingEnabled)
-                {
-                    valueCreateStart = TimingClock::now();
-                }
-                ValueId valueId = graph.createValue(valueSym, static_cast<int32_t>(width), isSigned, valueType);
-                if (timingEnabled)
-                {
-                    const auto now = TimingClock::now();
-                    valuesCreateMs += toMillis(now - valueCreateStart);
-                }
-                valueBySymbol.emplace(symbol, valueId);
-
-                bool isInput = inIt->second.asBool("value.in");
-                bool isOutput = outIt->second.asBool("value.out");
-                bool isInout = false;
-                if (auto inoutIt = valueObj.find("inout"); inoutIt != valueObj.end())
-                {
-                    isInout = inoutIt->second.asBool("value.inout");
-                }
-                if (isInout && (isInput || isOutput))
-                {
-                    throw std::runtime_error("Value cannot be both inout and input/output in JSON");
-                }
-
-                if (isInput)
-                {
-                    declaredInputs.insert(valueSym.value);
-                }
-                if (isOutput)
-                {
-                    declaredOutputs.insert(valueSym.value);
-                }
-                if (isInout)
-                {
-                    declaredInouts.insert(valueSym.value);
-                }
-
-                if (auto dbgIt = valueObj.find("loc"); dbgIt != valueObj.end())
-                {
-                    TimingClock::time_point valueLocStart;
+                    TimingClock::time_point valueSymbolStart;
+                    if (timingEnabled)
+                    {
+                        valueSymbolStart = TimingClock::now();
+                    }
+                    SymbolId valueSym = graph.internSymbol(symbol);
                     if (timingEnabled)
                     {
-                        valueLocStart = TimingClock::now();
+                        const auto now = TimingClock::now();
+                        valuesSymbolMs += toMillis(now - valueSymbolStart);
+                    }
+                    if (!valueSym.valid())
+                    {
+                        throw std::runtime_error("Value symbol already bound to value/operation: " + std::string(symbol));
                     }
-                    if (auto loc = parseSrcLoc(dbgIt->second, "value.loc"))
+                    TimingClock::time_point valueCreateStart;
+                    if (timingEnabled)
                     {
-                        graph.setValueSrcLoc(valueId, std::move(*loc));
+                        valueCreateStart = TimingClock::now();
                     }
+                    ValueId valueId = graph.createValue(valueSym, static_cast<int32_t>(width), isSigned, valueType);
                     if (timingEnabled)
                     {
                         const auto now = TimingClock::now();
-                        valuesLocMs += toMillis(now - valueLocStart);
-                        ++valuesLocCount;
+                        valuesCreateMs += toMillis(now - valueCreateStart);
+                    }
+
+                    bool isInput = JsonCursor(fields.spans[3]).readBool("value.in");
+                    bool isOutput = JsonCursor(fields.spans[4]).readBool("value.out");
+                    bool isInout = false;
+                    if (fields.has(5))
+                    {
+                        isInout = JsonCursor(fields.spans[5]).readBool("value.inout");
+                    }
+                    if (isInout && (isInput || isOutput))
+                    {
+                        throw std::runtime_error("Value cannot be both inout and input/output in JSON");
+                    }
+
+                    if (isInput)
+                    {
+                        declaredInputs.insert(valueSym.value);
+                    }
+                    if (isOutput)
+                    {
+                        declaredOutputs.insert(valueSym.value);
+                    }
+                    if (isInout)
+                    {
+                        declaredInouts.insert(valueSym.value);
+                    }
+
+                    if (fields.has(7))
+                    {
+                        TimingClock::time_point valueLocStart;
+                        if (timingEnabled)
+                        {
+                            valueLocStart = TimingClock::now();
+                        }
+                        if (auto loc = parseSrcLoc(fields.spans[7], "value.loc"))
+                        {
+                            graph.setValueSrcLoc(valueId, std::move(*loc));
+                        }
+                        if (timingEnabled)
+                        {
+                            const auto now = TimingClock::now();
+                            valuesLocMs += toMillis(now - valueLocStart);
+                            ++valuesLocCount;
+                        }
+                    }
+                    ++valuesCount;
+                    if (progressStep > 0 && (valuesCount % progressStep) == 0)
+                    {
+                        const auto now = TimingClock::now();
+                        std::ostringstream details;
+                        details << "symbol=" << graphSymbol
+                                << " count=" << valuesCount
+                                << " elapsed=" << toMillis(now - valuesStart) << "ms";
+                        logJsonTiming("load_json.values.progress", toMillis(now - valuesStart), details.str());
                     }
-                }
-                ++valuesCount;
-                if (progressStep > 0 && (valuesCount % progressStep) == 0)
-                {
-                    const auto now = TimingClock::now();
-                    std::ostringstream details;
-                    details << "symbol=" << graphSymbol
-                            << " count=" << valuesCount
-                            << " elapsed=" << toMillis(now - valuesStart) << "ms";
-                    logJsonTiming("load_json.values.progress", toMillis(now - valuesStart), details.str());
                 }
             }
-            totalValues += valuesCount;
+            stats.values = valuesCount;
             if (timingEnabled)
             {
                 valuesEnd = TimingClock::now();
@@ -1058,65 +637,69 @@ namespace wolvrix::lib::load
             double portsInBindMs = 0.0;
             double portsOutBindMs = 0.0;
             double portsInoutBindMs = 0.0;
-            if (auto portsIt = graphObj.find("ports"); portsIt != graphObj.end())
+            if (spans.ports.data() != nullptr)
             {
-                const auto &portsObj = portsIt->second.asObject("graph.ports");
+                JsonCursor portsCursor(spans.ports);
+                const ObjectFields<3> portFields =
+                    captureFields<3>(portsCursor, "graph.ports", {"in", "out", "inout"});
                 std::vector<Port> inputPorts;
                 std::vector<Port> outputPorts;
                 std::vector<InoutPort> inoutPorts;
-                auto parsePortArray = [&](std::string_view key, bool isInput)
+                std::string nameScratch;
+                std::string valScratch;
+                auto parsePortArray = [&](std::size_t fieldIndex, std::string_view key, bool isInput)
                 {
-                    auto arrayIt = portsObj.find(key);
-                    if (arrayIt == portsObj.end())
+                    if (!portFields.has(fieldIndex))
                     {
                         return;
                     }
                     const std::string context = std::string("graph.ports.") + std::string(key);
-                    const auto &portArray = arrayIt->second.asArray(context);
                     if (isInput)
                     {
-                        inputPorts.reserve(inputPorts.size() + portArray.size());
+                        inputPorts.reserve(inputPorts.size() + portFields.counts[fieldIndex]);
                     }
                     else
                     {
-                        outputPorts.reserve(outputPorts.size() + portArray.size());
+                        outputPorts.reserve(outputPorts.size() + portFields.counts[fieldIndex]);
                     }
-                    for (const auto &entry : portArray)
+                    JsonCursor cursor(portFields.spans[fieldIndex]);
+                    cursor.beginArray(context);
+                    while (cursor.nextElement())
                     {
-                        const auto &portObj = entry.asObject("graph.port");
                         TimingClock::time_point portStart;
                         if (timingEnabled)
                         {
                             portStart = TimingClock::now();
                         }
-                        auto nameField = portObj.find("name");
-                        auto valField = portObj.find("val");
-                        if (nameField == portObj.end() || valField == portObj.end())
+                        const ObjectFields<2> fields = captureFields<2>(cursor, "graph.port", {"name", "val"});
+                        if (!fields.has(0) || !fields.has(1))
                         {
                             throw std::runtime_error("Port entry missing name or val");
                         }
-                        const std::string &portNameText = nameField->second.asString("graph.port.name");
+                        JsonCursor nameCursor(fields.spans[0]);
+                        const std::string_view portNameText = nameCursor.readString("graph.port.name", nameScratch);
                         if (portNameText.empty())
                         {
                             throw std::runtime_error("Port name is empty");
                         }
-                        const std::string &valueName = valField->second.asString("graph.port.val");
+                        JsonCursor valCursor(fields.spans[1]);
+                        const std::string_view valueName = valCursor.readString("graph.port.val", valScratch);
                         if (valueName.empty())
                         {
                             throw std::runtime_error("Port value symbol is empty");
                         }
-                        auto valueIt = valueBySymbol.find(valueName);
-                        if (valueIt == valueBySymbol.end())
+                        const ValueId valueId = findValueBySymbol(valueName);
+                        if (!valueId.valid())
                         {
-                            throw std::runtime_error("Port references unknown value: " + valueName);
+                            throw std::runtime_error("Port references unknown value: " + std::string(valueName));
                         }
                         if (isInput)
                         {
-                            inputPorts.push_back(Port{portNameText, valueIt->second});
+                            inputPorts.push_back(Port{std::string(portNameText), valueId});
                         }
                         else
                         {
-                            outputPorts.push_back(Port{portNameText, valueIt->second});
+                            outputPorts.push_back(Port{std::string(portNameText), valueId});
                         }
                         if (timingEnabled)
                         {
@@ -1133,52 +716,54 @@ namespace wolvrix::lib::load
                         }
                     }
                 };
-                parsePortArray("in", true);
-                parsePortArray("out", false);
-
-                auto inoutIt = portsObj.find("inout");
-                if (inoutIt != portsObj.end())
-                {
-                    const auto &portArray = inoutIt->second.asArray("graph.ports.inout");
-                    inoutPorts.reserve(inoutPorts.size() + portArray.size());
-                    for (const auto &entry : portArray)
+                parsePortArray(0, "in", true);
+                parsePortArray(1, "out", false);
+
+                if (portFields.has(2))
+                {
+                    inoutPorts.reserve(inoutPorts.size() + portFields.counts[2]);
+                    JsonCursor cursor(portFields.spans[2]);
+                    std::string inScratch;
+                    std::string outScratch;
+                    std::string oeScratch;
+                    cursor.beginArray("graph.ports.inout");
+                    while (cursor.nextElement())
                     {
-                        const auto &portObj = entry.asObject("graph.inout_port");
                         TimingClock::time_point portStart;
                         if (timingEnabled)
                         {
                             portStart = TimingClock::now();
                         }
-                        auto nameField = portObj.find("name");
-                        auto inField = portObj.find("in");
-                        auto outField = portObj.find("out");
-                        auto oeField = portObj.find("oe");
-                        if (nameField == portObj.end() || inField == portObj.end() ||
-                            outField == portObj.end() || oeField == portObj.end())
+                        const ObjectFields<4> fields =
+                            captureFields<4>(cursor, "graph.inout_port", {"name", "in", "out", "oe"});
+                        if (!fields.has(0) || !fields.has(1) || !fields.has(2) || !fields.has(3))
                         {
                             throw std::runtime_error("Inout port entry missing name/in/out/oe");
                         }
-                        const std::string &portNameText = nameField->second.asString("graph.port.name");
+                        JsonCursor nameCursor(fields.spans[0]);
+                        const std::string_view portNameText = nameCursor.readString("graph.port.name", nameScratch);
                         if (portNameText.empty())
                         {
                             throw std::runtime_error("Inout port name is empty");
                         }
-                        const std::string &inName = inField->second.asString("graph.port.in");
-                        const std::string &outName = outField->second.asString("graph.port.out");
-                        const std::string &oeName = oeField->second.asString("graph.port.oe");
+                        JsonCursor inCursor(fields.spans[1]);
+                        JsonCursor outCursor(fields.spans[2]);
+                        JsonCursor oeCursor(fields.spans[3]);
+                        const std::string_view inName = inCursor.readString("graph.port.in", inScratch);
+                        const std::string_view outName = outCursor.readString("graph.port.out", outScratch);
+                        const std::string_view oeName = oeCursor.readString("graph.port.oe", oeScratch);
                         if (inName.empty() || outName.empty() || oeName.empty())
                         {
                             throw std::runtime_error("Inout port value symbol is empty");
                         }
-                        auto inIt = valueBySymbol.find(inName);
-                        auto outIt = valueBySymbol.find(outName);
-                        auto oeIt = valueBySymbol.find(oeName);
-                        if (inIt == valueBySymbol.end() || outIt == valueBySymbol.end() ||
-                            oeIt == valueBySymbol.end())
+                        const ValueId inId = findValueBySymbol(inName);
+                        const ValueId outId = findValueBySymbol(outName);
+                        const ValueId oeId = findValueBySymbol(oeName);
+                        if (!inId.valid() || !outId.valid() || !oeId.valid())
                         {
                             throw std::runtime_error("Inout port references unknown value");
                         }
-                        inoutPorts.push_back(InoutPort{portNameText, inIt->second, outIt->second, oeIt->second});
+                        inoutPorts.push_back(InoutPort{std::string(portNameText), inId, outId, oeId});
                         if (timingEnabled)
                         {
                             const auto now = TimingClock::now();
@@ -1323,9 +908,9 @@ namespace wolvrix::lib::load
                     throw std::runtime_error("Value marked inout=true but not bound to inout port");
                 }
             }
-            totalPortsIn += portsInCount;
-            totalPortsOut += portsOutCount;
-            totalPortsInout += portsInoutCount;
+            stats.portsIn = portsInCount;
+            stats.portsOut = portsOutCount;
+            stats.portsInout = portsInoutCount;
             if (timingEnabled)
             {
                 portsEnd = TimingClock::now();
@@ -1346,29 +931,39 @@ namespace wolvrix::lib::load
             {
                 opsStart = TimingClock::now();
             }
-            if (opsArray)
-            {
-                for (const auto &opEntry : *opsArray)
-                {
-                    const auto &opObj = opEntry.asObject("operation");
-                    auto kindIt = opObj.find("kind");
-                    if (kindIt == opObj.end())
+            if (spans.ops.data() != nullptr)
+            {
+                JsonCursor cursor(spans.ops);
+                std::string kindScratch;
+                std::string symScratch;
+                std::string refScratch;
+                std::string attrScratch;
+                std::vector<std::pair<std::string_view, std::string_view>> attrEntries;
+                std::deque<std::string> escapedAttrNames;
+                cursor.beginArray("graph.ops");
+                while (cursor.nextElement())
+                {
+                    const ObjectFields<6> fields = captureFields<6>(
+                        cursor, "operation", {"kind", "sym", "in", "out", "attrs", "loc"});
+                    if (!fields.has(0))
                     {
                         throw std::runtime_error("Operation missing kind");
                     }
-                    auto kind = parseOperationKind(kindIt->second.asString("operation.kind"));
+                    JsonCursor kindCursor(fields.spans[0]);
+                    const std::string_view kindText = kindCursor.readString("operation.kind", kindScratch);
+                    auto kind = parseOperationKind(kindText);
                     if (!kind)
                     {
-                        throw std::runtime_error("Unknown operation kind: " + kindIt->second.asString("operation.kind"));
+                        throw std::runtime_error("Unknown operation kind: " + std::string(kindText));
                     }
 
-                    auto symIt = opObj.find("sym");
-                    if (symIt == opObj.end())
+                    if (!fields.has(1))
                     {
                         throw std::runtime_error("Operation missing symbol");
                     }
 
-                    const std::string &opSymbol = symIt->second.asString("operation.sym");
+                    JsonCursor symCursor(fields.spans[1]);
+                    const std::string_view opSymbol = symCursor.readString("operation.sym", symScratch);
                     if (opSymbol.empty())
                     {
                         throw std::runtime_error("Operation symbol is empty");
@@ -1386,7 +981,7 @@ namespace wolvrix::lib::load
                     }
                     if (!opSym.valid())
                     {
-                        throw std::runtime_error("Operation symbol already bound to value/operation: " + opSymbol);
+                        throw std::runtime_error("Operation symbol already bound to value/operation: " + std::string(opSymbol));
                     }
                     TimingClock::time_point opCreateStart;
                     if (timingEnabled)
@@ -1400,29 +995,25 @@ namespace wolvrix::lib::load
                         opsCreateMs += toMillis(now - opCreateStart);
                     }
 
-                    const JsonValue::Array *inputsArray = nullptr;
-                    if (auto inIt = opObj.find("in"); inIt != opObj.end())
-                    {
-                        inputsArray = &inIt->second.asArray("operation.in");
-                        graph.reserveOpOperandCapacity(opId, inputsArray->size());
-                    }
-
                     TimingClock::time_point opInputsStart;
                     if (timingEnabled)
                     {
                         opInputsStart = TimingClock::now();
                     }
-                    if (inputsArray)
+                    if (fields.has(2))
                     {
-                        for (const auto &entry : *inputsArray)
+                        JsonCursor inCursor(fields.spans[2]);
+                        inCursor.beginArray("operation.in");
+                        graph.reserveOpOperandCapacity(opId, fields.counts[2]);
+                        while (inCursor.nextElement())
                         {
-                            const std::string &symbol = entry.asString("operation.in[]");
-                            auto valueIt = valueBySymbol.find(symbol);
-                            if (valueIt == valueBySymbol.end())
+                            const std::string_view symbol = inCursor.readString("operation.in[]", refScratch);
+                            const ValueId valueId = findValueBySymbol(symbol);
+                            if (!valueId.valid())
                             {
-                                throw std::runtime_error("Operand references unknown value: " + symbol);
+                                throw std::runtime_error("Operand references unknown value: " + std::string(symbol));
                             }
-                            graph.addOperand(opId, valueIt->second);
+                            graph.addOperand(opId, valueId);
                             ++opsInRefs;
                         }
                     }
@@ -1432,29 +1023,25 @@ namespace wolvrix::lib::load
                         opsInputsMs += toMillis(now - opInputsStart);
                     }
 
-                    const JsonValue::Array *outputsArray = nullptr;
-                    if (auto outIt = opObj.find("out"); outIt != opObj.end())
-                    {
-                        outputsArray = &outIt->second.asArray("operation.out");
-                        graph.reserveOpResultCapacity(opId, outputsArray->size());
-                    }
-
                     TimingClock::time_point opOutputsStart;
                     if (timingEnabled)
                     {
                         opOutputsStart = TimingClock::now();
                     }
-                    if (outputsArray)
+                    if (fields.has(3))
                     {
-                        for (const auto &entry : *outputsArray)
+                        JsonCursor outCursor(fields.spans[3]);
+                        outCursor.beginArray("operation.out");
+                        graph.reserveOpResultCapacity(opId, fields.counts[3]);
+                        while (outCursor.nextElement())
                         {
-                            const std::string &symbol = entry.asString("operation.out[]");
-                            auto valueIt = valueBySymbol.find(symbol);
-                            if (valueIt == valueBySymbol.end())
+                            const std::string_view symbol = outCursor.readString("operation.out[]", refScratch);
+                            const ValueId valueId = findValueBySymbol(symbol);
+                            if (!valueId.valid())
                             {
-                                throw std::runtime_error("Result references unknown value: " + symbol);
+                                throw std::runtime_error("Result references unknown value: " + std::string(symbol));
                             }
-                            graph.addResult(opId, valueIt->second);
+                            graph.addResult(opId, valueId);
                             ++opsOutRefs;
                         }
                     }
@@ -1464,18 +1051,37 @@ namespace wolvrix::lib::load
                         opsOutputsMs += toMillis(now - opOutputsStart);
                     }
 
-                    if (auto attrsIt = opObj.find("attrs"); attrsIt != opObj.end())
+                    if (fields.has(4))
                     {
                         TimingClock::time_point opAttrsStart;
                         if (timingEnabled)
                         {
                             opAttrsStart = TimingClock::now();
                         }
-                        const auto &attrsObj = attrsIt->second.asObject("operation.attrs");
-                        graph.reserveOpAttrCapacity(opId, attrsObj.size());
-                        for (const auto &[attrName, attrValue] : attrsObj)
+                        // Attributes are applied in key order with the first duplicate winning,
+                        // as they were when objects were materialized into an ordered map.
+                        attrEntries.clear();
+                        escapedAttrNames.clear();
+                        JsonCursor attrsCursor(fields.spans[4]);
+                        std::string_view attrName;
+                        attrsCursor.beginObject("operation.attrs");
+                        while (attrsCursor.nextKey(attrName, attrScratch))
+                        {
+                            if (attrName.data() == attrScratch.data())
+                            {
+                                attrName = escapedAttrNames.emplace_back(attrName);
+                            }
+                            attrEntries.emplace_back(attrName, attrsCursor.captureValue());
+                        }
+                        std::stable_sort(attrEntries.begin(), attrEntries.end(),
+                                         [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
+                        attrEntries.erase(std::unique(attrEntries.begin(), attrEntries.end(),
+                                                      [](const auto &lhs, const auto &rhs) { return lhs.first == rhs.first; }),
+                                          attrEntries.end());
+                        graph.reserveOpAttrCapacity(opId, attrEntries.size());
+                        for (const auto &[name, valueSpan] : attrEntries)
                         {
-                            graph.setAttr(opId, attrName, parseAttributeValue(attrValue));
+                            graph.setAttr(opId, name, parseAttributeValue(valueSpan));
                             ++opsAttrCount;
                         }
                         if (timingEnabled)
@@ -1485,14 +1091,14 @@ namespace wolvrix::lib::load
                         }
                     }
 
-                    if (auto dbgIt = opObj.find("loc"); dbgIt != opObj.end())
+                    if (fields.has(5))
                     {
                         TimingClock::time_point opLocStart;
                         if (timingEnabled)
                         {
                             opLocStart = TimingClock::now();
                         }
-                        if (auto loc = parseSrcLoc(dbgIt->second, "operation.loc"))
+                        if (auto loc = parseSrcLoc(fields.spans[5], "operation.loc"))
                         {
                             graph.setOpSrcLoc(opId, std::move(*loc));
                         }
@@ -1514,7 +1120,7 @@ namespace wolvrix::lib::load
                     }
                 }
             }
-            totalOps += opsCount;
+            stats.ops = opsCount;
             if (timingEnabled)
             {
                 opsEnd = TimingClock::now();
@@ -1551,18 +1157,329 @@ namespace wolvrix::lib::load
                         << " ops_attrs=" << opsAttrCount;
                 logJsonTiming("load_json.graph", toMillis(opsEnd - graphStart), details.str());
             }
+            return stats;
+        }
+
+        // Single structural pass over the document: graph objects are split into their
+        // field spans while the other top-level sections are captured whole.
+        struct DesignSpans
+        {
+            bool hasGraphs = false;
+            std::vector<GraphSpans> graphs;
+            std::string_view declaredSymbols;
+            std::string_view aliases;
+            std::string_view tops;
+        };
+
+        DesignSpans scanDesign(std::string_view json)
+        {
+            DesignSpans spans;
+            JsonCursor cursor(json);
+            std::string keyScratch;
+            std::string_view key;
+            cursor.beginObject("design");
+            while (cursor.nextKey(key, keyScratch))
+            {
+                if (key == "graphs" && !spans.hasGraphs)
+                {
+                    spans.hasGraphs = true;
+                    cursor.beginArray("graphs");
+                    while (cursor.nextElement())
+                    {
+                        spans.graphs.push_back(scanGraph(cursor));
+                    }
+                    continue;
+                }
+                std::string_view *target = key == "declaredSymbols" ? &spans.declaredSymbols
+                                           : key == "aliases"       ? &spans.aliases
+                                           : key == "tops"          ? &spans.tops
+                                                                    : nullptr;
+                if (!target || target->data() != nullptr)
+                {
+                    cursor.skipValue();
+                    continue;
+                }
+                *target = cursor.captureValue();
+            }
+            cursor.expectEnd();
+            return spans;
+        }
+
+        std::size_t jsonLoadThreads()
+        {
+            static const std::size_t threads = []() {
+                const char *env = std::getenv("WOLVRIX_JSON_THREADS");
+                if (env && *env != '\0')
+                {
+                    char *end = nullptr;
+                    const unsigned long long value = std::strtoull(env, &end, 10);
+                    if (end != env && *end == '\0' && value > 0)
+                    {
+                        return static_cast<std::size_t>(value);
+                    }
+                }
+                return std::max<std::size_t>(1, static_cast<std::size_t>(std::thread::hardware_concurrency()));
+            }();
+            return threads;
+        }
+
+    } // namespace
+
+    MappedFile::MappedFile(const std::string &path)
+    {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            throw std::runtime_error("open failed: " + path);
+        }
+        mapDescriptor(fd, path);
+    }
+
+    MappedFile MappedFile::sharedMemory(const std::string &name)
+    {
+        const int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd < 0)
+        {
+            throw std::runtime_error("shm_open failed: " + name);
+        }
+        MappedFile file;
+        file.mapDescriptor(fd, name);
+        return file;
+    }
+
+    void MappedFile::mapDescriptor(int fd, const std::string &what)
+    {
+        struct stat info{};
+        if (::fstat(fd, &info) != 0)
+        {
+            ::close(fd);
+            throw std::runtime_error("stat failed: " + what);
+        }
+        if (info.st_size <= 0)
+        {
+            ::close(fd);
+            throw std::runtime_error("empty file: " + what);
+        }
+        const std::size_t size = static_cast<std::size_t>(info.st_size);
+        void *data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (data == MAP_FAILED)
+        {
+            throw std::runtime_error("mmap failed: " + what);
+        }
+        ::madvise(data, size, MADV_WILLNEED);
+        data_ = data;
+        size_ = size;
+    }
+
+    MappedFile::~MappedFile()
+    {
+        release();
+    }
+
+    MappedFile::MappedFile(MappedFile &&other) noexcept
+        : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0))
+    {
+    }
+
+    MappedFile &MappedFile::operator=(MappedFile &&other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    void MappedFile::release() noexcept
+    {
+        if (data_)
+        {
+            ::munmap(data_, size_);
+            data_ = nullptr;
+            size_ = 0;
+        }
+    }
+
+    wolvrix::lib::grh::Design Load::loadFile(const std::string &path)
+    {
+        const bool timingEnabled = jsonTimingEnabled();
+        TimingClock::time_point mapStart;
+        if (timingEnabled)
+        {
+            mapStart = TimingClock::now();
+        }
+        MappedFile file(path);
+        if (timingEnabled)
+        {
+            std::ostringstream details;
+            details << "bytes=" << file.size() << " path=" << path;
+            logJsonTiming("load_json.map", toMillis(TimingClock::now() - mapStart), details.str());
+        }
+        return load(file.view());
+    }
+
+    wolvrix::lib::grh::Design LoadJson::load(std::string_view json)
+    {
+        const bool timingEnabled = jsonTimingEnabled();
+        const std::size_t progressStep = timingEnabled ? jsonTimingStep() : 0;
+        TimingClock::time_point totalStart;
+        if (timingEnabled)
+        {
+            totalStart = TimingClock::now();
+        }
+
+        // One structural pass finds every graph object and top-level section; graphs are then
+        // built concurrently into detached Graphs straight from the input bytes and adopted in
+        // document order, so the result does not depend on the thread count.
+        TimingClock::time_point scanStart;
+        if (timingEnabled)
+        {
+            scanStart = TimingClock::now();
+        }
+        const DesignSpans rootSpans = scanDesign(json);
+        if (timingEnabled)
+        {
+            const auto scanEnd = TimingClock::now();
+            std::ostringstream details;
+            details << "bytes=" << json.size()
+                    << " graphs=" << rootSpans.graphs.size();
+            logJsonTiming("load_json.scan", toMillis(scanEnd - scanStart), details.str());
+        }
+
+        Design design;
+        if (!rootSpans.hasGraphs)
+        {
+            throw std::runtime_error("Design JSON missing graphs field");
+        }
+
+        struct GraphTask
+        {
+            std::string symbol;
+            std::unique_ptr<Graph> graph;
+            GraphLoadStats stats;
+            std::exception_ptr error;
+            bool duplicate = false;
+        };
+        const std::size_t totalGraphs = rootSpans.graphs.size();
+        std::vector<GraphTask> tasks(totalGraphs);
+        {
+            // Graph ids are reserved in document order so they match a serial load.
+            std::unordered_set<std::string_view> seenSymbols;
+            seenSymbols.reserve(totalGraphs);
+            for (std::size_t i = 0; i < totalGraphs; ++i)
+            {
+                GraphTask &task = tasks[i];
+                try
+                {
+                    task.symbol = readGraphSymbol(rootSpans.graphs[i]);
+                }
+                catch (...)
+                {
+                    task.error = std::current_exception();
+                    continue;
+                }
+                if (!seenSymbols.insert(task.symbol).second)
+                {
+                    task.duplicate = true;
+                    continue;
+                }
+                task.graph = design.createDetachedGraph(task.symbol);
+            }
+        }
+
+        const std::size_t threadCount =
+            std::min<std::size_t>(threadCount_ ? threadCount_ : jsonLoadThreads(), std::max<std::size_t>(1, totalGraphs));
+        TimingClock::time_point graphsStart;
+        if (timingEnabled)
+        {
+            graphsStart = TimingClock::now();
+        }
+        auto populateTask = [&](std::size_t index)
+        {
+            GraphTask &task = tasks[index];
+            if (!task.graph)
+            {
+                return;
+            }
+            try
+            {
+                task.stats = populateGraph(*task.graph, rootSpans.graphs[index], task.symbol, timingEnabled, progressStep);
+            }
+            catch (...)
+            {
+                task.error = std::current_exception();
+            }
+        };
+        if (threadCount <= 1)
+        {
+            for (std::size_t i = 0; i < totalGraphs; ++i)
+            {
+                populateTask(i);
+                if (tasks[i].error)
+                {
+                    break;
+                }
+            }
+        }
+        else
+        {
+            std::atomic<std::size_t> next{0};
+            std::vector<std::thread> workers;
+            workers.reserve(threadCount);
+            for (std::size_t t = 0; t < threadCount; ++t)
+            {
+                workers.emplace_back([&]() {
+                    for (;;)
+                    {
+                        const std::size_t index = next.fetch_add(1, std::memory_order_relaxed);
+                        if (index >= totalGraphs)
+                        {
+                            return;
+                        }
+                        populateTask(index);
+                    }
+                });
+            }
+            for (auto &worker : workers)
+            {
+                worker.join();
+            }
+        }
+
+        GraphLoadStats totals;
+        for (GraphTask &task : tasks)
+        {
+            if (task.error)
+            {
+                std::rethrow_exception(task.error);
+            }
+            if (task.duplicate)
+            {
+                throw std::runtime_error("Duplicated graph symbol: " + task.symbol);
+            }
+            design.adoptGraph(std::move(task.graph));
+            totals.declared += task.stats.declared;
+            totals.values += task.stats.values;
+            totals.ops += task.stats.ops;
+            totals.portsIn += task.stats.portsIn;
+            totals.portsOut += task.stats.portsOut;
+            totals.portsInout += task.stats.portsInout;
         }
         if (timingEnabled)
         {
             const auto graphsEnd = TimingClock::now();
             std::ostringstream details;
             details << "graphs=" << totalGraphs
-                    << " declared=" << totalDeclared
-                    << " values=" << totalValues
-                    << " ops=" << totalOps
-                    << " ports_in=" << totalPortsIn
-                    << " ports_out=" << totalPortsOut
-                    << " ports_inout=" << totalPortsInout;
+                    << " threads=" << threadCount
+                    << " declared=" << totals.declared
+                    << " values=" << totals.values
+                    << " ops=" << totals.ops
+                    << " ports_in=" << totals.portsIn
+                    << " ports_out=" << totals.portsOut
+                    << " ports_inout=" << totals.portsInout;
             logJsonTiming("load_json.graphs", toMillis(graphsEnd - graphsStart), details.str());
         }
 
@@ -1571,33 +1488,52 @@ namespace wolvrix::lib::load
         {
             designStart = TimingClock::now();
         }
-        auto declaredIt = rootObj.find("declaredSymbols");
-        if (declaredIt == rootObj.end())
+        if (rootSpans.declaredSymbols.data() == nullptr)
         {
             throw std::runtime_error("Design JSON missing declaredSymbols");
         }
+        std::string scratch;
         std::size_t designDeclared = 0;
-        for (const auto &entry : declaredIt->second.asArray("design.declaredSymbols"))
         {
-            const std::string name = entry.asString("design.declaredSymbols[]");
-            if (name.empty())
+            JsonCursor cursor(rootSpans.declaredSymbols);
+            cursor.beginArray("design.declaredSymbols");
+            while (cursor.nextElement())
             {
-                throw std::runtime_error("Design declared symbol is empty");
+                const std::string_view name = cursor.readString("design.declaredSymbols[]", scratch);
+                if (name.empty())
+                {
+                    throw std::runtime_error("Design declared symbol is empty");
+                }
+                design.addDeclaredSymbol(design.internSymbol(name));
+                ++designDeclared;
             }
-            design.addDeclaredSymbol(design.internSymbol(name));
-            ++designDeclared;
         }
 
         std::size_t designAliases = 0;
-        if (auto aliasesIt = rootObj.find("aliases"); aliasesIt != rootObj.end())
+        if (rootSpans.aliases.data() != nullptr)
         {
-            for (const auto &[alias, value] : aliasesIt->second.asObject("design.aliases"))
+            // Registered in alias-name order, first duplicate wins.
+            std::vector<std::pair<std::string, std::string_view>> aliases;
+            JsonCursor cursor(rootSpans.aliases);
+            std::string_view alias;
+            cursor.beginObject("design.aliases");
+            while (cursor.nextKey(alias, scratch))
+            {
+                aliases.emplace_back(std::string(alias), cursor.captureValue());
+            }
+            std::stable_sort(aliases.begin(), aliases.end(),
+                             [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
+            aliases.erase(std::unique(aliases.begin(), aliases.end(),
+                                      [](const auto &lhs, const auto &rhs) { return lhs.first == rhs.first; }),
+                          aliases.end());
+            for (const auto &[aliasName, targetSpan] : aliases)
             {
-                if (alias.empty())
+                if (aliasName.empty())
                 {
                     throw std::runtime_error("Design alias is empty");
                 }
-                const std::string target = value.asString("design.aliases[]");
+                JsonCursor targetCursor(targetSpan);
+                const std::string target(targetCursor.readString("design.aliases[]", scratch));
                 if (target.empty())
                 {
                     throw std::runtime_error("Design alias target is empty");
@@ -1607,17 +1543,19 @@ namespace wolvrix::lib::load
                 {
                     throw std::runtime_error("Design alias target graph not found: " + target);
                 }
-                design.registerGraphAlias(alias, *graph);
+                design.registerGraphAlias(aliasName, *graph);
                 ++designAliases;
             }
         }
 
         std::size_t designTops = 0;
-        if (auto topIt = rootObj.find("tops"); topIt != rootObj.end())
+        if (rootSpans.tops.data() != nullptr)
         {
-            for (const auto &entry : topIt->second.asArray("design.tops"))
+            JsonCursor cursor(rootSpans.tops);
+            cursor.beginArray("design.tops");
+            while (cursor.nextElement())
             {
-                design.markAsTop(entry.asString("design.tops[]"));
+                design.markAsTop(std::string(cursor.readString("design.tops[]", scratch)));
                 ++designTops;
             }
         }
@@ -1637,6 +1575,352 @@ namespace wolvrix::lib::load
         return design;
     }
 
+    namespace
+    {
+        constexpr std::size_t kGrhbHeaderSize = 64;
+        constexpr std::size_t kGrhbIndexEntrySize = 24;
+
+        [[noreturn]] void grhbFail(std::string_view reason)
+        {
+            throw std::runtime_error("Invalid grhb file: " + std::string(reason));
+        }
+
+        template <typename T>
+        T grhbRead(std::string_view data, uint64_t offset, std::string_view what)
+        {
+            if (offset > data.size() || data.size() - offset < sizeof(T))
+            {
+                grhbFail(what);
+            }
+            T value;
+            std::memcpy(&value, data.data() + offset, sizeof(T));
+            return value;
+        }
+    } // namespace
+
+    GrhbArchive::GrhbArchive(std::string_view data) : data_(data)
+    {
+        if (data.size() < kGrhbHeaderSize ||
+            std::memcmp(data.data(), wolvrix::lib::grh::kGrhbMagic.data(), wolvrix::lib::grh::kGrhbMagic.size()) != 0)
+        {
+            grhbFail("bad magic");
+        }
+        const uint32_t version = grhbRead<uint32_t>(data, 4, "header");
+        if (version != wolvrix::lib::grh::kGrhbVersion)
+        {
+            grhbFail("unsupported version " + std::to_string(version));
+        }
+        const uint32_t graphCount = grhbRead<uint32_t>(data, 8, "header");
+        const uint32_t stringCount = grhbRead<uint32_t>(data, 12, "header");
+        const uint64_t stringTableOffset = grhbRead<uint64_t>(data, 16, "header");
+        const uint64_t graphIndexOffset = grhbRead<uint64_t>(data, 24, "header");
+        const uint64_t designOffset = grhbRead<uint64_t>(data, 32, "header");
+        const uint64_t fileSize = grhbRead<uint64_t>(data, 40, "header");
+        if (fileSize != data.size())
+        {
+            grhbFail("size mismatch (truncated file?)");
+        }
+        if (stringTableOffset < kGrhbHeaderSize || stringTableOffset > graphIndexOffset ||
+            graphIndexOffset > designOffset || designOffset > fileSize)
+        {
+            grhbFail("section offsets out of order");
+        }
+
+        const uint64_t stringBytesOffset = stringTableOffset + (static_cast<uint64_t>(stringCount) + 1) * 8;
+        if (stringBytesOffset > graphIndexOffset)
+        {
+            grhbFail("string table overflows its section");
+        }
+        auto stringAt = [&](uint32_t ref) -> std::string_view {
+            if (ref == 0)
+            {
+                return {};
+            }
+            if (ref > stringCount)
+            {
+                grhbFail("string reference out of range");
+            }
+            const uint64_t begin = grhbRead<uint64_t>(data, stringTableOffset + (ref - 1) * 8ull, "string table");
+            const uint64_t end = grhbRead<uint64_t>(data, stringTableOffset + ref * 8ull, "string table");
+            if (begin > end || stringBytesOffset + end > graphIndexOffset)
+            {
+                grhbFail("string table offsets out of range");
+            }
+            return data.substr(static_cast<std::size_t>(stringBytesOffset + begin), static_cast<std::size_t>(end - begin));
+        };
+
+        if ((designOffset - graphIndexOffset) / kGrhbIndexEntrySize < graphCount)
+        {
+            grhbFail("graph index overflows its section");
+        }
+        graphs_.reserve(graphCount);
+        for (uint32_t i = 0; i < graphCount; ++i)
+        {
+            const uint64_t entry = graphIndexOffset + static_cast<uint64_t>(i) * kGrhbIndexEntrySize;
+            const std::string_view name = stringAt(grhbRead<uint32_t>(data, entry, "graph index"));
+            const uint64_t offset = grhbRead<uint64_t>(data, entry + 8, "graph index");
+            const uint64_t size = grhbRead<uint64_t>(data, entry + 16, "graph index");
+            if (name.empty())
+            {
+                grhbFail("graph name is empty");
+            }
+            if (offset < kGrhbHeaderSize || offset > stringTableOffset || size > stringTableOffset - offset)
+            {
+                grhbFail("graph section out of range: " + std::string(name));
+            }
+            graphs_.push_back(GraphEntry{name, data.substr(static_cast<std::size_t>(offset), static_cast<std::size_t>(size))});
+        }
+
+        const uint32_t aliasCount = grhbRead<uint32_t>(data, designOffset, "design section");
+        const uint32_t declaredCount = grhbRead<uint32_t>(data, designOffset + 4, "design section");
+        const uint32_t topCount = grhbRead<uint32_t>(data, designOffset + 8, "design section");
+        uint64_t cursor = designOffset + 16;
+        auto next = [&]() {
+            const uint32_t value = grhbRead<uint32_t>(data, cursor, "design section");
+            cursor += 4;
+            return value;
+        };
+        auto graphRef = [&](uint32_t index) {
+            if (index >= graphCount)
+            {
+                grhbFail("graph reference out of range");
+            }
+            return index;
+        };
+        aliases_.reserve(aliasCount);
+        for (uint32_t i = 0; i < aliasCount; ++i)
+        {
+            const std::string_view alias = stringAt(next());
+            aliases_.emplace_back(alias, graphRef(next()));
+        }
+        declaredSymbols_.reserve(declaredCount);
+        for (uint32_t i = 0; i < declaredCount; ++i)
+        {
+            const std::string_view text = stringAt(next());
+            if (text.empty())
+            {
+                grhbFail("declared symbol is empty");
+            }
+            declaredSymbols_.push_back(text);
+        }
+        tops_.reserve(topCount);
+        for (uint32_t i = 0; i < topCount; ++i)
+        {
+            tops_.push_back(graphRef(next()));
+        }
+    }
+
+    GrhbArchive GrhbArchive::open(const std::string &path)
+    {
+        MappedFile file(path);
+        GrhbArchive archive(file.view());
+        archive.file_ = std::move(file);
+        return archive;
+    }
+
+    GrhbArchive GrhbArchive::openSharedMemory(const std::string &name)
+    {
+        MappedFile file = MappedFile::sharedMemory(name);
+        GrhbArchive archive(file.view());
+        archive.file_ = std::move(file);
+        return archive;
+    }
+
+    std::optional<std::size_t> GrhbArchive::findGraph(std::string_view name) const
+    {
+        for (std::size_t i = 0; i < graphs_.size(); ++i)
+        {
+            if (graphs_[i].name == name)
+            {
+                return i;
+            }
+        }
+        return std::nullopt;
+    }
+
+    std::unique_ptr<wolvrix::lib::grh::Graph> GrhbArchive::decodeGraph(wolvrix::lib::grh::Design &design,
+                                                                       std::size_t index) const
+    {
+        const GraphEntry &entry = graphs_.at(index);
+        std::unique_ptr<wolvrix::lib::grh::Graph> graph = design.createDetachedGraph(std::string(entry.name));
+        graph->readBinary(entry.section);
+        return graph;
+    }
+
+    wolvrix::lib::grh::Graph &GrhbArchive::loadGraph(wolvrix::lib::grh::Design &design, std::size_t index) const
+    {
+        return design.adoptGraph(decodeGraph(design, index));
+    }
+
+    void GrhbArchive::loadDesignInfo(wolvrix::lib::grh::Design &design) const
+    {
+        for (const std::string_view text : declaredSymbols_)
+        {
+            design.addDeclaredSymbol(design.internSymbol(text));
+        }
+        // peekGraph() keeps lazily added graphs unloaded.
+        for (const auto &[alias, graphIndex] : aliases_)
+        {
+            if (design.peekGraph(graphs_[graphIndex].name))
+            {
+                design.registerGraphAlias(std::string(alias), graphs_[graphIndex].name);
+            }
+        }
+        for (const uint32_t graphIndex : tops_)
+        {
+            if (design.peekGraph(graphs_[graphIndex].name))
+            {
+                design.markAsTop(graphs_[graphIndex].name);
+            }
+        }
+    }
+
+    namespace
+    {
+
+        // Owns the mapped archive for as long as any design (or clone) refers to it.
+        class GrhbGraphSource final : public wolvrix::lib::grh::LazyGraphSource
+        {
+        public:
+            explicit GrhbGraphSource(GrhbArchive archive) : archive_(std::move(archive)) {}
+
+            const GrhbArchive &archive() const noexcept { return archive_; }
+
+            void loadGraph(std::size_t slot, wolvrix::lib::grh::Graph &graph) const override
+            {
+                graph.readBinary(archive_.graphSection(slot));
+            }
+
+            std::optional<std::string_view> grhbSection(std::size_t slot) const override
+            {
+                return archive_.graphSection(slot);
+            }
+
+        private:
+            GrhbArchive archive_;
+        };
+
+    } // namespace
+
+    wolvrix::lib::grh::Design LoadGrhb::loadLazy(const std::string &path)
+    {
+        return loadLazy(GrhbArchive::open(path));
+    }
+
+    wolvrix::lib::grh::Design LoadGrhb::loadLazy(GrhbArchive archiveToOwn)
+    {
+        const bool timingEnabled = jsonTimingEnabled();
+        TimingClock::time_point totalStart;
+        if (timingEnabled)
+        {
+            totalStart = TimingClock::now();
+        }
+
+        auto source = std::make_shared<const GrhbGraphSource>(std::move(archiveToOwn));
+        const GrhbArchive &archive = source->archive();
+        Design design;
+        for (std::size_t i = 0; i < archive.graphCount(); ++i)
+        {
+            design.addLazyGraph(std::string(archive.graphName(i)), source, i);
+        }
+        archive.loadDesignInfo(design);
+
+        if (timingEnabled)
+        {
+            std::ostringstream details;
+            details << "graphs=" << archive.graphCount();
+            logJsonTiming("load_grhb.lazy", toMillis(TimingClock::now() - totalStart), details.str());
+        }
+        return design;
+    }
+
+    wolvrix::lib::grh::Design LoadGrhb::load(std::string_view data)
+    {
+        const bool timingEnabled = jsonTimingEnabled();
+        TimingClock::time_point totalStart;
+        if (timingEnabled)
+        {
+            totalStart = TimingClock::now();
+        }
+
+        const GrhbArchive archive(data);
+        const std::size_t totalGraphs = archive.graphCount();
+        Design design;
+
+        // Graph ids are reserved in index order so the result does not depend on scheduling.
+        std::vector<std::unique_ptr<Graph>> graphs(totalGraphs);
+        std::vector<std::exception_ptr> errors(totalGraphs);
+        for (std::size_t i = 0; i < totalGraphs; ++i)
+        {
+            graphs[i] = design.createDetachedGraph(std::string(archive.graphName(i)));
+        }
+        auto decodeTask = [&](std::size_t index)
+        {
+            try
+            {
+                graphs[index]->readBinary(archive.graphSection(index));
+            }
+            catch (...)
+            {
+                errors[index] = std::current_exception();
+            }
+        };
+
+        const std::size_t threadCount =
+            std::min<std::size_t>(threadCount_ ? threadCount_ : jsonLoadThreads(), std::max<std::size_t>(1, totalGraphs));
+        if (threadCount <= 1)
+        {
+            for (std::size_t i = 0; i < totalGraphs; ++i)
+            {
+                decodeTask(i);
+            }
+        }
+        else
+        {
+            std::atomic<std::size_t> next{0};
+            std::vector<std::thread> workers;
+            workers.reserve(threadCount);
+            for (std::size_t t = 0; t < threadCount; ++t)
+            {
+                workers.emplace_back([&]() {
+                    for (;;)
+                    {
+                        const std::size_t index = next.fetch_add(1, std::memory_order_relaxed);
+                        if (index >= totalGraphs)
+                        {
+                            return;
+                        }
+                        decodeTask(index);
+                    }
+                });
+            }
+            for (auto &worker : workers)
+            {
+                worker.join();
+            }
+        }
+
+        for (std::size_t i = 0; i < totalGraphs; ++i)
+        {
+            if (errors[i])
+            {
+                std::rethrow_exception(errors[i]);
+            }
+            design.adoptGraph(std::move(graphs[i]));
+        }
+        archive.loadDesignInfo(design);
+
+        if (timingEnabled)
+        {
+            std::ostringstream details;
+            details << "bytes=" << data.size()
+                    << " graphs=" << totalGraphs
+                    << " threads=" << threadCount;
+            logJsonTiming("load_grhb.total", toMillis(TimingClock::now() - totalStart), details.str());
+        }
+        return design;
+    }
+
 } // namespace wolvrix::lib::load
 
 namespace wolvrix::lib::grh
@@ -1648,4 +1932,10 @@ namespace wolvrix::lib::grh
         return loader.load(json);
     }
 
+    Design Design::fromJsonFile(const std::string &path)
+    {
+        wolvrix::lib::load::LoadJson loader;
+        return loader.loadFile(path);
+    }
+
 } // namespace wolvrix::lib::grh
@@ -1,26 +1,39 @@
 #include "core/store.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <cerrno>
 #include <chrono>
+#include <condition_variable>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <deque>
 #include <exception>
 #include <functional>
 #include <iomanip>
 #include <iostream>
+#include <mutex>
 #include <optional>
 #include <sstream>
 #include <system_error>
+#include <thread>
+#include <type_traits>
 #include <unordered_set>
 #include <utility>
 #include <unordered_map>
 #include <tuple>
 #include <string_view>
+#include <vector>
 
 #include "slang/numeric/SVInt.h"
 #include "slang/text/Json.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
 namespace wolvrix::lib::store
 {
 
@@ -78,6 +91,24 @@ namespace wolvrix::lib::store
             return step;
         }
 
+        std::size_t jsonStoreThreads()
+        {
+            static const std::size_t threads = []() {
+                const char *env = std::getenv("WOLVRIX_JSON_THREADS");
+                if (env && *env != '\0')
+                {
+                    char *end = nullptr;
+                    const unsigned long long value = std::strtoull(env, &end, 10);
+                    if (end != env && *end == '\0' && value > 0)
+                    {
+                        return static_cast<std::size_t>(value);
+                    }
+                }
+                return std::max<std::size_t>(1, static_cast<std::size_t>(std::thread::hardware_concurrency()));
+            }();
+            return threads;
+        }
+
         const char *jsonModeName(JsonPrintMode mode)
         {
             switch (mode)
@@ -649,55 +680,172 @@ namespace wolvrix::lib::store
             return graphs;
         }
 
-        std::string serializeWithJsonWriter(const wolvrix::lib::grh::Design &design,
-                                            std::span<const wolvrix::lib::grh::Graph *const> topGraphs,
-                                            bool pretty)
+        using OutputSink = std::function<void(std::string_view)>;
+
+        // At most this many serialized graphs per worker wait to be flushed to the sink, which
+        // bounds how many per-graph buffers are alive at once.
+        constexpr std::size_t kGraphWindowPerThread = 4;
+
+        struct GraphChunk
+        {
+            std::string text;
+            GraphWriteStats stats;
+            double ms = 0.0;
+            std::exception_ptr error;
+        };
+
+        // Serializes graphs on `threadCount` workers started once per call and hands the chunks
+        // to `emit` strictly in input order, so the output does not depend on scheduling. Workers
+        // pull the next graph index as long as it stays within the window of unflushed chunks.
+        template <typename Serialize, typename Emit>
+        void serializeGraphsInOrder(std::span<const wolvrix::lib::grh::Graph *const> graphs,
+                                    std::size_t threadCount,
+                                    Serialize &&serialize,
+                                    Emit &&emit)
         {
-            auto collectAliases = [&](const wolvrix::lib::grh::Design &source)
-                -> std::vector<std::pair<std::string, std::string>> {
-                std::vector<std::pair<std::string, std::string>> result;
-                for (const auto &graphSymbol : source.graphOrder())
+            const bool timingEnabled = jsonTimingEnabled();
+            auto runTask = [&](std::size_t index, GraphChunk &chunk)
+            {
+                TimingClock::time_point start;
+                if (timingEnabled)
                 {
-                    for (const auto &alias : source.aliasesForGraph(graphSymbol))
-                    {
-                        result.emplace_back(alias, graphSymbol);
-                    }
+                    start = TimingClock::now();
+                }
+                try
+                {
+                    serialize(*graphs[index], chunk);
+                }
+                catch (...)
+                {
+                    chunk.error = std::current_exception();
+                }
+                if (timingEnabled)
+                {
+                    chunk.ms = toMillis(TimingClock::now() - start);
+                }
+            };
+            auto flush = [&](std::size_t index, GraphChunk &chunk)
+            {
+                if (chunk.error)
+                {
+                    std::rethrow_exception(chunk.error);
                 }
-                std::sort(result.begin(), result.end(),
-                          [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
-                return result;
+                emit(index, chunk);
             };
 
-            slang::JsonWriter writer;
-            writer.setPrettyPrint(pretty);
-            writer.startObject();
+            const std::size_t workerCount = std::min(threadCount, graphs.size());
+            if (workerCount <= 1)
+            {
+                for (std::size_t index = 0; index < graphs.size(); ++index)
+                {
+                    GraphChunk chunk;
+                    runTask(index, chunk);
+                    flush(index, chunk);
+                }
+                return;
+            }
 
-            const bool timingEnabled = jsonTimingEnabled();
-            writer.writeProperty("graphs");
-            writer.startArray();
-            for (const wolvrix::lib::grh::Graph *graph : graphsSortedByName(design))
+            const std::size_t window = workerCount * kGraphWindowPerThread;
+            std::vector<GraphChunk> slots(window);
+            std::vector<char> ready(window, 0);
+            std::mutex mutex;
+            std::condition_variable workerCv;
+            std::condition_variable readyCv;
+            std::size_t next = 0;
+            std::size_t flushed = 0;
+            bool stop = false;
+
+            std::vector<std::thread> workers;
+            workers.reserve(workerCount);
+            auto shutdown = [&]()
             {
-                TimingClock::time_point graphStart;
-                if (timingEnabled)
                 {
-                    graphStart = TimingClock::now();
+                    std::lock_guard<std::mutex> lock(mutex);
+                    stop = true;
                 }
-                graph->writeJson(writer);
-                if (timingEnabled)
+                workerCv.notify_all();
+                for (auto &worker : workers)
                 {
-                    const auto graphEnd = TimingClock::now();
-                    std::ostringstream details;
-                    details << "symbol=" << graph->symbol()
-                            << " values=" << graph->values().size()
-                            << " ops=" << graph->operations().size()
-                            << " ports_in=" << graph->inputPorts().size()
-                            << " ports_out=" << graph->outputPorts().size()
-                            << " ports_inout=" << graph->inoutPorts().size();
-                    logJsonTiming("store_json.graph", toMillis(graphEnd - graphStart), details.str());
+                    worker.join();
                 }
+                workers.clear();
+            };
+            for (std::size_t t = 0; t < workerCount; ++t)
+            {
+                workers.emplace_back([&]() {
+                    for (;;)
+                    {
+                        std::size_t index = 0;
+                        {
+                            std::unique_lock<std::mutex> lock(mutex);
+                            workerCv.wait(lock, [&]() {
+                                return stop || next >= graphs.size() || next < flushed + window;
+                            });
+                            if (stop || next >= graphs.size())
+                            {
+                                return;
+                            }
+                            index = next++;
+                        }
+                        // The window bound guarantees the slot was flushed and is owned here.
+                        GraphChunk &chunk = slots[index % window];
+                        chunk = GraphChunk{};
+                        runTask(index, chunk);
+                        {
+                            std::lock_guard<std::mutex> lock(mutex);
+                            ready[index % window] = 1;
+                        }
+                        readyCv.notify_one();
+                    }
+                });
             }
-            writer.endArray();
 
+            try
+            {
+                for (std::size_t index = 0; index < graphs.size(); ++index)
+                {
+                    const std::size_t slot = index % window;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        readyCv.wait(lock, [&]() { return ready[slot] != 0; });
+                    }
+                    flush(index, slots[slot]);
+                    std::string().swap(slots[slot].text);
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        ready[slot] = 0;
+                        flushed = index + 1;
+                    }
+                    workerCv.notify_one();
+                }
+            }
+            catch (...)
+            {
+                shutdown();
+                throw;
+            }
+            shutdown();
+        }
+
+        std::vector<std::pair<std::string, std::string>> collectAliases(const wolvrix::lib::grh::Design &design)
+        {
+            std::vector<std::pair<std::string, std::string>> result;
+            for (const auto &graphSymbol : design.graphOrder())
+            {
+                for (const auto &alias : design.aliasesForGraph(graphSymbol))
+                {
+                    result.emplace_back(alias, graphSymbol);
+                }
+            }
+            std::sort(result.begin(), result.end(),
+                      [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
+            return result;
+        }
+
+        void writeDesignTrailer(slang::JsonWriter &writer,
+                                const wolvrix::lib::grh::Design &design,
+                                std::span<const wolvrix::lib::grh::Graph *const> topGraphs)
+        {
             writer.writeProperty("aliases");
             writer.startObject();
             for (const auto &[alias, graphSymbol] : collectAliases(design))
@@ -727,6 +875,111 @@ namespace wolvrix::lib::store
                 writer.writeValue(graph->symbol());
             }
             writer.endArray();
+        }
+
+        void logGraphWriteTiming(std::string_view label, const wolvrix::lib::grh::Graph &graph, const GraphChunk &chunk)
+        {
+            std::ostringstream details;
+            details << "symbol=" << graph.symbol()
+                    << " values=" << graph.values().size()
+                    << " ops=" << graph.operations().size()
+                    << " ports_in=" << graph.inputPorts().size()
+                    << " ports_out=" << graph.outputPorts().size()
+                    << " ports_inout=" << graph.inoutPorts().size();
+            logJsonTiming(label, chunk.ms, details.str());
+        }
+
+        // A writer may leave a pending separator after its last closed value; the pieces are
+        // joined explicitly below, so drop it.
+        std::string_view trimTrailingComma(std::string_view text)
+        {
+            if (!text.empty() && text.back() == ',')
+            {
+                text.remove_suffix(1);
+            }
+            return text;
+        }
+
+        void serializeCompact(const wolvrix::lib::grh::Design &design,
+                              std::span<const wolvrix::lib::grh::Graph *const> topGraphs,
+                              std::size_t threadCount,
+                              const OutputSink &sink)
+        {
+            // Each graph goes through its own compact writer; the design-level envelope is written
+            // by separate writers and spliced around the graph texts.
+            {
+                slang::JsonWriter head;
+                head.setPrettyPrint(false);
+                head.startObject();
+                head.writeProperty("graphs");
+                head.startArray();
+                sink(head.view());
+            }
+
+            const bool timingEnabled = jsonTimingEnabled();
+            const auto graphs = graphsSortedByName(design);
+            serializeGraphsInOrder(
+                graphs, threadCount,
+                [](const wolvrix::lib::grh::Graph &graph, GraphChunk &chunk)
+                {
+                    slang::JsonWriter writer;
+                    writer.setPrettyPrint(false);
+                    graph.writeJson(writer);
+                    chunk.text = trimTrailingComma(writer.view());
+                },
+                [&](std::size_t index, const GraphChunk &chunk)
+                {
+                    if (index != 0)
+                    {
+                        sink(",");
+                    }
+                    sink(chunk.text);
+                    if (timingEnabled)
+                    {
+                        logGraphWriteTiming("store_json.graph", *graphs[index], chunk);
+                    }
+                });
+            sink("],");
+
+            slang::JsonWriter tail;
+            tail.setPrettyPrint(false);
+            tail.startObject();
+            writeDesignTrailer(tail, design, topGraphs);
+            tail.endObject();
+            std::string_view tailText = trimTrailingComma(tail.view());
+            tailText.remove_prefix(1);
+            sink(tailText);
+        }
+
+        std::string serializeWithJsonWriter(const wolvrix::lib::grh::Design &design,
+                                            std::span<const wolvrix::lib::grh::Graph *const> topGraphs,
+                                            bool pretty)
+        {
+            slang::JsonWriter writer;
+            writer.setPrettyPrint(pretty);
+            writer.startObject();
+
+            const bool timingEnabled = jsonTimingEnabled();
+            writer.writeProperty("graphs");
+            writer.startArray();
+            for (const wolvrix::lib::grh::Graph *graph : graphsSortedByName(design))
+            {
+                GraphChunk chunk;
+                TimingClock::time_point graphStart;
+                if (timingEnabled)
+                {
+                    graphStart = TimingClock::now();
+                }
+                graph->writeJson(writer);
+                if (timingEnabled)
+                {
+                    chunk.ms = toMillis(TimingClock::now() - graphStart);
+                    logGraphWriteTiming("store_json.graph", *graph, chunk);
+                }
+            }
+            writer.endArray();
+
+            writeDesignTrailer(writer, design, topGraphs);
 
             writer.endObject();
             return std::string(writer.view());
@@ -1661,7 +1914,10 @@ namespace wolvrix::lib::store
             out.push_back('}');
         }
 
-        std::string serializePrettyCompact(const wolvrix::lib::grh::Design &design, std::span<const wolvrix::lib::grh::Graph *const> topGraphs)
+        void serializePrettyCompact(const wolvrix::lib::grh::Design &design,
+                                    std::span<const wolvrix::lib::grh::Graph *const> topGraphs,
+                                    std::size_t threadCount,
+                                    const OutputSink &sink)
         {
             std::string out;
             int indent = 0;
@@ -1672,48 +1928,50 @@ namespace wolvrix::lib::store
 
             appendQuotedString(out, "graphs");
             out.append(": [");
+            sink(out);
+            out.clear();
 
             const auto graphs = graphsSortedByName(design);
             const bool timingEnabled = jsonTimingEnabled();
             const std::size_t progressStep = timingEnabled ? jsonTimingStep() : 0;
             if (!graphs.empty())
             {
-                bool first = true;
-                for (const wolvrix::lib::grh::Graph *graph : graphs)
-                {
-                    TimingClock::time_point graphStart;
-                    if (timingEnabled)
+                serializeGraphsInOrder(
+                    graphs, threadCount,
+                    [&](const wolvrix::lib::grh::Graph &graph, GraphChunk &chunk)
                     {
-                        graphStart = TimingClock::now();
-                    }
-                    if (!first)
-                    {
-                        out.push_back(',');
-                    }
-                    appendNewlineAndIndent(out, indent + 1);
-                    GraphWriteStats stats{};
-                    GraphWriteStats *statsPtr = timingEnabled ? &stats : nullptr;
-                    writeGraphPrettyCompact(out, *graph, indent + 1, statsPtr, timingEnabled, progressStep);
-                    if (timingEnabled)
+                        GraphWriteStats *statsPtr = timingEnabled ? &chunk.stats : nullptr;
+                        writeGraphPrettyCompact(chunk.text, graph, indent + 1, statsPtr, timingEnabled, progressStep);
+                    },
+                    [&](std::size_t index, const GraphChunk &chunk)
                     {
-                        const auto graphEnd = TimingClock::now();
-                        std::ostringstream details;
-                        details << "symbol=" << graph->symbol()
-                                << " values=" << stats.valuesCount
-                                << " ops=" << stats.opsCount
-                                << " ports_in=" << stats.portsInCount
-                                << " ports_out=" << stats.portsOutCount
-                                << " ports_inout=" << stats.portsInoutCount
-                                << " sections_ms=decl:" << stats.declaredMs
-                                << ",vals:" << stats.valuesMs
-                                << ",ports_in:" << stats.portsInMs
-                                << ",ports_out:" << stats.portsOutMs
-                                << ",ports_inout:" << stats.portsInoutMs
-                                << ",ops:" << stats.opsMs;
-                        logJsonTiming("store_json.graph", toMillis(graphEnd - graphStart), details.str());
-                    }
-                    first = false;
-                }
+                        if (index != 0)
+                        {
+                            out.push_back(',');
+                        }
+                        appendNewlineAndIndent(out, indent + 1);
+                        sink(out);
+                        out.clear();
+                        sink(chunk.text);
+                        if (timingEnabled)
+                        {
+                            const GraphWriteStats &stats = chunk.stats;
+                            std::ostringstream details;
+                            details << "symbol=" << graphs[index]->symbol()
+                                    << " values=" << stats.valuesCount
+                                    << " ops=" << stats.opsCount
+                                    << " ports_in=" << stats.portsInCount
+                                    << " ports_out=" << stats.portsOutCount
+                                    << " ports_inout=" << stats.portsInoutCount
+                                    << " sections_ms=decl:" << stats.declaredMs
+                                    << ",vals:" << stats.valuesMs
+                                    << ",ports_in:" << stats.portsInMs
+                                    << ",ports_out:" << stats.portsOutMs
+                                    << ",ports_inout:" << stats.portsInoutMs
+                                    << ",ops:" << stats.opsMs;
+                            logJsonTiming("store_json.graph", chunk.ms, details.str());
+                        }
+                    });
                 appendNewlineAndIndent(out, indent);
             }
             out.push_back(']');
@@ -1722,18 +1980,9 @@ namespace wolvrix::lib::store
 
             appendQuotedString(out, "aliases");
             out.append(": {");
-            std::vector<std::pair<std::string, std::string>> aliases;
-            for (const auto &graphSymbol : design.graphOrder())
-            {
-                for (const auto &alias : design.aliasesForGraph(graphSymbol))
-                {
-                    aliases.emplace_back(alias, graphSymbol);
-                }
-            }
+            const auto aliases = collectAliases(design);
             if (!aliases.empty())
             {
-                std::sort(aliases.begin(), aliases.end(),
-                          [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
                 bool firstAlias = true;
                 for (const auto &[alias, graphSymbol] : aliases)
                 {
@@ -1801,24 +2050,212 @@ namespace wolvrix::lib::store
 
             appendNewlineAndIndent(out, indent - 1);
             out.push_back('}');
-            return out;
+            sink(out);
         }
 
-        std::string serializeDesignJson(const wolvrix::lib::grh::Design &design,
-                                         std::span<const wolvrix::lib::grh::Graph *const> topGraphs,
-                                         JsonPrintMode mode)
+        // Graph bodies are produced concurrently for Compact/PrettyCompact and delivered to the
+        // sink in graphsSortedByName order; Pretty keeps a single writer because its
+        // indentation depends on the enclosing context.
+        void serializeDesignJson(const wolvrix::lib::grh::Design &design,
+                                 std::span<const wolvrix::lib::grh::Graph *const> topGraphs,
+                                 JsonPrintMode mode,
+                                 std::size_t threadCount,
+                                 const OutputSink &sink)
         {
             switch (mode)
             {
             case JsonPrintMode::Compact:
-                return serializeWithJsonWriter(design, topGraphs, /* pretty */ false);
+                serializeCompact(design, topGraphs, threadCount, sink);
+                break;
             case JsonPrintMode::Pretty:
-                return serializeWithJsonWriter(design, topGraphs, /* pretty */ true);
+                sink(serializeWithJsonWriter(design, topGraphs, /* pretty */ true));
+                break;
             case JsonPrintMode::PrettyCompact:
             default:
-                return serializePrettyCompact(design, topGraphs);
+                serializePrettyCompact(design, topGraphs, threadCount, sink);
+                break;
             }
         }
+
+        constexpr std::size_t kGrhbHeaderSize = 64;
+
+        template <typename T>
+        void appendPod(std::string &out, T value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+            out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+        }
+
+        void padTo8(std::string &out)
+        {
+            out.append((8 - out.size() % 8) % 8, '\0');
+        }
+
+        // Design-level .grhb string table: reference 0 is the empty string, k names entry k - 1.
+        class GrhbDesignStrings
+        {
+        public:
+            uint32_t ref(std::string_view text)
+            {
+                if (text.empty())
+                {
+                    return 0;
+                }
+                if (auto it = refs_.find(text); it != refs_.end())
+                {
+                    return it->second;
+                }
+                const std::string &stored = entries_.emplace_back(text);
+                const uint32_t ref = static_cast<uint32_t>(entries_.size());
+                refs_.emplace(stored, ref);
+                return ref;
+            }
+
+            void write(std::string &out) const
+            {
+                uint64_t offset = 0;
+                appendPod<uint64_t>(out, offset);
+                for (const std::string &entry : entries_)
+                {
+                    offset += entry.size();
+                    appendPod<uint64_t>(out, offset);
+                }
+                for (const std::string &entry : entries_)
+                {
+                    out.append(entry);
+                }
+                padTo8(out);
+            }
+
+            std::size_t size() const noexcept { return entries_.size(); }
+
+        private:
+            std::deque<std::string> entries_;
+            std::unordered_map<std::string_view, uint32_t> refs_;
+        };
+
+        // Streams a .grhb container to `sink` and returns the final header. The sink first
+        // receives a zeroed placeholder of kGrhbHeaderSize bytes that the caller overwrites once
+        // the section offsets are known.
+        std::string serializeGrhb(const wolvrix::lib::grh::Design &design,
+                                  std::span<const wolvrix::lib::grh::Graph *const> topGraphs,
+                                  std::size_t threadCount,
+                                  const OutputSink &sink)
+        {
+            sink(std::string(kGrhbHeaderSize, '\0'));
+            uint64_t offset = kGrhbHeaderSize;
+
+            struct IndexEntry
+            {
+                uint64_t offset = 0;
+                uint64_t size = 0;
+            };
+            const bool timingEnabled = jsonTimingEnabled();
+            // Lazy graphs that were never loaded are copied through from their stored section;
+            // the rest are loaded (if needed) and encoded by the workers.
+            std::vector<const wolvrix::lib::grh::Graph *> graphs;
+            graphs.reserve(design.graphOrder().size());
+            for (const auto &symbol : design.graphOrder())
+            {
+                if (const wolvrix::lib::grh::Graph *graph = design.peekGraph(symbol))
+                {
+                    graphs.push_back(graph);
+                }
+            }
+            std::vector<IndexEntry> index(graphs.size());
+            serializeGraphsInOrder(
+                graphs, threadCount,
+                [&design](const wolvrix::lib::grh::Graph &graph, GraphChunk &chunk)
+                {
+                    if (const auto section = design.unloadedGrhbSection(graph.symbol()))
+                    {
+                        chunk.text.assign(*section);
+                        return;
+                    }
+                    design.findGraph(graph.symbol())->writeBinary(chunk.text);
+                },
+                [&](std::size_t graphIndex, const GraphChunk &chunk)
+                {
+                    index[graphIndex] = IndexEntry{offset, chunk.text.size()};
+                    sink(chunk.text);
+                    offset += chunk.text.size();
+                    if (timingEnabled)
+                    {
+                        logGraphWriteTiming("store_grhb.graph", *graphs[graphIndex], chunk);
+                    }
+                });
+
+            GrhbDesignStrings strings;
+            std::unordered_map<std::string_view, uint32_t> graphIndexByName;
+            std::string indexSection;
+            for (std::size_t i = 0; i < graphs.size(); ++i)
+            {
+                graphIndexByName.emplace(graphs[i]->symbol(), static_cast<uint32_t>(i));
+                appendPod<uint32_t>(indexSection, strings.ref(graphs[i]->symbol()));
+                appendPod<uint32_t>(indexSection, 0);
+                appendPod<uint64_t>(indexSection, index[i].offset);
+                appendPod<uint64_t>(indexSection, index[i].size);
+            }
+
+            const auto aliases = collectAliases(design);
+            const auto declared = design.declaredSymbols();
+            std::string designSection;
+            appendPod<uint32_t>(designSection, static_cast<uint32_t>(aliases.size()));
+            appendPod<uint32_t>(designSection, static_cast<uint32_t>(declared.size()));
+            appendPod<uint32_t>(designSection, static_cast<uint32_t>(topGraphs.size()));
+            appendPod<uint32_t>(designSection, 0);
+            for (const auto &[alias, graphSymbol] : aliases)
+            {
+                auto it = graphIndexByName.find(graphSymbol);
+                if (it == graphIndexByName.end())
+                {
+                    throw std::runtime_error("Design alias target graph not found: " + graphSymbol);
+                }
+                appendPod<uint32_t>(designSection, strings.ref(alias));
+                appendPod<uint32_t>(designSection, it->second);
+            }
+            for (const auto sym : declared)
+            {
+                std::string_view text = design.symbolText(sym);
+                if (text.empty())
+                {
+                    throw std::runtime_error("Design declared symbol is empty");
+                }
+                appendPod<uint32_t>(designSection, strings.ref(text));
+            }
+            for (const wolvrix::lib::grh::Graph *graph : topGraphs)
+            {
+                appendPod<uint32_t>(designSection, graphIndexByName.at(graph->symbol()));
+            }
+            padTo8(designSection);
+
+            std::string trailer;
+            strings.write(trailer);
+            const uint64_t stringTableOffset = offset;
+            const uint64_t graphIndexOffset = stringTableOffset + trailer.size();
+            trailer.append(indexSection);
+            const uint64_t designOffset = stringTableOffset + trailer.size();
+            trailer.append(designSection);
+            sink(trailer);
+            const uint64_t fileSize = stringTableOffset + trailer.size();
+
+            std::string header;
+            header.append(wolvrix::lib::grh::kGrhbMagic.data(), wolvrix::lib::grh::kGrhbMagic.size());
+            appendPod<uint32_t>(header, wolvrix::lib::grh::kGrhbVersion);
+            appendPod<uint32_t>(header, static_cast<uint32_t>(graphs.size()));
+            appendPod<uint32_t>(header, static_cast<uint32_t>(strings.size()));
+            appendPod<uint64_t>(header, stringTableOffset);
+            appendPod<uint64_t>(header, graphIndexOffset);
+            appendPod<uint64_t>(header, designOffset);
+            appendPod<uint64_t>(header, fileSize);
+            header.resize(kGrhbHeaderSize, '\0');
+            return header;
+        }
+
+        std::size_t resolveStoreThreads(const StoreOptions &options)
+        {
+            return options.threadCount ? options.threadCount : jsonStoreThreads();
+        }
     } // namespace
 
     Store::Store(StoreDiagnostics *diagnostics) : diagnostics_(diagnostics) {}
@@ -1862,7 +2299,8 @@ namespace wolvrix::lib::store
                 return;
             }
 
-            const wolvrix::lib::grh::Graph *graph = design.findGraph(name);
+            // Only the symbol is needed here, so lazy graphs are not loaded.
+            const wolvrix::lib::grh::Graph *graph = design.peekGraph(name);
             if (graph == nullptr)
             {
                 reportError("Top graph not found", std::string(name));
@@ -1925,7 +2363,7 @@ namespace wolvrix::lib::store
             return nullptr;
         }
 
-        auto stream = std::make_unique<std::ofstream>(path, std::ios::out | std::ios::trunc);
+        auto stream = std::make_unique<std::ofstream>(path, std::ios::out | std::ios::trunc | std::ios::binary);
         if (!stream->is_open())
         {
             reportError("Failed to open output file for writing", path.string());
@@ -1963,7 +2401,10 @@ namespace wolvrix::lib::store
 
         try
         {
-            return serializeDesignJson(design, topGraphs, options.jsonMode);
+            std::string jsonText;
+            serializeDesignJson(design, topGraphs, options.jsonMode, resolveStoreThreads(options),
+                                [&](std::string_view chunk) { jsonText.append(chunk); });
+            return jsonText;
         }
         catch (const std::exception &ex)
         {
@@ -1978,35 +2419,191 @@ namespace wolvrix::lib::store
     {
         StoreResult result;
 
-        std::string jsonText;
         const bool timingEnabled = jsonTimingEnabled();
         TimingClock::time_point totalStart;
-        TimingClock::time_point serializeStart;
         if (timingEnabled)
         {
             totalStart = TimingClock::now();
-            serializeStart = totalStart;
         }
+
+        const std::string filename = options.outputFilename.value_or(std::string("grh.json"));
+        const std::filesystem::path outputPath = resolveOutputDir(options) / filename;
+        auto stream = openOutputFile(outputPath);
+        if (!stream)
+        {
+            result.success = false;
+            return result;
+        }
+
+        // Graph texts are streamed to the file as soon as they are ready, so the whole document
+        // never has to be held in memory.
+        const std::size_t threadCount = resolveStoreThreads(options);
+        std::size_t bytesWritten = 0;
+        TimingClock::duration writeTime{};
+        auto writeChunk = [&](std::string_view chunk)
+        {
+            TimingClock::time_point writeStart;
+            if (timingEnabled)
+            {
+                writeStart = TimingClock::now();
+            }
+            stream->write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+            bytesWritten += chunk.size();
+            if (timingEnabled)
+            {
+                writeTime += TimingClock::now() - writeStart;
+            }
+        };
         try
         {
-            jsonText = serializeDesignJson(design, topGraphs, options.jsonMode);
+            serializeDesignJson(design, topGraphs, options.jsonMode, threadCount, writeChunk);
+            stream->flush();
+            if (!*stream)
+            {
+                throw std::runtime_error("write failed: " + outputPath.string());
+            }
         }
         catch (const std::exception &ex)
         {
+            stream.reset();
+            std::error_code ec;
+            std::filesystem::remove(outputPath, ec);
             reportError("Failed to serialize design to JSON: " + std::string(ex.what()));
             result.success = false;
             return result;
         }
         if (timingEnabled)
         {
-            const auto serializeEnd = TimingClock::now();
+            const auto totalEnd = TimingClock::now();
             std::ostringstream details;
-            details << "bytes=" << jsonText.size()
-                    << " mode=" << jsonModeName(options.jsonMode);
-            logJsonTiming("store_json.serialize", toMillis(serializeEnd - serializeStart), details.str());
+            details << "bytes=" << bytesWritten
+                    << " mode=" << jsonModeName(options.jsonMode)
+                    << " threads=" << threadCount;
+            logJsonTiming("store_json.serialize", toMillis(totalEnd - totalStart - writeTime), details.str());
+            std::ostringstream writeDetails;
+            writeDetails << "bytes=" << bytesWritten
+                         << " path=" << outputPath.string();
+            logJsonTiming("store_json.write_file", toMillis(writeTime), writeDetails.str());
+            logJsonTiming("store_json.total", toMillis(totalEnd - totalStart));
         }
+        result.artifacts.push_back(outputPath.string());
+        return result;
+    }
 
-        const std::string filename = options.outputFilename.value_or(std::string("grh.json"));
+    std::optional<std::string> StoreGrhb::storeToString(const wolvrix::lib::grh::Design &design, const StoreOptions &options)
+    {
+        std::vector<const wolvrix::lib::grh::Graph *> topGraphs = resolveTopGraphs(design, options);
+        if (!validateTopGraphs(topGraphs))
+        {
+            return std::nullopt;
+        }
+
+        try
+        {
+            std::string bytes;
+            const std::string header = serializeGrhb(design, topGraphs, resolveStoreThreads(options),
+                                                     [&](std::string_view chunk) { bytes.append(chunk); });
+            bytes.replace(0, header.size(), header);
+            return bytes;
+        }
+        catch (const std::exception &ex)
+        {
+            reportError("Failed to serialize design to grhb: " + std::string(ex.what()));
+            return std::nullopt;
+        }
+    }
+
+    bool StoreGrhb::storeToSharedMemory(const wolvrix::lib::grh::Design &design, const std::string &name,
+                                        const StoreOptions &options)
+    {
+        std::vector<const wolvrix::lib::grh::Graph *> topGraphs = resolveTopGraphs(design, options);
+        if (!validateTopGraphs(topGraphs))
+        {
+            return false;
+        }
+
+        const int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0)
+        {
+            reportError("Failed to create shared memory object: " + std::string(std::strerror(errno)), name);
+            return false;
+        }
+
+        // The image is serialized straight into the mapping, which is grown by doubling and
+        // trimmed at the end. Pages past the written end are never touched, so the object holds
+        // the only copy of the image.
+        char *data = nullptr;
+        std::size_t capacity = 0;
+        std::size_t size = 0;
+        auto reserve = [&](std::size_t needed) {
+            if (needed <= capacity)
+            {
+                return;
+            }
+            const std::size_t next = std::max({capacity * 2, needed, std::size_t{1} << 20});
+            if (::ftruncate(fd, static_cast<off_t>(next)) != 0)
+            {
+                throw std::system_error(errno, std::generic_category(), "Failed to size shared memory object");
+            }
+            if (data)
+            {
+                ::munmap(data, capacity);
+                data = nullptr;
+            }
+            void *mapped = ::mmap(nullptr, next, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (mapped == MAP_FAILED)
+            {
+                capacity = 0;
+                throw std::system_error(errno, std::generic_category(), "Failed to map shared memory object");
+            }
+            data = static_cast<char *>(mapped);
+            capacity = next;
+        };
+        try
+        {
+            const std::string header = serializeGrhb(design, topGraphs, resolveStoreThreads(options),
+                                                     [&](std::string_view chunk) {
+                                                         reserve(size + chunk.size());
+                                                         std::memcpy(data + size, chunk.data(), chunk.size());
+                                                         size += chunk.size();
+                                                     });
+            std::memcpy(data, header.data(), header.size());
+            ::munmap(data, capacity);
+            data = nullptr;
+            if (::ftruncate(fd, static_cast<off_t>(size)) != 0)
+            {
+                throw std::system_error(errno, std::generic_category(), "Failed to size shared memory object");
+            }
+        }
+        catch (const std::exception &ex)
+        {
+            if (data)
+            {
+                ::munmap(data, capacity);
+            }
+            ::close(fd);
+            ::shm_unlink(name.c_str());
+            reportError("Failed to store design to shared memory: " + std::string(ex.what()), name);
+            return false;
+        }
+        ::close(fd);
+        return true;
+    }
+
+    StoreResult StoreGrhb::storeImpl(const wolvrix::lib::grh::Design &design,
+                                     std::span<const wolvrix::lib::grh::Graph *const> topGraphs,
+                                     const StoreOptions &options)
+    {
+        StoreResult result;
+
+        const bool timingEnabled = jsonTimingEnabled();
+        TimingClock::time_point totalStart;
+        if (timingEnabled)
+        {
+            totalStart = TimingClock::now();
+        }
+
+        const std::string filename = options.outputFilename.value_or(std::string("grh.grhb"));
         const std::filesystem::path outputPath = resolveOutputDir(options) / filename;
         auto stream = openOutputFile(outputPath);
         if (!stream)
@@ -2015,21 +2612,38 @@ namespace wolvrix::lib::store
             return result;
         }
 
-        TimingClock::time_point writeStart;
-        if (timingEnabled)
+        const std::size_t threadCount = resolveStoreThreads(options);
+        std::size_t bytesWritten = 0;
+        try
+        {
+            const std::string header = serializeGrhb(design, topGraphs, threadCount, [&](std::string_view chunk) {
+                stream->write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+                bytesWritten += chunk.size();
+            });
+            stream->seekp(0);
+            stream->write(header.data(), static_cast<std::streamsize>(header.size()));
+            stream->flush();
+            if (!*stream)
+            {
+                throw std::runtime_error("write failed: " + outputPath.string());
+            }
+        }
+        catch (const std::exception &ex)
         {
-            writeStart = TimingClock::now();
+            stream.reset();
+            std::error_code ec;
+            std::filesystem::remove(outputPath, ec);
+            reportError("Failed to serialize design to grhb: " + std::string(ex.what()));
+            result.success = false;
+            return result;
         }
-        *stream << jsonText;
         if (timingEnabled)
         {
-            const auto writeEnd = TimingClock::now();
             std::ostringstream details;
-            details << "bytes=" << jsonText.size()
+            details << "bytes=" << bytesWritten
+                    << " threads=" << threadCount
                     << " path=" << outputPath.string();
-            logJsonTiming("store_json.write_file", toMillis(writeEnd - writeStart), details.str());
-            const auto totalEnd = TimingClock::now();
-            logJsonTiming("store_json.total", toMillis(totalEnd - totalStart));
+            logJsonTiming("store_grhb.total", toMillis(TimingClock::now() - totalStart), details.str());
         }
         result.artifacts.push_back(outputPath.string());
         return result;
@@ -17,8 +17,10 @@
 #include "transform/xmr_resolve.hpp"
 #include "transform/strip_debug.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <exception>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -1078,6 +1080,26 @@ namespace wolvrix::lib::transform
                         return nullptr;
                     }
                 }
+                else if (arg == "-threads")
+                {
+                    if (!parseSizeArg("-threads", options.threads))
+                    {
+                        return nullptr;
+                    }
+                }
+                else if (arg.starts_with("-threads="))
+                {
+                    try
+                    {
+                        options.threads = static_cast<std::size_t>(
+                            std::stoull(std::string(arg.substr(std::string_view("-threads=").size()))));
+                    }
+                    catch (const std::exception &)
+                    {
+                        error = "invalid -threads value";
+                        return nullptr;
+                    }
+                }
                 else
                 {
                     error = "unknown hrbcut option";
@@ -1240,6 +1262,50 @@ namespace wolvrix::lib::transform
                         return nullptr;
                     }
                 }
+                else if (arg == "-phase-b-threads")
+                {
+                    if (!parseSizeArg("-phase-b-threads", options.phaseBThreads))
+                    {
+                        return nullptr;
+                    }
+                }
+                else if (arg.starts_with("-phase-b-threads="))
+                {
+                    try
+                    {
+                        options.phaseBThreads = static_cast<std::size_t>(
+                            std::stoull(std::string(arg.substr(std::string_view("-phase-b-threads=").size()))));
+                    }
+                    catch (const std::exception &)
+                    {
+                        error = "invalid -phase-b-threads value";
+                        return nullptr;
+                    }
+                }
+                else if (arg == "-phase-b-scc-cones")
+                {
+                    options.phaseBSccCones = true;
+                }
+                else if (arg == "-phase-e-threads")
+                {
+                    if (!parseSizeArg("-phase-e-threads", options.phaseEThreads))
+                    {
+                        return nullptr;
+                    }
+                }
+                else if (arg.starts_with("-phase-e-threads="))
+                {
+                    try
+                    {
+                        options.phaseEThreads = static_cast<std::size_t>(
+                            std::stoull(std::string(arg.substr(std::string_view("-phase-e-threads=").size()))));
+                    }
+                    catch (const std::exception &)
+                    {
+                        error = "invalid -phase-e-threads value";
+                        return nullptr;
+                    }
+                }
                 else if (arg == "-kahypar-path" || arg.starts_with("-kahypar-path="))
                 {
                     error = "-kahypar-path has been removed; use -partitioner=mt-kahypar instead";
@@ -1249,6 +1315,135 @@ namespace wolvrix::lib::transform
                 {
                     options.keepIntermediateFiles = true;
                 }
+                else if (arg == "-sweep-partition-counts" || arg.starts_with("-sweep-partition-counts="))
+                {
+                    std::string list;
+                    if (arg == "-sweep-partition-counts")
+                    {
+                        if (!parseStringArg("-sweep-partition-counts", list))
+                        {
+                            return nullptr;
+                        }
+                    }
+                    else
+                    {
+                        list = std::string(arg.substr(std::string_view("-sweep-partition-counts=").size()));
+                    }
+                    options.sweepPartitionCounts.clear();
+                    std::size_t begin = 0;
+                    while (begin <= list.size())
+                    {
+                        const std::size_t end = std::min(list.find(',', begin), list.size());
+                        try
+                        {
+                            std::size_t parsed = 0;
+                            const std::string item = list.substr(begin, end - begin);
+                            options.sweepPartitionCounts.push_back(
+                                static_cast<std::size_t>(std::stoull(item, &parsed)));
+                            if (parsed != item.size())
+                            {
+                                throw std::invalid_argument(item);
+                            }
+                        }
+                        catch (const std::exception &)
+                        {
+                            error = "invalid -sweep-partition-counts value";
+                            return nullptr;
+                        }
+                        begin = end + 1;
+                    }
+                }
+                else if (arg == "-sweep-rebuild-best")
+                {
+                    options.sweepRebuildBest = true;
+                }
+                else if (arg == "-cache")
+                {
+                    options.cache = true;
+                }
+                else if (arg == "-cache-dir")
+                {
+                    if (!parseStringArg("-cache-dir", options.cacheDir))
+                    {
+                        return nullptr;
+                    }
+                    options.cache = true;
+                }
+                else if (arg.starts_with("-cache-dir="))
+                {
+                    options.cacheDir = std::string(arg.substr(std::string_view("-cache-dir=").size()));
+                    options.cache = true;
+                }
+                else if (arg == "-edge-weighting")
+                {
+                    if (!parseStringArg("-edge-weighting", options.edgeWeighting))
+                    {
+                        return nullptr;
+                    }
+                }
+                else if (arg.starts_with("-edge-weighting="))
+                {
+                    options.edgeWeighting = std::string(arg.substr(std::string_view("-edge-weighting=").size()));
+                }
+                else if (arg == "-compare-edge-weighting")
+                {
+                    options.compareEdgeWeighting = true;
+                }
+                else if (arg == "-timing-profile")
+                {
+                    if (!parseStringArg("-timing-profile", options.timingProfile))
+                    {
+                        return nullptr;
+                    }
+                }
+                else if (arg.starts_with("-timing-profile="))
+                {
+                    options.timingProfile = std::string(arg.substr(std::string_view("-timing-profile=").size()));
+                }
+                else if (arg == "-asc-partition-map")
+                {
+                    options.ascPartitionMap = true;
+                }
+                else if (arg == "-numa-domains")
+                {
+                    if (!parseSizeArg("-numa-domains", options.numaDomains))
+                    {
+                        return nullptr;
+                    }
+                }
+                else if (arg.starts_with("-numa-domains="))
+                {
+                    try
+                    {
+                        options.numaDomains = static_cast<std::size_t>(
+                            std::stoull(std::string(arg.substr(std::string_view("-numa-domains=").size()))));
+                    }
+                    catch (const std::exception &)
+                    {
+                        error = "invalid -numa-domains value";
+                        return nullptr;
+                    }
+                }
+                else if (arg == "-numa-inter-domain-cost")
+                {
+                    if (!parseDoubleArg("-numa-inter-domain-cost", options.numaInterDomainCost))
+                    {
+                        return nullptr;
+                    }
+                }
+                else if (arg.starts_with("-numa-inter-domain-cost="))
+                {
+                    try
+                    {
+                        options.numaInterDomainCost = std::stod(
+                            std::string(arg.substr(std::string_view("-numa-inter-domain-cost=").size())));
+                    }
+                    catch (const std::exception &)
+                    {
+                        error = "invalid -numa-inter-domain-cost value";
+                        return nullptr;
+                    }
+                }
                 else
                 {
                     error = "unknown repcut option";
@@ -158,6 +158,8 @@ namespace wolvrix::lib::emit
             std::string moduleName;
             std::string sourceSv;
             std::vector<ManifestPort> ports;
+            // NUMA domain from a hierarchical repcut (`repcutNumaDomain`), -1 when not set.
+            int64_t numaDomain = -1;
         };
 
         struct UnitShimInfo
@@ -793,12 +795,16 @@ namespace wolvrix::lib::emit
 
             std::unordered_map<std::string, std::size_t> timingIndexByInstance;
             timingIndexByInstance.reserve(manifest.units.size());
+            std::unordered_map<std::string, int64_t> numaDomainByInstance;
+            bool hasNumaDomains = false;
             std::vector<std::string> modelTypesInOrder;
             std::unordered_set<std::string> seenModelTypes;
             for (std::size_t i = 0; i < manifest.units.size(); ++i)
             {
                 const auto &unit = manifest.units[i];
                 timingIndexByInstance.emplace(unit.instanceName, i);
+                numaDomainByInstance.emplace(unit.instanceName, unit.numaDomain);
+                hasNumaDomains = hasNumaDomains || unit.numaDomain >= 0;
                 const auto &unitInfo = unitInfoByInstance.at(unit.instanceName);
                 if (seenModelTypes.insert(unitInfo.modelType).second)
                 {
@@ -1459,6 +1465,84 @@ namespace wolvrix::lib::emit
             commonSource << "  }\n";
             commonSource << "  return static_cast<std::size_t>(value);\n";
             commonSource << "}\n";
+            if (hasNumaDomains)
+            {
+                commonSource << "\n";
+                commonSource << "// NUMA domain of each eval step, from the repcut part it evaluates.\n";
+                commonSource << "constexpr int kWolviRepcutEvalNumaDomains[] = {";
+                for (std::size_t i = 0; i < evalMethods.size(); ++i)
+                {
+                    commonSource << (i == 0 ? "" : ", ") << numaDomainByInstance.at(evalMethods[i].instanceName);
+                }
+                commonSource << "};\n\n";
+                commonSource << "// Allowed CPUs of every NUMA node that has any, in node order.\n";
+                commonSource << "inline std::vector<std::vector<int>> wolvi_repcut_numa_node_cpus(const std::vector<int>& allowed) {\n";
+                commonSource << "  std::vector<std::vector<int>> nodes;\n";
+                commonSource << "#if defined(__linux__)\n";
+                commonSource << "  for (int node = 0;; ++node) {\n";
+                commonSource << "    char path[96];\n";
+                commonSource << "    std::snprintf(path, sizeof(path), \"/sys/devices/system/node/node%d/cpulist\", node);\n";
+                commonSource << "    FILE* file = std::fopen(path, \"r\");\n";
+                commonSource << "    if (file == nullptr) {\n";
+                commonSource << "      break;\n";
+                commonSource << "    }\n";
+                commonSource << "    char line[4096] = {};\n";
+                commonSource << "    const bool readOk = std::fgets(line, sizeof(line), file) != nullptr;\n";
+                commonSource << "    std::fclose(file);\n";
+                commonSource << "    std::vector<int> cpus;\n";
+                commonSource << "    const char* cursor = line;\n";
+                commonSource << "    while (readOk && *cursor != '\\0' && *cursor != '\\n') {\n";
+                commonSource << "      char* end = nullptr;\n";
+                commonSource << "      const long first = std::strtol(cursor, &end, 10);\n";
+                commonSource << "      if (end == cursor) {\n";
+                commonSource << "        break;\n";
+                commonSource << "      }\n";
+                commonSource << "      long last = first;\n";
+                commonSource << "      cursor = end;\n";
+                commonSource << "      if (*cursor == '-') {\n";
+                commonSource << "        last = std::strtol(cursor + 1, &end, 10);\n";
+                commonSource << "        cursor = end;\n";
+                commonSource << "      }\n";
+                commonSource << "      for (long cpu = first; cpu <= last; ++cpu) {\n";
+                commonSource << "        if (std::find(allowed.begin(), allowed.end(), static_cast<int>(cpu)) != allowed.end()) {\n";
+                commonSource << "          cpus.push_back(static_cast<int>(cpu));\n";
+                commonSource << "        }\n";
+                commonSource << "      }\n";
+                commonSource << "      if (*cursor == ',') {\n";
+                commonSource << "        ++cursor;\n";
+                commonSource << "      }\n";
+                commonSource << "    }\n";
+                commonSource << "    if (!cpus.empty()) {\n";
+                commonSource << "      nodes.push_back(std::move(cpus));\n";
+                commonSource << "    }\n";
+                commonSource << "  }\n";
+                commonSource << "#else\n";
+                commonSource << "  (void)allowed;\n";
+                commonSource << "#endif\n";
+                commonSource << "  return nodes;\n";
+                commonSource << "}\n\n";
+                commonSource << "// Gives every worker a CPU on the NUMA node of its domain (domain modulo node count).\n";
+                commonSource << "// Returns an empty list, keeping the plain CPU order, when the host has fewer than two\n";
+                commonSource << "// nodes or a node runs out of CPUs.\n";
+                commonSource << "inline std::vector<int> wolvi_repcut_numa_worker_cpus(const std::vector<int>& allowed,\n";
+                commonSource << "                                                   const std::vector<int>& workerDomains) {\n";
+                commonSource << "  const std::vector<std::vector<int>> nodes = wolvi_repcut_numa_node_cpus(allowed);\n";
+                commonSource << "  if (nodes.size() < 2) {\n";
+                commonSource << "    return {};\n";
+                commonSource << "  }\n";
+                commonSource << "  std::vector<std::size_t> nextCpu(nodes.size(), 0);\n";
+                commonSource << "  std::vector<int> cpus;\n";
+                commonSource << "  cpus.reserve(workerDomains.size());\n";
+                commonSource << "  for (const int domain : workerDomains) {\n";
+                commonSource << "    const std::size_t node = domain < 0 ? 0 : static_cast<std::size_t>(domain) % nodes.size();\n";
+                commonSource << "    if (nextCpu[node] >= nodes[node].size()) {\n";
+                commonSource << "      return {};\n";
+                commonSource << "    }\n";
+                commonSource << "    cpus.push_back(nodes[node][nextCpu[node]++]);\n";
+                commonSource << "  }\n";
+                commonSource << "  return cpus;\n";
+                commonSource << "}\n";
+            }
             commonSource << "} // namespace\n\n";
 
             for (const auto &signal : constSignals)
@@ -1545,6 +1629,23 @@ namespace wolvrix::lib::emit
             commonSource << "  if (!phase_cpu_ids_.empty()) {\n";
             commonSource << "    phase_cpu_ids_.resize(phase_worker_count_);\n";
             commonSource << "  }\n";
+            if (hasNumaDomains)
+            {
+                // Worker i runs a contiguous slice of the eval steps; pin it to the node of the
+                // domain its slice starts in.
+                commonSource << "  std::vector<int> workerNumaDomains(phase_worker_count_, -1);\n";
+                commonSource << "  for (std::size_t workerIndex = 0; workerIndex < phase_worker_count_; ++workerIndex) {\n";
+                commonSource << "    const std::size_t begin = eval_step_fns_.size() * workerIndex / phase_worker_count_;\n";
+                commonSource << "    if (begin < eval_step_fns_.size()) {\n";
+                commonSource << "      workerNumaDomains[workerIndex] = kWolviRepcutEvalNumaDomains[begin];\n";
+                commonSource << "    }\n";
+                commonSource << "  }\n";
+                commonSource << "  std::vector<int> numaCpuIds =\n";
+                commonSource << "      wolvi_repcut_numa_worker_cpus(wolvi_repcut_available_cpus(), workerNumaDomains);\n";
+                commonSource << "  if (!numaCpuIds.empty()) {\n";
+                commonSource << "    phase_cpu_ids_ = std::move(numaCpuIds);\n";
+                commonSource << "  }\n";
+            }
             commonSource << "  part_timing_worker_stats_.assign(phase_worker_count_, {});\n";
             commonSource << "  phase_workers_ = std::make_unique<PhaseWorker[]>(phase_worker_count_);\n";
             commonSource << "  for (std::size_t workerIndex = 0; workerIndex < phase_worker_count_; ++workerIndex) {\n";
@@ -2267,6 +2368,7 @@ namespace wolvrix::lib::emit
                 storedShim.wrapperModuleName,
                 storedShim.wrapperSourceSv,
                 storedShim.wrapperPorts,
+                getAttribute<int64_t>(op, "repcutNumaDomain").value_or(-1),
             });
 
             const auto operands = topGraph.opOperands(opId);
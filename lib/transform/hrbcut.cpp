@@ -1,13 +1,21 @@
 #include "transform/hrbcut.hpp"
 
+#include "transform/cone_bitmap.hpp"
+
 #include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cmath>
 #include <cstddef>
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
+#include <exception>
 #include <functional>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <random>
 #include <sstream>
@@ -39,17 +47,21 @@ namespace wolvrix::lib::transform
             wolvrix::lib::grh::ValueId value = wolvrix::lib::grh::ValueId::invalid();
         };
 
+        using detail::ConeBitmap;
+
+        // Cones are keyed by operation slot index (OperationId::index), which is dense within
+        // the graph being cut.
         struct ConeInfo
         {
-            std::unordered_set<wolvrix::lib::grh::OperationId, wolvrix::lib::grh::OperationIdHash> combOps;
-            std::unordered_set<wolvrix::lib::grh::ValueId, wolvrix::lib::grh::ValueIdHash> values;
-            std::unordered_set<std::string> memSymbols;
+            ConeBitmap combOps;
+            // Indices into the memory write groups whose memories this cone reads, sorted.
+            std::vector<uint32_t> memWriteGroups;
         };
 
         struct AscInfo
         {
             std::vector<std::size_t> sinks;
-            std::unordered_set<wolvrix::lib::grh::OperationId, wolvrix::lib::grh::OperationIdHash> combOps;
+            ConeBitmap combOps;
             double weight = 0.0;
         };
 
@@ -163,6 +175,253 @@ namespace wolvrix::lib::transform
             }
         }
 
+        // Fork-join pool for the split tree. Every worker owns a deque: it pushes and pops its own
+        // tasks at the back and steals from the front of the others. A thread waiting on a
+        // TaskGroup only runs queued tasks of that group, so a nested wait never piles unrelated
+        // work onto its stack, and sleeps on the group once none are left after a short spin. The
+        // thread that created the pool takes part as one more worker while it waits.
+        class WorkStealingPool
+        {
+        public:
+            struct TaskGroup
+            {
+                std::atomic<std::size_t> pending{0};
+                std::atomic<std::size_t> queued{0};
+                std::mutex errorMutex;
+                std::exception_ptr error;
+                // Guards the last decrement of `pending` and wakes a waiter blocked on the group.
+                std::mutex waitMutex;
+                std::condition_variable waitCv;
+            };
+
+            explicit WorkStealingPool(std::size_t threadCount)
+                : queues_(std::max<std::size_t>(1, threadCount))
+            {
+                threads_.reserve(queues_.size() - 1);
+                for (std::size_t worker = 1; worker < queues_.size(); ++worker)
+                {
+                    threads_.emplace_back([this, worker]() { workerLoop(worker); });
+                }
+            }
+
+            ~WorkStealingPool()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(sleepMutex_);
+                    stop_ = true;
+                }
+                sleepCv_.notify_all();
+                for (auto &thread : threads_)
+                {
+                    thread.join();
+                }
+            }
+
+            WorkStealingPool(const WorkStealingPool &) = delete;
+            WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+            void spawn(TaskGroup &group, std::function<void()> fn)
+            {
+                group.pending.fetch_add(1, std::memory_order_relaxed);
+                const std::size_t worker = currentWorker();
+                Queue &queue = queues_[worker < queues_.size() ? worker : 0];
+                {
+                    std::lock_guard<std::mutex> lock(queue.mutex);
+                    queue.tasks.push_back(Task{&group, std::move(fn)});
+                }
+                group.queued.fetch_add(1, std::memory_order_release);
+                queued_.fetch_add(1, std::memory_order_release);
+                {
+                    // Pairs with the predicate check in workerLoop, so the wakeup is not lost.
+                    std::lock_guard<std::mutex> lock(sleepMutex_);
+                }
+                sleepCv_.notify_one();
+                {
+                    // Same for a thread blocked in wait() on this group.
+                    std::lock_guard<std::mutex> lock(group.waitMutex);
+                }
+                group.waitCv.notify_one();
+            }
+
+            // Returns once every task spawned into `group` has finished, rethrowing the first
+            // exception one of them raised.
+            void wait(TaskGroup &group)
+            {
+                const std::size_t worker = currentWorker() < queues_.size() ? currentWorker() : 0;
+                const PoolBinding binding(this, worker);
+                std::size_t idleRounds = 0;
+                while (group.pending.load(std::memory_order_acquire) != 0)
+                {
+                    if (runOne(worker, &group))
+                    {
+                        idleRounds = 0;
+                        continue;
+                    }
+                    // The remaining tasks are running on other threads; spin briefly, then sleep
+                    // until one of them finishes the group or spawns more work into it.
+                    if (++idleRounds < kWaitSpinRounds)
+                    {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    std::unique_lock<std::mutex> lock(group.waitMutex);
+                    group.waitCv.wait(lock, [&group]() {
+                        return group.pending.load(std::memory_order_acquire) == 0 ||
+                               group.queued.load(std::memory_order_acquire) != 0;
+                    });
+                    idleRounds = 0;
+                }
+                {
+                    // The thread that finished the last task may still hold waitMutex; the group
+                    // must outlive it.
+                    std::lock_guard<std::mutex> lock(group.waitMutex);
+                }
+                if (group.error)
+                {
+                    std::rethrow_exception(group.error);
+                }
+            }
+
+        private:
+            struct Task
+            {
+                TaskGroup *group = nullptr;
+                std::function<void()> fn;
+            };
+
+            struct Queue
+            {
+                std::mutex mutex;
+                std::deque<Task> tasks;
+            };
+
+            // Which pool and worker slot the calling thread runs as.
+            struct PoolBinding
+            {
+                PoolBinding(WorkStealingPool *pool, std::size_t worker)
+                    : savedPool(tlsPool), savedWorker(tlsWorker)
+                {
+                    tlsPool = pool;
+                    tlsWorker = worker;
+                }
+                ~PoolBinding()
+                {
+                    tlsPool = savedPool;
+                    tlsWorker = savedWorker;
+                }
+                WorkStealingPool *savedPool;
+                std::size_t savedWorker;
+            };
+
+            static constexpr std::size_t kWaitSpinRounds = 64;
+
+            static inline thread_local WorkStealingPool *tlsPool = nullptr;
+            static inline thread_local std::size_t tlsWorker = 0;
+
+            std::size_t currentWorker() const
+            {
+                return tlsPool == this ? tlsWorker : std::numeric_limits<std::size_t>::max();
+            }
+
+            // Takes the newest task of the own queue or the oldest of another one. With `only`
+            // set, tasks of other groups are skipped.
+            bool takeTask(std::size_t worker, const TaskGroup *only, Task &task)
+            {
+                const auto matches = [only](const Task &candidate) {
+                    return only == nullptr || candidate.group == only;
+                };
+                {
+                    Queue &own = queues_[worker];
+                    std::lock_guard<std::mutex> lock(own.mutex);
+                    const auto it = std::find_if(own.tasks.rbegin(), own.tasks.rend(), matches);
+                    if (it != own.tasks.rend())
+                    {
+                        task = std::move(*it);
+                        own.tasks.erase(std::next(it).base());
+                        return true;
+                    }
+                }
+                for (std::size_t offset = 1; offset < queues_.size(); ++offset)
+                {
+                    Queue &victim = queues_[(worker + offset) % queues_.size()];
+                    std::lock_guard<std::mutex> lock(victim.mutex);
+                    const auto it = std::find_if(victim.tasks.begin(), victim.tasks.end(), matches);
+                    if (it != victim.tasks.end())
+                    {
+                        task = std::move(*it);
+                        victim.tasks.erase(it);
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            bool runOne(std::size_t worker, TaskGroup *only = nullptr)
+            {
+                if (queued_.load(std::memory_order_acquire) == 0 ||
+                    (only != nullptr && only->queued.load(std::memory_order_acquire) == 0))
+                {
+                    return false;
+                }
+                Task task;
+                if (!takeTask(worker, only, task))
+                {
+                    return false;
+                }
+                queued_.fetch_sub(1, std::memory_order_relaxed);
+                task.group->queued.fetch_sub(1, std::memory_order_relaxed);
+                try
+                {
+                    task.fn();
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(task.group->errorMutex);
+                    if (!task.group->error)
+                    {
+                        task.group->error = std::current_exception();
+                    }
+                }
+                TaskGroup &group = *task.group;
+                task = Task{};
+                {
+                    std::lock_guard<std::mutex> lock(group.waitMutex);
+                    if (group.pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    {
+                        group.waitCv.notify_all();
+                    }
+                }
+                return true;
+            }
+
+            void workerLoop(std::size_t worker)
+            {
+                const PoolBinding binding(this, worker);
+                for (;;)
+                {
+                    if (runOne(worker))
+                    {
+                        continue;
+                    }
+                    std::unique_lock<std::mutex> lock(sleepMutex_);
+                    sleepCv_.wait(lock, [this]() {
+                        return stop_ || queued_.load(std::memory_order_acquire) != 0;
+                    });
+                    if (stop_)
+                    {
+                        return;
+                    }
+                }
+            }
+
+            std::vector<Queue> queues_;
+            std::vector<std::thread> threads_;
+            std::atomic<std::size_t> queued_{0};
+            std::mutex sleepMutex_;
+            std::condition_variable sleepCv_;
+            bool stop_ = false;
+        };
+
         template <typename T>
         std::optional<T> getAttr(const wolvrix::lib::grh::Operation &op, std::string_view key)
         {
@@ -284,20 +543,12 @@ namespace wolvrix::lib::transform
             }
         }
 
-        bool isPowerOfTwo(std::size_t value)
+        uint64_t splitMix64(uint64_t value)
         {
-            return value && ((value & (value - 1)) == 0);
-        }
-
-        std::size_t log2Exact(std::size_t value)
-        {
-            std::size_t result = 0;
-            while (value > 1)
-            {
-                value >>= 1;
-                ++result;
-            }
-            return result;
+            value += 0x9e3779b97f4a7c15ULL;
+            value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+            return value ^ (value >> 31);
         }
 
         double combOpWeight(const wolvrix::lib::grh::Graph &graph,
@@ -377,37 +628,30 @@ namespace wolvrix::lib::transform
             return wB / (wA + wB + kBalanceEpsilon);
         }
 
+        // `weights` is indexed by operation slot index.
         double computeOverlap(const std::vector<AscInfo> &ascs,
                               const std::vector<std::size_t> &a,
                               const std::vector<std::size_t> &b,
-                              const std::unordered_map<wolvrix::lib::grh::OperationId, double,
-                                                       wolvrix::lib::grh::OperationIdHash> &weights)
+                              const std::vector<double> &weights)
         {
-            std::unordered_set<wolvrix::lib::grh::OperationId, wolvrix::lib::grh::OperationIdHash> opsA;
-            std::unordered_set<wolvrix::lib::grh::OperationId, wolvrix::lib::grh::OperationIdHash> opsB;
+            ConeBitmap opsA;
+            ConeBitmap opsB;
             for (std::size_t id : a)
             {
-                opsA.insert(ascs[id].combOps.begin(), ascs[id].combOps.end());
+                opsA.unionWith(ascs[id].combOps);
             }
             for (std::size_t id : b)
             {
-                opsB.insert(ascs[id].combOps.begin(), ascs[id].combOps.end());
+                opsB.unionWith(ascs[id].combOps);
             }
             if (opsA.empty() || opsB.empty())
             {
                 return 0.0;
             }
-            const auto &smaller = opsA.size() <= opsB.size() ? opsA : opsB;
-            const auto &larger = opsA.size() <= opsB.size() ? opsB : opsA;
             double overlap = 0.0;
-            for (const auto &opId : smaller)
-            {
-                if (larger.find(opId) != larger.end())
-                {
-                    auto it = weights.find(opId);
-                    overlap += (it != weights.end()) ? it->second : 0.0;
-                }
-            }
+            opsA.forEachIntersection(opsB, [&](uint32_t opIndex) {
+                overlap += opIndex < weights.size() ? weights[opIndex] : 0.0;
+            });
             return overlap;
         }
 
@@ -423,13 +667,19 @@ namespace wolvrix::lib::transform
             return items;
         }
 
-        std::pair<std::vector<std::size_t>, std::vector<std::size_t>> randomSplitEven(std::vector<std::size_t> items,
-                                                                                       std::mt19937 &rng)
+        // Shuffles items and gives A the share 1 - targetBalance of them (half, rounded down, for
+        // an even split).
+        std::pair<std::vector<std::size_t>, std::vector<std::size_t>> randomSplitTarget(std::vector<std::size_t> items,
+                                                                                          double targetBalance,
+                                                                                          std::mt19937 &rng)
         {
             std::shuffle(items.begin(), items.end(), rng);
-            const std::size_t half = items.size() / 2;
-            std::vector<std::size_t> a(items.begin(), items.begin() + half);
-            std::vector<std::size_t> b(items.begin() + half, items.end());
+            const std::size_t countB = std::min(
+                items.size(),
+                static_cast<std::size_t>(std::llround(static_cast<double>(items.size()) * targetBalance)));
+            const std::size_t countA = items.size() - countB;
+            std::vector<std::size_t> a(items.begin(), items.begin() + countA);
+            std::vector<std::size_t> b(items.begin() + countA, items.end());
             return {std::move(a), std::move(b)};
         }
 
@@ -463,8 +713,11 @@ namespace wolvrix::lib::transform
             return {std::move(a), std::move(b)};
         }
 
+        // targetBalance is the share of the weight B should end up with. Only the first random
+        // split aims for it; later batches follow the current A/B ratio.
         PartitionSolution splitRecursiveBalance(const std::vector<AscInfo> &ascs,
                                                 const std::vector<std::size_t> &ascIds,
+                                                double targetBalance,
                                                 std::size_t splitStopThreshold,
                                                 std::mt19937 &rng)
         {
@@ -487,7 +740,7 @@ namespace wolvrix::lib::transform
                 }
             }
 
-            auto split = randomSplitEven(std::move(H), rng);
+            auto split = randomSplitTarget(std::move(H), targetBalance, rng);
             std::vector<std::size_t> A = std::move(split.first);
             std::vector<std::size_t> B = std::move(split.second);
 
@@ -526,15 +779,18 @@ namespace wolvrix::lib::transform
             return sol;
         }
 
+        // Trials run as tasks on `pool`. Trial i is seeded from baseSeed and i only, and trials are
+        // ranked in index order, so the choice does not depend on the thread count.
         PartitionSolution multiSampleSelect(const std::vector<AscInfo> &ascs,
                                             const std::vector<std::size_t> &ascIds,
+                                            double targetBalance,
                                             double balanceThreshold,
                                             std::size_t targetCandidateCount,
                                             std::size_t maxTrials,
                                             std::size_t splitStopThreshold,
-                                            const std::unordered_map<wolvrix::lib::grh::OperationId, double,
-                                                                     wolvrix::lib::grh::OperationIdHash> &weights,
-                                            std::mt19937 &rng,
+                                            const std::vector<double> &weights,
+                                            uint64_t baseSeed,
+                                            WorkStealingPool &pool,
                                             const std::function<void(std::string)> &log)
         {
             PartitionSolution best;
@@ -555,32 +811,32 @@ namespace wolvrix::lib::transform
                     " split_stop=" + std::to_string(splitStopThreshold));
             }
 
-            const uint64_t baseSeed = (static_cast<uint64_t>(rng()) << 32) ^ static_cast<uint64_t>(rng());
             std::vector<PartitionSolution> trials(maxTrials);
-            struct TrialLocal
-            {
-            };
-            std::vector<TrialLocal> trialLocals;
-            runParallelTasks(maxTrials, trialLocals, [&](std::size_t index, TrialLocal &) {
-                const uint64_t seed = baseSeed ^
-                    (0x9e3779b97f4a7c15ULL + static_cast<uint64_t>(index) * 0xbf58476d1ce4e5b9ULL);
-                std::seed_seq seq{
-                    static_cast<uint32_t>(seed),
-                    static_cast<uint32_t>(seed >> 32),
-                    static_cast<uint32_t>(index)};
-                std::mt19937 localRng(seq);
-                trials[index] = splitRecursiveBalance(ascs, ascIds, splitStopThreshold, localRng);
-            });
+            WorkStealingPool::TaskGroup trialGroup;
+            for (std::size_t index = 0; index < maxTrials; ++index)
+            {
+                pool.spawn(trialGroup, [&, index]() {
+                    const uint64_t seed = baseSeed ^
+                        (0x9e3779b97f4a7c15ULL + static_cast<uint64_t>(index) * 0xbf58476d1ce4e5b9ULL);
+                    std::seed_seq seq{
+                        static_cast<uint32_t>(seed),
+                        static_cast<uint32_t>(seed >> 32),
+                        static_cast<uint32_t>(index)};
+                    std::mt19937 localRng(seq);
+                    trials[index] = splitRecursiveBalance(ascs, ascIds, targetBalance, splitStopThreshold, localRng);
+                });
+            }
+            pool.wait(trialGroup);
 
             for (auto &trial : trials)
             {
                 trial.balance = computeBalance(ascs, trial.a, trial.b);
-                if (!bestSet || std::abs(trial.balance - 0.5) < std::abs(best.balance - 0.5))
+                if (!bestSet || std::abs(trial.balance - targetBalance) < std::abs(best.balance - targetBalance))
                 {
                     best = trial;
                     bestSet = true;
                 }
-                if (std::abs(trial.balance - 0.5) <= balanceThreshold)
+                if (std::abs(trial.balance - targetBalance) <= balanceThreshold)
                 {
                     accepted.push_back(trial);
                     if (accepted.size() >= targetCandidateCount)
@@ -828,9 +1084,9 @@ namespace wolvrix::lib::transform
             result.failed = true;
             return result;
         }
-        if (!isPowerOfTwo(options_.partitionCount))
+        if (options_.partitionCount == 0)
         {
-            error("hrbcut partition_count must be a power of two");
+            error("hrbcut partition_count must be >= 1");
             result.failed = true;
             return result;
         }
@@ -970,24 +1226,57 @@ namespace wolvrix::lib::transform
         }
 
         const auto coneStart = std::chrono::steady_clock::now();
+        uint32_t maxOpIndex = 0;
+        for (const auto opId : ops)
+        {
+            maxOpIndex = std::max(maxOpIndex, opId.index);
+        }
+        uint32_t maxValueIndex = 0;
+        for (const auto valueId : values)
+        {
+            maxValueIndex = std::max(maxValueIndex, valueId.index);
+        }
+        std::vector<wolvrix::lib::grh::OperationId> opByIndex(static_cast<std::size_t>(maxOpIndex) + 1);
+        for (const auto opId : ops)
+        {
+            opByIndex[opId.index] = opId;
+        }
+
+        std::unordered_map<std::string, uint32_t> memWriteGroupBySymbol;
+        std::vector<const std::vector<std::size_t> *> memWriteGroups;
+        memWriteGroupBySymbol.reserve(memWriteSinks.size());
+        memWriteGroups.reserve(memWriteSinks.size());
+        for (const auto &entry : memWriteSinks)
+        {
+            memWriteGroupBySymbol.emplace(entry.first, static_cast<uint32_t>(memWriteGroups.size()));
+            memWriteGroups.push_back(&entry.second);
+        }
+
         std::vector<ConeInfo> sinkCones(sinks.size());
+        // Visit marks are per worker and reset by bumping the epoch, so a cone only keeps its
+        // final operation bitmap.
         struct ConeLocal
         {
             std::vector<wolvrix::lib::grh::OperationId> missingMemSymbols;
+            std::vector<uint32_t> valueStamp;
+            std::vector<uint32_t> opStamp;
+            uint32_t epoch = 0;
+            std::vector<uint32_t> coneOps;
         };
 
         auto traverseValue = [&](auto &&self,
                                  ConeInfo &cone,
                                  wolvrix::lib::grh::ValueId valueId,
-                                 ConeLocal *local) -> void {
+                                 ConeLocal &local) -> void {
             if (!valueId.valid())
             {
                 return;
             }
-            if (!cone.values.insert(valueId).second)
+            if (local.valueStamp[valueId.index] == local.epoch)
             {
                 return;
             }
+            local.valueStamp[valueId.index] = local.epoch;
             if (graph->valueIsInput(valueId) || inoutInputs.find(valueId) != inoutInputs.end())
             {
                 return;
@@ -1006,23 +1295,22 @@ namespace wolvrix::lib::transform
             {
                 return;
             }
-            if (!cone.combOps.insert(defOpId).second)
+            if (local.opStamp[defOpId.index] == local.epoch)
             {
                 return;
             }
+            local.opStamp[defOpId.index] = local.epoch;
+            local.coneOps.push_back(defOpId.index);
             if (defOp.kind() == wolvrix::lib::grh::OperationKind::kMemoryReadPort)
             {
                 auto memSym = getAttrString(defOp, "memSymbol");
                 if (!memSym)
                 {
-                    if (local)
-                    {
-                        local->missingMemSymbols.push_back(defOpId);
-                    }
+                    local.missingMemSymbols.push_back(defOpId);
                 }
-                else
+                else if (auto it = memWriteGroupBySymbol.find(*memSym); it != memWriteGroupBySymbol.end())
                 {
-                    cone.memSymbols.insert(*memSym);
+                    cone.memWriteGroups.push_back(it->second);
                 }
             }
             for (const auto operand : defOp.operands())
@@ -1035,18 +1323,35 @@ namespace wolvrix::lib::transform
         runParallelTasks(sinks.size(), coneLocals, [&](std::size_t index, ConeLocal &local) {
             ConeInfo &cone = sinkCones[index];
             const SinkRef &sink = sinks[index];
+            if (local.opStamp.empty())
+            {
+                local.valueStamp.assign(static_cast<std::size_t>(maxValueIndex) + 1, 0);
+                local.opStamp.assign(static_cast<std::size_t>(maxOpIndex) + 1, 0);
+            }
+            if (++local.epoch == 0)
+            {
+                std::fill(local.valueStamp.begin(), local.valueStamp.end(), 0);
+                std::fill(local.opStamp.begin(), local.opStamp.end(), 0);
+                local.epoch = 1;
+            }
+            local.coneOps.clear();
             if (sink.kind == SinkRef::Kind::Operation)
             {
                 const auto op = graph->getOperation(sink.op);
                 for (const auto operand : op.operands())
                 {
-                    traverseValue(traverseValue, cone, operand, &local);
+                    traverseValue(traverseValue, cone, operand, local);
                 }
             }
             else
             {
-                traverseValue(traverseValue, cone, sink.value, &local);
+                traverseValue(traverseValue, cone, sink.value, local);
             }
+            std::sort(local.coneOps.begin(), local.coneOps.end());
+            cone.combOps = ConeBitmap::fromSorted(local.coneOps);
+            std::sort(cone.memWriteGroups.begin(), cone.memWriteGroups.end());
+            cone.memWriteGroups.erase(std::unique(cone.memWriteGroups.begin(), cone.memWriteGroups.end()),
+                                      cone.memWriteGroups.end());
         });
 
         std::unordered_set<wolvrix::lib::grh::OperationId, wolvrix::lib::grh::OperationIdHash> missingMemOps;
@@ -1064,13 +1369,16 @@ namespace wolvrix::lib::transform
                 warning(*graph, graph->getOperation(opId), "kMemoryReadPort missing memSymbol");
             }
         }
-        std::unordered_set<wolvrix::lib::grh::OperationId, wolvrix::lib::grh::OperationIdHash> coneCombOps;
-        coneCombOps.reserve(ops.size());
+        coneLocals.clear();
+        ConeBitmap coneCombOps;
+        std::size_t coneBitmapBytes = 0;
         for (const auto &cone : sinkCones)
         {
-            coneCombOps.insert(cone.combOps.begin(), cone.combOps.end());
+            coneCombOps.unionWith(cone.combOps);
+            coneBitmapBytes += cone.combOps.memoryBytes();
         }
-        logInfo("hrbcut: cone build done comb_ops=" + std::to_string(coneCombOps.size()) + " in " +
+        logInfo("hrbcut: cone build done comb_ops=" + std::to_string(coneCombOps.size()) +
+                " bitmap_bytes=" + std::to_string(coneBitmapBytes) + " in " +
                 std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(
                                    std::chrono::steady_clock::now() - coneStart)
                                    .count()) +
@@ -1101,15 +1409,9 @@ namespace wolvrix::lib::transform
 
         for (std::size_t i = 0; i < sinks.size(); ++i)
         {
-            for (const auto &memSym : sinkCones[i].memSymbols)
+            for (const uint32_t group : sinkCones[i].memWriteGroups)
             {
-                auto it = memWriteSinks.find(memSym);
-                if (it == memWriteSinks.end())
-                {
-                    continue;
-                }
-                const auto &indices = it->second;
-                for (std::size_t idx : indices)
+                for (std::size_t idx : *memWriteGroups[group])
                 {
                     dsu.unite(i, idx);
                 }
@@ -1139,30 +1441,23 @@ namespace wolvrix::lib::transform
                                    .count()) +
                 "ms");
 
-        std::unordered_map<wolvrix::lib::grh::OperationId, double, wolvrix::lib::grh::OperationIdHash> opWeights;
-        opWeights.reserve(ops.size());
+        std::vector<double> opWeights(static_cast<std::size_t>(maxOpIndex) + 1, 0.0);
+        coneCombOps.forEach([&](uint32_t opIndex) {
+            opWeights[opIndex] = combOpWeight(*graph, graph->getOperation(opByIndex[opIndex]));
+        });
 
         for (auto &asc : ascs)
         {
             for (std::size_t sinkIdx : asc.sinks)
             {
-                const auto &cone = sinkCones[sinkIdx];
-                asc.combOps.insert(cone.combOps.begin(), cone.combOps.end());
+                asc.combOps.unionWith(sinkCones[sinkIdx].combOps);
             }
             double weight = 0.0;
-            for (const auto &opId : asc.combOps)
-            {
-                auto it = opWeights.find(opId);
-                if (it == opWeights.end())
-                {
-                    const auto op = graph->getOperation(opId);
-                    const double w = combOpWeight(*graph, op);
-                    it = opWeights.emplace(opId, w).first;
-                }
-                weight += it->second;
-            }
+            asc.combOps.forEach([&](uint32_t opIndex) { weight += opWeights[opIndex]; });
             asc.weight = weight;
         }
+        sinkCones.clear();
+        sinkCones.shrink_to_fit();
 
         if (options_.partitionCount > ascs.size())
         {
@@ -1171,7 +1466,6 @@ namespace wolvrix::lib::transform
             return result;
         }
 
-        const std::size_t depth = log2Exact(options_.partitionCount);
         std::vector<std::vector<std::size_t>> partitions;
         partitions.reserve(options_.partitionCount);
 
@@ -1184,42 +1478,105 @@ namespace wolvrix::lib::transform
 
         std::mt19937 rng(static_cast<uint32_t>(std::hash<std::string>{}(graph->symbol())) ^ 0x9e3779b9U);
 
+        // A node that must produce k parts is bisected into floor(k / 2) and ceil(k / 2) parts,
+        // with the weight split in the same ratio. Sibling subtrees are independent and run as
+        // tasks on the pool; a child's seed derives from its parent's seed and its side, and
+        // logs are replayed in tree order afterwards, so the result and the log do not depend on
+        // the thread count.
+        struct SplitNode
+        {
+            std::vector<std::size_t> ascIds;
+            std::size_t partCount = 1;
+            std::size_t level = 0;
+            uint64_t seed = 0;
+            std::vector<std::string> logs;
+            bool emptySplit = false;
+            std::unique_ptr<SplitNode> a;
+            std::unique_ptr<SplitNode> b;
+        };
+
+        const std::size_t threadCount = options_.threads == 0 ? maxParallelThreads() : options_.threads;
         const auto splitStart = std::chrono::steady_clock::now();
-        std::function<void(const std::vector<std::size_t> &, std::size_t)> recurse;
-        recurse = [&](const std::vector<std::size_t> &current, std::size_t remainingDepth) {
-            if (remainingDepth == 0 || current.size() <= 1)
+        SplitNode root;
+        root.ascIds = std::move(ascIds);
+        root.partCount = options_.partitionCount;
+        root.seed = (static_cast<uint64_t>(rng()) << 32) ^ static_cast<uint64_t>(rng());
+        {
+            WorkStealingPool pool(threadCount);
+            WorkStealingPool::TaskGroup splitGroup;
+            std::function<void(SplitNode &)> splitNode;
+            splitNode = [&](SplitNode &node) {
+                if (node.partCount <= 1 || node.ascIds.size() <= 1)
+                {
+                    return;
+                }
+                const std::size_t partsA = node.partCount / 2;
+                const std::size_t partsB = node.partCount - partsA;
+                const double targetBalance = static_cast<double>(partsB) / static_cast<double>(node.partCount);
+                node.logs.push_back("hrbcut: split level=" + std::to_string(node.level) +
+                                    " parts=" + std::to_string(partsA) + "+" + std::to_string(partsB) +
+                                    " asc=" + std::to_string(node.ascIds.size()));
+                PartitionSolution split = multiSampleSelect(
+                    ascs,
+                    node.ascIds,
+                    targetBalance,
+                    options_.balanceThreshold,
+                    options_.targetCandidateCount,
+                    options_.maxTrials,
+                    options_.splitStopThreshold,
+                    opWeights,
+                    node.seed,
+                    pool,
+                    [&node](std::string msg) { node.logs.push_back(std::move(msg)); });
+                node.logs.push_back("hrbcut: split result level=" + std::to_string(node.level) +
+                                    " balance=" + std::to_string(split.balance) +
+                                    " target=" + std::to_string(targetBalance) +
+                                    " overlap=" + std::to_string(split.overlap) +
+                                    " A=" + std::to_string(split.a.size()) +
+                                    " B=" + std::to_string(split.b.size()));
+                if (split.a.empty() || split.b.empty())
+                {
+                    node.emptySplit = true;
+                    return;
+                }
+                node.a = std::make_unique<SplitNode>();
+                node.a->ascIds = std::move(split.a);
+                node.a->partCount = partsA;
+                node.a->level = node.level + 1;
+                node.a->seed = splitMix64(node.seed ^ 0xa);
+                node.b = std::make_unique<SplitNode>();
+                node.b->ascIds = std::move(split.b);
+                node.b->partCount = partsB;
+                node.b->level = node.level + 1;
+                node.b->seed = splitMix64(node.seed ^ 0xb);
+                SplitNode *childA = node.a.get();
+                SplitNode *childB = node.b.get();
+                pool.spawn(splitGroup, [&splitNode, childA]() { splitNode(*childA); });
+                pool.spawn(splitGroup, [&splitNode, childB]() { splitNode(*childB); });
+            };
+            pool.spawn(splitGroup, [&]() { splitNode(root); });
+            pool.wait(splitGroup);
+        }
+
+        std::function<void(SplitNode &)> collect;
+        collect = [&](SplitNode &node) {
+            for (auto &msg : node.logs)
             {
-                partitions.push_back(current);
-                return;
+                logInfo(std::move(msg));
             }
-            logInfo("hrbcut: split depth=" + std::to_string(remainingDepth) +
-                    " asc=" + std::to_string(current.size()));
-            PartitionSolution split = multiSampleSelect(
-                ascs,
-                current,
-                options_.balanceThreshold,
-                options_.targetCandidateCount,
-                options_.maxTrials,
-                options_.splitStopThreshold,
-                opWeights,
-                rng,
-                [&](std::string msg) { logInfo(std::move(msg)); });
-            logInfo("hrbcut: split result depth=" + std::to_string(remainingDepth) +
-                    " balance=" + std::to_string(split.balance) +
-                    " overlap=" + std::to_string(split.overlap) +
-                    " A=" + std::to_string(split.a.size()) +
-                    " B=" + std::to_string(split.b.size()));
-            if (split.a.empty() || split.b.empty())
+            if (node.emptySplit)
             {
                 warning(*graph, "hrbcut produced empty partition during split; stopping recursion");
-                partitions.push_back(current);
+            }
+            if (!node.a)
+            {
+                partitions.push_back(std::move(node.ascIds));
                 return;
             }
-            recurse(split.a, remainingDepth - 1);
-            recurse(split.b, remainingDepth - 1);
+            collect(*node.a);
+            collect(*node.b);
         };
-
-        recurse(ascIds, depth);
+        collect(root);
         logInfo("hrbcut: partitioning done parts=" + std::to_string(partitions.size()) + " in " +
                 std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(
                                    std::chrono::steady_clock::now() - splitStart)
@@ -1239,22 +1596,22 @@ namespace wolvrix::lib::transform
         partitionOpCountsEst.reserve(partitions.size());
         partitionOpCountsActual.reserve(partitions.size());
 
-        std::unordered_set<wolvrix::lib::grh::OperationId, wolvrix::lib::grh::OperationIdHash> combOpsAll;
+        ConeBitmap combOpsAll;
         for (const auto &asc : ascs)
         {
-            combOpsAll.insert(asc.combOps.begin(), asc.combOps.end());
+            combOpsAll.unionWith(asc.combOps);
         }
 
         std::size_t combOpsAfter = 0;
         for (const auto &part : partitions)
         {
             double weight = 0.0;
-            std::unordered_set<wolvrix::lib::grh::OperationId, wolvrix::lib::grh::OperationIdHash> combOps;
+            ConeBitmap combOps;
             std::size_t sinkOps = 0;
             for (std::size_t id : part)
             {
                 weight += ascs[id].weight;
-                combOps.insert(ascs[id].combOps.begin(), ascs[id].combOps.end());
+                combOps.unionWith(ascs[id].combOps);
                 for (std::size_t sinkIdx : ascs[id].sinks)
                 {
                     if (sinks[sinkIdx].kind == SinkRef::Kind::Operation)
@@ -1510,7 +1867,7 @@ namespace wolvrix::lib::transform
                 auto &opSet = partitionOps[p];
                 for (std::size_t ascId : partitions[p])
                 {
-                    opSet.insert(ascs[ascId].combOps.begin(), ascs[ascId].combOps.end());
+                    ascs[ascId].combOps.forEach([&](uint32_t opIndex) { opSet.insert(opByIndex[opIndex]); });
                     for (std::size_t sinkIdx : ascs[ascId].sinks)
                     {
                         if (sinks[sinkIdx].kind == SinkRef::Kind::Operation)
@@ -1,13 +1,22 @@
 #include "transform/repcut.hpp"
+#include "core/json_cursor.hpp"
 #include "transform/repcut_boundary_bundle.hpp"
 #include "transform/repcut_partition_set.hpp"
 
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <bit>
+#include <cctype>
+#include <cerrno>
+#include <charconv>
 #include <chrono>
 #include <cmath>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
 #include <cstdint>
+#include <exception>
 #include <filesystem>
 #include <functional>
 #include <fstream>
@@ -21,9 +30,11 @@
 #include <string_view>
 #include <system_error>
 #include <thread>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
+#include <variant>
 #include <vector>
 
 #if WOLVRIX_HAVE_MT_KAHYPAR
@@ -183,6 +194,7 @@ namespace wolvrix::lib::transform
         constexpr PieceId kInvalidPiece = std::numeric_limits<PieceId>::max();
         constexpr std::size_t kMaxConeCollectThreads = 8;
         constexpr std::size_t kConeCollectChunkSize = 64;
+        constexpr std::size_t kMaxPartitionCloneThreads = 8;
         constexpr std::size_t kForbiddenCrossDiagLimit = 12;
         constexpr std::size_t kMaxPartitionCount = 4096;
 
@@ -840,61 +852,140 @@ namespace wolvrix::lib::transform
             return inst;
         }
 
-        class DisjointSet
+        // Union-find that several threads may unite into at once. A root is only ever linked under
+        // a smaller index, so every set ends up rooted at its smallest member whatever order the
+        // unions ran in, and the sets match those of a serial run exactly.
+        class ConcurrentDisjointSet
         {
         public:
-            explicit DisjointSet(size_t count)
-                : parent_(count), rank_(count, 0)
+            explicit ConcurrentDisjointSet(size_t count)
+                : parent_(count)
             {
                 for (size_t i = 0; i < count; ++i)
                 {
-                    parent_[i] = i;
+                    parent_[i].store(static_cast<uint32_t>(i), std::memory_order_relaxed);
                 }
             }
 
             size_t find(size_t value)
             {
-                size_t root = value;
-                while (parent_[root] != root)
+                uint32_t current = static_cast<uint32_t>(value);
+                while (true)
                 {
-                    root = parent_[root];
-                }
-                while (parent_[value] != value)
-                {
-                    const size_t next = parent_[value];
-                    parent_[value] = root;
-                    value = next;
+                    uint32_t parent = parent_[current].load(std::memory_order_acquire);
+                    if (parent == current)
+                    {
+                        return current;
+                    }
+                    const uint32_t grandparent = parent_[parent].load(std::memory_order_acquire);
+                    if (grandparent != parent)
+                    {
+                        // Path halving; losing the race only means the path stays longer.
+                        parent_[current].compare_exchange_weak(parent,
+                                                               grandparent,
+                                                               std::memory_order_release,
+                                                               std::memory_order_relaxed);
+                    }
+                    current = grandparent;
                 }
-                return root;
             }
 
-            void unite(size_t lhs, size_t rhs)
+            // Returns true when the two sets were distinct.
+            bool unite(size_t lhs, size_t rhs)
             {
-                lhs = find(lhs);
-                rhs = find(rhs);
-                if (lhs == rhs)
-                {
-                    return;
-                }
-                if (rank_[lhs] < rank_[rhs])
+                while (true)
                 {
-                    parent_[lhs] = rhs;
+                    size_t lhsRoot = find(lhs);
+                    size_t rhsRoot = find(rhs);
+                    if (lhsRoot == rhsRoot)
+                    {
+                        return false;
+                    }
+                    if (lhsRoot < rhsRoot)
+                    {
+                        std::swap(lhsRoot, rhsRoot);
+                    }
+                    uint32_t expected = static_cast<uint32_t>(lhsRoot);
+                    if (parent_[lhsRoot].compare_exchange_strong(expected,
+                                                                 static_cast<uint32_t>(rhsRoot),
+                                                                 std::memory_order_acq_rel,
+                                                                 std::memory_order_acquire))
+                    {
+                        return true;
+                    }
                 }
-                else if (rank_[lhs] > rank_[rhs])
+            }
+
+        private:
+            std::vector<std::atomic<uint32_t>> parent_;
+        };
+
+        size_t resolvePhaseBThreads(size_t requested)
+        {
+            if (requested != 0)
+            {
+                return requested;
+            }
+            const size_t hwThreads = std::max<size_t>(1, static_cast<size_t>(std::thread::hardware_concurrency()));
+            return std::min<size_t>(kMaxConeCollectThreads, hwThreads);
+        }
+
+        // Runs fn(worker, begin, end) over chunks of [0, count) on up to threadCount threads, the
+        // calling thread included. The first exception thrown by a chunk is rethrown here.
+        void parallelForChunks(size_t count,
+                               size_t chunkSize,
+                               size_t threadCount,
+                               const std::function<void(size_t, size_t, size_t)> &fn)
+        {
+            if (count == 0)
+            {
+                return;
+            }
+            threadCount = std::min(threadCount, (count + chunkSize - 1) / chunkSize);
+            if (threadCount <= 1)
+            {
+                fn(0, 0, count);
+                return;
+            }
+
+            std::atomic<size_t> nextBegin{0};
+            std::exception_ptr failure;
+            std::mutex failureMutex;
+            auto work = [&](size_t worker) {
+                try
                 {
-                    parent_[rhs] = lhs;
+                    for (size_t begin = nextBegin.fetch_add(chunkSize, std::memory_order_relaxed); begin < count;
+                         begin = nextBegin.fetch_add(chunkSize, std::memory_order_relaxed))
+                    {
+                        fn(worker, begin, std::min(count, begin + chunkSize));
+                    }
                 }
-                else
+                catch (...)
                 {
-                    parent_[rhs] = lhs;
-                    ++rank_[lhs];
+                    std::lock_guard<std::mutex> lock(failureMutex);
+                    if (!failure)
+                    {
+                        failure = std::current_exception();
+                    }
+                    nextBegin.store(count, std::memory_order_relaxed);
                 }
+            };
+            std::vector<std::thread> workers;
+            workers.reserve(threadCount - 1);
+            for (size_t t = 1; t < threadCount; ++t)
+            {
+                workers.emplace_back(work, t);
             }
-
-        private:
-            std::vector<size_t> parent_;
-            std::vector<uint32_t> rank_;
-        };
+            work(0);
+            for (auto &worker : workers)
+            {
+                worker.join();
+            }
+            if (failure)
+            {
+                std::rethrow_exception(failure);
+            }
+        }
 
         PhaseAData buildPhaseAData(const wolvrix::lib::grh::Graph &graph)
         {
@@ -996,12 +1087,6 @@ namespace wolvrix::lib::transform
             return sinks;
         }
 
-        struct MemSymbolCollectStats
-        {
-            uint64_t visitedNodes = 0;
-            uint64_t memSymbolHits = 0;
-        };
-
         struct MemSymbolIntern
         {
             uint32_t intern(const std::string &symbol)
@@ -1021,276 +1106,361 @@ namespace wolvrix::lib::transform
             std::vector<std::string> idToSymbol;
         };
 
-        struct MemSymbolMemo
-        {
-            std::vector<std::vector<uint32_t>> nodeToMemSymbolIds;
-            std::vector<uint8_t> nodeState;
+        // What a cone walk from each node reaches: the interned memory read-port symbols and the
+        // returned-effect ops (as dense effect indices), following the defining nodes of the
+        // non-source operands of cone traversal ops. On an acyclic graph every node is its own
+        // component and components of equal depth are summarized concurrently.
+        //
+        // On a combinational cycle the memoized walk sees less: a node whose walk runs into a
+        // node still being walked does not inherit that node's cone, so the summary depends on
+        // where the walk, in sink order, first entered the cycle. That walk is kept by default
+        // so ASCs match earlier releases; with componentSummaries the nodes of a cycle share
+        // their strongly connected component's complete summary instead.
+        struct ConeSummaries
+        {
+            std::vector<uint32_t> nodeToComponent;
+            std::vector<std::vector<uint32_t>> componentMemSymbols;
+            std::vector<std::vector<uint32_t>> componentEffects;
+            std::size_t effectCount = 0;
+            std::size_t memSymbolHits = 0;
+            std::size_t componentCount = 0;
+            std::size_t levelCount = 0;
+            bool cyclic = false;
+            // Filled by the serial sink-order walk; nodeToComponent is then the identity.
+            bool walked = false;
         };
 
-        const std::vector<uint32_t> &collectNodeMemSymbolIds(const wolvrix::lib::grh::Graph &graph,
-                                                              const PhaseAData &phaseA,
-                                                              NodeId node,
-                                                              const std::unordered_set<wolvrix::lib::grh::ValueId, wolvrix::lib::grh::ValueIdHash> &inoutInputValues,
-                                                              MemSymbolIntern &intern,
-                                                              MemSymbolMemo &memo,
-                                                              MemSymbolCollectStats &stats)
+        NodeId findConeChildNode(const wolvrix::lib::grh::Graph &graph,
+                                 const PhaseAData &phaseA,
+                                 wolvrix::lib::grh::ValueId value,
+                                 const std::unordered_set<wolvrix::lib::grh::ValueId, wolvrix::lib::grh::ValueIdHash> &inoutInputValues)
         {
-            static const std::vector<uint32_t> kEmpty;
-            if (node >= memo.nodeToMemSymbolIds.size() || node >= memo.nodeState.size())
-            {
-                return kEmpty;
-            }
-
-            uint8_t &state = memo.nodeState[node];
-            if (state == 2)
-            {
-                return memo.nodeToMemSymbolIds[node];
-            }
-            if (state == 1)
-            {
-                return kEmpty;
-            }
-
-            state = 1;
-            ++stats.visitedNodes;
-            std::vector<uint32_t> &result = memo.nodeToMemSymbolIds[node];
-            result.clear();
-
-            const wolvrix::lib::grh::OperationId opId = phaseA.nodeToOp[node];
-            const wolvrix::lib::grh::Operation op = graph.getOperation(opId);
-            if (op.kind() == wolvrix::lib::grh::OperationKind::kMemoryReadPort)
-            {
-                if (auto sym = getAttrString(op, "memSymbol"))
-                {
-                    ++stats.memSymbolHits;
-                    result.push_back(intern.intern(*sym));
-                }
-            }
-
-            if (isAscConeTraversalOp(op))
+            if (isSourceValue(graph, value, inoutInputValues))
             {
-                for (const auto operand : op.operands())
-                {
-                    if (isSourceValue(graph, operand, inoutInputValues))
-                    {
-                        continue;
-                    }
-                    const wolvrix::lib::grh::OperationId predOp = graph.valueDef(operand);
-                    if (!predOp.valid())
-                    {
-                        continue;
-                    }
-                    auto it = phaseA.opToNode.find(predOp);
-                    if (it == phaseA.opToNode.end())
-                    {
-                        continue;
-                    }
-                    const std::vector<uint32_t> &childIds = collectNodeMemSymbolIds(graph,
-                                                                                    phaseA,
-                                                                                    it->second,
-                                                                                    inoutInputValues,
-                                                                                    intern,
-                                                                                    memo,
-                                                                                    stats);
-                    result.insert(result.end(), childIds.begin(), childIds.end());
-                }
+                return kInvalidNode;
             }
-
-            if (result.size() > 1)
+            const wolvrix::lib::grh::OperationId defOp = graph.valueDef(value);
+            if (!defOp.valid())
             {
-                std::sort(result.begin(), result.end());
-                result.erase(std::unique(result.begin(), result.end()), result.end());
+                return kInvalidNode;
             }
-
-            state = 2;
-            return result;
+            auto it = phaseA.opToNode.find(defOp);
+            return it == phaseA.opToNode.end() ? kInvalidNode : it->second;
         }
 
-        void collectConeMemSymbolIds(const wolvrix::lib::grh::Graph &graph,
-                                     const PhaseAData &phaseA,
-                                     const SinkRef &sink,
-                                     const std::unordered_set<wolvrix::lib::grh::ValueId, wolvrix::lib::grh::ValueIdHash> &inoutInputValues,
-                                     MemSymbolIntern &intern,
-                                     MemSymbolMemo &memo,
-                                     std::unordered_set<uint32_t> &memSymbolIds,
-                                     MemSymbolCollectStats &stats)
-        {
-            auto collectFromValue = [&](wolvrix::lib::grh::ValueId value) {
-                if (isSourceValue(graph, value, inoutInputValues))
-                {
-                    return;
-                }
-
-                const wolvrix::lib::grh::OperationId defOp = graph.valueDef(value);
-                if (!defOp.valid())
-                {
-                    return;
-                }
-                auto it = phaseA.opToNode.find(defOp);
-                if (it == phaseA.opToNode.end())
+        // Calls fn(node) for the cone root node of every non-source input of a sink.
+        template <typename Fn>
+        void forEachSinkConeRoot(const wolvrix::lib::grh::Graph &graph,
+                                 const PhaseAData &phaseA,
+                                 const SinkRef &sink,
+                                 const std::unordered_set<wolvrix::lib::grh::ValueId, wolvrix::lib::grh::ValueIdHash> &inoutInputValues,
+                                 Fn &&fn)
+        {
+            auto visit = [&](wolvrix::lib::grh::ValueId value) {
+                const NodeId node = findConeChildNode(graph, phaseA, value, inoutInputValues);
+                if (node != kInvalidNode)
                 {
-                    return;
+                    fn(node);
                 }
-
-                const std::vector<uint32_t> &ids = collectNodeMemSymbolIds(graph,
-                                                                            phaseA,
-                                                                            it->second,
-                                                                            inoutInputValues,
-                                                                            intern,
-                                                                            memo,
-                                                                            stats);
-                memSymbolIds.insert(ids.begin(), ids.end());
             };
-
             if (sink.kind == SinkRef::Kind::Operation)
             {
                 const wolvrix::lib::grh::Operation op = graph.getOperation(sink.op);
                 for (const auto operand : op.operands())
                 {
-                    collectFromValue(operand);
+                    visit(operand);
                 }
             }
             else
             {
-                collectFromValue(sink.value);
+                visit(sink.value);
             }
         }
 
-        struct ReturnedEffectCollectStats
-        {
-            uint64_t visitedNodes = 0;
-            uint64_t returnedEffectHits = 0;
-        };
-
-        struct ReturnedEffectMemo
-        {
-            std::vector<std::vector<wolvrix::lib::grh::OperationId>> nodeToReturnedEffectOps;
-            std::vector<uint8_t> nodeState;
-        };
-
-        const std::vector<wolvrix::lib::grh::OperationId> &
-        collectNodeReturnedEffectOps(
-            const wolvrix::lib::grh::Graph &graph,
-            const PhaseAData &phaseA,
-            NodeId node,
-            const std::unordered_set<wolvrix::lib::grh::ValueId, wolvrix::lib::grh::ValueIdHash> &inoutInputValues,
-            ReturnedEffectMemo &memo,
-            ReturnedEffectCollectStats &stats)
+        // The memoized walk of earlier releases, without recursion: sinks in order, cone roots in
+        // operand order, children in operand order. A child still on the walk contributes nothing.
+        void walkConeSummaries(const wolvrix::lib::grh::Graph &graph,
+                               const PhaseAData &phaseA,
+                               const std::vector<SinkRef> &sinks,
+                               const std::unordered_set<wolvrix::lib::grh::ValueId, wolvrix::lib::grh::ValueIdHash> &inoutInputValues,
+                               const std::vector<std::vector<NodeId>> &children,
+                               const std::vector<uint32_t> &ownMemSymbol,
+                               const std::vector<uint32_t> &ownEffect,
+                               ConeSummaries &summaries)
         {
-            static const std::vector<wolvrix::lib::grh::OperationId> kEmpty;
-            if (node >= memo.nodeToReturnedEffectOps.size() || node >= memo.nodeState.size())
+            constexpr uint32_t kNone = std::numeric_limits<uint32_t>::max();
+            const size_t nodeCount = children.size();
+            summaries.walked = true;
+            summaries.componentCount = nodeCount;
+            summaries.levelCount = 0;
+            summaries.nodeToComponent.resize(nodeCount);
+            for (size_t node = 0; node < nodeCount; ++node)
             {
-                return kEmpty;
+                summaries.nodeToComponent[node] = static_cast<uint32_t>(node);
             }
+            auto &memSymbols = summaries.componentMemSymbols;
+            auto &effects = summaries.componentEffects;
+            memSymbols.assign(nodeCount, {});
+            effects.assign(nodeCount, {});
 
-            uint8_t &state = memo.nodeState[node];
-            if (state == 2)
-            {
-                return memo.nodeToReturnedEffectOps[node];
-            }
-            if (state == 1)
+            std::vector<uint8_t> state(nodeCount, 0);
+            std::vector<std::pair<NodeId, size_t>> callStack;
+            auto enter = [&](NodeId node) {
+                state[node] = 1;
+                if (ownMemSymbol[node] != kNone)
+                {
+                    memSymbols[node].push_back(ownMemSymbol[node]);
+                }
+                if (ownEffect[node] != kNone)
+                {
+                    effects[node].push_back(ownEffect[node]);
+                }
+                callStack.emplace_back(node, 0);
+            };
+            auto inherit = [&](NodeId node, NodeId child) {
+                memSymbols[node].insert(memSymbols[node].end(), memSymbols[child].begin(), memSymbols[child].end());
+                effects[node].insert(effects[node].end(), effects[child].begin(), effects[child].end());
+            };
+            for (const SinkRef &sink : sinks)
             {
-                return kEmpty;
+                forEachSinkConeRoot(graph, phaseA, sink, inoutInputValues, [&](NodeId root) {
+                    if (state[root] != 0)
+                    {
+                        return;
+                    }
+                    enter(root);
+                    while (!callStack.empty())
+                    {
+                        auto &[node, nextChild] = callStack.back();
+                        if (nextChild < children[node].size())
+                        {
+                            const NodeId child = children[node][nextChild++];
+                            if (state[child] == 2)
+                            {
+                                inherit(node, child);
+                            }
+                            else if (state[child] == 0)
+                            {
+                                enter(child);
+                            }
+                            continue;
+                        }
+                        const NodeId done = node;
+                        callStack.pop_back();
+                        std::sort(memSymbols[done].begin(), memSymbols[done].end());
+                        memSymbols[done].erase(std::unique(memSymbols[done].begin(), memSymbols[done].end()),
+                                               memSymbols[done].end());
+                        std::sort(effects[done].begin(), effects[done].end());
+                        effects[done].erase(std::unique(effects[done].begin(), effects[done].end()), effects[done].end());
+                        state[done] = 2;
+                        if (!callStack.empty())
+                        {
+                            inherit(callStack.back().first, done);
+                        }
+                    }
+                });
             }
+        }
 
-            state = 1;
-            ++stats.visitedNodes;
-            std::vector<wolvrix::lib::grh::OperationId> &result = memo.nodeToReturnedEffectOps[node];
-            result.clear();
-
-            const wolvrix::lib::grh::OperationId opId = phaseA.nodeToOp[node];
-            const wolvrix::lib::grh::Operation op = graph.getOperation(opId);
-            if (opHasReturnedEffectValue(op))
-            {
-                ++stats.returnedEffectHits;
-                result.push_back(opId);
-            }
+        ConeSummaries buildConeSummaries(const wolvrix::lib::grh::Graph &graph,
+                                         const PhaseAData &phaseA,
+                                         const std::vector<SinkRef> &sinks,
+                                         const std::unordered_set<wolvrix::lib::grh::ValueId, wolvrix::lib::grh::ValueIdHash> &inoutInputValues,
+                                         MemSymbolIntern &memSymbolIntern,
+                                         size_t threadCount,
+                                         bool componentSummaries)
+        {
+            constexpr uint32_t kNone = std::numeric_limits<uint32_t>::max();
+            const size_t nodeCount = phaseA.nodeToOp.size();
+            ConeSummaries summaries;
 
-            if (isAscConeTraversalOp(op))
-            {
-                for (const auto operand : op.operands())
+            std::vector<std::vector<NodeId>> children(nodeCount);
+            std::vector<std::optional<std::string>> readSymbols(nodeCount);
+            std::vector<uint8_t> isEffect(nodeCount, 0);
+            parallelForChunks(nodeCount, 1024, threadCount, [&](size_t, size_t begin, size_t end) {
+                for (size_t node = begin; node < end; ++node)
                 {
-                    if (isSourceValue(graph, operand, inoutInputValues))
+                    const wolvrix::lib::grh::Operation op = graph.getOperation(phaseA.nodeToOp[node]);
+                    if (op.kind() == wolvrix::lib::grh::OperationKind::kMemoryReadPort)
                     {
-                        continue;
+                        readSymbols[node] = getAttrString(op, "memSymbol");
                     }
-                    const wolvrix::lib::grh::OperationId predOp = graph.valueDef(operand);
-                    if (!predOp.valid())
+                    isEffect[node] = opHasReturnedEffectValue(op) ? 1 : 0;
+                    if (!isAscConeTraversalOp(op))
                     {
                         continue;
                     }
-                    auto it = phaseA.opToNode.find(predOp);
-                    if (it == phaseA.opToNode.end())
+                    for (const auto operand : op.operands())
                     {
-                        continue;
+                        const NodeId child = findConeChildNode(graph, phaseA, operand, inoutInputValues);
+                        if (child != kInvalidNode && child != node)
+                        {
+                            children[node].push_back(child);
+                        }
                     }
-                    const auto &childOps =
-                        collectNodeReturnedEffectOps(graph, phaseA, it->second, inoutInputValues, memo, stats);
-                    result.insert(result.end(), childOps.begin(), childOps.end());
                 }
-            }
+            });
 
-            if (result.size() > 1)
+            // Interned in node order so symbol ids do not depend on the thread count.
+            std::vector<uint32_t> ownMemSymbol(nodeCount, kNone);
+            std::vector<uint32_t> ownEffect(nodeCount, kNone);
+            for (size_t node = 0; node < nodeCount; ++node)
             {
-                std::sort(result.begin(),
-                          result.end(),
-                          [](wolvrix::lib::grh::OperationId lhs, wolvrix::lib::grh::OperationId rhs) {
-                              if (lhs.index != rhs.index)
-                              {
-                                  return lhs.index < rhs.index;
-                              }
-                              return lhs.generation < rhs.generation;
-                          });
-                result.erase(std::unique(result.begin(), result.end()), result.end());
-            }
-
-            state = 2;
-            return result;
-        }
-
-        void collectConeReturnedEffectOps(
-            const wolvrix::lib::grh::Graph &graph,
-            const PhaseAData &phaseA,
-            const SinkRef &sink,
-            const std::unordered_set<wolvrix::lib::grh::ValueId, wolvrix::lib::grh::ValueIdHash> &inoutInputValues,
-            ReturnedEffectMemo &memo,
-            std::unordered_set<wolvrix::lib::grh::OperationId, wolvrix::lib::grh::OperationIdHash> &returnedEffectOps,
-            ReturnedEffectCollectStats &stats)
-        {
-            auto collectFromValue = [&](wolvrix::lib::grh::ValueId value) {
-                if (isSourceValue(graph, value, inoutInputValues))
+                if (readSymbols[node])
                 {
-                    return;
+                    ownMemSymbol[node] = memSymbolIntern.intern(*readSymbols[node]);
+                    ++summaries.memSymbolHits;
                 }
+                if (isEffect[node] != 0)
+                {
+                    ownEffect[node] = static_cast<uint32_t>(summaries.effectCount++);
+                }
+            }
+            readSymbols.clear();
 
-                const wolvrix::lib::grh::OperationId defOp = graph.valueDef(value);
-                if (!defOp.valid())
+            // Iterative Tarjan: components complete children-first, so every child component
+            // gets a smaller index than its parents.
+            summaries.nodeToComponent.assign(nodeCount, kNone);
+            std::vector<uint32_t> order(nodeCount, kNone);
+            std::vector<uint32_t> lowLink(nodeCount, 0);
+            std::vector<uint8_t> onStack(nodeCount, 0);
+            std::vector<NodeId> tarjanStack;
+            std::vector<std::pair<NodeId, size_t>> callStack;
+            std::vector<std::vector<NodeId>> componentNodes;
+            uint32_t nextOrder = 0;
+            for (NodeId root = 0; root < nodeCount; ++root)
+            {
+                if (order[root] != kNone)
                 {
-                    return;
+                    continue;
                 }
-                auto it = phaseA.opToNode.find(defOp);
-                if (it == phaseA.opToNode.end())
+                callStack.emplace_back(root, 0);
+                order[root] = lowLink[root] = nextOrder++;
+                tarjanStack.push_back(root);
+                onStack[root] = 1;
+                while (!callStack.empty())
                 {
-                    return;
+                    auto &[node, nextChild] = callStack.back();
+                    if (nextChild < children[node].size())
+                    {
+                        const NodeId child = children[node][nextChild++];
+                        if (order[child] == kNone)
+                        {
+                            order[child] = lowLink[child] = nextOrder++;
+                            tarjanStack.push_back(child);
+                            onStack[child] = 1;
+                            callStack.emplace_back(child, 0);
+                        }
+                        else if (onStack[child] != 0)
+                        {
+                            lowLink[node] = std::min(lowLink[node], order[child]);
+                        }
+                        continue;
+                    }
+                    const NodeId done = node;
+                    callStack.pop_back();
+                    if (!callStack.empty())
+                    {
+                        const NodeId parent = callStack.back().first;
+                        lowLink[parent] = std::min(lowLink[parent], lowLink[done]);
+                    }
+                    if (lowLink[done] != order[done])
+                    {
+                        continue;
+                    }
+                    const uint32_t component = static_cast<uint32_t>(componentNodes.size());
+                    componentNodes.emplace_back();
+                    NodeId member = kInvalidNode;
+                    do
+                    {
+                        member = tarjanStack.back();
+                        tarjanStack.pop_back();
+                        onStack[member] = 0;
+                        summaries.nodeToComponent[member] = component;
+                        componentNodes.back().push_back(member);
+                    } while (member != done);
                 }
+            }
+            order.clear();
+            lowLink.clear();
+            onStack.clear();
 
-                const auto &ops =
-                    collectNodeReturnedEffectOps(graph, phaseA, it->second, inoutInputValues, memo, stats);
-                returnedEffectOps.insert(ops.begin(), ops.end());
-            };
+            // Self-loops are not children, so only a component of several nodes is a cycle.
+            summaries.cyclic = std::any_of(componentNodes.begin(), componentNodes.end(),
+                                           [](const std::vector<NodeId> &nodes) { return nodes.size() > 1; });
+            if (summaries.cyclic && !componentSummaries)
+            {
+                walkConeSummaries(graph, phaseA, sinks, inoutInputValues, children, ownMemSymbol, ownEffect, summaries);
+                return summaries;
+            }
 
-            if (sink.kind == SinkRef::Kind::Operation)
+            const size_t componentCount = componentNodes.size();
+            summaries.componentCount = componentCount;
+            std::vector<uint32_t> level(componentCount, 0);
+            uint32_t maxLevel = 0;
+            for (uint32_t component = 0; component < componentCount; ++component)
             {
-                const wolvrix::lib::grh::Operation op = graph.getOperation(sink.op);
-                for (const auto operand : op.operands())
+                for (const NodeId node : componentNodes[component])
                 {
-                    collectFromValue(operand);
+                    for (const NodeId child : children[node])
+                    {
+                        const uint32_t childComponent = summaries.nodeToComponent[child];
+                        if (childComponent != component)
+                        {
+                            level[component] = std::max(level[component], level[childComponent] + 1);
+                        }
+                    }
                 }
+                maxLevel = std::max(maxLevel, level[component]);
             }
-            else
+            std::vector<std::vector<uint32_t>> componentsByLevel(static_cast<size_t>(maxLevel) + 1);
+            for (uint32_t component = 0; component < componentCount; ++component)
             {
-                collectFromValue(sink.value);
+                componentsByLevel[level[component]].push_back(component);
+            }
+            summaries.levelCount = componentsByLevel.size();
+
+            summaries.componentMemSymbols.resize(componentCount);
+            summaries.componentEffects.resize(componentCount);
+            for (const auto &components : componentsByLevel)
+            {
+                parallelForChunks(components.size(), 256, threadCount, [&](size_t, size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        const uint32_t component = components[i];
+                        std::vector<uint32_t> &memSymbols = summaries.componentMemSymbols[component];
+                        std::vector<uint32_t> &effects = summaries.componentEffects[component];
+                        for (const NodeId node : componentNodes[component])
+                        {
+                            if (ownMemSymbol[node] != kNone)
+                            {
+                                memSymbols.push_back(ownMemSymbol[node]);
+                            }
+                            if (ownEffect[node] != kNone)
+                            {
+                                effects.push_back(ownEffect[node]);
+                            }
+                            for (const NodeId child : children[node])
+                            {
+                                const uint32_t childComponent = summaries.nodeToComponent[child];
+                                if (childComponent == component)
+                                {
+                                    continue;
+                                }
+                                const auto &childMem = summaries.componentMemSymbols[childComponent];
+                                const auto &childEffects = summaries.componentEffects[childComponent];
+                                memSymbols.insert(memSymbols.end(), childMem.begin(), childMem.end());
+                                effects.insert(effects.end(), childEffects.begin(), childEffects.end());
+                            }
+                        }
+                        std::sort(memSymbols.begin(), memSymbols.end());
+                        memSymbols.erase(std::unique(memSymbols.begin(), memSymbols.end()), memSymbols.end());
+                        std::sort(effects.begin(), effects.end());
+                        effects.erase(std::unique(effects.begin(), effects.end()), effects.end());
+                    }
+                });
             }
+            return summaries;
         }
 
         void collectAscCone(const wolvrix::lib::grh::Graph &graph,
@@ -1384,6 +1554,8 @@ namespace wolvrix::lib::transform
         PhaseBData buildAscs(const wolvrix::lib::grh::Graph &graph,
                              const PhaseAData &phaseA,
                              const std::unordered_set<wolvrix::lib::grh::ValueId, wolvrix::lib::grh::ValueIdHash> &inoutInputValues,
+                             size_t threadCount,
+                             bool componentSummaries,
                              const ProgressLogger &progressLogger)
         {
             const auto phaseStart = std::chrono::steady_clock::now();
@@ -1407,253 +1579,189 @@ namespace wolvrix::lib::transform
                 return data;
             }
 
-            DisjointSet dsu(data.sinks.size());
+            ConcurrentDisjointSet dsu(data.sinks.size());
+            constexpr size_t kNoSink = std::numeric_limits<size_t>::max();
+            const size_t sinkCount = data.sinks.size();
+            constexpr size_t kSinkChunkSize = 256;
 
-            std::unordered_map<std::string, std::vector<size_t>> regWriteSinks;
-            std::unordered_map<std::string, std::vector<size_t>> latchWriteSinks;
-            std::unordered_map<uint32_t, std::vector<size_t>> memWriteSinks;
-            MemSymbolIntern memSymbolIntern;
+            enum class SinkStorageKind : uint8_t
+            {
+                None,
+                Register,
+                Latch,
+                Memory
+            };
+            struct SinkStorage
+            {
+                SinkStorageKind kind = SinkStorageKind::None;
+                std::string symbol;
+            };
 
+            // Attribute lookups run in parallel; grouping and interning stay in sink order so the
+            // groups and memory symbol ids do not depend on the thread count.
             const auto indexStart = std::chrono::steady_clock::now();
-            const size_t sinkCount = data.sinks.size();
-            const size_t indexProgressEvery = sinkCount < 50000 ? 10000 : 50000;
-            for (size_t i = 0; i < data.sinks.size(); ++i)
-            {
-                const SinkRef &sink = data.sinks[i];
-                if (sink.kind != SinkRef::Kind::Operation)
+            std::vector<SinkStorage> sinkStorage(sinkCount);
+            parallelForChunks(sinkCount, kSinkChunkSize, threadCount, [&](size_t, size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i)
                 {
-                    if (progressLogger && i > 0 && (i % indexProgressEvery) == 0)
+                    const SinkRef &sink = data.sinks[i];
+                    if (sink.kind != SinkRef::Kind::Operation)
                     {
-                        progressLogger("repcut phase-b/ascs: index_sink_progress=" + std::to_string(i) +
-                                       "/" + std::to_string(sinkCount) +
-                                       " elapsed_ms=" + std::to_string(msSince(indexStart)));
+                        continue;
+                    }
+                    const wolvrix::lib::grh::Operation op = graph.getOperation(sink.op);
+                    SinkStorage &storage = sinkStorage[i];
+                    if (auto sym = getAttrString(op, "regSymbol"))
+                    {
+                        storage = SinkStorage{SinkStorageKind::Register, std::move(*sym)};
+                    }
+                    else if (auto sym = getAttrString(op, "latchSymbol"))
+                    {
+                        storage = SinkStorage{SinkStorageKind::Latch, std::move(*sym)};
+                    }
+                    else if (auto sym = getAttrString(op, "memSymbol"))
+                    {
+                        storage = SinkStorage{SinkStorageKind::Memory, std::move(*sym)};
                     }
-                    continue;
-                }
-                const wolvrix::lib::grh::Operation op = graph.getOperation(sink.op);
-                if (auto sym = getAttrString(op, "regSymbol"))
-                {
-                    regWriteSinks[*sym].push_back(i);
                 }
-                else if (auto sym = getAttrString(op, "latchSymbol"))
+            });
+
+            std::unordered_map<std::string, size_t> regGroupHead;
+            std::unordered_map<std::string, size_t> latchGroupHead;
+            std::vector<size_t> memGroupHead;
+            MemSymbolIntern memSymbolIntern;
+            std::vector<size_t> groupHead(sinkCount, kNoSink);
+            for (size_t i = 0; i < sinkCount; ++i)
+            {
+                SinkStorage &storage = sinkStorage[i];
+                switch (storage.kind)
                 {
-                    latchWriteSinks[*sym].push_back(i);
-                }
-                else if (auto sym = getAttrString(op, "memSymbol"))
+                case SinkStorageKind::Register:
+                    groupHead[i] = regGroupHead.emplace(std::move(storage.symbol), i).first->second;
+                    break;
+                case SinkStorageKind::Latch:
+                    groupHead[i] = latchGroupHead.emplace(std::move(storage.symbol), i).first->second;
+                    break;
+                case SinkStorageKind::Memory:
                 {
-                    const uint32_t symbolId = memSymbolIntern.intern(*sym);
-                    memWriteSinks[symbolId].push_back(i);
+                    const uint32_t symbolId = memSymbolIntern.intern(storage.symbol);
+                    if (symbolId >= memGroupHead.size())
+                    {
+                        memGroupHead.resize(static_cast<size_t>(symbolId) + 1, i);
+                    }
+                    groupHead[i] = memGroupHead[symbolId];
+                    break;
                 }
-
-                if (progressLogger && i > 0 && (i % indexProgressEvery) == 0)
-                {
-                    progressLogger("repcut phase-b/ascs: index_sink_progress=" + std::to_string(i) +
-                                   "/" + std::to_string(sinkCount) +
-                                   " elapsed_ms=" + std::to_string(msSince(indexStart)));
+                case SinkStorageKind::None:
+                    break;
                 }
             }
+            sinkStorage.clear();
             if (progressLogger)
             {
                 progressLogger("repcut phase-b/ascs: index_sink_done reg_groups=" +
-                               std::to_string(regWriteSinks.size()) + " latch_groups=" +
-                               std::to_string(latchWriteSinks.size()) + " mem_groups=" +
-                               std::to_string(memWriteSinks.size()) +
+                               std::to_string(regGroupHead.size()) + " latch_groups=" +
+                               std::to_string(latchGroupHead.size()) + " mem_groups=" +
+                               std::to_string(memGroupHead.size()) + " threads=" + std::to_string(threadCount) +
                                " elapsed_ms=" + std::to_string(msSince(indexStart)));
             }
 
-            auto unionGroup = [&](const auto &groups) {
-                for (const auto &[symbol, indices] : groups)
+            const auto unionStart = std::chrono::steady_clock::now();
+            parallelForChunks(sinkCount, kSinkChunkSize, threadCount, [&](size_t, size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i)
                 {
-                    (void)symbol;
-                    if (indices.size() < 2)
-                    {
-                        continue;
-                    }
-                    const size_t root = indices[0];
-                    for (size_t i = 1; i < indices.size(); ++i)
+                    if (groupHead[i] != kNoSink && groupHead[i] != i)
                     {
-                        dsu.unite(root, indices[i]);
+                        dsu.unite(groupHead[i], i);
                     }
                 }
-            };
-            const auto unionStart = std::chrono::steady_clock::now();
-            unionGroup(regWriteSinks);
-            unionGroup(latchWriteSinks);
-            unionGroup(memWriteSinks);
+            });
             if (progressLogger)
             {
                 progressLogger("repcut phase-b/ascs: union_symbol_groups_done elapsed_ms=" +
                                std::to_string(msSince(unionStart)));
             }
 
-            const auto memConeStart = std::chrono::steady_clock::now();
-            const size_t memProgressEvery = sinkCount < 20000 ? 5000 : 20000;
-            MemSymbolMemo memMemo;
-            memMemo.nodeToMemSymbolIds.resize(phaseA.nodeToOp.size());
-            memMemo.nodeState.resize(phaseA.nodeToOp.size(), 0);
+            const auto summaryStart = std::chrono::steady_clock::now();
+            const size_t writtenMemSymbols = memGroupHead.size();
+            const ConeSummaries summaries = buildConeSummaries(
+                graph, phaseA, data.sinks, inoutInputValues, memSymbolIntern, threadCount, componentSummaries);
             if (progressLogger)
             {
-                progressLogger("repcut phase-b/ascs: collect_mem_symbols_begin mem_cone_union=enabled");
+                progressLogger(std::string("repcut phase-b/ascs: cone_summaries_done cyclic=") +
+                               (summaries.cyclic ? "true" : "false") +
+                               " mode=" + (summaries.walked ? "walk" : "components") +
+                               " components=" + std::to_string(summaries.componentCount) +
+                               " levels=" + std::to_string(summaries.levelCount) +
+                               " mem_symbol_hits=" + std::to_string(summaries.memSymbolHits) +
+                               " returned_effects=" + std::to_string(summaries.effectCount) +
+                               " elapsed_ms=" + std::to_string(msSince(summaryStart)));
             }
-            size_t batchStartIndex = 0;
-            auto batchStart = memConeStart;
-            uint64_t batchVisitedNodes = 0;
-            uint64_t batchMemSymbolHits = 0;
-            uint64_t batchDsuUnions = 0;
-            std::unordered_set<uint32_t> batchUniqueMemSymbols;
-            for (size_t i = 0; i < data.sinks.size(); ++i)
-            {
-                MemSymbolCollectStats sinkStats;
-                std::unordered_set<uint32_t> sinkMemSymbolIds;
-                collectConeMemSymbolIds(graph,
-                                        phaseA,
-                                        data.sinks[i],
-                                        inoutInputValues,
-                                        memSymbolIntern,
-                                        memMemo,
-                                        sinkMemSymbolIds,
-                                        sinkStats);
-                batchVisitedNodes += sinkStats.visitedNodes;
-                batchMemSymbolHits += sinkStats.memSymbolHits;
-                for (const uint32_t memSymbolId : sinkMemSymbolIds)
-                {
-                    batchUniqueMemSymbols.insert(memSymbolId);
-                    auto it = memWriteSinks.find(memSymbolId);
-                    if (it == memWriteSinks.end())
-                    {
-                        continue;
-                    }
-                    for (const size_t writeSinkIndex : it->second)
-                    {
-                        const size_t sinkRoot = dsu.find(i);
-                        const size_t writeRoot = dsu.find(writeSinkIndex);
-                        if (sinkRoot != writeRoot)
+
+            // A sink joins every write group of a memory its cone reads.
+            const auto memConeStart = std::chrono::steady_clock::now();
+            std::atomic<uint64_t> memDsuUnions{0};
+            parallelForChunks(sinkCount, kSinkChunkSize, threadCount, [&](size_t, size_t begin, size_t end) {
+                uint64_t unions = 0;
+                for (size_t i = begin; i < end; ++i)
+                {
+                    forEachSinkConeRoot(graph, phaseA, data.sinks[i], inoutInputValues, [&](NodeId node) {
+                        const uint32_t component = summaries.nodeToComponent[node];
+                        for (const uint32_t memSymbolId : summaries.componentMemSymbols[component])
                         {
-                            ++batchDsuUnions;
-                            dsu.unite(sinkRoot, writeRoot);
+                            if (memSymbolId < writtenMemSymbols && dsu.unite(i, memGroupHead[memSymbolId]))
+                            {
+                                ++unions;
+                            }
                         }
-                    }
-                }
-
-                if (progressLogger && ((i + 1) % memProgressEvery) == 0)
-                {
-                    const size_t processed = i + 1;
-                    progressLogger("repcut phase-b/ascs: collect_mem_symbols_progress=" + std::to_string(processed) +
-                                   "/" + std::to_string(sinkCount) +
-                                   " elapsed_ms=" + std::to_string(msSince(memConeStart)) +
-                                   " batch_elapsed_ms=" + std::to_string(msSince(batchStart)) +
-                                   " visited_nodes=" + std::to_string(batchVisitedNodes) +
-                                   " mem_symbol_hits=" + std::to_string(batchMemSymbolHits) +
-                                   " unique_mem_symbols=" + std::to_string(batchUniqueMemSymbols.size()) +
-                                   " dsu_unions=" + std::to_string(batchDsuUnions));
-                    batchStartIndex = processed;
-                    batchStart = std::chrono::steady_clock::now();
-                    batchVisitedNodes = 0;
-                    batchMemSymbolHits = 0;
-                    batchDsuUnions = 0;
-                    batchUniqueMemSymbols.clear();
+                    });
                 }
-            }
-            if (progressLogger && batchStartIndex < sinkCount)
-            {
-                progressLogger("repcut phase-b/ascs: collect_mem_symbols_progress=" + std::to_string(sinkCount) +
-                               "/" + std::to_string(sinkCount) +
-                               " elapsed_ms=" + std::to_string(msSince(memConeStart)) +
-                               " batch_elapsed_ms=" + std::to_string(msSince(batchStart)) +
-                               " visited_nodes=" + std::to_string(batchVisitedNodes) +
-                               " mem_symbol_hits=" + std::to_string(batchMemSymbolHits) +
-                               " unique_mem_symbols=" + std::to_string(batchUniqueMemSymbols.size()) +
-                               " dsu_unions=" + std::to_string(batchDsuUnions));
-            }
+                memDsuUnions.fetch_add(unions, std::memory_order_relaxed);
+            });
             if (progressLogger)
             {
-                progressLogger("repcut phase-b/ascs: collect_mem_symbols_done elapsed_ms=" +
-                               std::to_string(msSince(memConeStart)));
+                progressLogger("repcut phase-b/ascs: collect_mem_symbols_done unique_mem_symbols=" +
+                               std::to_string(memSymbolIntern.idToSymbol.size()) +
+                               " dsu_unions=" + std::to_string(memDsuUnions.load()) +
+                               " elapsed_ms=" + std::to_string(msSince(memConeStart)));
             }
 
+            // Sinks whose cones reach the same returned-effect op share an ASC; the first sink to
+            // claim an effect stands in for the others.
             const auto effectConeStart = std::chrono::steady_clock::now();
-            const size_t effectProgressEvery = sinkCount < 20000 ? 5000 : 20000;
-            ReturnedEffectMemo effectMemo;
-            effectMemo.nodeToReturnedEffectOps.resize(phaseA.nodeToOp.size());
-            effectMemo.nodeState.resize(phaseA.nodeToOp.size(), 0);
-            std::unordered_map<wolvrix::lib::grh::OperationId, size_t, wolvrix::lib::grh::OperationIdHash>
-                firstSinkByReturnedEffect;
-            if (progressLogger)
+            std::vector<std::atomic<size_t>> effectOwner(summaries.effectCount);
+            for (auto &owner : effectOwner)
             {
-                progressLogger("repcut phase-b/ascs: collect_returned_effect_begin");
+                owner.store(kNoSink, std::memory_order_relaxed);
             }
-            batchStartIndex = 0;
-            batchStart = effectConeStart;
-            uint64_t batchReturnedVisitedNodes = 0;
-            uint64_t batchReturnedEffectHits = 0;
-            uint64_t batchReturnedDsuUnions = 0;
-            std::unordered_set<wolvrix::lib::grh::OperationId, wolvrix::lib::grh::OperationIdHash>
-                batchUniqueReturnedEffects;
-            for (size_t i = 0; i < data.sinks.size(); ++i)
-            {
-                ReturnedEffectCollectStats sinkStats;
-                std::unordered_set<wolvrix::lib::grh::OperationId, wolvrix::lib::grh::OperationIdHash>
-                    sinkReturnedEffects;
-                collectConeReturnedEffectOps(graph,
-                                             phaseA,
-                                             data.sinks[i],
-                                             inoutInputValues,
-                                             effectMemo,
-                                             sinkReturnedEffects,
-                                             sinkStats);
-                batchReturnedVisitedNodes += sinkStats.visitedNodes;
-                batchReturnedEffectHits += sinkStats.returnedEffectHits;
-                for (const auto returnedEffectOp : sinkReturnedEffects)
-                {
-                    batchUniqueReturnedEffects.insert(returnedEffectOp);
-                    const auto [it, inserted] = firstSinkByReturnedEffect.emplace(returnedEffectOp, i);
-                    if (inserted)
-                    {
-                        continue;
-                    }
-                    const size_t sinkRoot = dsu.find(i);
-                    const size_t firstRoot = dsu.find(it->second);
-                    if (sinkRoot != firstRoot)
-                    {
-                        ++batchReturnedDsuUnions;
-                        dsu.unite(sinkRoot, firstRoot);
-                    }
-                }
-
-                if (progressLogger && ((i + 1) % effectProgressEvery) == 0)
+            std::atomic<uint64_t> effectDsuUnions{0};
+            parallelForChunks(sinkCount, kSinkChunkSize, threadCount, [&](size_t, size_t begin, size_t end) {
+                uint64_t unions = 0;
+                for (size_t i = begin; i < end; ++i)
                 {
-                    const size_t processed = i + 1;
-                    progressLogger("repcut phase-b/ascs: collect_returned_effect_progress=" +
-                                   std::to_string(processed) + "/" + std::to_string(sinkCount) +
-                                   " elapsed_ms=" + std::to_string(msSince(effectConeStart)) +
-                                   " batch_elapsed_ms=" + std::to_string(msSince(batchStart)) +
-                                   " visited_nodes=" + std::to_string(batchReturnedVisitedNodes) +
-                                   " returned_effect_hits=" + std::to_string(batchReturnedEffectHits) +
-                                   " unique_returned_effects=" + std::to_string(batchUniqueReturnedEffects.size()) +
-                                   " dsu_unions=" + std::to_string(batchReturnedDsuUnions));
-                    batchStartIndex = processed;
-                    batchStart = std::chrono::steady_clock::now();
-                    batchReturnedVisitedNodes = 0;
-                    batchReturnedEffectHits = 0;
-                    batchReturnedDsuUnions = 0;
-                    batchUniqueReturnedEffects.clear();
+                    forEachSinkConeRoot(graph, phaseA, data.sinks[i], inoutInputValues, [&](NodeId node) {
+                        const uint32_t component = summaries.nodeToComponent[node];
+                        for (const uint32_t effect : summaries.componentEffects[component])
+                        {
+                            size_t owner = kNoSink;
+                            if (effectOwner[effect].compare_exchange_strong(owner, i, std::memory_order_acq_rel))
+                            {
+                                continue;
+                            }
+                            if (dsu.unite(i, owner))
+                            {
+                                ++unions;
+                            }
+                        }
+                    });
                 }
-            }
-            if (progressLogger && batchStartIndex < sinkCount)
-            {
-                progressLogger("repcut phase-b/ascs: collect_returned_effect_progress=" +
-                               std::to_string(sinkCount) + "/" + std::to_string(sinkCount) +
-                               " elapsed_ms=" + std::to_string(msSince(effectConeStart)) +
-                               " batch_elapsed_ms=" + std::to_string(msSince(batchStart)) +
-                               " visited_nodes=" + std::to_string(batchReturnedVisitedNodes) +
-                               " returned_effect_hits=" + std::to_string(batchReturnedEffectHits) +
-                               " unique_returned_effects=" + std::to_string(batchUniqueReturnedEffects.size()) +
-                               " dsu_unions=" + std::to_string(batchReturnedDsuUnions));
-            }
+                effectDsuUnions.fetch_add(unions, std::memory_order_relaxed);
+            });
             if (progressLogger)
             {
-                progressLogger("repcut phase-b/ascs: collect_returned_effect_done elapsed_ms=" +
-                               std::to_string(msSince(effectConeStart)));
+                progressLogger("repcut phase-b/ascs: collect_returned_effect_done dsu_unions=" +
+                               std::to_string(effectDsuUnions.load()) +
+                               " elapsed_ms=" + std::to_string(msSince(effectConeStart)));
             }
 
             std::unordered_map<size_t, AscId> ascByRoot;
@@ -1680,13 +1788,9 @@ namespace wolvrix::lib::transform
             const auto collectConeStart = std::chrono::steady_clock::now();
             const size_t ascProgressEvery = data.ascs.size() < 2000 ? 200 : 1000;
             const size_t totalAscs = data.ascs.size();
-            const size_t hwThreads =
-                std::max<size_t>(1, static_cast<size_t>(std::thread::hardware_concurrency()));
-            const size_t threadCount = std::min<size_t>(
-                totalAscs,
-                std::min<size_t>(kMaxConeCollectThreads, hwThreads));
+            const size_t coneThreads = std::min<size_t>(totalAscs, threadCount);
 
-            if (threadCount <= 1 || totalAscs < kConeCollectChunkSize * 2)
+            if (coneThreads <= 1 || totalAscs < kConeCollectChunkSize * 2)
             {
                 std::vector<uint32_t> coneVisitStamp(phaseA.nodeToOp.size(), 0);
                 uint32_t coneVisitEpoch = 1;
@@ -1719,16 +1823,16 @@ namespace wolvrix::lib::transform
                 if (progressLogger)
                 {
                     progressLogger("repcut phase-b/ascs: collect_cones_parallel threads=" +
-                                   std::to_string(threadCount) +
+                                   std::to_string(coneThreads) +
                                    " chunk=" + std::to_string(kConeCollectChunkSize));
                 }
 
                 std::atomic<size_t> nextAsc{0};
                 std::atomic<size_t> processedAscs{0};
                 std::vector<std::thread> workers;
-                workers.reserve(threadCount);
+                workers.reserve(coneThreads);
 
-                for (size_t t = 0; t < threadCount; ++t)
+                for (size_t t = 0; t < coneThreads; ++t)
                 {
                     workers.emplace_back([&, t]() {
                         (void)t;
@@ -1874,15 +1978,6 @@ namespace wolvrix::lib::transform
             return data;
         }
 
-        void normalizeNodeToAscs(std::vector<std::vector<AscId>> &nodeToAscs)
-        {
-            for (auto &ascs : nodeToAscs)
-            {
-                std::sort(ascs.begin(), ascs.end());
-                ascs.erase(std::unique(ascs.begin(), ascs.end()), ascs.end());
-            }
-        }
-
         NodeId chooseAscSeedNode(const AscInfo &asc,
                                  const std::vector<SinkRef> &sinks,
                                  const PhaseAData &phaseA)
@@ -1907,20 +2002,17 @@ namespace wolvrix::lib::transform
             return kInvalidNode;
         }
 
-        void findPiece(NodeId seed,
-                       PieceId pid,
-                       const PhaseAData &phaseA,
-                       const std::vector<std::vector<AscId>> &nodeToAscs,
-                       std::vector<std::unordered_set<NodeId>> &pieces,
-                       std::vector<PieceId> &nodeToPiece,
-                       std::vector<std::vector<AscId>> &pieceToAscs)
+        // Walks the connected nodes around `seed` that carry the seed's ASC set and calls
+        // take(node) for each, in depth-first claim order. Pieces are unordered sets, so their
+        // iteration order follows this order; every flood therefore uses the same walk.
+        template <typename IsTaken, typename Take>
+        void floodPiece(NodeId seed,
+                        const PhaseAData &phaseA,
+                        const std::vector<std::vector<AscId>> &nodeToAscs,
+                        IsTaken &&isTaken,
+                        Take &&take)
         {
-            if (seed == kInvalidNode || seed >= nodeToPiece.size() || nodeToPiece[seed] != kInvalidPiece)
-            {
-                return;
-            }
-
-            const std::vector<AscId> targetAscs = nodeToAscs[seed];
+            const std::vector<AscId> &targetAscs = nodeToAscs[seed];
             std::vector<NodeId> stack;
             stack.push_back(seed);
 
@@ -1929,38 +2021,36 @@ namespace wolvrix::lib::transform
                 const NodeId node = stack.back();
                 stack.pop_back();
 
-                if (nodeToPiece[node] != kInvalidPiece)
-                {
-                    continue;
-                }
-                if (nodeToAscs[node] != targetAscs)
+                if (isTaken(node) || nodeToAscs[node] != targetAscs)
                 {
                     continue;
                 }
-
-                nodeToPiece[node] = pid;
-                pieces[pid].insert(node);
+                take(node);
 
                 for (const NodeId pred : phaseA.inNeighbors[node])
                 {
-                    if (nodeToPiece[pred] == kInvalidPiece && nodeToAscs[pred] == targetAscs)
+                    if (!isTaken(pred) && nodeToAscs[pred] == targetAscs)
                     {
                         stack.push_back(pred);
                     }
                 }
                 for (const NodeId succ : phaseA.outNeighbors[node])
                 {
-                    if (nodeToPiece[succ] == kInvalidPiece && nodeToAscs[succ] == targetAscs)
+                    if (!isTaken(succ) && nodeToAscs[succ] == targetAscs)
                     {
                         stack.push_back(succ);
                     }
                 }
             }
-
-            pieceToAscs[pid] = targetAscs;
         }
 
-        void buildPieces(PhaseBData &phaseB, const PhaseAData &phaseA, const ProgressLogger &progressLogger)
+        // Every stage runs on threadCount threads and produces exactly what the serial
+        // construction did: piece ids, piece contents and their insertion order are fixed by ASC
+        // and node order, not by which thread got there first.
+        void buildPieces(PhaseBData &phaseB,
+                         const PhaseAData &phaseA,
+                         size_t threadCount,
+                         const ProgressLogger &progressLogger)
         {
             const auto phaseStart = std::chrono::steady_clock::now();
             auto msSince = [&](const std::chrono::steady_clock::time_point &start) -> uint64_t {
@@ -1968,17 +2058,19 @@ namespace wolvrix::lib::transform
                     std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start)
                         .count());
             };
+            const size_t nodeCount = phaseA.nodeToOp.size();
+            const size_t ascCount = phaseB.ascs.size();
+            constexpr size_t kAscChunkSize = 64;
+            constexpr size_t kNodeChunkSize = 4096;
 
-            phaseB.nodeToAscs.clear();
-            phaseB.nodeToAscs.resize(phaseA.nodeToOp.size());
-
+            // Node -> ASC inversion as a counting sort: counts and slots are claimed atomically,
+            // then each node's list is sorted, which also removes the dependence on claim order.
             const auto nodeToAscsStart = std::chrono::steady_clock::now();
-            const size_t ascProgressEvery = phaseB.ascs.size() < 2000 ? 200 : 1000;
-            for (AscId aid = 0; aid < phaseB.ascs.size(); ++aid)
+            std::vector<NodeId> ascSinkNodes;
+            std::vector<size_t> ascSinkNodeOffsets(ascCount + 1, 0);
+            for (AscId aid = 0; aid < ascCount; ++aid)
             {
-                const AscInfo &asc = phaseB.ascs[aid];
-
-                for (const size_t sinkIndex : asc.sinks)
+                for (const size_t sinkIndex : phaseB.ascs[aid].sinks)
                 {
                     const SinkRef &sink = phaseB.sinks[sinkIndex];
                     if (sink.kind != SinkRef::Kind::Operation)
@@ -1988,56 +2080,137 @@ namespace wolvrix::lib::transform
                     auto it = phaseA.opToNode.find(sink.op);
                     if (it != phaseA.opToNode.end())
                     {
-                        phaseB.nodeToAscs[it->second].push_back(aid);
+                        ascSinkNodes.push_back(it->second);
                     }
                 }
-                for (const NodeId node : asc.combOps)
+                ascSinkNodeOffsets[aid + 1] = ascSinkNodes.size();
+            }
+            auto forEachAscNode = [&](AscId aid, auto &&fn) {
+                for (size_t i = ascSinkNodeOffsets[aid]; i < ascSinkNodeOffsets[aid + 1]; ++i)
                 {
-                    phaseB.nodeToAscs[node].push_back(aid);
+                    fn(ascSinkNodes[i]);
                 }
-
-                if (progressLogger && aid > 0 && (aid % ascProgressEvery) == 0)
+                for (const NodeId node : phaseB.ascs[aid].combOps)
                 {
-                    progressLogger("repcut phase-b/pieces: build_node_to_ascs_progress=" +
-                                   std::to_string(aid) + "/" + std::to_string(phaseB.ascs.size()) +
-                                   " elapsed_ms=" + std::to_string(msSince(nodeToAscsStart)));
+                    fn(node);
                 }
-            }
-            if (progressLogger)
+            };
+            std::vector<std::atomic<uint32_t>> nodeAscCounts(nodeCount);
+            parallelForChunks(ascCount, kAscChunkSize, threadCount, [&](size_t, size_t begin, size_t end) {
+                for (size_t aid = begin; aid < end; ++aid)
+                {
+                    forEachAscNode(static_cast<AscId>(aid), [&](NodeId node) {
+                        nodeAscCounts[node].fetch_add(1, std::memory_order_relaxed);
+                    });
+                }
+            });
+            std::vector<size_t> nodeAscOffsets(nodeCount + 1, 0);
+            for (size_t node = 0; node < nodeCount; ++node)
             {
-                progressLogger("repcut phase-b/pieces: build_node_to_ascs_done elapsed_ms=" +
-                               std::to_string(msSince(nodeToAscsStart)));
+                nodeAscOffsets[node + 1] = nodeAscOffsets[node] + nodeAscCounts[node].load(std::memory_order_relaxed);
+                nodeAscCounts[node].store(0, std::memory_order_relaxed);
             }
-
-            const auto normalizeStart = std::chrono::steady_clock::now();
-            normalizeNodeToAscs(phaseB.nodeToAscs);
+            std::vector<AscId> nodeAscSlots(nodeAscOffsets[nodeCount]);
+            parallelForChunks(ascCount, kAscChunkSize, threadCount, [&](size_t, size_t begin, size_t end) {
+                for (size_t aid = begin; aid < end; ++aid)
+                {
+                    forEachAscNode(static_cast<AscId>(aid), [&](NodeId node) {
+                        const uint32_t slot = nodeAscCounts[node].fetch_add(1, std::memory_order_relaxed);
+                        nodeAscSlots[nodeAscOffsets[node] + slot] = static_cast<AscId>(aid);
+                    });
+                }
+            });
+            nodeAscCounts.clear();
+            phaseB.nodeToAscs.clear();
+            phaseB.nodeToAscs.resize(nodeCount);
+            parallelForChunks(nodeCount, kNodeChunkSize, threadCount, [&](size_t, size_t begin, size_t end) {
+                for (size_t node = begin; node < end; ++node)
+                {
+                    auto first = nodeAscSlots.begin() + static_cast<std::ptrdiff_t>(nodeAscOffsets[node]);
+                    auto last = nodeAscSlots.begin() + static_cast<std::ptrdiff_t>(nodeAscOffsets[node + 1]);
+                    std::sort(first, last);
+                    phaseB.nodeToAscs[node].assign(first, std::unique(first, last));
+                }
+            });
+            nodeAscSlots.clear();
             if (progressLogger)
             {
-                progressLogger("repcut phase-b/pieces: normalize_node_to_ascs_done elapsed_ms=" +
-                               std::to_string(msSince(normalizeStart)));
+                progressLogger("repcut phase-b/pieces: build_node_to_ascs_done threads=" + std::to_string(threadCount) +
+                               " elapsed_ms=" + std::to_string(msSince(nodeToAscsStart)));
             }
 
             phaseB.pieces.clear();
             phaseB.pieceToAscs.clear();
-            phaseB.nodeToPiece.assign(phaseA.nodeToOp.size(), kInvalidPiece);
+            phaseB.nodeToPiece.assign(nodeCount, kInvalidPiece);
 
+            // One piece per ASC, grown from its seed. The floods run concurrently into private
+            // node lists; an ASC whose seed an earlier ASC already claimed keeps an empty piece.
             const auto ascPieceStart = std::chrono::steady_clock::now();
-            for (AscId aid = 0; aid < phaseB.ascs.size(); ++aid)
-            {
-                const PieceId pid = static_cast<PieceId>(phaseB.pieces.size());
-                phaseB.pieces.emplace_back();
-                phaseB.pieceToAscs.emplace_back(std::vector<AscId>{aid});
-
-                const NodeId seed = chooseAscSeedNode(phaseB.ascs[aid], phaseB.sinks, phaseA);
-                findPiece(seed, pid, phaseA, phaseB.nodeToAscs, phaseB.pieces, phaseB.nodeToPiece, phaseB.pieceToAscs);
+            std::vector<NodeId> ascSeeds(ascCount, kInvalidNode);
+            std::vector<std::vector<NodeId>> ascRegions(ascCount);
+            std::vector<std::vector<uint32_t>> workerStamps(std::min(threadCount, std::max<size_t>(1, ascCount)));
+            std::vector<uint32_t> workerEpochs(workerStamps.size(), 0);
+            parallelForChunks(ascCount, kAscChunkSize, threadCount, [&](size_t worker, size_t begin, size_t end) {
+                std::vector<uint32_t> &stamps = workerStamps[worker];
+                if (stamps.empty())
+                {
+                    stamps.assign(nodeCount, 0);
+                }
+                uint32_t &epoch = workerEpochs[worker];
+                for (size_t aid = begin; aid < end; ++aid)
+                {
+                    const NodeId seed = chooseAscSeedNode(phaseB.ascs[aid], phaseB.sinks, phaseA);
+                    ascSeeds[aid] = seed;
+                    if (seed == kInvalidNode || seed >= nodeCount)
+                    {
+                        continue;
+                    }
+                    if (++epoch == 0)
+                    {
+                        std::fill(stamps.begin(), stamps.end(), 0);
+                        epoch = 1;
+                    }
+                    std::vector<NodeId> &region = ascRegions[aid];
+                    floodPiece(
+                        seed,
+                        phaseA,
+                        phaseB.nodeToAscs,
+                        [&](NodeId node) { return stamps[node] == epoch; },
+                        [&](NodeId node) {
+                            stamps[node] = epoch;
+                            region.push_back(node);
+                        });
+                }
+            });
+            workerStamps.clear();
 
-                if (progressLogger && aid > 0 && (aid % ascProgressEvery) == 0)
+            phaseB.pieces.resize(ascCount);
+            phaseB.pieceToAscs.resize(ascCount);
+            for (AscId aid = 0; aid < ascCount; ++aid)
+            {
+                phaseB.pieceToAscs[aid] = std::vector<AscId>{aid};
+                const NodeId seed = ascSeeds[aid];
+                if (seed == kInvalidNode || seed >= nodeCount || phaseB.nodeToPiece[seed] != kInvalidPiece)
+                {
+                    ascRegions[aid].clear();
+                    continue;
+                }
+                for (const NodeId node : ascRegions[aid])
                 {
-                    progressLogger("repcut phase-b/pieces: asc_piece_progress=" +
-                                   std::to_string(aid) + "/" + std::to_string(phaseB.ascs.size()) +
-                                   " elapsed_ms=" + std::to_string(msSince(ascPieceStart)));
+                    phaseB.nodeToPiece[node] = aid;
                 }
+                phaseB.pieceToAscs[aid] = phaseB.nodeToAscs[seed];
             }
+            parallelForChunks(ascCount, kAscChunkSize, threadCount, [&](size_t, size_t begin, size_t end) {
+                for (size_t aid = begin; aid < end; ++aid)
+                {
+                    for (const NodeId node : ascRegions[aid])
+                    {
+                        phaseB.pieces[aid].insert(node);
+                    }
+                    std::vector<NodeId>().swap(ascRegions[aid]);
+                }
+            });
             if (progressLogger)
             {
                 progressLogger("repcut phase-b/pieces: asc_piece_done elapsed_ms=" +
@@ -2045,33 +2218,68 @@ namespace wolvrix::lib::transform
                                " pieces_now=" + std::to_string(phaseB.pieces.size()));
             }
 
+            // Remaining nodes form one piece per connected run of equal ASC sets. The union-find
+            // roots each run at its smallest node, which is where the serial scan used to start
+            // it, so pieces are numbered in that order and flooded from that node.
             const auto residualStart = std::chrono::steady_clock::now();
-            const size_t nodeCount = phaseB.nodeToPiece.size();
-            const size_t nodeProgressEvery = nodeCount < 200000 ? 50000 : 200000;
-            for (NodeId node = 0; node < phaseB.nodeToPiece.size(); ++node)
-            {
-                if (phaseB.nodeToPiece[node] != kInvalidPiece)
+            ConcurrentDisjointSet residualRuns(nodeCount);
+            parallelForChunks(nodeCount, kNodeChunkSize, threadCount, [&](size_t, size_t begin, size_t end) {
+                for (size_t node = begin; node < end; ++node)
                 {
-                    if (progressLogger && node > 0 && (node % nodeProgressEvery) == 0)
+                    if (phaseB.nodeToPiece[node] != kInvalidPiece)
                     {
-                        progressLogger("repcut phase-b/pieces: residual_scan_progress=" +
-                                       std::to_string(node) + "/" + std::to_string(nodeCount) +
-                                       " elapsed_ms=" + std::to_string(msSince(residualStart)));
+                        continue;
+                    }
+                    for (const NodeId succ : phaseA.outNeighbors[node])
+                    {
+                        if (phaseB.nodeToPiece[succ] == kInvalidPiece &&
+                            phaseB.nodeToAscs[succ] == phaseB.nodeToAscs[node])
+                        {
+                            residualRuns.unite(node, succ);
+                        }
                     }
-                    continue;
                 }
-                const PieceId pid = static_cast<PieceId>(phaseB.pieces.size());
-                phaseB.pieces.emplace_back();
-                phaseB.pieceToAscs.emplace_back();
-                findPiece(node, pid, phaseA, phaseB.nodeToAscs, phaseB.pieces, phaseB.nodeToPiece, phaseB.pieceToAscs);
-
-                if (progressLogger && node > 0 && (node % nodeProgressEvery) == 0)
+            });
+            std::vector<NodeId> residualRoot(nodeCount, kInvalidNode);
+            parallelForChunks(nodeCount, kNodeChunkSize, threadCount, [&](size_t, size_t begin, size_t end) {
+                for (size_t node = begin; node < end; ++node)
                 {
-                    progressLogger("repcut phase-b/pieces: residual_scan_progress=" +
-                                   std::to_string(node) + "/" + std::to_string(nodeCount) +
-                                   " elapsed_ms=" + std::to_string(msSince(residualStart)));
+                    if (phaseB.nodeToPiece[node] == kInvalidPiece)
+                    {
+                        residualRoot[node] = static_cast<NodeId>(residualRuns.find(node));
+                    }
                 }
-            }
+            });
+            std::vector<NodeId> residualSeeds;
+            for (NodeId node = 0; node < nodeCount; ++node)
+            {
+                if (residualRoot[node] == node)
+                {
+                    residualSeeds.push_back(node);
+                }
+            }
+            const size_t residualBase = phaseB.pieces.size();
+            phaseB.pieces.resize(residualBase + residualSeeds.size());
+            phaseB.pieceToAscs.resize(residualBase + residualSeeds.size());
+            parallelForChunks(residualSeeds.size(), kAscChunkSize, threadCount, [&](size_t, size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    const NodeId seed = residualSeeds[i];
+                    const PieceId pid = static_cast<PieceId>(residualBase + i);
+                    floodPiece(
+                        seed,
+                        phaseA,
+                        phaseB.nodeToAscs,
+                        [&](NodeId node) {
+                            return residualRoot[node] != seed || phaseB.nodeToPiece[node] != kInvalidPiece;
+                        },
+                        [&](NodeId node) {
+                            phaseB.nodeToPiece[node] = pid;
+                            phaseB.pieces[pid].insert(node);
+                        });
+                    phaseB.pieceToAscs[pid] = phaseB.nodeToAscs[seed];
+                }
+            });
 
             if (progressLogger)
             {
@@ -2610,6 +2818,10 @@ namespace wolvrix::lib::transform
             std::size_t wide256Words = 0;
             std::size_t fanoutExcess = 0;
             std::size_t stateBoundaryWords = 0;
+            // 32-bit words of the out signals, as the generated package copies them, and the same
+            // words counted once per extra ASC reading each signal.
+            std::size_t outWords32 = 0;
+            std::size_t fanoutWords32 = 0;
         };
 
         bool isStateBoundaryDefKind(wolvrix::lib::grh::OperationKind kind) noexcept
@@ -2737,9 +2949,12 @@ namespace wolvrix::lib::transform
 
                 const int32_t width = std::max(1, safeValueWidth(graph, valueId));
                 const std::size_t words = static_cast<std::size_t>((width + 63) / 64);
+                const std::size_t words32 = static_cast<std::size_t>((width + 31) / 32);
                 const std::size_t fanoutFactor = std::max<std::size_t>(1, userAscs.size() - 1);
                 stats.outSignalCount += 1;
                 stats.outWords += words;
+                stats.outWords32 += words32;
+                stats.fanoutWords32 += words32 * fanoutFactor;
                 stats.fanoutExcess += fanoutFactor;
                 if (width > 64)
                 {
@@ -2951,14 +3166,147 @@ namespace wolvrix::lib::transform
             return records;
         }
 
+        constexpr std::size_t kMaxCutEdgeWeight = 65535;
+
+        enum class EdgeWeighting
+        {
+            Heuristic,
+            Comm,
+            Unit
+        };
+
+        constexpr std::array<EdgeWeighting, 3> kEdgeWeightings = {
+            EdgeWeighting::Heuristic,
+            EdgeWeighting::Comm,
+            EdgeWeighting::Unit,
+        };
+
+        const char *edgeWeightingName(EdgeWeighting weighting) noexcept
+        {
+            switch (weighting)
+            {
+            case EdgeWeighting::Heuristic:
+                return "heuristic";
+            case EdgeWeighting::Comm:
+                return "comm";
+            case EdgeWeighting::Unit:
+                return "unit";
+            }
+            return "heuristic";
+        }
+
+        std::optional<EdgeWeighting> parseEdgeWeighting(std::string_view text)
+        {
+            for (const EdgeWeighting weighting : kEdgeWeightings)
+            {
+                if (text == edgeWeightingName(weighting))
+                {
+                    return weighting;
+                }
+            }
+            return std::nullopt;
+        }
+
+        struct EdgeWeightPercentiles
+        {
+            std::size_t signalCount = 0;
+            std::size_t fanoutExcess = 0;
+            std::size_t wide64Words = 0;
+        };
+
+        EdgeWeightPercentiles computeEdgeWeightPercentiles(const std::vector<PieceCommStats> &edgeCommStats)
+        {
+            std::vector<std::size_t> signalCounts;
+            std::vector<std::size_t> fanoutExcesses;
+            std::vector<std::size_t> wide64Words;
+            signalCounts.reserve(edgeCommStats.size());
+            fanoutExcesses.reserve(edgeCommStats.size());
+            wide64Words.reserve(edgeCommStats.size());
+            for (const PieceCommStats &stats : edgeCommStats)
+            {
+                signalCounts.push_back(stats.outSignalCount);
+                fanoutExcesses.push_back(stats.fanoutExcess);
+                wide64Words.push_back(stats.wide64Words);
+            }
+            EdgeWeightPercentiles percentiles;
+            percentiles.signalCount = percentileThreshold(std::move(signalCounts), 0.90);
+            percentiles.fanoutExcess = percentileThreshold(std::move(fanoutExcesses), 0.90);
+            percentiles.wide64Words = percentileThreshold(std::move(wide64Words), 0.90);
+            return percentiles;
+        }
+
+        uint32_t heuristicEdgeWeight(const PieceCommStats &stats, const EdgeWeightPercentiles &percentiles)
+        {
+            const bool hubBonus =
+                (percentiles.signalCount > 0 && stats.outSignalCount >= percentiles.signalCount) ||
+                (percentiles.fanoutExcess > 0 && stats.fanoutExcess >= percentiles.fanoutExcess) ||
+                (percentiles.wide64Words > 0 && stats.wide64Words >= percentiles.wide64Words);
+            const std::size_t outWordScore = compressWeightMetric(stats.outWords, 128, 128.0, 32.0);
+            const std::size_t wide64Score = compressWeightMetric(stats.wide64Words, 64, 64.0, 24.0);
+            const std::size_t wide256Score = compressWeightMetric(stats.wide256Words, 32, 32.0, 24.0);
+            const std::size_t fanoutScore = compressWeightMetric(stats.fanoutExcess, 64, 64.0, 24.0);
+            const std::size_t stateBoundaryScore = compressWeightMetric(stats.stateBoundaryWords, 64, 64.0, 24.0);
+            const std::size_t edgeWeight =
+                1u + outWordScore + 2u * wide64Score + 4u * wide256Score + 2u * fanoutScore +
+                3u * stateBoundaryScore + (hubBonus ? 32u : 0u);
+            return std::max<uint32_t>(1u, clampToUint32(std::min<std::size_t>(kMaxCutEdgeWeight, edgeWeight)));
+        }
+
+        // 32-bit words copied for one extra partition spanned by a cut piece. The km1 objective
+        // multiplies this by (partitions - 1); a signal read by fewer of the piece's ASCs than the
+        // piece has contributes its share of the words.
+        std::size_t commEdgeWords32(const PieceCommStats &stats, std::size_t edgeAscCount)
+        {
+            if (edgeAscCount <= 1)
+            {
+                return stats.outWords32;
+            }
+            const std::size_t extraAscs = edgeAscCount - 1;
+            return (stats.fanoutWords32 + extraAscs - 1) / extraAscs;
+        }
+
+        // Re-derives every hyperedge weight from its comm stats; the heuristic weighting gives the
+        // weights buildHyperGraph assigned.
+        void assignEdgeWeights(HyperGraph &hg,
+                               const std::vector<PieceCommStats> &edgeCommStats,
+                               EdgeWeighting weighting)
+        {
+            const EdgeWeightPercentiles percentiles = weighting == EdgeWeighting::Heuristic
+                                                          ? computeEdgeWeightPercentiles(edgeCommStats)
+                                                          : EdgeWeightPercentiles{};
+            for (std::size_t edgeIndex = 0; edgeIndex < hg.edges.size(); ++edgeIndex)
+            {
+                auto &edge = hg.edges[edgeIndex];
+                const PieceCommStats stats =
+                    edgeIndex < edgeCommStats.size() ? edgeCommStats[edgeIndex] : PieceCommStats{};
+                switch (weighting)
+                {
+                case EdgeWeighting::Heuristic:
+                    edge.weight = heuristicEdgeWeight(stats, percentiles);
+                    break;
+                case EdgeWeighting::Comm:
+                    edge.weight = std::max<uint32_t>(
+                        1u,
+                        clampToUint32(std::min<std::size_t>(kMaxCutEdgeWeight,
+                                                            commEdgeWords32(stats, edge.nodes.size()))));
+                    break;
+                case EdgeWeighting::Unit:
+                    edge.weight = 1u;
+                    break;
+                }
+            }
+        }
+
         HyperGraph buildHyperGraph(const wolvrix::lib::grh::Graph &graph,
                                    const PhaseAData &phaseA,
                                    const PhaseBData &phaseB,
                                    std::vector<uint32_t> &nodeWeights,
                                    std::vector<uint32_t> &pieceWeights,
-                                   std::vector<uint32_t> &edgeCutWeights)
+                                   std::vector<uint32_t> &edgeCutWeights,
+                                   std::vector<PieceCommStats> &edgeCommStats)
         {
             HyperGraph hg;
+            edgeCommStats.clear();
 
             nodeWeights.assign(phaseA.nodeToOp.size(), std::numeric_limits<uint32_t>::max());
             pieceWeights.assign(phaseB.pieces.size(), std::numeric_limits<uint32_t>::max());
@@ -2974,24 +3322,15 @@ namespace wolvrix::lib::transform
                 pieceCommStats[pid] = calculatePieceCommStats(graph, phaseA, phaseB, pid);
             }
 
-            std::vector<std::size_t> edgeSignalCounts;
-            std::vector<std::size_t> edgeFanoutExcesses;
-            std::vector<std::size_t> edgeWide64Words;
+            std::vector<PieceCommStats> hyperEdgeStats;
             for (PieceId pid = static_cast<PieceId>(phaseB.ascs.size()); pid < phaseB.pieces.size(); ++pid)
             {
-                if (phaseB.pieceToAscs[pid].empty())
+                if (!phaseB.pieceToAscs[pid].empty())
                 {
-                    continue;
+                    hyperEdgeStats.push_back(pieceCommStats[pid]);
                 }
-                edgeSignalCounts.push_back(pieceCommStats[pid].outSignalCount);
-                edgeFanoutExcesses.push_back(pieceCommStats[pid].fanoutExcess);
-                edgeWide64Words.push_back(pieceCommStats[pid].wide64Words);
             }
-
-            const std::size_t p90SignalCount = percentileThreshold(std::move(edgeSignalCounts), 0.90);
-            const std::size_t p90FanoutExcess = percentileThreshold(std::move(edgeFanoutExcesses), 0.90);
-            const std::size_t p90Wide64Words = percentileThreshold(std::move(edgeWide64Words), 0.90);
-            constexpr std::size_t kMaxCutEdgeWeight = 65535;
+            const EdgeWeightPercentiles percentiles = computeEdgeWeightPercentiles(hyperEdgeStats);
 
             std::vector<uint32_t> balanceWeights(phaseB.pieces.size(), 1u);
             edgeCutWeights.assign(phaseB.pieces.size(), 1u);
@@ -3005,23 +3344,7 @@ namespace wolvrix::lib::transform
                     static_cast<double>((pid < pieceWeights.size()) ? pieceWeights[pid] : 1u) + 0.35 * sourceUpdateWeight;
                 balanceWeights[pid] =
                     std::max<uint32_t>(1u, clampToUint32(static_cast<std::size_t>(std::llround(std::max(1.0, balanced)))));
-
-                const bool hubBonus =
-                    (p90SignalCount > 0 && stats.outSignalCount >= p90SignalCount) ||
-                    (p90FanoutExcess > 0 && stats.fanoutExcess >= p90FanoutExcess) ||
-                    (p90Wide64Words > 0 && stats.wide64Words >= p90Wide64Words);
-                const std::size_t outWordScore = compressWeightMetric(stats.outWords, 128, 128.0, 32.0);
-                const std::size_t wide64Score = compressWeightMetric(stats.wide64Words, 64, 64.0, 24.0);
-                const std::size_t wide256Score = compressWeightMetric(stats.wide256Words, 32, 32.0, 24.0);
-                const std::size_t fanoutScore = compressWeightMetric(stats.fanoutExcess, 64, 64.0, 24.0);
-                const std::size_t stateBoundaryScore =
-                    compressWeightMetric(stats.stateBoundaryWords, 64, 64.0, 24.0);
-                const std::size_t edgeWeight =
-                    1u + outWordScore + 2u * wide64Score + 4u * wide256Score + 2u * fanoutScore +
-                    3u * stateBoundaryScore + (hubBonus ? 32u : 0u);
-                edgeCutWeights[pid] = std::max<uint32_t>(
-                    1u,
-                    clampToUint32(std::min<std::size_t>(kMaxCutEdgeWeight, edgeWeight)));
+                edgeCutWeights[pid] = heuristicEdgeWeight(stats, percentiles);
             }
 
             hg.nodeWeights.reserve(phaseB.ascs.size());
@@ -3039,12 +3362,230 @@ namespace wolvrix::lib::transform
                 if (!edge.nodes.empty())
                 {
                     hg.edges.push_back(std::move(edge));
+                    edgeCommStats.push_back(pieceCommStats[pid]);
                 }
             }
 
             return hg;
         }
 
+        struct PartitionSweepRecord
+        {
+            std::size_t partitionCount = 0;
+            std::size_t partsUsed = 0;
+            std::size_t cutEdges = 0;
+            // Connectivity-minus-one objective, the metric mt-kahypar optimizes.
+            uint64_t cutWeight = 0;
+            uint64_t maxPartWeight = 0;
+            double imbalance = 0.0;
+            // Source words of cut pieces, counted once per extra partition that needs them.
+            uint64_t commWords = 0;
+            uint64_t maxPartCommWords = 0;
+            // Bytes copied between partitions per step, from the 32-bit words of the cut pieces.
+            uint64_t trafficBytes = 0;
+            double predictedStepCost = 0.0;
+            uint64_t solverRunMs = 0;
+        };
+
+        // One transferred word is charged like this much hyper-node weight in the step model.
+        constexpr double kSweepCommWordCost = 2.0;
+
+        // Scores a partition without rebuilding anything. The predicted step cost models a
+        // lock-step simulation: every partition evaluates its own nodes and then exchanges the
+        // words of the cut pieces it touches, so the slowest partition bounds the step.
+        PartitionSweepRecord evaluatePartitionSweep(const HyperGraph &hg,
+                                                    const std::vector<PieceCommStats> &edgeCommStats,
+                                                    const std::vector<uint32_t> &partition,
+                                                    std::size_t partitionCount)
+        {
+            PartitionSweepRecord record;
+            record.partitionCount = partitionCount;
+            std::vector<uint64_t> partWeights(partitionCount, 0);
+            std::vector<uint64_t> partCommWords(partitionCount, 0);
+            uint64_t totalWeight = 0;
+            for (std::size_t node = 0; node < hg.nodeWeights.size(); ++node)
+            {
+                const uint32_t part = node < partition.size() ? partition[node] : 0u;
+                if (part < partitionCount)
+                {
+                    partWeights[part] += hg.nodeWeights[node];
+                }
+                totalWeight += hg.nodeWeights[node];
+            }
+
+            std::vector<uint32_t> edgeParts;
+            for (std::size_t edgeIndex = 0; edgeIndex < hg.edges.size(); ++edgeIndex)
+            {
+                const auto &edge = hg.edges[edgeIndex];
+                edgeParts.clear();
+                for (const uint32_t node : edge.nodes)
+                {
+                    const uint32_t part = node < partition.size() ? partition[node] : 0u;
+                    if (part < partitionCount)
+                    {
+                        edgeParts.push_back(part);
+                    }
+                }
+                std::sort(edgeParts.begin(), edgeParts.end());
+                edgeParts.erase(std::unique(edgeParts.begin(), edgeParts.end()), edgeParts.end());
+                if (edgeParts.size() <= 1)
+                {
+                    continue;
+                }
+                const uint64_t extraParts = edgeParts.size() - 1;
+                const uint64_t words =
+                    edgeIndex < edgeCommStats.size() ? std::max<uint64_t>(1, edgeCommStats[edgeIndex].outWords) : 1;
+                record.cutEdges += 1;
+                record.cutWeight += extraParts * edge.weight;
+                record.commWords += extraParts * words;
+                if (edgeIndex < edgeCommStats.size())
+                {
+                    record.trafficBytes += extraParts * 4u * commEdgeWords32(edgeCommStats[edgeIndex], edge.nodes.size());
+                }
+                for (const uint32_t part : edgeParts)
+                {
+                    partCommWords[part] += words;
+                }
+            }
+
+            double slowest = 0.0;
+            for (std::size_t part = 0; part < partitionCount; ++part)
+            {
+                if (partWeights[part] != 0)
+                {
+                    record.partsUsed += 1;
+                }
+                record.maxPartWeight = std::max(record.maxPartWeight, partWeights[part]);
+                record.maxPartCommWords = std::max(record.maxPartCommWords, partCommWords[part]);
+                slowest = std::max(slowest,
+                                   static_cast<double>(partWeights[part]) +
+                                       kSweepCommWordCost * static_cast<double>(partCommWords[part]));
+            }
+            const uint64_t perfectWeight = (totalWeight + partitionCount - 1) / partitionCount;
+            record.imbalance = perfectWeight == 0
+                                   ? 0.0
+                                   : static_cast<double>(record.maxPartWeight) / static_cast<double>(perfectWeight) - 1.0;
+            record.predictedStepCost = slowest;
+            return record;
+        }
+
+        // In hierarchical (NUMA) mode parts are numbered domain by domain.
+        uint32_t numaDomainOfPart(uint32_t part, std::size_t partsPerDomain, std::size_t domainCount)
+        {
+            return static_cast<uint32_t>(std::min<std::size_t>(part / partsPerDomain, domainCount - 1));
+        }
+
+        struct DomainHyperGraph
+        {
+            HyperGraph hg;
+            // Global hypergraph node of every local node.
+            std::vector<AscId> nodes;
+        };
+
+        // Restricts hg to the nodes of one domain. A hyperedge that also reaches other domains
+        // brings its words into the domain over the inter-domain link once per local part that
+        // reads them, so its local copy is weighted interDomainCost times higher than an edge
+        // that lives entirely inside the domain.
+        DomainHyperGraph buildDomainHyperGraph(const HyperGraph &hg,
+                                               const std::vector<uint32_t> &domainOf,
+                                               uint32_t domain,
+                                               double interDomainCost)
+        {
+            constexpr AscId kNotLocal = std::numeric_limits<AscId>::max();
+            DomainHyperGraph sub;
+            std::vector<AscId> localOf(hg.nodeWeights.size(), kNotLocal);
+            for (std::size_t node = 0; node < hg.nodeWeights.size(); ++node)
+            {
+                const uint32_t nodeDomain = node < domainOf.size() ? domainOf[node] : 0u;
+                if (nodeDomain != domain)
+                {
+                    continue;
+                }
+                localOf[node] = static_cast<AscId>(sub.nodes.size());
+                sub.nodes.push_back(static_cast<AscId>(node));
+                sub.hg.nodeWeights.push_back(hg.nodeWeights[node]);
+            }
+            for (const auto &edge : hg.edges)
+            {
+                HyperGraph::HyperEdge local;
+                bool reachesOtherDomain = false;
+                for (const AscId node : edge.nodes)
+                {
+                    if (node < localOf.size() && localOf[node] != kNotLocal)
+                    {
+                        local.nodes.push_back(localOf[node]);
+                    }
+                    else
+                    {
+                        reachesOtherDomain = true;
+                    }
+                }
+                if (local.nodes.size() < 2)
+                {
+                    continue;
+                }
+                local.weight = edge.weight;
+                if (reachesOtherDomain)
+                {
+                    const double scaled = std::round(static_cast<double>(edge.weight) * interDomainCost);
+                    local.weight = static_cast<uint32_t>(
+                        std::clamp(scaled, 1.0, static_cast<double>(std::numeric_limits<uint32_t>::max())));
+                }
+                sub.hg.edges.push_back(std::move(local));
+            }
+            return sub;
+        }
+
+        struct NumaTrafficRecord
+        {
+            uint64_t intraDomainBytes = 0;
+            uint64_t interDomainBytes = 0;
+            // intraDomainBytes plus interDomainBytes charged at the inter-domain cost.
+            double cost = 0.0;
+        };
+
+        // Splits the predicted traffic of evaluatePartitionSweep into copies between parts of the
+        // same domain and copies that cross domains: an edge spanning p parts in d domains crosses
+        // d - 1 domain boundaries and p - d part boundaries inside domains.
+        NumaTrafficRecord evaluateNumaTraffic(const HyperGraph &hg,
+                                              const std::vector<PieceCommStats> &edgeCommStats,
+                                              const std::vector<uint32_t> &partition,
+                                              std::size_t partsPerDomain,
+                                              std::size_t domainCount,
+                                              double interDomainCost)
+        {
+            NumaTrafficRecord record;
+            std::vector<uint32_t> edgeParts;
+            std::vector<uint32_t> edgeDomains;
+            for (std::size_t edgeIndex = 0; edgeIndex < hg.edges.size() && edgeIndex < edgeCommStats.size(); ++edgeIndex)
+            {
+                const auto &edge = hg.edges[edgeIndex];
+                edgeParts.clear();
+                for (const uint32_t node : edge.nodes)
+                {
+                    edgeParts.push_back(node < partition.size() ? partition[node] : 0u);
+                }
+                std::sort(edgeParts.begin(), edgeParts.end());
+                edgeParts.erase(std::unique(edgeParts.begin(), edgeParts.end()), edgeParts.end());
+                if (edgeParts.size() <= 1)
+                {
+                    continue;
+                }
+                edgeDomains.clear();
+                for (const uint32_t part : edgeParts)
+                {
+                    edgeDomains.push_back(numaDomainOfPart(part, partsPerDomain, domainCount));
+                }
+                edgeDomains.erase(std::unique(edgeDomains.begin(), edgeDomains.end()), edgeDomains.end());
+                const uint64_t bytes = 4u * commEdgeWords32(edgeCommStats[edgeIndex], edge.nodes.size());
+                record.intraDomainBytes += (edgeParts.size() - edgeDomains.size()) * bytes;
+                record.interDomainBytes += (edgeDomains.size() - 1) * bytes;
+            }
+            record.cost = static_cast<double>(record.intraDomainBytes) +
+                          interDomainCost * static_cast<double>(record.interDomainBytes);
+            return record;
+        }
+
         bool validateHyperGraph(const PhaseBData &phaseB,
                                 const HyperGraph &hg,
                                 std::string &errorMessage)
@@ -3244,12 +3785,26 @@ namespace wolvrix::lib::transform
             return oss.str();
         }
 
-        bool writeTextFile(const std::filesystem::path &path,
-                           const std::string &content,
-                           std::string &errorMessage)
+        std::string joinSizes(const std::vector<std::size_t> &values)
         {
-            std::ofstream out(path);
-            if (!out)
+            std::string joined;
+            for (const std::size_t value : values)
+            {
+                if (!joined.empty())
+                {
+                    joined += ",";
+                }
+                joined += std::to_string(value);
+            }
+            return joined;
+        }
+
+        bool writeTextFile(const std::filesystem::path &path,
+                           const std::string &content,
+                           std::string &errorMessage)
+        {
+            std::ofstream out(path);
+            if (!out)
             {
                 errorMessage = "cannot open file for writing: " + path.string();
                 return false;
@@ -3400,6 +3955,50 @@ namespace wolvrix::lib::transform
             }
             return message;
         }
+
+        // HyperGraph flattened into the CSR arrays mt_kahypar_create_hypergraph() takes. Node ids
+        // are ASC ids; weights above the solver's int range are clamped.
+        struct MtKaHyParInput
+        {
+            std::vector<size_t> edgeOffsets;
+            std::vector<mt_kahypar_hyperedge_id_t> pins;
+            std::vector<mt_kahypar_hyperedge_weight_t> edgeWeights;
+            std::vector<mt_kahypar_hypernode_weight_t> nodeWeights;
+        };
+
+        MtKaHyParInput buildMtKaHyParInput(const HyperGraph &hg)
+        {
+            auto clampWeight = [](uint32_t weight) {
+                constexpr uint32_t kMax = static_cast<uint32_t>(std::numeric_limits<int32_t>::max());
+                return static_cast<int32_t>(std::min(weight, kMax));
+            };
+
+            MtKaHyParInput input;
+            std::size_t pinCount = 0;
+            for (const auto &edge : hg.edges)
+            {
+                pinCount += edge.nodes.size();
+            }
+            input.edgeOffsets.reserve(hg.edges.size() + 1);
+            input.pins.reserve(pinCount);
+            input.edgeWeights.reserve(hg.edges.size());
+            input.edgeOffsets.push_back(0);
+            for (const auto &edge : hg.edges)
+            {
+                for (const AscId aid : edge.nodes)
+                {
+                    input.pins.push_back(static_cast<mt_kahypar_hyperedge_id_t>(aid));
+                }
+                input.edgeOffsets.push_back(input.pins.size());
+                input.edgeWeights.push_back(clampWeight(edge.weight));
+            }
+            input.nodeWeights.reserve(hg.nodeWeights.size());
+            for (const uint32_t weight : hg.nodeWeights)
+            {
+                input.nodeWeights.push_back(clampWeight(weight));
+            }
+            return input;
+        }
 #endif
 
         enum class PartitionBackendErrorKind
@@ -3412,6 +4011,9 @@ namespace wolvrix::lib::transform
 
         struct PartitionBackendRequest
         {
+            const HyperGraph *hypergraph = nullptr;
+            // Set only with -keep-intermediate-files: the hMETIS copy of `hypergraph` (for logs)
+            // and where the backend should also write its partition file.
             std::filesystem::path hmetisPath;
             std::filesystem::path partitionPath;
             std::size_t partitionCount = 0;
@@ -3466,8 +4068,8 @@ namespace wolvrix::lib::transform
 #else
                 {
                     std::ostringstream oss;
-                    oss << "invoke hgr_path=" << request.hmetisPath.string()
-                        << " partition_path=" << request.partitionPath.string()
+                    oss << "invoke hgr_path=" << (request.hmetisPath.empty() ? "<memory>" : request.hmetisPath.string())
+                        << " partition_path=" << (request.partitionPath.empty() ? "<none>" : request.partitionPath.string())
                         << " k=" << request.partitionCount
                         << " imbalance_factor=" << toFixedString(request.imbalanceFactor, 6)
                         << " asc_count=" << request.ascCount
@@ -3573,135 +4175,960 @@ namespace wolvrix::lib::transform
                     addBackendLog(oss.str());
                 }
 
-                const std::string hgrPath = request.hmetisPath.string();
-                addBackendLog("read_hypergraph_from_file path=" + hgrPath + " format=HMETIS");
-                hypergraph = mt_kahypar_read_hypergraph_from_file(
-                    hgrPath.c_str(), context, HMETIS, &mtError);
-                if (hypergraph.hypergraph == nullptr)
+                if (request.hypergraph == nullptr)
+                {
+                    response.errorKind = PartitionBackendErrorKind::kInvalidConfig;
+                    response.errorMessage = "no hypergraph was passed to the backend";
+                    cleanup();
+                    return false;
+                }
+                const auto buildStart = std::chrono::steady_clock::now();
+                {
+                    const MtKaHyParInput input = buildMtKaHyParInput(*request.hypergraph);
+                    hypergraph = mt_kahypar_create_hypergraph(
+                        context,
+                        static_cast<mt_kahypar_hypernode_id_t>(input.nodeWeights.size()),
+                        static_cast<mt_kahypar_hyperedge_id_t>(input.edgeWeights.size()),
+                        input.edgeOffsets.data(),
+                        input.pins.data(),
+                        input.edgeWeights.data(),
+                        input.nodeWeights.data(),
+                        &mtError);
+                }
+                if (hypergraph.hypergraph == nullptr)
+                {
+                    response.errorKind = PartitionBackendErrorKind::kExecutionFailed;
+                    response.errorMessage = "mt-kahypar failed to build the hypergraph: " + takeMtKaHyParError(mtError);
+                    cleanup();
+                    return false;
+                }
+                addBackendLog("create_hypergraph node_count=" +
+                              std::to_string(static_cast<std::size_t>(mt_kahypar_num_hypernodes(hypergraph))) +
+                              " edge_count=" + std::to_string(request.hypergraph->edges.size()) +
+                              " build_ms=" +
+                              std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                                 std::chrono::steady_clock::now() - buildStart)
+                                                 .count()));
+
+                addBackendLog("partition begin");
+                const auto solverStart = std::chrono::steady_clock::now();
+                partitionedHg = mt_kahypar_partition(hypergraph, context, &mtError);
+                response.solverRunMs = static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::steady_clock::now() - solverStart)
+                        .count());
+                if (partitionedHg.partitioned_hg == nullptr)
+                {
+                    response.errorKind = PartitionBackendErrorKind::kExecutionFailed;
+                    response.errorMessage = "mt-kahypar partition failed: " + takeMtKaHyParError(mtError);
+                    cleanup();
+                    return false;
+                }
+                addBackendLog("partition done run_ms=" + std::to_string(response.solverRunMs));
+
+                response.partitionPath = request.partitionPath;
+                if (!request.partitionPath.empty())
+                {
+                    const std::string partPath = request.partitionPath.string();
+                    addBackendLog("write_partition_to_file path=" + partPath);
+                    const mt_kahypar_status_t writeStatus =
+                        mt_kahypar_write_partition_to_file(partitionedHg, partPath.c_str(), &mtError);
+                    if (writeStatus != SUCCESS)
+                    {
+                        response.errorKind = PartitionBackendErrorKind::kExecutionFailed;
+                        response.errorMessage = "mt-kahypar failed to write partition file: " +
+                                                takeMtKaHyParError(mtError);
+                        cleanup();
+                        return false;
+                    }
+                }
+
+                const auto parseStart = std::chrono::steady_clock::now();
+                const std::size_t nodeCount = static_cast<std::size_t>(mt_kahypar_num_hypernodes(hypergraph));
+                std::vector<mt_kahypar_partition_id_t> rawPartition(nodeCount, 0);
+                if (!rawPartition.empty())
+                {
+                    mt_kahypar_get_partition(partitionedHg, rawPartition.data());
+                }
+                addBackendLog("get_partition entries=" + std::to_string(rawPartition.size()));
+
+                response.partition.assign(request.ascCount, 0);
+                std::size_t negativeCount = 0;
+                std::size_t outOfRangeCount = 0;
+                const std::size_t limit = std::min(request.ascCount, rawPartition.size());
+                for (std::size_t i = 0; i < limit; ++i)
+                {
+                    int64_t part = static_cast<int64_t>(rawPartition[i]);
+                    if (part < 0)
+                    {
+                        ++negativeCount;
+                        part = 0;
+                    }
+                    if (part >= static_cast<int64_t>(request.partitionCount))
+                    {
+                        ++outOfRangeCount;
+                        part = static_cast<int64_t>(request.partitionCount - 1);
+                    }
+                    response.partition[i] = static_cast<uint32_t>(part);
+                }
+
+                std::ostringstream warning;
+                if (rawPartition.size() < request.ascCount)
+                {
+                    response.partitionComplete = false;
+                    warning << "fewer entries than ASC count (" << rawPartition.size()
+                            << " < " << request.ascCount
+                            << "), missing entries default to 0";
+                }
+                else if (rawPartition.size() > request.ascCount)
+                {
+                    response.partitionComplete = false;
+                    warning << "extra entries in partition result (" << rawPartition.size()
+                            << " > " << request.ascCount
+                            << "), extras ignored";
+                }
+                if (negativeCount > 0)
+                {
+                    if (warning.tellp() > 0)
+                    {
+                        warning << "; ";
+                    }
+                    response.partitionComplete = false;
+                    warning << "negative ids clamped=" << negativeCount;
+                }
+                if (outOfRangeCount > 0)
+                {
+                    if (warning.tellp() > 0)
+                    {
+                        warning << "; ";
+                    }
+                    response.partitionComplete = false;
+                    warning << "ids >= max-part-count clamped=" << outOfRangeCount;
+                }
+                response.partitionWarning = warning.str();
+                response.parsePartitionMs = static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::milliseconds>(
+                        std::chrono::steady_clock::now() - parseStart)
+                        .count());
+
+                cleanup();
+                return true;
+#endif
+            }
+        };
+
+        std::unique_ptr<PartitionBackend> createPartitionBackend(const RepcutOptions &options)
+        {
+            const std::string normalized = normalizeBackendToken(options.partitioner);
+            if (normalized == "mt-kahypar" || normalized == "mtkahypar")
+            {
+                return std::make_unique<MtKaHyParBackend>();
+            }
+            return nullptr;
+        }
+
+        // Bump when phase-b/c or the cache layout changes so stale caches are ignored.
+        constexpr uint32_t kRepcutCacheVersion = 3;
+        constexpr std::array<char, 4> kRepcutCacheMagic{'R', 'C', 'U', 'T'};
+        // Written right after the version in native byte order; a file from a host with the
+        // other byte order reads it swapped and is ignored like any other mismatching cache.
+        constexpr uint32_t kRepcutCacheByteOrderMark = 0x01020304u;
+        // CacheWriter/CacheReader copy integers and doubles in native representation.
+        static_assert(std::endian::native == std::endian::little,
+                      "repcut cache is only written on little-endian hosts");
+
+        // FNV-1a over everything phases a-c read: op/value ids, kinds, symbols, widths, attrs and
+        // ports. Source locations are left out, so re-elaborating the same RTL keeps the hash.
+        class StructuralHasher
+        {
+        public:
+            void bytes(const void *data, std::size_t size)
+            {
+                const auto *ptr = static_cast<const unsigned char *>(data);
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    hash_ ^= ptr[i];
+                    hash_ *= 1099511628211ull;
+                }
+            }
+            void u64(uint64_t value) { bytes(&value, sizeof(value)); }
+            void str(std::string_view text)
+            {
+                u64(text.size());
+                bytes(text.data(), text.size());
+            }
+            uint64_t value() const noexcept { return hash_; }
+
+        private:
+            uint64_t hash_ = 14695981039346656037ull;
+        };
+
+        // phaseBSccCones changes the ASCs of cyclic graphs, so it is part of the key.
+        uint64_t hashGraphStructure(const wolvrix::lib::grh::Graph &graph, bool phaseBSccCones)
+        {
+            StructuralHasher hasher;
+            hasher.u64(phaseBSccCones ? 1u : 0u);
+            auto hashValueId = [&](wolvrix::lib::grh::ValueId id) {
+                hasher.u64((static_cast<uint64_t>(id.index) << 32) | id.generation);
+            };
+            for (const auto valueId : graph.values())
+            {
+                const wolvrix::lib::grh::Value value = graph.getValue(valueId);
+                hashValueId(valueId);
+                hasher.str(value.symbolText());
+                hasher.u64(static_cast<uint64_t>(static_cast<uint32_t>(value.width())));
+                hasher.u64((value.isSigned() ? 1u : 0u) | (value.isInput() ? 2u : 0u) | (value.isOutput() ? 4u : 0u) |
+                           (value.isInout() ? 8u : 0u) | (static_cast<uint64_t>(value.type()) << 8));
+            }
+            for (const auto opId : graph.operations())
+            {
+                const wolvrix::lib::grh::Operation op = graph.getOperation(opId);
+                hasher.u64((static_cast<uint64_t>(opId.index) << 32) | opId.generation);
+                hasher.u64(static_cast<uint64_t>(op.kind()));
+                hasher.str(op.symbolText());
+                hasher.u64(op.operands().size());
+                for (const auto operand : op.operands())
+                {
+                    hashValueId(operand);
+                }
+                hasher.u64(op.results().size());
+                for (const auto resultValue : op.results())
+                {
+                    hashValueId(resultValue);
+                }
+                hasher.u64(op.attrs().size());
+                for (const auto &attr : op.attrs())
+                {
+                    hasher.str(attr.key);
+                    hasher.u64(attr.value.index());
+                    std::visit(
+                        [&](const auto &item) {
+                            using T = std::decay_t<decltype(item)>;
+                            if constexpr (std::is_same_v<T, std::string>)
+                            {
+                                hasher.str(item);
+                            }
+                            else if constexpr (std::is_same_v<T, std::vector<std::string>>)
+                            {
+                                hasher.u64(item.size());
+                                for (const auto &text : item)
+                                {
+                                    hasher.str(text);
+                                }
+                            }
+                            else if constexpr (std::is_same_v<T, std::vector<bool>>)
+                            {
+                                hasher.u64(item.size());
+                                for (const bool bit : item)
+                                {
+                                    hasher.u64(bit ? 1u : 0u);
+                                }
+                            }
+                            else if constexpr (std::is_same_v<T, std::vector<int64_t>> ||
+                                               std::is_same_v<T, std::vector<double>>)
+                            {
+                                hasher.u64(item.size());
+                                hasher.bytes(item.data(), item.size() * sizeof(typename T::value_type));
+                            }
+                            else
+                            {
+                                hasher.bytes(&item, sizeof(item));
+                            }
+                        },
+                        attr.value);
+                }
+            }
+            for (const auto &port : graph.inputPorts())
+            {
+                hasher.str(port.name);
+                hashValueId(port.value);
+            }
+            for (const auto &port : graph.outputPorts())
+            {
+                hasher.str(port.name);
+                hashValueId(port.value);
+            }
+            for (const auto &port : graph.inoutPorts())
+            {
+                hasher.str(port.name);
+                hashValueId(port.in);
+                hashValueId(port.out);
+                hashValueId(port.oe);
+            }
+            return hasher.value();
+        }
+
+        struct RepcutCachedPartition
+        {
+            std::size_t partitionCount = 0;
+            double imbalanceFactor = 0.0;
+            std::string partitioner;
+            std::string preset;
+            std::string edgeWeighting;
+            std::vector<uint32_t> partition;
+        };
+
+        // What phase-e needs from phases b-d, persisted per target graph under -work-dir so an
+        // unchanged graph goes from phase-a straight to the rebuild. ASC comb ops are phase-a
+        // node ids, which are stable for a graph with the same structural hash.
+        struct RepcutCache
+        {
+            std::size_t nodeCount = 0;
+            std::vector<SinkRef> sinks;
+            std::vector<AscInfo> ascs;
+            std::size_t pieceCount = 0;
+            HyperGraph hypergraph;
+            std::vector<PieceCommStats> edgeCommStats;
+            std::vector<RepcutCachedPartition> partitions;
+        };
+
+        const RepcutCachedPartition *findCachedPartition(const std::vector<RepcutCachedPartition> &partitions,
+                                                         const PartitionBackendRequest &request,
+                                                         std::string_view partitioner,
+                                                         std::string_view edgeWeighting)
+        {
+            for (const auto &entry : partitions)
+            {
+                if (entry.partitionCount == request.partitionCount &&
+                    entry.imbalanceFactor == request.imbalanceFactor && entry.partitioner == partitioner &&
+                    entry.preset == request.preset && entry.edgeWeighting == edgeWeighting)
+                {
+                    return &entry;
+                }
+            }
+            return nullptr;
+        }
+
+        class CacheWriter
+        {
+        public:
+            explicit CacheWriter(std::ostream &out) : out_(out) {}
+            void u8(uint8_t value) { out_.put(static_cast<char>(value)); }
+            void u32(uint32_t value) { out_.write(reinterpret_cast<const char *>(&value), sizeof(value)); }
+            void u64(uint64_t value) { out_.write(reinterpret_cast<const char *>(&value), sizeof(value)); }
+            void f64(double value) { out_.write(reinterpret_cast<const char *>(&value), sizeof(value)); }
+            void str(std::string_view text)
+            {
+                u64(text.size());
+                out_.write(text.data(), static_cast<std::streamsize>(text.size()));
+            }
+            template <typename T>
+            void u32s(const std::vector<T> &values)
+            {
+                u64(values.size());
+                for (const T value : values)
+                {
+                    u32(static_cast<uint32_t>(value));
+                }
+            }
+
+        private:
+            std::ostream &out_;
+        };
+
+        // Bounds-checked reads; any short or malformed input sets failed() and yields zeros.
+        class CacheReader
+        {
+        public:
+            explicit CacheReader(std::string_view data) : data_(data) {}
+            bool failed() const noexcept { return failed_; }
+            uint8_t u8() { return read<uint8_t>(); }
+            uint32_t u32() { return read<uint32_t>(); }
+            uint64_t u64() { return read<uint64_t>(); }
+            double f64() { return read<double>(); }
+            std::size_t count(std::size_t elementSize)
+            {
+                const uint64_t value = u64();
+                if (elementSize != 0 && value > (data_.size() - pos_) / elementSize)
+                {
+                    failed_ = true;
+                    return 0;
+                }
+                return static_cast<std::size_t>(value);
+            }
+            std::string str()
+            {
+                const std::size_t size = count(1);
+                std::string text(data_.substr(pos_, size));
+                pos_ += size;
+                return text;
+            }
+            template <typename T>
+            std::vector<T> u32s()
+            {
+                std::vector<T> values(count(sizeof(uint32_t)));
+                for (auto &value : values)
+                {
+                    value = static_cast<T>(u32());
+                }
+                return values;
+            }
+            bool atEnd() const noexcept { return pos_ == data_.size(); }
+
+        private:
+            template <typename T>
+            T read()
+            {
+                T value{};
+                if (failed_ || data_.size() - pos_ < sizeof(T))
+                {
+                    failed_ = true;
+                    return value;
+                }
+                std::memcpy(&value, data_.data() + pos_, sizeof(T));
+                pos_ += sizeof(T);
+                return value;
+            }
+
+            std::string_view data_;
+            std::size_t pos_ = 0;
+            bool failed_ = false;
+        };
+
+        // A structural hash hit does not prove the cached phase-b/c data was built from this graph
+        // (hash collision, hand-edited file, repcut bug). Checks what can be checked without
+        // redoing phase-b; returns an empty string when the cache is consistent.
+        std::string checkRepcutCache(const RepcutCache &cache,
+                                     const std::vector<SinkRef> &liveSinks,
+                                     std::size_t nodeCount)
+        {
+            if (cache.nodeCount != nodeCount)
+            {
+                return "node count " + std::to_string(cache.nodeCount) + " != " + std::to_string(nodeCount);
+            }
+            if (cache.sinks.size() != liveSinks.size())
+            {
+                return "sink count " + std::to_string(cache.sinks.size()) + " != " + std::to_string(liveSinks.size());
+            }
+            for (std::size_t i = 0; i < liveSinks.size(); ++i)
+            {
+                const SinkRef &cached = cache.sinks[i];
+                const SinkRef &live = liveSinks[i];
+                if (cached.kind != live.kind || cached.op.index != live.op.index ||
+                    cached.op.generation != live.op.generation || cached.value.index != live.value.index ||
+                    cached.value.generation != live.value.generation)
+                {
+                    return "sink " + std::to_string(i) + " differs";
+                }
+            }
+            if (cache.ascs.size() > liveSinks.size())
+            {
+                return "ASC count " + std::to_string(cache.ascs.size()) + " does not fit " +
+                       std::to_string(liveSinks.size()) + " sinks";
+            }
+            std::vector<char> sinkSeen(liveSinks.size(), 0);
+            for (const AscInfo &asc : cache.ascs)
+            {
+                for (const std::size_t sink : asc.sinks)
+                {
+                    if (sink >= sinkSeen.size() || sinkSeen[sink])
+                    {
+                        return "ASC sink " + std::to_string(sink) + " is out of range or shared";
+                    }
+                    sinkSeen[sink] = 1;
+                }
+                for (const NodeId node : asc.combOps)
+                {
+                    if (node >= nodeCount)
+                    {
+                        return "ASC node " + std::to_string(node) + " is out of range";
+                    }
+                }
+            }
+            if (std::find(sinkSeen.begin(), sinkSeen.end(), 0) != sinkSeen.end())
+            {
+                return "some sinks belong to no ASC";
+            }
+            if (cache.hypergraph.nodeWeights.size() != cache.ascs.size())
+            {
+                return "hypergraph has " + std::to_string(cache.hypergraph.nodeWeights.size()) + " nodes for " +
+                       std::to_string(cache.ascs.size()) + " ASCs";
+            }
+            return {};
+        }
+
+        std::filesystem::path repcutCachePath(const std::filesystem::path &outputDir, const std::string &graphBase)
+        {
+            return outputDir / (graphBase + ".repcut-cache");
+        }
+
+        // Returns nullopt when the file is missing, malformed, from another cache version or byte
+        // order, or for a different graph hash.
+        std::optional<RepcutCache> readRepcutCache(const std::filesystem::path &path, uint64_t graphHash)
+        {
+            std::ifstream in(path, std::ios::binary);
+            if (!in)
+            {
+                return std::nullopt;
+            }
+            const std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+            CacheReader reader(data);
+            std::array<char, 4> magic{};
+            for (char &ch : magic)
+            {
+                ch = static_cast<char>(reader.u8());
+            }
+            if (magic != kRepcutCacheMagic || reader.u32() != kRepcutCacheVersion ||
+                reader.u32() != kRepcutCacheByteOrderMark)
+            {
+                return std::nullopt;
+            }
+            if (reader.u64() != graphHash || reader.failed())
+            {
+                return std::nullopt;
+            }
+            RepcutCache cache;
+            cache.nodeCount = static_cast<std::size_t>(reader.u64());
+            cache.sinks.resize(reader.count(9));
+            for (auto &sink : cache.sinks)
+            {
+                sink.kind = reader.u8() == 0 ? SinkRef::Kind::Operation : SinkRef::Kind::OutputValue;
+                const uint32_t index = reader.u32();
+                const uint32_t generation = reader.u32();
+                if (sink.kind == SinkRef::Kind::Operation)
+                {
+                    sink.op.index = index;
+                    sink.op.generation = generation;
+                }
+                else
+                {
+                    sink.value.index = index;
+                    sink.value.generation = generation;
+                }
+            }
+            cache.ascs.resize(reader.count(16));
+            for (auto &asc : cache.ascs)
+            {
+                asc.sinks = reader.u32s<size_t>();
+                asc.combOps = reader.u32s<NodeId>();
+            }
+            cache.pieceCount = static_cast<std::size_t>(reader.u64());
+            cache.hypergraph.nodeWeights = reader.u32s<uint32_t>();
+            cache.hypergraph.edges.resize(reader.count(12));
+            for (auto &edge : cache.hypergraph.edges)
+            {
+                edge.weight = reader.u32();
+                edge.nodes = reader.u32s<AscId>();
+            }
+            cache.edgeCommStats.resize(reader.count(8 * sizeof(uint64_t)));
+            for (auto &stats : cache.edgeCommStats)
+            {
+                stats.outSignalCount = static_cast<std::size_t>(reader.u64());
+                stats.outWords = static_cast<std::size_t>(reader.u64());
+                stats.wide64Words = static_cast<std::size_t>(reader.u64());
+                stats.wide256Words = static_cast<std::size_t>(reader.u64());
+                stats.fanoutExcess = static_cast<std::size_t>(reader.u64());
+                stats.stateBoundaryWords = static_cast<std::size_t>(reader.u64());
+                stats.outWords32 = static_cast<std::size_t>(reader.u64());
+                stats.fanoutWords32 = static_cast<std::size_t>(reader.u64());
+            }
+            cache.partitions.resize(reader.count(32));
+            for (auto &entry : cache.partitions)
+            {
+                entry.partitionCount = static_cast<std::size_t>(reader.u64());
+                entry.imbalanceFactor = reader.f64();
+                entry.partitioner = reader.str();
+                entry.preset = reader.str();
+                entry.edgeWeighting = reader.str();
+                entry.partition = reader.u32s<uint32_t>();
+            }
+            if (reader.failed() || !reader.atEnd())
+            {
+                return std::nullopt;
+            }
+            return cache;
+        }
+
+        // Writes through a temporary file and a rename, so concurrent runs never see a torn cache.
+        bool writeRepcutCache(const std::filesystem::path &path,
+                              uint64_t graphHash,
+                              std::size_t nodeCount,
+                              const PhaseBData &phaseB,
+                              std::size_t pieceCount,
+                              const HyperGraph &hg,
+                              const std::vector<PieceCommStats> &edgeCommStats,
+                              const std::vector<RepcutCachedPartition> &partitions,
+                              std::string &errorMessage)
+        {
+            if (path.has_parent_path())
+            {
+                std::error_code ec;
+                std::filesystem::create_directories(path.parent_path(), ec);
+            }
+            const std::filesystem::path tmpPath = path.string() + ".tmp";
+            {
+                std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+                if (!out)
+                {
+                    errorMessage = "cannot open repcut cache for writing: " + tmpPath.string();
+                    return false;
+                }
+                CacheWriter writer(out);
+                for (const char ch : kRepcutCacheMagic)
+                {
+                    writer.u8(static_cast<uint8_t>(ch));
+                }
+                writer.u32(kRepcutCacheVersion);
+                writer.u32(kRepcutCacheByteOrderMark);
+                writer.u64(graphHash);
+                writer.u64(nodeCount);
+                writer.u64(phaseB.sinks.size());
+                for (const auto &sink : phaseB.sinks)
+                {
+                    const bool isOp = sink.kind == SinkRef::Kind::Operation;
+                    writer.u8(isOp ? 0u : 1u);
+                    writer.u32(isOp ? sink.op.index : sink.value.index);
+                    writer.u32(isOp ? sink.op.generation : sink.value.generation);
+                }
+                writer.u64(phaseB.ascs.size());
+                for (const auto &asc : phaseB.ascs)
+                {
+                    writer.u32s(asc.sinks);
+                    writer.u32s(asc.combOps);
+                }
+                writer.u64(pieceCount);
+                writer.u32s(hg.nodeWeights);
+                writer.u64(hg.edges.size());
+                for (const auto &edge : hg.edges)
+                {
+                    writer.u32(edge.weight);
+                    writer.u32s(edge.nodes);
+                }
+                writer.u64(edgeCommStats.size());
+                for (const auto &stats : edgeCommStats)
+                {
+                    writer.u64(stats.outSignalCount);
+                    writer.u64(stats.outWords);
+                    writer.u64(stats.wide64Words);
+                    writer.u64(stats.wide256Words);
+                    writer.u64(stats.fanoutExcess);
+                    writer.u64(stats.stateBoundaryWords);
+                    writer.u64(stats.outWords32);
+                    writer.u64(stats.fanoutWords32);
+                }
+                writer.u64(partitions.size());
+                for (const auto &entry : partitions)
+                {
+                    writer.u64(entry.partitionCount);
+                    writer.f64(entry.imbalanceFactor);
+                    writer.str(entry.partitioner);
+                    writer.str(entry.preset);
+                    writer.str(entry.edgeWeighting);
+                    writer.u32s(entry.partition);
+                }
+                out.flush();
+                if (!out.good())
+                {
+                    errorMessage = "failed writing repcut cache: " + tmpPath.string();
+                    return false;
+                }
+            }
+            std::error_code ec;
+            std::filesystem::rename(tmpPath, path, ec);
+            if (ec)
+            {
+                std::filesystem::remove(tmpPath, ec);
+                errorMessage = "cannot replace repcut cache: " + path.string();
+                return false;
+            }
+            return true;
+        }
+
+        bool writePartitionFile(const std::filesystem::path &path,
+                                const std::vector<uint32_t> &partition,
+                                std::string &errorMessage)
+        {
+            std::string content;
+            content.reserve(partition.size() * 3);
+            for (const uint32_t part : partition)
+            {
+                content += std::to_string(part);
+                content += '\n';
+            }
+            return writeTextFile(path, content, errorMessage);
+        }
+
+        // Name of an ASC that survives a re-run on an edited graph: the smallest name among its
+        // sinks. Write ports are named by the storage they write and output sinks by their value,
+        // so the key does not depend on op or value ids.
+        std::string ascStableKey(const wolvrix::lib::grh::Graph &graph,
+                                 const std::vector<SinkRef> &sinks,
+                                 const AscInfo &asc)
+        {
+            std::string best;
+            for (const size_t sinkIndex : asc.sinks)
+            {
+                if (sinkIndex >= sinks.size())
+                {
+                    continue;
+                }
+                const SinkRef &sink = sinks[sinkIndex];
+                std::string key;
+                if (sink.kind == SinkRef::Kind::Operation)
+                {
+                    const wolvrix::lib::grh::Operation op = graph.getOperation(sink.op);
+                    std::optional<std::string> storage;
+                    switch (op.kind())
+                    {
+                    case wolvrix::lib::grh::OperationKind::kRegisterWritePort:
+                        storage = getAttrString(op, "regSymbol");
+                        break;
+                    case wolvrix::lib::grh::OperationKind::kLatchWritePort:
+                        storage = getAttrString(op, "latchSymbol");
+                        break;
+                    case wolvrix::lib::grh::OperationKind::kMemoryWritePort:
+                        storage = getAttrString(op, "memSymbol");
+                        break;
+                    default:
+                        break;
+                    }
+                    const std::string name = storage ? *storage : std::string(op.symbolText());
+                    if (!name.empty())
+                    {
+                        key = std::string(wolvrix::lib::grh::toString(op.kind())) + ":" + name;
+                    }
+                }
+                else
+                {
+                    const std::string_view name = graph.getValue(sink.value).symbolText();
+                    if (!name.empty())
+                    {
+                        key = "out:" + std::string(name);
+                    }
+                }
+                if (!key.empty() && (best.empty() || key < best))
+                {
+                    best = std::move(key);
+                }
+            }
+            return best;
+        }
+
+        std::filesystem::path ascPartitionMapPath(const std::filesystem::path &outputDir, const std::string &graphBase)
+        {
+            return outputDir / (graphBase + ".repcut-asc-parts");
+        }
+
+        // One "<part>\t<asc key>" line per named ASC of the rebuilt partitioning, so a timing
+        // profile of the generated package can be mapped back onto the ASCs of a later run.
+        bool writeAscPartitionMap(const std::filesystem::path &path,
+                                  const std::vector<std::string> &ascKeys,
+                                  const std::vector<uint32_t> &partition,
+                                  std::string &errorMessage)
+        {
+            std::string content = "# repcut asc partition map v1\n";
+            for (std::size_t aid = 0; aid < ascKeys.size() && aid < partition.size(); ++aid)
+            {
+                if (ascKeys[aid].empty())
+                {
+                    continue;
+                }
+                content += std::to_string(partition[aid]);
+                content += '\t';
+                content += ascKeys[aid];
+                content += '\n';
+            }
+            return writeTextFile(path, content, errorMessage);
+        }
+
+        // Malformed lines are skipped with a warning: a partial map only leaves the affected
+        // ASCs at their static weight.
+        bool readAscPartitionMap(const std::filesystem::path &path,
+                                 std::unordered_map<std::string, uint32_t> &partByKey,
+                                 std::vector<std::string> &warnings,
+                                 std::string &errorMessage)
+        {
+            std::ifstream in(path);
+            if (!in)
+            {
+                errorMessage = "cannot open asc partition map: " + path.string();
+                return false;
+            }
+            std::string line;
+            std::size_t lineNo = 0;
+            while (std::getline(in, line))
+            {
+                ++lineNo;
+                if (line.empty() || line.front() == '#')
                 {
-                    response.errorKind = PartitionBackendErrorKind::kExecutionFailed;
-                    response.errorMessage = "mt-kahypar failed to load hMETIS file: " + takeMtKaHyParError(mtError);
-                    cleanup();
-                    return false;
+                    continue;
                 }
-                addBackendLog("read_hypergraph_done node_count=" +
-                              std::to_string(static_cast<std::size_t>(mt_kahypar_num_hypernodes(hypergraph))));
-
-                addBackendLog("partition begin");
-                const auto solverStart = std::chrono::steady_clock::now();
-                partitionedHg = mt_kahypar_partition(hypergraph, context, &mtError);
-                response.solverRunMs = static_cast<uint64_t>(
-                    std::chrono::duration_cast<std::chrono::milliseconds>(
-                        std::chrono::steady_clock::now() - solverStart)
-                        .count());
-                if (partitionedHg.partitioned_hg == nullptr)
+                const std::size_t tab = line.find('\t');
+                bool valid = tab != std::string::npos && tab > 0 && tab + 1 < line.size() &&
+                             std::isdigit(static_cast<unsigned char>(line.front()));
+                unsigned long part = 0;
+                if (valid)
                 {
-                    response.errorKind = PartitionBackendErrorKind::kExecutionFailed;
-                    response.errorMessage = "mt-kahypar partition failed: " + takeMtKaHyParError(mtError);
-                    cleanup();
-                    return false;
+                    char *end = nullptr;
+                    errno = 0;
+                    part = std::strtoul(line.c_str(), &end, 10);
+                    valid = errno == 0 && end == line.c_str() + tab &&
+                            part <= std::numeric_limits<uint32_t>::max();
                 }
-                addBackendLog("partition done run_ms=" + std::to_string(response.solverRunMs));
-
-                response.partitionPath = request.partitionPath;
-                if (!request.partitionPath.empty())
+                if (!valid)
                 {
-                    const std::string partPath = request.partitionPath.string();
-                    addBackendLog("write_partition_to_file path=" + partPath);
-                    const mt_kahypar_status_t writeStatus =
-                        mt_kahypar_write_partition_to_file(partitionedHg, partPath.c_str(), &mtError);
-                    if (writeStatus != SUCCESS)
-                    {
-                        response.errorKind = PartitionBackendErrorKind::kExecutionFailed;
-                        response.errorMessage = "mt-kahypar failed to write partition file: " +
-                                                takeMtKaHyParError(mtError);
-                        cleanup();
-                        return false;
-                    }
+                    warnings.push_back(path.string() + ":" + std::to_string(lineNo) +
+                                       ": malformed asc partition map line");
+                    continue;
                 }
+                partByKey[line.substr(tab + 1)] = static_cast<uint32_t>(part);
+            }
+            return true;
+        }
 
-                const auto parseStart = std::chrono::steady_clock::now();
-                const std::size_t nodeCount = static_cast<std::size_t>(mt_kahypar_num_hypernodes(hypergraph));
-                std::vector<mt_kahypar_partition_id_t> rawPartition(nodeCount, 0);
-                if (!rawPartition.empty())
+        // Reads the part_timing records that the generated package writes to
+        // WOLVI_REPCUT_TIMING_JSONL and returns the average eval time per step, keyed by the
+        // partition index of the part_<index> instance. Each line is parsed as one JSON object;
+        // malformed lines are skipped with a warning naming the line.
+        bool readPartTimingProfile(const std::filesystem::path &path,
+                                   std::unordered_map<uint32_t, double> &evalUsByPart,
+                                   std::vector<std::string> &warnings,
+                                   std::string &errorMessage)
+        {
+            std::ifstream in(path);
+            if (!in)
+            {
+                errorMessage = "cannot open timing profile: " + path.string();
+                return false;
+            }
+            std::string line;
+            std::string scratch;
+            std::size_t lineNo = 0;
+            while (std::getline(in, line))
+            {
+                ++lineNo;
+                if (line.find_first_not_of(" \t\r") == std::string::npos)
                 {
-                    mt_kahypar_get_partition(partitionedHg, rawPartition.data());
+                    continue;
                 }
-                addBackendLog("get_partition entries=" + std::to_string(rawPartition.size()));
-
-                response.partition.assign(request.ascCount, 0);
-                std::size_t negativeCount = 0;
-                std::size_t outOfRangeCount = 0;
-                const std::size_t limit = std::min(request.ascCount, rawPartition.size());
-                for (std::size_t i = 0; i < limit; ++i)
+                const std::string where = path.string() + ":" + std::to_string(lineNo) + ": ";
+                std::string recordType;
+                std::string partName;
+                std::optional<double> evalUs;
+                try
                 {
-                    int64_t part = static_cast<int64_t>(rawPartition[i]);
-                    if (part < 0)
-                    {
-                        ++negativeCount;
-                        part = 0;
-                    }
-                    if (part >= static_cast<int64_t>(request.partitionCount))
+                    wolvrix::lib::load::JsonCursor cursor(line);
+                    cursor.beginObject("timing record");
+                    std::string_view key;
+                    while (cursor.nextKey(key, scratch))
                     {
-                        ++outOfRangeCount;
-                        part = static_cast<int64_t>(request.partitionCount - 1);
+                        if (key == "record_type")
+                        {
+                            recordType = std::string(cursor.readString("record_type", scratch));
+                        }
+                        else if (key == "part_name")
+                        {
+                            partName = std::string(cursor.readString("part_name", scratch));
+                        }
+                        else if (key == "eval_avg_us")
+                        {
+                            evalUs = cursor.readDouble("eval_avg_us");
+                        }
+                        else
+                        {
+                            cursor.skipValue();
+                        }
                     }
-                    response.partition[i] = static_cast<uint32_t>(part);
+                    cursor.expectEnd();
                 }
-
-                std::ostringstream warning;
-                if (rawPartition.size() < request.ascCount)
+                catch (const std::exception &ex)
                 {
-                    response.partitionComplete = false;
-                    warning << "fewer entries than ASC count (" << rawPartition.size()
-                            << " < " << request.ascCount
-                            << "), missing entries default to 0";
+                    warnings.push_back(where + ex.what());
+                    continue;
                 }
-                else if (rawPartition.size() > request.ascCount)
+                if (recordType != "part_timing")
                 {
-                    response.partitionComplete = false;
-                    warning << "extra entries in partition result (" << rawPartition.size()
-                            << " > " << request.ascCount
-                            << "), extras ignored";
+                    continue;
                 }
-                if (negativeCount > 0)
+                if (!evalUs || partName.size() <= 5 || !partName.starts_with("part_") ||
+                    partName.find_first_not_of("0123456789", 5) != std::string::npos)
                 {
-                    if (warning.tellp() > 0)
-                    {
-                        warning << "; ";
-                    }
-                    response.partitionComplete = false;
-                    warning << "negative ids clamped=" << negativeCount;
+                    warnings.push_back(where + "malformed part_timing record");
+                    continue;
                 }
-                if (outOfRangeCount > 0)
+                uint32_t part = 0;
+                const auto [ptr, ec] = std::from_chars(partName.data() + 5, partName.data() + partName.size(), part);
+                if (ec != std::errc())
                 {
-                    if (warning.tellp() > 0)
-                    {
-                        warning << "; ";
-                    }
-                    response.partitionComplete = false;
-                    warning << "ids >= max-part-count clamped=" << outOfRangeCount;
+                    warnings.push_back(where + "part index out of range: " + partName);
+                    continue;
                 }
-                response.partitionWarning = warning.str();
-                response.parsePartitionMs = static_cast<uint64_t>(
-                    std::chrono::duration_cast<std::chrono::milliseconds>(
-                        std::chrono::steady_clock::now() - parseStart)
-                        .count());
-
-                cleanup();
-                return true;
-#endif
+                evalUsByPart[part] = std::max(0.0, *evalUs);
+            }
+            if (evalUsByPart.empty())
+            {
+                errorMessage = "no part_timing records in " + path.string();
+                return false;
             }
+            return true;
+        }
+
+        struct ProfileWeightStats
+        {
+            std::size_t matchedAscs = 0;
+            std::size_t unmatchedAscs = 0;
+            std::size_t profiledParts = 0;
         };
 
-        std::unique_ptr<PartitionBackend> createPartitionBackend(const RepcutOptions &options)
+        // Rescales the node weights of ASCs found in the previous partitioning so that each
+        // previous part weighs in proportion to its measured eval time. Within a part, weight is
+        // spread by the static estimate; the matched total is preserved, and ASCs that are new
+        // since the profiled run keep their static weight.
+        ProfileWeightStats applyProfileNodeWeights(std::vector<uint32_t> &nodeWeights,
+                                                   const std::vector<std::string> &ascKeys,
+                                                   const std::unordered_map<std::string, uint32_t> &previousPartByKey,
+                                                   const std::unordered_map<uint32_t, double> &evalUsByPart)
         {
-            const std::string normalized = normalizeBackendToken(options.partitioner);
-            if (normalized == "mt-kahypar" || normalized == "mtkahypar")
+            ProfileWeightStats stats;
+            constexpr uint32_t kUnmatched = std::numeric_limits<uint32_t>::max();
+            std::vector<uint32_t> previousPart(nodeWeights.size(), kUnmatched);
+            std::unordered_map<uint32_t, uint64_t> staticWeightByPart;
+            for (std::size_t aid = 0; aid < nodeWeights.size() && aid < ascKeys.size(); ++aid)
             {
-                return std::make_unique<MtKaHyParBackend>();
+                if (ascKeys[aid].empty())
+                {
+                    continue;
+                }
+                const auto keyIt = previousPartByKey.find(ascKeys[aid]);
+                if (keyIt == previousPartByKey.end() || evalUsByPart.count(keyIt->second) == 0)
+                {
+                    continue;
+                }
+                previousPart[aid] = keyIt->second;
+                staticWeightByPart[keyIt->second] += nodeWeights[aid];
             }
-            return nullptr;
+
+            double matchedStatic = 0.0;
+            double matchedMeasured = 0.0;
+            for (const auto &[part, staticWeight] : staticWeightByPart)
+            {
+                matchedStatic += static_cast<double>(staticWeight);
+                matchedMeasured += evalUsByPart.at(part);
+            }
+            stats.profiledParts = staticWeightByPart.size();
+            if (matchedStatic <= 0.0 || matchedMeasured <= 0.0)
+            {
+                stats.unmatchedAscs = nodeWeights.size();
+                return stats;
+            }
+
+            const double normalize = matchedStatic / matchedMeasured;
+            for (std::size_t aid = 0; aid < nodeWeights.size(); ++aid)
+            {
+                const uint32_t part = previousPart[aid];
+                if (part == kUnmatched)
+                {
+                    ++stats.unmatchedAscs;
+                    continue;
+                }
+                ++stats.matchedAscs;
+                const double partScale =
+                    evalUsByPart.at(part) / static_cast<double>(staticWeightByPart.at(part)) * normalize;
+                const double scaled = static_cast<double>(nodeWeights[aid]) * partScale;
+                nodeWeights[aid] = std::max<uint32_t>(
+                    1u, clampToUint32(static_cast<std::size_t>(std::llround(std::max(1.0, scaled)))));
+            }
+            return stats;
         }
 
         void collectStorageInfos(const wolvrix::lib::grh::Graph &graph,
@@ -3928,9 +5355,43 @@ namespace wolvrix::lib::transform
             result.failed = true;
             return result;
         }
-        if (options_.partitionCount > kMaxPartitionCount)
+        // Each backend call sees at most kMaxPartitionCount parts; hierarchical mode makes one call
+        // for the domains and one per domain, so the total may reach numaDomains times the limit.
+        const bool numaHierarchical = options_.numaDomains >= 2;
+        const std::size_t numaDomainCount = numaHierarchical ? options_.numaDomains : 1;
+        if (numaHierarchical)
+        {
+            if (options_.numaDomains > kMaxPartitionCount)
+            {
+                error("repcut numa_domains must be <= " + std::to_string(kMaxPartitionCount));
+                result.failed = true;
+                return result;
+            }
+            if (options_.partitionCount % options_.numaDomains != 0)
+            {
+                error("repcut partition_count (" + std::to_string(options_.partitionCount) +
+                      ") must be a multiple of numa_domains (" + std::to_string(options_.numaDomains) + ")");
+                result.failed = true;
+                return result;
+            }
+            if (!options_.sweepPartitionCounts.empty())
+            {
+                error("repcut numa_domains cannot be combined with a partition count sweep");
+                result.failed = true;
+                return result;
+            }
+            if (!(options_.numaInterDomainCost > 0.0) || !std::isfinite(options_.numaInterDomainCost))
+            {
+                error("repcut numa_inter_domain_cost must be a positive number");
+                result.failed = true;
+                return result;
+            }
+        }
+        if (options_.partitionCount / numaDomainCount > kMaxPartitionCount)
         {
-            error("repcut partition_count must be <= " + std::to_string(kMaxPartitionCount));
+            error(numaHierarchical ? "repcut partition_count / numa_domains must be <= " +
+                                         std::to_string(kMaxPartitionCount)
+                                   : "repcut partition_count must be <= " + std::to_string(kMaxPartitionCount));
             result.failed = true;
             return result;
         }
@@ -3940,6 +5401,32 @@ namespace wolvrix::lib::transform
             result.failed = true;
             return result;
         }
+        for (const std::size_t sweepCount : options_.sweepPartitionCounts)
+        {
+            if (sweepCount < 2 || sweepCount > kMaxPartitionCount)
+            {
+                error("repcut sweep partition counts must be within [2, " + std::to_string(kMaxPartitionCount) +
+                      "], got " + std::to_string(sweepCount));
+                result.failed = true;
+                return result;
+            }
+        }
+        const std::optional<EdgeWeighting> edgeWeighting = parseEdgeWeighting(options_.edgeWeighting);
+        if (!edgeWeighting)
+        {
+            error("repcut edge weighting must be heuristic, comm or unit, got " + options_.edgeWeighting);
+            result.failed = true;
+            return result;
+        }
+        const bool sweeping = !options_.sweepPartitionCounts.empty();
+        std::vector<std::size_t> candidatePartitionCounts = options_.sweepPartitionCounts;
+        std::sort(candidatePartitionCounts.begin(), candidatePartitionCounts.end());
+        candidatePartitionCounts.erase(std::unique(candidatePartitionCounts.begin(), candidatePartitionCounts.end()),
+                                       candidatePartitionCounts.end());
+        if (!sweeping)
+        {
+            candidatePartitionCounts.push_back(options_.partitionCount);
+        }
         std::string resolveError;
         const std::optional<std::string> targetGraphName = resolveTargetGraphName(design(), options_.path, resolveError);
         if (!targetGraphName)
@@ -3962,11 +5449,14 @@ namespace wolvrix::lib::transform
             boot << "repcut start: path=" << options_.path
                  << " graph=" << graph->symbol()
                  << " partition_count=" << options_.partitionCount
+                 << " sweep_partition_counts=" << (sweeping ? joinSizes(candidatePartitionCounts) : std::string("<none>"))
                  << " imbalance_factor=" << toFixedString(options_.imbalanceFactor, 6)
                  << " work_dir=" << (options_.workDir.empty() ? std::string(".") : options_.workDir)
                  << " partitioner=" << options_.partitioner
                  << " mtkahypar_preset=" << options_.mtKaHyParPreset
                  << " mtkahypar_threads=" << options_.mtKaHyParThreads
+                 << " edge_weighting=" << edgeWeightingName(*edgeWeighting)
+                 << " numa_domains=" << numaDomainCount
                  << " mem_cone_union=true"
                  << " keep_intermediate=" << (options_.keepIntermediateFiles ? "true" : "false");
             logInfo(boot.str());
@@ -4054,13 +5544,84 @@ namespace wolvrix::lib::transform
             summary << " elapsed_ms=" << phaseAMs;
             logInfo(summary.str());
 
+        std::filesystem::path outputDir = options_.workDir.empty() ? std::filesystem::path(".")
+                                        : std::filesystem::path(options_.workDir);
+        const std::string graphBase = wolvrix::lib::grh::Graph::normalizeComponent(graph->symbol());
+
+        // Phases b-d only depend on the graph structure, so an unchanged graph reuses the ASCs,
+        // hypergraph and partitions persisted by an earlier run.
+        std::optional<RepcutCache> cache;
+        std::filesystem::path cachePath;
+        uint64_t graphHash = 0;
+        if (options_.cache)
+        {
+            const auto cacheLookupStart = std::chrono::steady_clock::now();
+            graphHash = hashGraphStructure(*graph, options_.phaseBSccCones);
+            const std::filesystem::path cacheDir =
+                options_.cacheDir.empty() ? outputDir : std::filesystem::path(options_.cacheDir);
+            cachePath = repcutCachePath(cacheDir, graphBase);
+            cache = readRepcutCache(cachePath, graphHash);
+            std::ostringstream hashText;
+            hashText << std::hex << graphHash;
+            logInfo("repcut cache: graph_hash=" + hashText.str() + " hit=" + (cache ? "true" : "false") +
+                    " path=" + cachePath.string() + " elapsed_ms=" + std::to_string(msSince(cacheLookupStart)));
+            if (cache)
+            {
+                const std::string stale = checkRepcutCache(*cache, collectSinks(*graph), data.nodeToOp.size());
+                if (!stale.empty())
+                {
+                    error(*graph, "repcut cache " + cachePath.string() + " matches the graph hash but not the graph (" +
+                                      stale + "); delete it or run without -cache");
+                    result.failed = true;
+                    return result;
+                }
+            }
+        }
+
+        PhaseBData phaseB;
+        HyperGraph hg;
+        std::vector<PieceCommStats> edgeCommStats;
+        std::vector<RepcutCachedPartition> cachedPartitions;
+        std::size_t pieceCount = 0;
+        uint64_t phaseBMs = 0;
+        uint64_t phaseCMs = 0;
+        if (cache)
+        {
+            phaseB.sinks = std::move(cache->sinks);
+            for (auto &sink : phaseB.sinks)
+            {
+                if (sink.op.valid())
+                {
+                    sink.op.graph = graph->id();
+                }
+                if (sink.value.valid())
+                {
+                    sink.value.graph = graph->id();
+                }
+            }
+            phaseB.ascs = std::move(cache->ascs);
+            pieceCount = cache->pieceCount;
+            hg = std::move(cache->hypergraph);
+            edgeCommStats = std::move(cache->edgeCommStats);
+            cachedPartitions = std::move(cache->partitions);
+            logInfo("repcut phase-b/c: reused from cache ascs=" + std::to_string(phaseB.ascs.size()) +
+                    " pieces=" + std::to_string(pieceCount) +
+                    " hyper_nodes=" + std::to_string(hg.nodeWeights.size()) +
+                    " hyper_edges=" + std::to_string(hg.edges.size()) +
+                    " cached_partitions=" + std::to_string(cachedPartitions.size()));
+        }
+        else
+        {
             const auto phaseBStart = std::chrono::steady_clock::now();
-            logInfo("repcut phase-b: begin build_ascs");
+            const size_t phaseBThreads = resolvePhaseBThreads(options_.phaseBThreads);
+            logInfo("repcut phase-b: begin build_ascs threads=" + std::to_string(phaseBThreads));
             const auto buildAscsStart = std::chrono::steady_clock::now();
-            PhaseBData phaseB = buildAscs(
+            phaseB = buildAscs(
                 *graph,
                 data,
                 inoutInputValues,
+                phaseBThreads,
+                options_.phaseBSccCones,
                 [&](const std::string &message) {
                     logInfo(message);
                 });
@@ -4072,175 +5633,249 @@ namespace wolvrix::lib::transform
             buildPieces(
                 phaseB,
                 data,
+                phaseBThreads,
                 [&](const std::string &message) {
                     logInfo(message);
                 });
             const uint64_t buildPiecesMs = msSince(buildPiecesStart);
             logInfo("repcut phase-b: build_pieces done elapsed_ms=" + std::to_string(buildPiecesMs));
 
-        std::string phaseBError;
-        if (!validatePhaseB(data, phaseB, phaseBError))
-        {
-            error(phaseBError);
-            result.failed = true;
-            return result;
-        }
+            std::string phaseBError;
+            if (!validatePhaseB(data, phaseB, phaseBError))
+            {
+                error(phaseBError);
+                result.failed = true;
+                return result;
+            }
 
-        const auto phaseBGuardStart = std::chrono::steady_clock::now();
-        std::string phaseBGuardError;
-        if (!validateHyperNodeAndHyperSinkTypes(*graph, data, phaseB, inoutOutputValues, phaseBGuardError))
-        {
-            error(phaseBGuardError);
-            result.failed = true;
-            return result;
-        }
-        logInfo("repcut phase-b guard: hypernode/hypersink node types validated elapsed_ms=" +
-                std::to_string(msSince(phaseBGuardStart)));
+            const auto phaseBGuardStart = std::chrono::steady_clock::now();
+            std::string phaseBGuardError;
+            if (!validateHyperNodeAndHyperSinkTypes(*graph, data, phaseB, inoutOutputValues, phaseBGuardError))
+            {
+                error(phaseBGuardError);
+                result.failed = true;
+                return result;
+            }
+            logInfo("repcut phase-b guard: hypernode/hypersink node types validated elapsed_ms=" +
+                    std::to_string(msSince(phaseBGuardStart)));
+
+            std::size_t opSinkCountInAsc = 0;
+            std::size_t valueSinkCountInAsc = 0;
+            std::size_t totalCombOpsInAsc = 0;
+            std::size_t maxAscSinkCount = 0;
+            std::size_t maxAscCombOpCount = 0;
+            for (const auto &asc : phaseB.ascs)
+            {
+                maxAscSinkCount = std::max(maxAscSinkCount, asc.sinks.size());
+                maxAscCombOpCount = std::max(maxAscCombOpCount, asc.combOps.size());
+                totalCombOpsInAsc += asc.combOps.size();
+                for (const size_t sinkIndex : asc.sinks)
+                {
+                    if (phaseB.sinks[sinkIndex].kind == SinkRef::Kind::Operation)
+                    {
+                        ++opSinkCountInAsc;
+                    }
+                    else
+                    {
+                        ++valueSinkCountInAsc;
+                    }
+                }
+            }
+
+            std::size_t nonAscPieceCount = 0;
+            std::size_t maxPieceSize = 0;
+            std::size_t emptyPieceCount = 0;
+            for (PieceId pid = 0; pid < phaseB.pieces.size(); ++pid)
+            {
+                const auto &piece = phaseB.pieces[pid];
+                if (piece.empty())
+                {
+                    ++emptyPieceCount;
+                }
+                maxPieceSize = std::max(maxPieceSize, piece.size());
+                if (pid >= phaseB.ascs.size())
+                {
+                    ++nonAscPieceCount;
+                }
+            }
+
+            std::ostringstream phaseBSummary;
+            phaseBSummary << "repcut phase-b: graph=" << graph->symbol()
+                          << " sinks=" << phaseB.sinks.size()
+                          << " sink_ops=" << opSinkCountInAsc
+                          << " sink_values=" << valueSinkCountInAsc
+                          << " ascs=" << phaseB.ascs.size()
+                          << " total_asc_comb_ops=" << totalCombOpsInAsc
+                          << " max_asc_sinks=" << maxAscSinkCount
+                          << " max_asc_comb_ops=" << maxAscCombOpCount
+                          << " pieces=" << phaseB.pieces.size()
+                          << " non_asc_pieces=" << nonAscPieceCount
+                          << " empty_pieces=" << emptyPieceCount
+                          << " max_piece_size=" << maxPieceSize;
+            phaseBMs = msSince(phaseBStart);
+            phaseBSummary << " build_ascs_ms=" << buildAscsMs
+                          << " build_pieces_ms=" << buildPiecesMs
+                          << " elapsed_ms=" << phaseBMs;
+            logInfo(phaseBSummary.str());
+
+            const auto phaseCStart = std::chrono::steady_clock::now();
+            std::vector<uint32_t> nodeWeights;
+            std::vector<uint32_t> pieceWeights;
+            std::vector<uint32_t> edgeProxyWeights;
+            const auto hyperBuildStart = std::chrono::steady_clock::now();
+            hg = buildHyperGraph(*graph, data, phaseB, nodeWeights, pieceWeights, edgeProxyWeights, edgeCommStats);
+            const uint64_t hyperBuildMs = msSince(hyperBuildStart);
+
+            const auto phaseCGuardStart = std::chrono::steady_clock::now();
+            std::string phaseCGuardError;
+            if (!validateHyperEdgeContentGuard(phaseB, hg, edgeProxyWeights, phaseCGuardError))
+            {
+                error(phaseCGuardError);
+                result.failed = true;
+                return result;
+            }
+            logInfo("repcut phase-c guard: hyperedge content validated elapsed_ms=" +
+                    std::to_string(msSince(phaseCGuardStart)));
+
+            std::string phaseCError;
+            if (!validateHyperGraph(phaseB, hg, phaseCError))
+            {
+                error(phaseCError);
+                result.failed = true;
+                return result;
+            }
+
+            std::size_t totalPieceWeight = 0;
+            std::size_t maxPieceWeight = 0;
+            for (const uint32_t pieceWeight : pieceWeights)
+            {
+                totalPieceWeight += pieceWeight;
+                maxPieceWeight = std::max(maxPieceWeight, static_cast<std::size_t>(pieceWeight));
+            }
 
-        std::size_t opSinkCountInAsc = 0;
-        std::size_t valueSinkCountInAsc = 0;
-        std::size_t totalCombOpsInAsc = 0;
-        std::size_t maxAscSinkCount = 0;
-        std::size_t maxAscCombOpCount = 0;
-        for (const auto &asc : phaseB.ascs)
-        {
-            maxAscSinkCount = std::max(maxAscSinkCount, asc.sinks.size());
-            maxAscCombOpCount = std::max(maxAscCombOpCount, asc.combOps.size());
-            totalCombOpsInAsc += asc.combOps.size();
-            for (const size_t sinkIndex : asc.sinks)
+            std::size_t totalNodeWeight = 0;
+            std::size_t weightedNodeCount = 0;
+            std::size_t maxNodeWeight = 0;
+            for (const uint32_t nodeWeight : nodeWeights)
             {
-                if (phaseB.sinks[sinkIndex].kind == SinkRef::Kind::Operation)
+                if (nodeWeight == std::numeric_limits<uint32_t>::max())
                 {
-                    ++opSinkCountInAsc;
-                }
-                else
-                {
-                    ++valueSinkCountInAsc;
+                    continue;
                 }
+                totalNodeWeight += nodeWeight;
+                weightedNodeCount += 1;
+                maxNodeWeight = std::max(maxNodeWeight, static_cast<std::size_t>(nodeWeight));
             }
-        }
 
-        std::size_t nonAscPieceCount = 0;
-        std::size_t maxPieceSize = 0;
-        std::size_t emptyPieceCount = 0;
-        for (PieceId pid = 0; pid < phaseB.pieces.size(); ++pid)
-        {
-            const auto &piece = phaseB.pieces[pid];
-            if (piece.empty())
+            std::size_t maxHyperNodeWeight = 0;
+            std::size_t maxHyperEdgeWeight = 0;
+            for (const uint32_t w : hg.nodeWeights)
             {
-                ++emptyPieceCount;
+                maxHyperNodeWeight = std::max(maxHyperNodeWeight, static_cast<std::size_t>(w));
             }
-            maxPieceSize = std::max(maxPieceSize, piece.size());
-            if (pid >= phaseB.ascs.size())
+            for (const auto &edge : hg.edges)
             {
-                ++nonAscPieceCount;
+                maxHyperEdgeWeight = std::max(maxHyperEdgeWeight, static_cast<std::size_t>(edge.weight));
             }
-        }
-
-        std::ostringstream phaseBSummary;
-        phaseBSummary << "repcut phase-b: graph=" << graph->symbol()
-                      << " sinks=" << phaseB.sinks.size()
-                      << " sink_ops=" << opSinkCountInAsc
-                      << " sink_values=" << valueSinkCountInAsc
-                      << " ascs=" << phaseB.ascs.size()
-                      << " total_asc_comb_ops=" << totalCombOpsInAsc
-                      << " max_asc_sinks=" << maxAscSinkCount
-                      << " max_asc_comb_ops=" << maxAscCombOpCount
-                      << " pieces=" << phaseB.pieces.size()
-                      << " non_asc_pieces=" << nonAscPieceCount
-                      << " empty_pieces=" << emptyPieceCount
-                          << " max_piece_size=" << maxPieceSize;
-                const uint64_t phaseBMs = msSince(phaseBStart);
-                phaseBSummary << " build_ascs_ms=" << buildAscsMs
-                          << " build_pieces_ms=" << buildPiecesMs
-                          << " elapsed_ms=" << phaseBMs;
-                logInfo(phaseBSummary.str());
 
-                const auto phaseCStart = std::chrono::steady_clock::now();
-        std::vector<uint32_t> nodeWeights;
-        std::vector<uint32_t> pieceWeights;
-        std::vector<uint32_t> edgeProxyWeights;
-                const auto hyperBuildStart = std::chrono::steady_clock::now();
-        const HyperGraph hg = buildHyperGraph(*graph, data, phaseB, nodeWeights, pieceWeights, edgeProxyWeights);
-                const uint64_t hyperBuildMs = msSince(hyperBuildStart);
-
-        const auto phaseCGuardStart = std::chrono::steady_clock::now();
-        std::string phaseCGuardError;
-        if (!validateHyperEdgeContentGuard(phaseB, hg, edgeProxyWeights, phaseCGuardError))
-        {
-            error(phaseCGuardError);
-            result.failed = true;
-            return result;
+            std::ostringstream phaseCSummary;
+            phaseCSummary << "repcut phase-c: graph=" << graph->symbol()
+                          << " weighted_nodes=" << weightedNodeCount
+                          << " total_node_weight=" << totalNodeWeight
+                          << " max_node_weight=" << maxNodeWeight
+                          << " total_piece_weight=" << totalPieceWeight
+                          << " max_piece_weight=" << maxPieceWeight
+                          << " hyper_nodes=" << hg.nodeWeights.size()
+                          << " hyper_edges=" << hg.edges.size()
+                          << " max_hyper_node_weight=" << maxHyperNodeWeight
+                          << " max_hyper_edge_weight=" << maxHyperEdgeWeight;
+            phaseCMs = msSince(phaseCStart);
+            phaseCSummary << " hyper_build_ms=" << hyperBuildMs
+                          << " elapsed_ms=" << phaseCMs;
+            logInfo(phaseCSummary.str());
+            pieceCount = phaseB.pieces.size();
         }
-        logInfo("repcut phase-c guard: hyperedge content validated elapsed_ms=" +
-                std::to_string(msSince(phaseCGuardStart)));
 
-        std::string phaseCError;
-        if (!validateHyperGraph(phaseB, hg, phaseCError))
+        if (hg.nodeWeights.empty())
         {
-            error(phaseCError);
-            result.failed = true;
+            warning("repcut phase-d: hypergraph has no nodes, skipping partitioning");
             return result;
         }
 
-        std::size_t totalPieceWeight = 0;
-        std::size_t maxPieceWeight = 0;
-        for (const uint32_t pieceWeight : pieceWeights)
-        {
-            totalPieceWeight += pieceWeight;
-            maxPieceWeight = std::max(maxPieceWeight, static_cast<std::size_t>(pieceWeight));
-        }
-
-        std::size_t totalNodeWeight = 0;
-        std::size_t weightedNodeCount = 0;
-        std::size_t maxNodeWeight = 0;
-        for (const uint32_t nodeWeight : nodeWeights)
+        assignEdgeWeights(hg, edgeCommStats, *edgeWeighting);
+        if (*edgeWeighting != EdgeWeighting::Heuristic)
         {
-            if (nodeWeight == std::numeric_limits<uint32_t>::max())
+            uint64_t totalEdgeWeight = 0;
+            uint32_t maxEdgeWeight = 0;
+            for (const auto &edge : hg.edges)
             {
-                continue;
+                totalEdgeWeight += edge.weight;
+                maxEdgeWeight = std::max(maxEdgeWeight, edge.weight);
             }
-            totalNodeWeight += nodeWeight;
-            weightedNodeCount += 1;
-            maxNodeWeight = std::max(maxNodeWeight, static_cast<std::size_t>(nodeWeight));
-        }
-
-        std::size_t maxHyperNodeWeight = 0;
-        std::size_t maxHyperEdgeWeight = 0;
-        for (const uint32_t w : hg.nodeWeights)
-        {
-            maxHyperNodeWeight = std::max(maxHyperNodeWeight, static_cast<std::size_t>(w));
-        }
-        for (const auto &edge : hg.edges)
-        {
-            maxHyperEdgeWeight = std::max(maxHyperEdgeWeight, static_cast<std::size_t>(edge.weight));
+            logInfo("repcut phase-c: edge_weighting=" + std::string(edgeWeightingName(*edgeWeighting)) +
+                    " total_hyper_edge_weight=" + std::to_string(totalEdgeWeight) +
+                    " max_hyper_edge_weight=" + std::to_string(maxEdgeWeight));
         }
 
-        std::ostringstream phaseCSummary;
-        phaseCSummary << "repcut phase-c: graph=" << graph->symbol()
-                      << " weighted_nodes=" << weightedNodeCount
-                      << " total_node_weight=" << totalNodeWeight
-                      << " max_node_weight=" << maxNodeWeight
-                      << " total_piece_weight=" << totalPieceWeight
-                      << " max_piece_weight=" << maxPieceWeight
-                      << " hyper_nodes=" << hg.nodeWeights.size()
-                      << " hyper_edges=" << hg.edges.size()
-                      << " max_hyper_node_weight=" << maxHyperNodeWeight
-                      << " max_hyper_edge_weight=" << maxHyperEdgeWeight;
-        const uint64_t phaseCMs = msSince(phaseCStart);
-        phaseCSummary << " hyper_build_ms=" << hyperBuildMs
-                      << " elapsed_ms=" << phaseCMs;
-        logInfo(phaseCSummary.str());
-
-        if (hg.nodeWeights.empty())
+        // Profile-guided node weights replace hg.nodeWeights for phase-d only; the cache keeps the
+        // static weights, and partitions computed with a profile are keyed by its weights' hash.
+        std::vector<std::string> ascKeys;
+        std::vector<uint32_t> staticNodeWeights;
+        std::string nodeWeightingToken;
+        if (!options_.timingProfile.empty())
         {
-            warning("repcut phase-d: hypergraph has no nodes, skipping partitioning");
-            return result;
+            const std::filesystem::path mapPath = ascPartitionMapPath(outputDir, graphBase);
+            std::unordered_map<std::string, uint32_t> previousPartByKey;
+            std::unordered_map<uint32_t, double> evalUsByPart;
+            std::vector<std::string> profileWarnings;
+            std::string profileError;
+            const bool profileLoaded =
+                readAscPartitionMap(mapPath, previousPartByKey, profileWarnings, profileError) &&
+                readPartTimingProfile(options_.timingProfile, evalUsByPart, profileWarnings, profileError);
+            for (const std::string &message : profileWarnings)
+            {
+                warning("repcut phase-c: " + message);
+            }
+            if (!profileLoaded)
+            {
+                error("repcut phase-c: " + profileError);
+                result.failed = true;
+                return result;
+            }
+            ascKeys.reserve(phaseB.ascs.size());
+            for (const AscInfo &asc : phaseB.ascs)
+            {
+                ascKeys.push_back(ascStableKey(*graph, phaseB.sinks, asc));
+            }
+            staticNodeWeights = hg.nodeWeights;
+            const ProfileWeightStats profileStats =
+                applyProfileNodeWeights(hg.nodeWeights, ascKeys, previousPartByKey, evalUsByPart);
+            if (profileStats.matchedAscs == 0)
+            {
+                warning("repcut phase-c: timing profile matched no ASC of graph " + graph->symbol() +
+                        ", keeping static node weights");
+                hg.nodeWeights = staticNodeWeights;
+                staticNodeWeights.clear();
+            }
+            else
+            {
+                StructuralHasher weightHasher;
+                for (const uint32_t w : hg.nodeWeights)
+                {
+                    weightHasher.u64(w);
+                }
+                std::ostringstream hashText;
+                hashText << std::hex << weightHasher.value();
+                nodeWeightingToken = "+profile:" + hashText.str();
+            }
+            logInfo("repcut phase-c: timing_profile=" + options_.timingProfile +
+                    " profiled_parts=" + std::to_string(profileStats.profiledParts) +
+                    " matched_ascs=" + std::to_string(profileStats.matchedAscs) +
+                    " unmatched_ascs=" + std::to_string(profileStats.unmatchedAscs));
         }
+        const bool profileWeighted = !nodeWeightingToken.empty();
 
         const auto phaseDStart = std::chrono::steady_clock::now();
-        std::filesystem::path outputDir = options_.workDir.empty() ? std::filesystem::path(".")
-                                        : std::filesystem::path(options_.workDir);
         std::error_code fsError;
         std::filesystem::create_directories(outputDir, fsError);
         if (fsError)
@@ -4250,27 +5885,29 @@ namespace wolvrix::lib::transform
             return result;
         }
 
-        const std::string graphBase = wolvrix::lib::grh::Graph::normalizeComponent(graph->symbol());
-        const std::string stem = graphBase + "_repcut_k" + std::to_string(options_.partitionCount);
-        const std::filesystem::path hmetisPath = outputDir / (stem + ".hgr");
-        const std::filesystem::path partitionPath = std::filesystem::path(hmetisPath.string() + ".part" +
-                                                                           std::to_string(options_.partitionCount));
-
-        std::string ioError;
-        const auto writeHgrStart = std::chrono::steady_clock::now();
-        if (!writeHyperGraphToHmetis(hg, hmetisPath, ioError))
+        const std::string stem = sweeping ? graphBase + "_repcut_sweep"
+                                          : graphBase + "_repcut_k" + std::to_string(options_.partitionCount);
+        // The backend reads the hypergraph from memory; the hMETIS text and the partition files are
+        // only debugging aids written for -keep-intermediate-files.
+        std::filesystem::path hmetisPath;
+        if (options_.keepIntermediateFiles)
         {
-            error("repcut phase-d: " + ioError);
-            result.failed = true;
-            return result;
-        }
-        const uint64_t writeHgrMs = msSince(writeHgrStart);
-        result.artifacts.push_back(hmetisPath.string());
+            hmetisPath = outputDir / (stem + ".hgr");
+
+            std::string ioError;
+            const auto writeHgrStart = std::chrono::steady_clock::now();
+            if (!writeHyperGraphToHmetis(hg, hmetisPath, ioError))
+            {
+                error("repcut phase-d: " + ioError);
+                result.failed = true;
+                return result;
+            }
+            const uint64_t writeHgrMs = msSince(writeHgrStart);
+            result.artifacts.push_back(hmetisPath.string());
 
-        std::error_code sizeEc;
-        const uintmax_t hgrBytes = std::filesystem::file_size(hmetisPath, sizeEc);
+            std::error_code sizeEc;
+            const uintmax_t hgrBytes = std::filesystem::file_size(hmetisPath, sizeEc);
 
-        {
             std::ostringstream dprep;
             dprep << "repcut phase-d prep: hgr_path=" << hmetisPath.string()
                   << " hgr_bytes=" << hgrBytes
@@ -4286,23 +5923,24 @@ namespace wolvrix::lib::transform
             return result;
         }
 
-        PartitionBackendRequest backendRequest;
-        backendRequest.hmetisPath = hmetisPath;
-        backendRequest.partitionPath = partitionPath;
-        backendRequest.partitionCount = options_.partitionCount;
-        backendRequest.imbalanceFactor = options_.imbalanceFactor;
-        backendRequest.ascCount = phaseB.ascs.size();
-        backendRequest.preset = options_.mtKaHyParPreset;
-        backendRequest.threadCount = options_.mtKaHyParThreads;
-
-        PartitionBackendResponse backendResponse;
-        const bool backendOk = partitionBackend->run(backendRequest, backendResponse);
-        for (const auto &backendLog : backendResponse.backendLogs)
-        {
-            logInfo("repcut phase-d " + std::string(partitionBackend->name()) + " call: " + backendLog);
-        }
-        if (!backendOk)
-        {
+        // Phases a-c are shared by every candidate count; only the backend call is repeated. For
+        // a sweep the best-scoring response is kept for phase-e.
+        const std::string partitionerToken = normalizeBackendToken(options_.partitioner);
+        bool cacheDirty = options_.cache && !cache.has_value();
+        // Runs the backend once and logs its calls. Reports failures through error() and returns
+        // false.
+        auto runPartitionBackend = [&](const PartitionBackendRequest &backendRequest,
+                                       PartitionBackendResponse &backendResponse) -> bool {
+            const bool backendOk = partitionBackend->run(backendRequest, backendResponse);
+            for (const auto &backendLog : backendResponse.backendLogs)
+            {
+                logInfo("repcut phase-d " + std::string(partitionBackend->name()) + " call: " + backendLog);
+            }
+            if (backendOk)
+            {
+                return true;
+            }
+            const HyperGraph &requestHg = *backendRequest.hypergraph;
             std::ostringstream diag;
             diag << "repcut phase-d: " << partitionBackend->name() << " backend failed";
             if (!backendResponse.errorMessage.empty())
@@ -4310,20 +5948,393 @@ namespace wolvrix::lib::transform
                 diag << ": " << backendResponse.errorMessage;
             }
             diag << "; graph=" << graph->symbol()
-                 << "; hyper_nodes=" << hg.nodeWeights.size()
-                 << "; hyper_edges=" << hg.edges.size()
-                 << "; hmetis=" << hmetisPath.string();
+                 << "; k=" << backendRequest.partitionCount
+                 << "; hyper_nodes=" << requestHg.nodeWeights.size()
+                 << "; hyper_edges=" << requestHg.edges.size();
+            if (!backendRequest.hmetisPath.empty())
+            {
+                diag << "; hmetis=" << backendRequest.hmetisPath.string();
+            }
             if (!backendResponse.partitionPath.empty())
             {
                 diag << "; partition_file=" << backendResponse.partitionPath.string();
             }
-            if (hg.edges.empty())
+            if (requestHg.edges.empty())
             {
                 diag << "; hint=hypergraph has zero hyper-edges (degenerate partitioning input)";
             }
             error(diag.str());
-            result.failed = true;
-            return result;
+            return false;
+        };
+        // Hierarchical mode: one backend call splits hg into domains, then every domain is split
+        // into its own parts over the hyperedges restricted to it. Local part l of domain d
+        // becomes part d * partsPerDomain + l.
+        auto partitionNumaDomains = [&](const PartitionBackendRequest &backendRequest,
+                                        PartitionBackendResponse &backendResponse) -> bool {
+            const std::size_t partsPerDomain = backendRequest.partitionCount / numaDomainCount;
+            PartitionBackendRequest domainRequest = backendRequest;
+            domainRequest.partitionPath.clear();
+            domainRequest.partitionCount = numaDomainCount;
+            PartitionBackendResponse domainResponse;
+            if (!runPartitionBackend(domainRequest, domainResponse))
+            {
+                return false;
+            }
+            backendResponse.solverRunMs = domainResponse.solverRunMs;
+            backendResponse.parsePartitionMs = domainResponse.parsePartitionMs;
+            backendResponse.partitionComplete = domainResponse.partitionComplete;
+            backendResponse.partitionWarning = domainResponse.partitionWarning;
+            backendResponse.partition.assign(domainResponse.partition.size(), 0);
+            for (std::size_t domain = 0; domain < numaDomainCount; ++domain)
+            {
+                const DomainHyperGraph sub = buildDomainHyperGraph(
+                    hg, domainResponse.partition, static_cast<uint32_t>(domain), options_.numaInterDomainCost);
+                const uint32_t partBase = static_cast<uint32_t>(domain * partsPerDomain);
+                uint64_t domainRunMs = 0;
+                if (sub.nodes.size() <= partsPerDomain)
+                {
+                    // Nothing to balance: every node gets a part of its own.
+                    for (std::size_t local = 0; local < sub.nodes.size(); ++local)
+                    {
+                        backendResponse.partition[sub.nodes[local]] = partBase + static_cast<uint32_t>(local);
+                    }
+                }
+                else
+                {
+                    PartitionBackendRequest localRequest = domainRequest;
+                    localRequest.hypergraph = &sub.hg;
+                    localRequest.hmetisPath.clear();
+                    localRequest.partitionCount = partsPerDomain;
+                    localRequest.ascCount = sub.nodes.size();
+                    PartitionBackendResponse localResponse;
+                    if (!runPartitionBackend(localRequest, localResponse))
+                    {
+                        return false;
+                    }
+                    for (std::size_t local = 0; local < sub.nodes.size(); ++local)
+                    {
+                        backendResponse.partition[sub.nodes[local]] = partBase + localResponse.partition[local];
+                    }
+                    domainRunMs = localResponse.solverRunMs;
+                    backendResponse.solverRunMs += localResponse.solverRunMs;
+                    backendResponse.parsePartitionMs += localResponse.parsePartitionMs;
+                    if (!localResponse.partitionComplete)
+                    {
+                        backendResponse.partitionComplete = false;
+                        backendResponse.partitionWarning += (backendResponse.partitionWarning.empty() ? "" : "; ") +
+                                                            std::string("domain ") + std::to_string(domain) + ": " +
+                                                            localResponse.partitionWarning;
+                    }
+                }
+                logInfo("repcut phase-d numa: domain=" + std::to_string(domain) +
+                        " hyper_nodes=" + std::to_string(sub.nodes.size()) +
+                        " hyper_edges=" + std::to_string(sub.hg.edges.size()) +
+                        " parts=" + std::to_string(partBase) + ".." +
+                        std::to_string(partBase + partsPerDomain - 1) +
+                        " run_ms=" + std::to_string(domainRunMs));
+            }
+            if (!backendRequest.partitionPath.empty())
+            {
+                std::string ioError;
+                if (!writePartitionFile(backendRequest.partitionPath, backendResponse.partition, ioError))
+                {
+                    backendResponse.errorMessage = ioError;
+                    error("repcut phase-d: " + ioError);
+                    return false;
+                }
+                backendResponse.partitionPath = backendRequest.partitionPath;
+            }
+            return true;
+        };
+        // Hierarchical partitions are cached as a whole, under their own weighting token.
+        const std::string numaToken =
+            numaHierarchical ? "+numa:" + std::to_string(numaDomainCount) + ":" +
+                                   toFixedString(options_.numaInterDomainCost, 6)
+                             : std::string();
+        // Partitions hg, as currently weighted, into candidateCount parts. `weighting` only keys the
+        // cache and, when it is not the selected one, the partition file name. Reports failures
+        // through error() and returns false.
+        auto partitionHyperGraph = [&](std::size_t candidateCount,
+                                       EdgeWeighting weighting,
+                                       PartitionBackendResponse &candidateResponse) -> bool {
+            PartitionBackendRequest backendRequest;
+            backendRequest.hypergraph = &hg;
+            backendRequest.hmetisPath = hmetisPath;
+            if (!hmetisPath.empty())
+            {
+                std::string partitionPath = hmetisPath.string() + ".part" + std::to_string(candidateCount);
+                if (weighting != *edgeWeighting)
+                {
+                    partitionPath += std::string(".") + edgeWeightingName(weighting);
+                }
+                backendRequest.partitionPath = std::filesystem::path(partitionPath);
+            }
+            backendRequest.partitionCount = candidateCount;
+            backendRequest.imbalanceFactor = options_.imbalanceFactor;
+            backendRequest.ascCount = phaseB.ascs.size();
+            backendRequest.preset = options_.mtKaHyParPreset;
+            backendRequest.threadCount = options_.mtKaHyParThreads;
+
+            const std::string weightingToken = edgeWeightingName(weighting) + nodeWeightingToken + numaToken;
+            const RepcutCachedPartition *cachedPartition =
+                options_.cache ? findCachedPartition(cachedPartitions, backendRequest, partitionerToken, weightingToken)
+                               : nullptr;
+            if (cachedPartition != nullptr)
+            {
+                candidateResponse.partition = cachedPartition->partition;
+                if (!backendRequest.partitionPath.empty())
+                {
+                    std::string ioError;
+                    if (writePartitionFile(backendRequest.partitionPath, candidateResponse.partition, ioError))
+                    {
+                        candidateResponse.partitionPath = backendRequest.partitionPath;
+                    }
+                    else
+                    {
+                        warning("repcut phase-d: " + ioError);
+                    }
+                }
+                logInfo("repcut phase-d: reused cached partition k=" + std::to_string(candidateCount) +
+                        " edge_weighting=" + weightingToken);
+                return true;
+            }
+            const bool backendOk = numaHierarchical ? partitionNumaDomains(backendRequest, candidateResponse)
+                                                    : runPartitionBackend(backendRequest, candidateResponse);
+            if (!backendOk)
+            {
+                return false;
+            }
+            if (options_.cache && candidateResponse.partitionComplete)
+            {
+                cachedPartitions.push_back(RepcutCachedPartition{candidateCount,
+                                                                 backendRequest.imbalanceFactor,
+                                                                 partitionerToken,
+                                                                 backendRequest.preset,
+                                                                 weightingToken,
+                                                                 candidateResponse.partition});
+                cacheDirty = true;
+            }
+            return true;
+        };
+
+        PartitionBackendResponse backendResponse;
+        std::size_t selectedPartitionCount = candidatePartitionCounts.front();
+        std::vector<PartitionSweepRecord> sweepRecords;
+        std::size_t bestSweepIndex = 0;
+        for (const std::size_t candidateCount : candidatePartitionCounts)
+        {
+            PartitionBackendResponse candidateResponse;
+            if (!partitionHyperGraph(candidateCount, *edgeWeighting, candidateResponse))
+            {
+                result.failed = true;
+                return result;
+            }
+            if (!sweeping)
+            {
+                backendResponse = std::move(candidateResponse);
+                break;
+            }
+
+            PartitionSweepRecord record =
+                evaluatePartitionSweep(hg, edgeCommStats, candidateResponse.partition, candidateCount);
+            record.solverRunMs = candidateResponse.solverRunMs;
+            std::ostringstream sweepLine;
+            sweepLine << "repcut phase-d sweep: k=" << candidateCount
+                      << " parts_used=" << record.partsUsed
+                      << " cut_edges=" << record.cutEdges
+                      << " cut_weight=" << record.cutWeight
+                      << " max_part_weight=" << record.maxPartWeight
+                      << " imbalance=" << toFixedString(record.imbalance, 6)
+                      << " comm_words=" << record.commWords
+                      << " max_part_comm_words=" << record.maxPartCommWords
+                      << " traffic_bytes=" << record.trafficBytes
+                      << " predicted_step_cost=" << toFixedString(record.predictedStepCost, 1)
+                      << " run_ms=" << record.solverRunMs;
+            logInfo(sweepLine.str());
+            if (!candidateResponse.partitionPath.empty())
+            {
+                result.artifacts.push_back(candidateResponse.partitionPath.string());
+            }
+            // Candidates are visited in ascending k, so ties keep the smaller count.
+            if (sweepRecords.empty() || record.predictedStepCost < sweepRecords[bestSweepIndex].predictedStepCost)
+            {
+                bestSweepIndex = sweepRecords.size();
+                selectedPartitionCount = candidateCount;
+                backendResponse = std::move(candidateResponse);
+            }
+            sweepRecords.push_back(record);
+        }
+
+        if (options_.compareEdgeWeighting)
+        {
+            // The selected count is partitioned again under every other weighting. All results are
+            // then scored against the selected weighting's hyperedges, so cut weights compare too.
+            struct WeightingRun
+            {
+                EdgeWeighting weighting = EdgeWeighting::Heuristic;
+                std::vector<uint32_t> partition;
+                uint64_t solverRunMs = 0;
+            };
+            std::vector<WeightingRun> weightingRuns;
+            weightingRuns.push_back(WeightingRun{*edgeWeighting, backendResponse.partition, backendResponse.solverRunMs});
+            for (const EdgeWeighting weighting : kEdgeWeightings)
+            {
+                if (weighting == *edgeWeighting)
+                {
+                    continue;
+                }
+                assignEdgeWeights(hg, edgeCommStats, weighting);
+                PartitionBackendResponse compareResponse;
+                if (!partitionHyperGraph(selectedPartitionCount, weighting, compareResponse))
+                {
+                    result.failed = true;
+                    return result;
+                }
+                if (!compareResponse.partitionPath.empty())
+                {
+                    result.artifacts.push_back(compareResponse.partitionPath.string());
+                }
+                weightingRuns.push_back(
+                    WeightingRun{weighting, std::move(compareResponse.partition), compareResponse.solverRunMs});
+            }
+            assignEdgeWeights(hg, edgeCommStats, *edgeWeighting);
+
+            std::vector<PartitionSweepRecord> weightingRecords;
+            uint64_t unitTrafficBytes = 0;
+            for (const auto &run : weightingRuns)
+            {
+                PartitionSweepRecord record =
+                    evaluatePartitionSweep(hg, edgeCommStats, run.partition, selectedPartitionCount);
+                record.solverRunMs = run.solverRunMs;
+                if (run.weighting == EdgeWeighting::Unit)
+                {
+                    unitTrafficBytes = record.trafficBytes;
+                }
+                weightingRecords.push_back(record);
+            }
+
+            std::ostringstream compareStats;
+            compareStats << "{"
+                         << "\"pass\":\"repcut\""
+                         << ",\"mode\":\"edge-weighting\""
+                         << ",\"graph\":\"" << escapeJson(graph->symbol()) << "\""
+                         << ",\"partition_count\":" << selectedPartitionCount
+                         << ",\"selected\":\"" << edgeWeightingName(*edgeWeighting) << "\""
+                         << ",\"runs\":[";
+            for (std::size_t i = 0; i < weightingRuns.size(); ++i)
+            {
+                const PartitionSweepRecord &record = weightingRecords[i];
+                const double trafficVsUnit =
+                    unitTrafficBytes == 0 ? 0.0
+                                          : static_cast<double>(record.trafficBytes) /
+                                                static_cast<double>(unitTrafficBytes);
+                const char *name = edgeWeightingName(weightingRuns[i].weighting);
+                std::ostringstream compareLine;
+                compareLine << "repcut phase-d edge weighting: weighting=" << name
+                            << " k=" << selectedPartitionCount
+                            << " traffic_bytes=" << record.trafficBytes
+                            << " traffic_vs_unit=" << toFixedString(trafficVsUnit, 3)
+                            << " cut_edges=" << record.cutEdges
+                            << " comm_words=" << record.commWords
+                            << " imbalance=" << toFixedString(record.imbalance, 6)
+                            << " predicted_step_cost=" << toFixedString(record.predictedStepCost, 1);
+                logInfo(compareLine.str());
+                compareStats << (i == 0 ? "" : ",") << "{"
+                             << "\"edge_weighting\":\"" << name << "\""
+                             << ",\"traffic_bytes\":" << record.trafficBytes
+                             << ",\"traffic_vs_unit\":" << toFixedString(trafficVsUnit, 6)
+                             << ",\"cut_edges\":" << record.cutEdges
+                             << ",\"cut_weight\":" << record.cutWeight
+                             << ",\"comm_words\":" << record.commWords
+                             << ",\"max_part_weight\":" << record.maxPartWeight
+                             << ",\"imbalance\":" << toFixedString(record.imbalance, 6)
+                             << ",\"predicted_step_cost\":" << toFixedString(record.predictedStepCost, 3)
+                             << ",\"solver_run_ms\":" << record.solverRunMs
+                             << "}";
+            }
+            compareStats << "]}";
+            const std::string compareMessage = compareStats.str();
+            info(compareMessage);
+            result.artifacts.push_back(compareMessage);
+        }
+
+        if (cacheDirty)
+        {
+            std::string cacheError;
+            if (profileWeighted)
+            {
+                std::swap(hg.nodeWeights, staticNodeWeights);
+            }
+            const bool cacheStored = writeRepcutCache(cachePath,
+                                 graphHash,
+                                 data.nodeToOp.size(),
+                                 phaseB,
+                                 pieceCount,
+                                 hg,
+                                 edgeCommStats,
+                                 cachedPartitions,
+                                 cacheError);
+            if (profileWeighted)
+            {
+                std::swap(hg.nodeWeights, staticNodeWeights);
+            }
+            if (cacheStored)
+            {
+                logInfo("repcut cache: stored path=" + cachePath.string() +
+                        " partitions=" + std::to_string(cachedPartitions.size()));
+            }
+            else
+            {
+                warning("repcut cache: " + cacheError);
+            }
+        }
+
+        if (sweeping)
+        {
+            std::ostringstream sweepStats;
+            sweepStats << "{"
+                       << "\"pass\":\"repcut\""
+                       << ",\"mode\":\"sweep\""
+                       << ",\"graph\":\"" << escapeJson(graph->symbol()) << "\""
+                       << ",\"asc_count\":" << phaseB.ascs.size()
+                       << ",\"hyper_edge_count\":" << hg.edges.size()
+                       << ",\"edge_weighting\":\"" << edgeWeightingName(*edgeWeighting) << "\""
+                       << ",\"comm_word_cost\":" << toFixedString(kSweepCommWordCost, 3)
+                       << ",\"best_partition_count\":" << selectedPartitionCount
+                       << ",\"rebuilt\":" << (options_.sweepRebuildBest ? "true" : "false")
+                       << ",\"time_ms_phase_a\":" << phaseAMs
+                       << ",\"time_ms_phase_b\":" << phaseBMs
+                       << ",\"time_ms_phase_c\":" << phaseCMs
+                       << ",\"candidates\":[";
+            for (std::size_t i = 0; i < sweepRecords.size(); ++i)
+            {
+                const PartitionSweepRecord &record = sweepRecords[i];
+                sweepStats << (i == 0 ? "" : ",") << "{"
+                           << "\"partition_count\":" << record.partitionCount
+                           << ",\"parts_used\":" << record.partsUsed
+                           << ",\"cut_edges\":" << record.cutEdges
+                           << ",\"cut_weight\":" << record.cutWeight
+                           << ",\"max_part_weight\":" << record.maxPartWeight
+                           << ",\"imbalance\":" << toFixedString(record.imbalance, 6)
+                           << ",\"comm_words\":" << record.commWords
+                           << ",\"max_part_comm_words\":" << record.maxPartCommWords
+                           << ",\"traffic_bytes\":" << record.trafficBytes
+                           << ",\"predicted_step_cost\":" << toFixedString(record.predictedStepCost, 3)
+                           << ",\"solver_run_ms\":" << record.solverRunMs
+                           << "}";
+            }
+            sweepStats << "]}";
+            const std::string sweepMessage = sweepStats.str();
+            info(sweepMessage);
+            result.artifacts.push_back(sweepMessage);
+            logInfo("repcut phase-d sweep: best k=" + std::to_string(selectedPartitionCount) +
+                    " candidates=" + std::to_string(sweepRecords.size()) +
+                    " elapsed_ms=" + std::to_string(msSince(phaseDStart)));
+            if (!options_.sweepRebuildBest)
+            {
+                logInfo("repcut: sweep finished without rebuild in " + std::to_string(msSince(totalStart)) + "ms");
+                return result;
+            }
         }
 
         const uint64_t partitionRunMs = backendResponse.solverRunMs;
@@ -4336,7 +6347,7 @@ namespace wolvrix::lib::transform
         logInfo("repcut phase-d " + std::string(partitionBackend->name()) + ": run_ms=" +
                 std::to_string(partitionRunMs));
 
-        if (!partitionOutPath.empty())
+        if (!sweeping && !partitionOutPath.empty())
         {
             result.artifacts.push_back(partitionOutPath.string());
         }
@@ -4357,11 +6368,32 @@ namespace wolvrix::lib::transform
         std::ostringstream phaseDSummary;
         phaseDSummary << "repcut phase-d: graph=" << graph->symbol()
                       << " backend=" << partitionBackend->name()
-                      << " hmetis=" << hmetisPath.string()
+                      << " hmetis=" << (hmetisPath.empty() ? "<none>" : hmetisPath.string())
                       << " partition_file=" << (partitionOutPath.empty() ? "<none>" : partitionOutPath.string())
                       << " asc_count=" << ascPartition.size()
                       << " part_count_observed=" << (partSizes.empty() ? 0 : (maxPartId + 1))
                       << " partition_complete=" << (partitionComplete ? "true" : "false");
+        const uint64_t predictedTrafficBytes =
+            evaluatePartitionSweep(hg, edgeCommStats, ascPartition, selectedPartitionCount).trafficBytes;
+        phaseDSummary << " edge_weighting=" << edgeWeightingName(*edgeWeighting)
+                      << " node_weighting=" << (profileWeighted ? "profile" : "static")
+                      << " traffic_bytes=" << predictedTrafficBytes;
+        const std::size_t partsPerDomain = selectedPartitionCount / numaDomainCount;
+        NumaTrafficRecord numaTraffic;
+        if (numaHierarchical)
+        {
+            numaTraffic = evaluateNumaTraffic(hg,
+                                              edgeCommStats,
+                                              ascPartition,
+                                              partsPerDomain,
+                                              numaDomainCount,
+                                              options_.numaInterDomainCost);
+            phaseDSummary << " numa_domains=" << numaDomainCount
+                          << " parts_per_domain=" << partsPerDomain
+                          << " intra_domain_bytes=" << numaTraffic.intraDomainBytes
+                          << " inter_domain_bytes=" << numaTraffic.interDomainBytes
+                          << " numa_cost=" << toFixedString(numaTraffic.cost, 1);
+        }
         const uint64_t phaseDMs = msSince(phaseDStart);
         phaseDSummary << " parse_partition_ms=" << parsePartMs
                       << " partition_run_ms=" << partitionRunMs
@@ -4646,7 +6678,7 @@ namespace wolvrix::lib::transform
             }
         }
 
-        std::size_t partitionCount = options_.partitionCount;
+        std::size_t partitionCount = selectedPartitionCount;
         for (const auto &[opId, partSet] : opPartitionSet)
         {
             (void)opId;
@@ -4764,7 +6796,7 @@ namespace wolvrix::lib::transform
                       << " cross_scan_ms=" << phaseECrossMs;
         logInfo(phaseESummary.str());
 
-        std::vector<std::size_t> partitionWeights(options_.partitionCount, 0);
+        std::vector<std::size_t> partitionWeights(selectedPartitionCount, 0);
         for (AscId aid = 0; aid < hg.nodeWeights.size(); ++aid)
         {
             const uint32_t partId = (aid < ascPartition.size()) ? ascPartition[aid] : 0u;
@@ -4777,6 +6809,30 @@ namespace wolvrix::lib::transform
         const std::vector<PartitionStaticFeatureRecord> partitionFeatureRecords =
             buildPartitionStaticFeatureRecords(*graph, data, partitionOps, crossValues, partitionWeights);
 
+        // Written before the rebuild, while the sink ops still belong to the source graph. The
+        // map only feeds a later -timing-profile run, so it is emitted on request.
+        if (!options_.timingProfile.empty() || options_.keepIntermediateFiles || options_.ascPartitionMap)
+        {
+            if (ascKeys.empty())
+            {
+                ascKeys.reserve(phaseB.ascs.size());
+                for (const AscInfo &asc : phaseB.ascs)
+                {
+                    ascKeys.push_back(ascStableKey(*graph, phaseB.sinks, asc));
+                }
+            }
+            const std::filesystem::path mapPath = ascPartitionMapPath(outputDir, graphBase);
+            std::string ioError;
+            if (writeAscPartitionMap(mapPath, ascKeys, ascPartition, ioError))
+            {
+                result.artifacts.push_back(mapPath.string());
+            }
+            else
+            {
+                warning("repcut phase-e: " + ioError);
+            }
+        }
+
         const auto phaseERebuildStart = std::chrono::steady_clock::now();
         logInfo("repcut phase-e rebuild: begin graph=" + graph->symbol() +
                 " partition_count=" + std::to_string(partitionOps.size()) +
@@ -5309,8 +7365,7 @@ namespace wolvrix::lib::transform
             std::unordered_map<std::size_t, std::string> outputPortByGroup;
         };
 
-        std::vector<PartitionGraphInfo> partInfos;
-        partInfos.reserve(partitionOps.size());
+        std::vector<PartitionGraphInfo> partInfos(partitionOps.size());
         logInfo("repcut phase-e rebuild: begin partition graph cloning partition_count=" +
                 std::to_string(partitionOps.size()));
         std::unordered_set<uint32_t> sourceDeclaredSymbols;
@@ -5319,19 +7374,62 @@ namespace wolvrix::lib::transform
         {
             sourceDeclaredSymbols.insert(sym.value);
         }
-        std::vector<uint32_t> requiredValueMarks(static_cast<std::size_t>(maxValueIndex) + 1u, 0u);
-        std::vector<uint32_t> inputValueMarks(static_cast<std::size_t>(maxValueIndex) + 1u, 0u);
-        std::vector<uint32_t> outputValueMarks(static_cast<std::size_t>(maxValueIndex) + 1u, 0u);
-        uint32_t requiredValueStamp = 0;
-        uint32_t inputValueStamp = 0;
-        uint32_t outputValueStamp = 0;
+        // Sorted by index with duplicates dropped: the same lists the stamp-marked appends used
+        // to produce, without a value-count-sized mark array per clone worker.
+        auto sortUniqueValues = [](std::vector<wolvrix::lib::grh::ValueId> &list) {
+            std::sort(list.begin(), list.end(),
+                      [](wolvrix::lib::grh::ValueId lhs, wolvrix::lib::grh::ValueId rhs) {
+                          return lhs.index < rhs.index;
+                      });
+            list.erase(std::unique(list.begin(), list.end(),
+                                   [](wolvrix::lib::grh::ValueId lhs, wolvrix::lib::grh::ValueId rhs) {
+                                       return lhs.index == rhs.index;
+                                   }),
+                       list.end());
+        };
+        auto appendValidValue = [](std::vector<wolvrix::lib::grh::ValueId> &list, wolvrix::lib::grh::ValueId valueId) {
+            if (valueId.valid())
+            {
+                list.push_back(valueId);
+            }
+        };
 
-        for (std::size_t p = 0; p < partitionOps.size(); ++p)
+        // Each partition is built into its own staged graph, so the builds run concurrently.
+        // Names are reserved here in partition order; graph ids are only assigned when the graphs
+        // are adopted in that order after every build succeeded, which keeps the design identical
+        // to building them one by one and leaves no ids behind when a build fails.
+        std::vector<std::unique_ptr<wolvrix::lib::grh::Graph>> partGraphs;
+        partGraphs.reserve(partitionOps.size());
         {
+            std::unordered_set<std::string> reservedNames;
+            for (std::size_t p = 0; p < partitionOps.size(); ++p)
+            {
+                const std::string base = graph->symbol() + "_repcut_part" + std::to_string(p);
+                std::string partName = base;
+                int suffix = 0;
+                while (design().findGraph(partName) != nullptr || reservedNames.count(partName) != 0)
+                {
+                    partName = base + "_" + std::to_string(++suffix);
+                }
+                reservedNames.insert(partName);
+                partGraphs.push_back(design().createStagedGraph(partName));
+            }
+        }
+
+        struct PartitionCloneStats
+        {
+            std::size_t sourceValues = 0;
+            std::size_t sourceOps = 0;
+            uint64_t elapsedMs = 0;
+        };
+
+        // Returns an error message, empty on success.
+        auto buildPartition = [&](std::size_t p,
+                                  wolvrix::lib::grh::Graph &partGraph,
+                                  PartitionGraphInfo &info,
+                                  PartitionCloneStats &stats) -> std::string {
             const auto partBuildStart = std::chrono::steady_clock::now();
-            logInfo("repcut phase-e rebuild: partition_clone_begin index=" +
-                    std::to_string(p + 1) + "/" + std::to_string(partitionOps.size()) +
-                    " source_ops=" + std::to_string(partitionOps[p].size()));
+
             const auto &sourceOpsInPart = partitionOps[p];
             std::vector<wolvrix::lib::grh::OperationId> sourceOps;
             sourceOps.reserve(sourceOpsInPart.size());
@@ -5344,10 +7442,6 @@ namespace wolvrix::lib::transform
                           return lhs.index < rhs.index;
                       });
 
-            resetStampVector(requiredValueMarks, requiredValueStamp);
-            resetStampVector(inputValueMarks, inputValueStamp);
-            resetStampVector(outputValueMarks, outputValueStamp);
-
             std::vector<wolvrix::lib::grh::ValueId> sourceValues;
             sourceValues.reserve(partRequiredValueCandidates[p].size() +
                                  partInputValueCandidates[p].size() +
@@ -5389,41 +7483,29 @@ namespace wolvrix::lib::transform
                 {
                     continue;
                 }
-                appendUniqueValue(sourceValues, requiredValueMarks, requiredValueStamp, valueId);
+                appendValidValue(sourceValues, valueId);
             }
             for (const auto valueId : partInputValueCandidates[p])
             {
                 if (groupedInputValues.find(valueId) == groupedInputValues.end())
                 {
-                    appendUniqueValue(inputList, inputValueMarks, inputValueStamp, valueId);
-                    appendUniqueValue(sourceValues, requiredValueMarks, requiredValueStamp, valueId);
+                    appendValidValue(inputList, valueId);
+                    appendValidValue(sourceValues, valueId);
                 }
             }
             for (const auto valueId : partOutputValueCandidates[p])
             {
                 if (groupedOutputValues.find(valueId) == groupedOutputValues.end())
                 {
-                    appendUniqueValue(outputList, outputValueMarks, outputValueStamp, valueId);
+                    appendValidValue(outputList, valueId);
                 }
-                appendUniqueValue(sourceValues, requiredValueMarks, requiredValueStamp, valueId);
+                appendValidValue(sourceValues, valueId);
             }
 
-            std::sort(sourceValues.begin(), sourceValues.end(),
-                      [](wolvrix::lib::grh::ValueId lhs, wolvrix::lib::grh::ValueId rhs) {
-                          return lhs.index < rhs.index;
-                      });
-            std::sort(inputList.begin(), inputList.end(),
-                      [](wolvrix::lib::grh::ValueId lhs, wolvrix::lib::grh::ValueId rhs) {
-                          return lhs.index < rhs.index;
-                      });
-            std::sort(outputList.begin(), outputList.end(),
-                      [](wolvrix::lib::grh::ValueId lhs, wolvrix::lib::grh::ValueId rhs) {
-                          return lhs.index < rhs.index;
-                      });
+            sortUniqueValues(sourceValues);
+            sortUniqueValues(inputList);
+            sortUniqueValues(outputList);
 
-            const std::string partName =
-                uniqueGraphName(design(), graph->symbol() + "_repcut_part" + std::to_string(p));
-            wolvrix::lib::grh::Graph &partGraph = design().createGraph(partName);
             const std::size_t symbolReserveCount = sourceValues.size() + sourceOps.size() + 32;
             partGraph.reserveSymbolCapacity(symbolReserveCount);
             partGraph.reserveDeclaredSymbolCapacity(symbolReserveCount);
@@ -5481,9 +7563,8 @@ namespace wolvrix::lib::transform
                 valueMap.emplace(sourceValueId, dstValue);
             }
 
-            PartitionGraphInfo info;
             info.graph = &partGraph;
-            info.name = partName;
+            info.name = partGraph.symbol();
 
             std::unordered_set<std::string> usedPortNames;
 
@@ -5496,10 +7577,8 @@ namespace wolvrix::lib::transform
                 const BoundaryPortGroup &group = boundaryGroups[groupId];
                 if (group.totalWidth <= 0 || group.totalWidth > std::numeric_limits<int32_t>::max())
                 {
-                    error("repcut phase-e rebuild: invalid grouped input width group=" + std::to_string(groupId) +
-                          " width=" + std::to_string(group.totalWidth));
-                    result.failed = true;
-                    return result;
+                    return "repcut phase-e rebuild: invalid grouped input width group=" + std::to_string(groupId) +
+                          " width=" + std::to_string(group.totalWidth);
                 }
 
                 wolvrix::lib::grh::ValueId bundleValue = wolvrix::lib::grh::ValueId::invalid();
@@ -5586,11 +7665,9 @@ namespace wolvrix::lib::transform
                     auto it = valueMap.find(operand);
                     if (it == valueMap.end())
                     {
-                        error("repcut phase-e rebuild: missing operand clone for op " +
+                        return "repcut phase-e rebuild: missing operand clone for op " +
                               formatOperationRef(*graph, sourceOpId) +
-                              " operand_value=" + std::to_string(operand.index));
-                        result.failed = true;
-                        return result;
+                              " operand_value=" + std::to_string(operand.index);
                     }
                     partGraph.addOperand(dstOp, it->second);
                 }
@@ -5599,11 +7676,9 @@ namespace wolvrix::lib::transform
                     auto it = valueMap.find(resultValue);
                     if (it == valueMap.end())
                     {
-                        error("repcut phase-e rebuild: missing result clone for op " +
+                        return "repcut phase-e rebuild: missing result clone for op " +
                               formatOperationRef(*graph, sourceOpId) +
-                              " result_value=" + std::to_string(resultValue.index));
-                        result.failed = true;
-                        return result;
+                              " result_value=" + std::to_string(resultValue.index);
                     }
                     partGraph.addResult(dstOp, it->second);
                 }
@@ -5618,9 +7693,7 @@ namespace wolvrix::lib::transform
                 auto it = valueMap.find(valueId);
                 if (it == valueMap.end())
                 {
-                    error("repcut phase-e rebuild: missing input-port clone value=" + std::to_string(valueId.index));
-                    result.failed = true;
-                    return result;
+                    return "repcut phase-e rebuild: missing input-port clone value=" + std::to_string(valueId.index);
                 }
                 const auto vinfoIt = valueInfos.find(valueId);
                 if (vinfoIt == valueInfos.end())
@@ -5640,9 +7713,7 @@ namespace wolvrix::lib::transform
                 auto it = valueMap.find(valueId);
                 if (it == valueMap.end())
                 {
-                    error("repcut phase-e rebuild: missing output-port clone value=" + std::to_string(valueId.index));
-                    result.failed = true;
-                    return result;
+                    return "repcut phase-e rebuild: missing output-port clone value=" + std::to_string(valueId.index);
                 }
                 const auto vinfoIt = valueInfos.find(valueId);
                 if (vinfoIt == valueInfos.end())
@@ -5666,10 +7737,8 @@ namespace wolvrix::lib::transform
                 const BoundaryPortGroup &group = boundaryGroups[groupId];
                 if (group.totalWidth <= 0 || group.totalWidth > std::numeric_limits<int32_t>::max())
                 {
-                    error("repcut phase-e rebuild: invalid grouped output width group=" + std::to_string(groupId) +
-                          " width=" + std::to_string(group.totalWidth));
-                    result.failed = true;
-                    return result;
+                    return "repcut phase-e rebuild: invalid grouped output width group=" + std::to_string(groupId) +
+                          " width=" + std::to_string(group.totalWidth);
                 }
 
                 wolvrix::lib::grh::ValueId bundleValue = wolvrix::lib::grh::ValueId::invalid();
@@ -5678,10 +7747,8 @@ namespace wolvrix::lib::transform
                     auto it = valueMap.find(group.members.front());
                     if (it == valueMap.end())
                     {
-                        error("repcut phase-e rebuild: missing grouped output member clone value=" +
-                              std::to_string(group.members.front().index));
-                        result.failed = true;
-                        return result;
+                        return "repcut phase-e rebuild: missing grouped output member clone value=" +
+                              std::to_string(group.members.front().index);
                     }
                     bundleValue = it->second;
                 }
@@ -5698,10 +7765,8 @@ namespace wolvrix::lib::transform
                         auto it = valueMap.find(valueId);
                         if (it == valueMap.end())
                         {
-                            error("repcut phase-e rebuild: missing grouped output member clone value=" +
-                                  std::to_string(valueId.index));
-                            result.failed = true;
-                            return result;
+                            return "repcut phase-e rebuild: missing grouped output member clone value=" +
+                                  std::to_string(valueId.index);
                         }
                         partGraph.addOperand(concatOp, it->second);
                     }
@@ -5721,18 +7786,123 @@ namespace wolvrix::lib::transform
                 info.outputPortByGroup.emplace(groupId, portName);
             }
 
-            partInfos.push_back(std::move(info));
+            stats.sourceValues = sourceValues.size();
+            stats.sourceOps = sourceOps.size();
+            stats.elapsedMs = msSince(partBuildStart);
+            return {};
+        };
+
+        const std::size_t cloneHwThreads =
+            std::max<std::size_t>(1, static_cast<std::size_t>(std::thread::hardware_concurrency()));
+        const std::size_t cloneThreads = std::min<std::size_t>(
+            partitionOps.size(),
+            options_.phaseEThreads != 0 ? options_.phaseEThreads
+                                        : std::min<std::size_t>(kMaxPartitionCloneThreads, cloneHwThreads));
+        std::vector<std::string> cloneErrors(partitionOps.size());
+        std::vector<std::exception_ptr> cloneExceptions(partitionOps.size());
+        std::vector<PartitionCloneStats> cloneStats(partitionOps.size());
+        std::vector<char> cloneDone(partitionOps.size(), 0);
+        std::mutex cloneDoneMutex;
+        std::condition_variable cloneDoneCv;
+        auto runClone = [&](std::size_t p) {
+            try
+            {
+                cloneErrors[p] = buildPartition(p, *partGraphs[p], partInfos[p], cloneStats[p]);
+            }
+            catch (...)
+            {
+                cloneExceptions[p] = std::current_exception();
+            }
+            {
+                std::lock_guard<std::mutex> lock(cloneDoneMutex);
+                cloneDone[p] = 1;
+            }
+            cloneDoneCv.notify_one();
+        };
+        auto cloneFailed = [&](std::size_t p) {
+            return cloneExceptions[p] != nullptr || !cloneErrors[p].empty();
+        };
+        auto logCloneDone = [&](std::size_t p) {
+            const PartitionGraphInfo &info = partInfos[p];
             logInfo("repcut phase-e rebuild: partition_clone_done index=" +
                     std::to_string(p + 1) + "/" + std::to_string(partitionOps.size()) +
-                    " graph=" + partName +
-                    " source_values=" + std::to_string(sourceValues.size()) +
-                    " source_ops=" + std::to_string(sourceOps.size()) +
+                    " graph=" + info.name +
+                    " source_values=" + std::to_string(cloneStats[p].sourceValues) +
+                    " source_ops=" + std::to_string(cloneStats[p].sourceOps) +
                     " input_ports=" +
-                    std::to_string(partInfos.back().inputPortByValue.size() + partInfos.back().inputPortByGroup.size()) +
+                    std::to_string(info.inputPortByValue.size() + info.inputPortByGroup.size()) +
                     " output_ports=" +
-                    std::to_string(partInfos.back().outputPortByValue.size() + partInfos.back().outputPortByGroup.size()) +
-                    " elapsed_ms=" + std::to_string(msSince(partBuildStart)) +
+                    std::to_string(info.outputPortByValue.size() + info.outputPortByGroup.size()) +
+                    " elapsed_ms=" + std::to_string(cloneStats[p].elapsedMs) +
                     " total_elapsed_ms=" + std::to_string(msSince(phaseERebuildStart)));
+        };
+
+        if (cloneThreads <= 1)
+        {
+            for (std::size_t p = 0; p < partitionOps.size(); ++p)
+            {
+                logInfo("repcut phase-e rebuild: partition_clone_begin index=" +
+                        std::to_string(p + 1) + "/" + std::to_string(partitionOps.size()) +
+                        " source_ops=" + std::to_string(partitionOps[p].size()));
+                runClone(p);
+                if (cloneFailed(p))
+                {
+                    break;
+                }
+                logCloneDone(p);
+            }
+        }
+        else
+        {
+            logInfo("repcut phase-e rebuild: partition_clone_parallel threads=" + std::to_string(cloneThreads));
+            std::atomic<std::size_t> nextPart{0};
+            std::vector<std::thread> workers;
+            workers.reserve(cloneThreads);
+            for (std::size_t t = 0; t < cloneThreads; ++t)
+            {
+                workers.emplace_back([&]() {
+                    for (std::size_t p = nextPart.fetch_add(1, std::memory_order_relaxed); p < partitionOps.size();
+                         p = nextPart.fetch_add(1, std::memory_order_relaxed))
+                    {
+                        runClone(p);
+                    }
+                });
+            }
+            // Completions are reported from this thread in partition order; the log sink does not
+            // have to be thread-safe.
+            for (std::size_t p = 0; p < partitionOps.size(); ++p)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(cloneDoneMutex);
+                    cloneDoneCv.wait(lock, [&]() { return cloneDone[p] != 0; });
+                }
+                if (!cloneFailed(p))
+                {
+                    logCloneDone(p);
+                }
+            }
+            for (auto &worker : workers)
+            {
+                worker.join();
+            }
+        }
+
+        for (std::size_t p = 0; p < partitionOps.size(); ++p)
+        {
+            if (cloneExceptions[p])
+            {
+                std::rethrow_exception(cloneExceptions[p]);
+            }
+            if (!cloneErrors[p].empty())
+            {
+                error(cloneErrors[p]);
+                result.failed = true;
+                return result;
+            }
+        }
+        for (std::size_t p = 0; p < partitionOps.size(); ++p)
+        {
+            design().adoptGraph(std::move(partGraphs[p]));
         }
         logInfo("repcut phase-e rebuild: partition graph cloning done part_graphs=" +
                 std::to_string(partInfos.size()) +
@@ -6299,7 +8469,15 @@ namespace wolvrix::lib::transform
                 return result;
             }
 
-            buildInstance(newTop, part.graph->symbol(), "part_" + std::to_string(p), *part.graph, inputMapping, outputMapping);
+            const wolvrix::lib::grh::OperationId partInst = buildInstance(
+                newTop, part.graph->symbol(), "part_" + std::to_string(p), *part.graph, inputMapping, outputMapping);
+            if (numaHierarchical)
+            {
+                newTop.setAttr(partInst,
+                               "repcutNumaDomain",
+                               static_cast<int64_t>(numaDomainOfPart(
+                                   static_cast<uint32_t>(p), partsPerDomain, numaDomainCount)));
+            }
             if (((p + 1) % 8) == 0 || (p + 1) == partInfos.size())
             {
                 logInfo("repcut phase-e rebuild: instance_wiring_progress done=" +
@@ -6337,14 +8515,6 @@ namespace wolvrix::lib::transform
         logInfo(phaseEReconstructSummary.str());
         const uint64_t phaseEMs = msSince(phaseEStart);
 
-        if (!options_.keepIntermediateFiles)
-        {
-            std::error_code cleanupError;
-            std::filesystem::remove(hmetisPath, cleanupError);
-            cleanupError.clear();
-            std::filesystem::remove(partitionPath, cleanupError);
-        }
-
         std::size_t partitionWeightSum = 0;
         std::size_t partitionWeightMax = 0;
         std::size_t weightedPartitionCount = 0;
@@ -6408,11 +8578,24 @@ namespace wolvrix::lib::transform
         stats << "{"
               << "\"pass\":\"repcut\""
               << ",\"graph\":\"" << escapeJson(topName) << "\""
-              << ",\"partition_count_requested\":" << options_.partitionCount
+              << ",\"partition_count_requested\":" << selectedPartitionCount
               << ",\"partition_count_observed\":" << partInfos.size()
               << ",\"asc_count\":" << phaseB.ascs.size()
-              << ",\"piece_count\":" << phaseB.pieces.size()
+              << ",\"piece_count\":" << pieceCount
               << ",\"hyper_edge_count\":" << hg.edges.size()
+              << ",\"edge_weighting\":\"" << edgeWeightingName(*edgeWeighting) << "\""
+              << ",\"node_weighting\":\"" << (profileWeighted ? "profile" : "static") << "\""
+              << ",\"predicted_traffic_bytes\":" << predictedTrafficBytes
+              << ",\"numa_domains\":" << numaDomainCount;
+        if (numaHierarchical)
+        {
+            stats << ",\"numa_parts_per_domain\":" << partsPerDomain
+                  << ",\"numa_inter_domain_cost\":" << toFixedString(options_.numaInterDomainCost, 6)
+                  << ",\"predicted_intra_domain_bytes\":" << numaTraffic.intraDomainBytes
+                  << ",\"predicted_inter_domain_bytes\":" << numaTraffic.interDomainBytes
+                  << ",\"predicted_numa_cost\":" << toFixedString(numaTraffic.cost, 3);
+        }
+        stats
               << ",\"cross_values_total\":" << crossValues.size()
               << ",\"cross_values_need_ports\":" << crossNeedsPortCount
               << ",\"cross_links\":" << linkValues.size()
@@ -570,6 +570,42 @@ int main()
     {
         return fail("Makefile missing expected top-level build rules");
     }
+    if (contains(commonSource, "kWolviRepcutEvalNumaDomains"))
+    {
+        return fail("wrapper source should not contain NUMA pinning without repcutNumaDomain attributes");
+    }
+
+    // Parts from a hierarchical repcut carry their NUMA domain; workers are pinned per domain.
+    Design numaDesign = buildDesign();
+    Graph *numaTop = numaDesign.findGraph("SimTop");
+    for (const auto opId : numaTop->operations())
+    {
+        const auto op = numaTop->getOperation(opId);
+        const auto nameAttr = op.attr("instanceName");
+        const auto *name = nameAttr ? std::get_if<std::string>(&*nameAttr) : nullptr;
+        if (name != nullptr && name->rfind("part_", 0) == 0)
+        {
+            numaTop->setAttr(opId, "repcutNumaDomain", static_cast<int64_t>(std::stoll(name->substr(5))));
+        }
+    }
+    const std::filesystem::path numaRoot = std::filesystem::path(WOLF_SV_EMIT_ARTIFACT_DIR) / "verilator_repcut_package_numa";
+    std::filesystem::remove_all(numaRoot, ec);
+    EmitDiagnostics numaDiagnostics;
+    EmitVerilatorRepCutPackage numaEmitter(&numaDiagnostics);
+    EmitOptions numaOptions;
+    numaOptions.outputDir = numaRoot.string();
+    numaOptions.topOverrides = {"SimTop"};
+    if (!numaEmitter.emit(numaDesign, numaOptions).success || numaDiagnostics.hasError())
+    {
+        return fail("package emit with NUMA domains failed: " + diagnosticsSummary(numaDiagnostics));
+    }
+    const std::string numaCommonSource = readFile(numaRoot / "wolvi_repcut_verilator_sim_common.cpp");
+    if (!contains(numaCommonSource, "constexpr int kWolviRepcutEvalNumaDomains[] = {-1, 0, 1};") ||
+        !contains(numaCommonSource, "/sys/devices/system/node/node%d/cpulist") ||
+        !contains(numaCommonSource, "wolvi_repcut_numa_worker_cpus(wolvi_repcut_available_cpus(), workerNumaDomains);"))
+    {
+        return fail("wrapper source missing expected NUMA worker pinning");
+    }
 
     return 0;
 }
@@ -6,6 +6,7 @@
 #include <fstream>
 #include <iostream>
 #include <limits>
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <vector>
@@ -650,6 +651,21 @@ int main()
             {
                 return fail("GraphView port flags mismatch");
             }
+
+            const auto addIndex = static_cast<std::size_t>(opAdd.index - 1);
+            const auto sumIndex = static_cast<std::size_t>(vSum.index - 1);
+            const grh_ir::Range operandRange = view.opOperandRangeArray()[addIndex];
+            const grh_ir::Range userRange = view.valueUserRangeArray()[sumIndex];
+            if (view.opKindArray()[addIndex] != OperationKind::kAdd ||
+                view.opSymbolArray()[addIndex] != symAdd ||
+                view.valueWidthArray().size() != view.values().size() ||
+                operandRange.count != view.opOperands(opAdd).size() ||
+                view.operandArray()[operandRange.offset] != view.opOperands(opAdd)[0] ||
+                view.valueDefArray()[sumIndex] != opAdd || userRange.count != 1 ||
+                view.useListArray()[userRange.offset].operation != opAssign)
+            {
+                return fail("GraphView dense arrays disagree with per-id accessors");
+            }
         }
 
         {
@@ -810,6 +826,47 @@ int main()
             }
         }
 
+        {
+            // Staged graphs get their GraphId on adoption, in adoption order, whatever order
+            // they were created in; handles stored inside the graph follow the new id.
+            Design stagedDesign;
+            std::unique_ptr<Graph> late = stagedDesign.createStagedGraph("staged_late");
+            std::unique_ptr<Graph> early = stagedDesign.createStagedGraph("staged_early");
+            for (Graph *graph : {late.get(), early.get()})
+            {
+                const ValueId in = graph->createValue(graph->internSymbol("in"), 4, false);
+                const ValueId out = graph->createValue(graph->internSymbol("out"), 4, false);
+                const OperationId op = graph->createOperation(OperationKind::kAssign, graph->internSymbol("assign"));
+                graph->addOperand(op, in);
+                graph->addResult(op, out);
+                graph->bindInputPort("in", in);
+                graph->bindOutputPort("out", out);
+            }
+            early->freeze();
+            Graph &adoptedEarly = stagedDesign.adoptGraph(std::move(early));
+            Graph &adoptedLate = stagedDesign.adoptGraph(std::move(late));
+            if (adoptedEarly.id().index != 1 || adoptedLate.id().index != 2 ||
+                adoptedEarly.id().generation != 0 || adoptedLate.id().generation != 0)
+            {
+                return fail("Staged graphs should get GraphIds in adoption order");
+            }
+            for (Graph *graph : {&adoptedEarly, &adoptedLate})
+            {
+                const OperationId op = graph->findOperation("assign");
+                const ValueId out = graph->outputPortValue("out");
+                if (op.graph != graph->id() || out.graph != graph->id() || graph->valueDef(out) != op ||
+                    graph->opOperands(op).front() != graph->inputPortValue("in") ||
+                    graph->getValue(graph->inputPortValue("in")).users().front().operation != op)
+                {
+                    return fail("Staged graph handles should follow the adopted GraphId");
+                }
+            }
+            if (stagedDesign.createGraph("plain").id().index != 3)
+            {
+                return fail("Staged graphs should not consume GraphIds before adoption");
+            }
+        }
+
     }
     catch (const std::exception &ex)
     {
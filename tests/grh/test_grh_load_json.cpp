@@ -0,0 +1,245 @@
+#include "core/grh.hpp"
+#include "core/load.hpp"
+#include "core/store.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+using namespace wolvrix::lib::grh;
+using namespace wolvrix::lib::store;
+
+namespace
+{
+
+    int fail(const std::string &message)
+    {
+        std::cerr << "[grh_load_json_tests] " << message << '\n';
+        return 1;
+    }
+
+    template <typename Func>
+    bool expectThrows(Func &&func)
+    {
+        try
+        {
+            func();
+        }
+        catch (const std::exception &)
+        {
+            return true;
+        }
+        return false;
+    }
+
+    std::string storeCompact(const Design &design)
+    {
+        StoreJson store;
+        StoreOptions options;
+        options.jsonMode = JsonPrintMode::Compact;
+        auto text = store.storeToString(design, options);
+        if (!text)
+        {
+            throw std::runtime_error("storeToString failed");
+        }
+        return *text;
+    }
+
+    // Canonical field order, as written by StoreJson.
+    const char *kCanonicalJson = R"({
+  "graphs": [
+    {
+      "symbol": "top",
+      "declaredSymbols": ["a"],
+      "vals": [
+        {"sym": "a", "w": 4, "sgn": false, "in": true, "out": false, "users": [{"op": "n", "idx": 0}]},
+        {"sym": "y", "w": 4, "sgn": false, "in": false, "out": true, "def": "n", "loc": {"file": "t.sv", "line": 3}}
+      ],
+      "ports": {"in": [{"name": "a", "val": "a"}], "out": [{"name": "y", "val": "y"}]},
+      "ops": [
+        {"sym": "n", "kind": "kNot", "in": ["a"], "out": ["y"],
+         "attrs": {"tag": {"t": "string", "v": "x"}, "depth": {"t": "int", "v": 2}}}
+      ]
+    }
+  ],
+  "declaredSymbols": ["top"],
+  "aliases": {"top_alias": "top"},
+  "tops": ["top"]
+})";
+
+    // Same design with every object's keys permuted, extra unknown keys, and duplicates.
+    const char *kPermutedJson = R"({
+  "tops": ["top"],
+  "aliases": {"top_alias": "top"},
+  "extra": {"ignored": [1, 2, {"deep": null}]},
+  "graphs": [
+    {
+      "ops": [
+        {"attrs": {"depth": {"v": 2, "t": "int"}, "tag": {"v": "x", "k": "string"}},
+         "out": ["y"], "in": ["a"], "kind": "kNot", "sym": "n", "sym": "ignored_duplicate"}
+      ],
+      "ports": {"out": [{"val": "y", "name": "y"}], "in": [{"val": "a", "name": "a"}]},
+      "vals": [
+        {"users": [], "out": false, "in": true, "sgn": false, "w": 4, "sym": "a"},
+        {"loc": {"line": 3, "file": "t.sv"}, "out": true, "in": false, "sgn": false, "w": 4.0, "sym": "y"}
+      ],
+      "declaredSymbols": ["a"],
+      "symbol": "top"
+    }
+  ],
+  "declaredSymbols": ["top"]
+})";
+
+    std::string buildMultiGraphJson(int graphCount)
+    {
+        std::string json = R"({"graphs": [)";
+        for (int i = 0; i < graphCount; ++i)
+        {
+            const std::string name = "g" + std::to_string(graphCount - i);
+            if (i != 0)
+            {
+                json += ",";
+            }
+            json += R"({"symbol": ")" + name + R"(", "declaredSymbols": [], "vals": [)"
+                    R"({"sym": "a", "w": 8, "sgn": false, "in": true, "out": false},)"
+                    R"({"sym": "y", "w": 8, "sgn": false, "in": false, "out": true}],)"
+                    R"("ports": {"in": [{"name": "a", "val": "a"}], "out": [{"name": "y", "val": "y"}]},)"
+                    R"("ops": [{"sym": "n", "kind": "kNot", "in": ["a"], "out": ["y"]}]})";
+        }
+        json += R"(], "declaredSymbols": [], "tops": ["g1"]})";
+        return json;
+    }
+
+} // namespace
+
+int main()
+{
+    try
+    {
+        const Design canonical = Design::fromJsonString(kCanonicalJson);
+        const Design permuted = Design::fromJsonString(kPermutedJson);
+        if (storeCompact(canonical) != storeCompact(permuted))
+        {
+            return fail("Key order, unknown keys or duplicate keys changed the loaded design");
+        }
+
+        const Graph *graph = permuted.findGraph("top");
+        if (!graph || !graph->findOperation("n").valid())
+        {
+            return fail("Expected first duplicate key to win for operation symbol");
+        }
+        if (!permuted.findGraph("top_alias"))
+        {
+            return fail("Alias not registered");
+        }
+
+        const std::string escapedJson = R"({
+  "graphs": [
+    {
+      "symbol": "esc\"graph",
+      "declaredSymbols": [],
+      "vals": [
+        {"sym": "in\\put", "w": 1, "sgn": false, "in": true, "out": false},
+        {"sym": "outA", "w": 1, "sgn": false, "in": false, "out": true}
+      ],
+      "ports": {"in": [{"name": "in\\put", "val": "in\\put"}], "out": [{"name": "outA", "val": "outA"}]},
+      "ops": [
+        {"sym": "op", "kind": "kAssign", "in": ["in\\put"], "out": ["outA"],
+         "attrs": {"key": {"t": "string[]", "vs": ["a\nb", "c"]}}}
+      ]
+    }
+  ],
+  "declaredSymbols": [],
+  "tops": ["esc\"graph"]
+})";
+        const Design escaped = Design::fromJsonString(escapedJson);
+        const Graph *escapedGraph = escaped.findGraph("esc\"graph");
+        if (!escapedGraph)
+        {
+            return fail("Escaped graph symbol not decoded");
+        }
+        if (!escapedGraph->findValue("in\\put").valid() || !escapedGraph->findValue("outA").valid())
+        {
+            return fail("Escaped value symbols not decoded");
+        }
+        const OperationId op = escapedGraph->findOperation("op");
+        if (!op.valid() || !escapedGraph->getOperation(op).attr("key"))
+        {
+            return fail("Escaped attribute name not decoded");
+        }
+
+        const std::filesystem::path mappedPath =
+            std::filesystem::temp_directory_path() / "grh_load_json_mapped.json";
+        {
+            std::ofstream out(mappedPath, std::ios::binary);
+            out << kPermutedJson;
+        }
+        const Design mapped = Design::fromJsonFile(mappedPath.string());
+        if (storeCompact(mapped) != storeCompact(canonical))
+        {
+            return fail("fromJsonFile result differs from fromJsonString");
+        }
+        {
+            std::ofstream truncate(mappedPath, std::ios::binary | std::ios::trunc);
+        }
+        if (!expectThrows([&]
+                          { Design::fromJsonFile(mappedPath.string()); }))
+        {
+            return fail("Expected fromJsonFile to throw on an empty file");
+        }
+        std::filesystem::remove(mappedPath);
+        if (!expectThrows([&]
+                          { Design::fromJsonFile(mappedPath.string()); }))
+        {
+            return fail("Expected fromJsonFile to throw on a missing file");
+        }
+
+        const std::string multiJson = buildMultiGraphJson(64);
+        const Design serial = wolvrix::lib::load::LoadJson(1).load(multiJson);
+        const Design parallel = wolvrix::lib::load::LoadJson(8).load(multiJson);
+        if (serial.graphOrder() != parallel.graphOrder() || serial.graphOrder().front() != "g64")
+        {
+            return fail("Parallel load changed graph order");
+        }
+        if (storeCompact(serial) != storeCompact(parallel))
+        {
+            return fail("Parallel load changed the design");
+        }
+        std::string duplicateJson = multiJson;
+        duplicateJson.replace(duplicateJson.find("\"g3\""), 4, "\"g9\"");
+        if (!expectThrows([&]
+                          { wolvrix::lib::load::LoadJson(8).load(duplicateJson); }))
+        {
+            return fail("Expected duplicated graph symbol to throw in parallel load");
+        }
+
+        const auto expectLoadThrows = [&](const std::string &json, const std::string &what) -> bool
+        {
+            if (!expectThrows([&]
+                              { Design::fromJsonString(json); }))
+            {
+                std::cerr << "[grh_load_json_tests] Expected load to throw: " << what << '\n';
+                return false;
+            }
+            return true;
+        };
+        if (!expectLoadThrows(std::string(kCanonicalJson) + " x", "trailing characters") ||
+            !expectLoadThrows(R"({"graphs": [], "tops": []})", "missing declaredSymbols") ||
+            !expectLoadThrows(R"({"graphs": [{"symbol": "g", "declaredSymbols": [], "vals": [], "ports": {}, "ops": [{"sym": "o", "kind": "kAssign", "in": ["missing"]}]}], "declaredSymbols": []})",
+                              "unknown operand") ||
+            !expectLoadThrows(R"({"graphs": [{"symbol": "g", "declaredSymbols": [], "vals": [{"sym": "v", "w": 1.5, "sgn": false, "in": false, "out": false}], "ports": {}}], "declaredSymbols": []})",
+                              "fractional width") ||
+            !expectLoadThrows(R"({"graphs": [{"symbol": "g", "declaredSymbols": [], "vals": [], "ports": {}}], "declaredSymbols": [], "tops": [)",
+                              "truncated document"))
+        {
+            return 1;
+        }
+    }
+    catch (const std::exception &ex)
+    {
+        return fail(std::string("Unexpected exception: ") + ex.what());
+    }
+    return 0;
+}
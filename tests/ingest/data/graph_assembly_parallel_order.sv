@@ -0,0 +1,47 @@
+module leaf #(
+    parameter int WIDTH = 1
+) (
+    input logic [WIDTH-1:0] a,
+    output logic [WIDTH-1:0] y
+);
+    assign y = ~a;
+endmodule
+
+module mid_a (
+    input logic [3:0] a,
+    output logic [3:0] y
+);
+    logic [3:0] t;
+    leaf #(.WIDTH(4)) u_leaf0 (.a(a), .y(t));
+    leaf #(.WIDTH(4)) u_leaf1 (.a(t), .y(y));
+endmodule
+
+module mid_b (
+    input logic [7:0] a,
+    output logic [7:0] y
+);
+    logic [7:0] t;
+    leaf #(.WIDTH(8)) u_leaf0 (.a(a), .y(t));
+    mid_c u_mid_c (.a(t), .y(y));
+endmodule
+
+module mid_c (
+    input logic [7:0] a,
+    output logic [7:0] y
+);
+    logic [1:0] lo;
+    leaf #(.WIDTH(2)) u_leaf0 (.a(a[1:0]), .y(lo));
+    assign y = {a[7:2], lo};
+endmodule
+
+module graph_assembly_parallel_order (
+    input logic [3:0] a,
+    input logic [7:0] b,
+    output logic [3:0] ya,
+    output logic [7:0] yb,
+    output logic yc
+);
+    mid_b u_mid_b (.a(b), .y(yb));
+    mid_a u_mid_a (.a(a), .y(ya));
+    leaf u_leaf (.a(a[0]), .y(yc));
+endmodule
@@ -0,0 +1,159 @@
+#include "core/ingest.hpp"
+#include "core/store.hpp"
+
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "slang/analysis/AnalysisManager.h"
+#include "slang/ast/symbols/InstanceSymbols.h"
+#include "slang/driver/Driver.h"
+
+namespace {
+
+int fail(const std::string& message) {
+    std::cerr << "[ingest-graph-assembly-parallel-order] " << message << '\n';
+    return 1;
+}
+
+struct CompilationBundle {
+    slang::driver::Driver driver;
+    std::unique_ptr<slang::ast::Compilation> compilation;
+};
+
+std::unique_ptr<CompilationBundle> compileInput(const std::filesystem::path& sourcePath,
+                                                std::string_view topModule) {
+    auto bundle = std::make_unique<CompilationBundle>();
+    auto& driver = bundle->driver;
+    driver.addStandardArgs();
+    driver.languageVersion = slang::LanguageVersion::v1800_2023;
+    if (!topModule.empty()) {
+        driver.options.topModules.emplace_back(topModule);
+    }
+
+    std::vector<std::string> argStorage;
+    argStorage.emplace_back("ingest-graph-assembly-parallel-order");
+    argStorage.emplace_back(sourcePath.string());
+    std::vector<const char*> argv;
+    argv.reserve(argStorage.size());
+    for (const std::string& arg : argStorage) {
+        argv.push_back(arg.c_str());
+    }
+
+    if (!driver.parseCommandLine(static_cast<int>(argv.size()), argv.data())) {
+        return nullptr;
+    }
+    if (!driver.processOptions()) {
+        return nullptr;
+    }
+    if (!driver.parseAllSources()) {
+        return nullptr;
+    }
+
+    bundle->compilation = driver.createCompilation();
+    if (!bundle->compilation) {
+        return nullptr;
+    }
+    driver.reportCompilation(*bundle->compilation, /* quiet */ true);
+    driver.runAnalysis(*bundle->compilation);
+    return bundle;
+}
+
+struct ConvertSnapshot {
+    std::vector<std::string> graphOrder;
+    std::vector<std::string> topGraphs;
+    std::vector<std::string> declaredSymbols;
+    std::vector<uint32_t> graphIds;
+    std::string json;
+};
+
+std::optional<ConvertSnapshot> convertWithThreads(const slang::ast::Compilation& compilation,
+                                                  uint32_t threadCount) {
+    wolvrix::lib::ingest::ConvertOptions options;
+    options.threadCount = threadCount;
+    options.singleThread = threadCount <= 1;
+    wolvrix::lib::ingest::ConvertDriver driver(options);
+    wolvrix::lib::grh::Design design = driver.convert(compilation.getRoot());
+    if (!driver.diagnostics().empty()) {
+        return std::nullopt;
+    }
+
+    ConvertSnapshot snapshot;
+    snapshot.graphOrder = design.graphOrder();
+    snapshot.topGraphs = design.topGraphs();
+    for (wolvrix::lib::grh::SymbolId sym : design.declaredSymbols()) {
+        snapshot.declaredSymbols.emplace_back(design.symbolText(sym));
+    }
+    for (const std::string& name : snapshot.graphOrder) {
+        snapshot.graphIds.push_back(design.findGraph(name)->id().index);
+    }
+    wolvrix::lib::store::StoreOptions storeOptions;
+    storeOptions.jsonMode = wolvrix::lib::store::JsonPrintMode::Compact;
+    wolvrix::lib::store::StoreJson store;
+    auto json = store.storeToString(design, storeOptions);
+    if (!json) {
+        return std::nullopt;
+    }
+    snapshot.json = std::move(*json);
+    return snapshot;
+}
+
+int testGraphAssemblyParallelOrder(const std::filesystem::path& sourcePath) {
+    auto bundle = compileInput(sourcePath, "graph_assembly_parallel_order");
+    if (!bundle || !bundle->compilation) {
+        return fail("Failed to compile " + sourcePath.string());
+    }
+
+    auto serial = convertWithThreads(*bundle->compilation, 1);
+    if (!serial) {
+        return fail("Serial convert failed");
+    }
+    if (serial->graphOrder.size() != 8) {
+        return fail("Expected 8 graphs, got " + std::to_string(serial->graphOrder.size()));
+    }
+    if (serial->graphOrder[0] != "graph_assembly_parallel_order" ||
+        serial->graphOrder[1] != "mid_b" || serial->graphOrder[2] != "mid_a") {
+        return fail("Serial graph order does not follow instance discovery order");
+    }
+    if (serial->graphOrder[5] != "mid_c") {
+        return fail("Expected mid_c after the first-level children and their leaves");
+    }
+
+    for (uint32_t threads : {2u, 4u, 8u}) {
+        for (int round = 0; round < 4; ++round) {
+            auto parallel = convertWithThreads(*bundle->compilation, threads);
+            if (!parallel) {
+                return fail("Parallel convert failed with " + std::to_string(threads) + " threads");
+            }
+            if (parallel->graphOrder != serial->graphOrder) {
+                return fail("Graph order differs with " + std::to_string(threads) + " threads");
+            }
+            if (parallel->topGraphs != serial->topGraphs) {
+                return fail("Top graphs differ with " + std::to_string(threads) + " threads");
+            }
+            if (parallel->declaredSymbols != serial->declaredSymbols) {
+                return fail("Declared symbols differ with " + std::to_string(threads) + " threads");
+            }
+            if (parallel->graphIds != serial->graphIds) {
+                return fail("Graph ids differ with " + std::to_string(threads) + " threads");
+            }
+            if (parallel->json != serial->json) {
+                return fail("Stored JSON differs with " + std::to_string(threads) + " threads");
+            }
+        }
+    }
+
+    return 0;
+}
+
+} // namespace
+
+int main() {
+    const std::filesystem::path sourcePath =
+        WOLF_SV_INGEST_GRAPH_ASSEMBLY_PARALLEL_ORDER_DATA_PATH;
+    return testGraphAssemblyParallelOrder(sourcePath);
+}
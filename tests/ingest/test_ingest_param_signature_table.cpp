@@ -0,0 +1,119 @@
+#include "core/ingest.hpp"
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+int fail(const std::string& message) {
+    std::cerr << "[ingest-param-signature-table] " << message << '\n';
+    return 1;
+}
+
+int testInterning() {
+    wolvrix::lib::ingest::ParamSignatureTable table;
+    if (table.intern("") != nullptr) {
+        return fail("Empty signature should intern to nullptr");
+    }
+    const auto* a = table.intern("WIDTH=8;DEPTH=16");
+    const std::string copy = "WIDTH=8;DEPTH=16";
+    const auto* b = table.intern(copy);
+    const auto* c = table.intern("WIDTH=8;DEPTH=32");
+    if (!a || a != b) {
+        return fail("Equal signatures should intern to the same entry");
+    }
+    if (!c || c == a) {
+        return fail("Different signatures should intern to different entries");
+    }
+    if (a->text != "WIDTH=8;DEPTH=16" ||
+        a->fingerprint != wolvrix::lib::ingest::ParamSignatureTable::fingerprint(a->text)) {
+        return fail("Interned entry should keep text and fingerprint");
+    }
+    if (table.size() != 2) {
+        return fail("Expected two interned signatures");
+    }
+    return 0;
+}
+
+int testPlanKeyEquality() {
+    wolvrix::lib::ingest::ParamSignatureTable table;
+    wolvrix::lib::ingest::PlanKey lhs;
+    wolvrix::lib::ingest::PlanKey rhs;
+    lhs.paramSignature = table.intern("N=1");
+    rhs.paramSignature = table.intern(std::string("N=") + "1");
+    if (!(lhs == rhs) ||
+        wolvrix::lib::ingest::PlanKeyHash{}(lhs) != wolvrix::lib::ingest::PlanKeyHash{}(rhs)) {
+        return fail("Keys with equal signatures should compare and hash equal");
+    }
+    rhs.paramSignature = table.intern("N=2");
+    if (lhs == rhs) {
+        return fail("Keys with different signatures should not compare equal");
+    }
+    wolvrix::lib::ingest::PlanKey empty;
+    if (empty.paramFingerprint() != 0 || !empty.paramText().empty()) {
+        return fail("Key without overrides should have an empty signature");
+    }
+    return 0;
+}
+
+int testContextCopiesShareTable() {
+    wolvrix::lib::ingest::ConvertContext context{};
+    const wolvrix::lib::ingest::ConvertContext copy = context;
+    if (!context.paramSignatures || context.paramSignatures != copy.paramSignatures) {
+        return fail("Copies of a context should share one signature table");
+    }
+    if (context.paramSignatures->intern("N=1") != copy.paramSignatures->intern("N=1")) {
+        return fail("Signatures interned through context copies should compare equal by pointer");
+    }
+    return 0;
+}
+
+int testConcurrentIntern() {
+    wolvrix::lib::ingest::ParamSignatureTable table;
+    constexpr int kThreads = 8;
+    constexpr int kSignatures = 512;
+    std::vector<std::vector<const wolvrix::lib::ingest::ParamSignature*>> results(kThreads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < kSignatures; ++i) {
+                results[t].push_back(table.intern("DEPTH=" + std::to_string(i)));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (int t = 1; t < kThreads; ++t) {
+        if (results[t] != results[0]) {
+            return fail("Concurrent interning should return identical entries");
+        }
+    }
+    std::unordered_set<const wolvrix::lib::ingest::ParamSignature*> unique(results[0].begin(),
+                                                                          results[0].end());
+    if (unique.size() != kSignatures || table.size() != kSignatures) {
+        return fail("Expected one entry per distinct signature");
+    }
+    return 0;
+}
+
+} // namespace
+
+int main() {
+    if (int result = testInterning(); result != 0) {
+        return result;
+    }
+    if (int result = testPlanKeyEquality(); result != 0) {
+        return result;
+    }
+    if (int result = testContextCopiesShareTable(); result != 0) {
+        return result;
+    }
+    if (int result = testConcurrentIntern(); result != 0) {
+        return result;
+    }
+    return 0;
+}
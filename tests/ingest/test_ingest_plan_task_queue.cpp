@@ -0,0 +1,93 @@
+#include "core/ingest.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+int fail(const std::string& message) {
+    std::cerr << "[ingest-plan-task-queue] " << message << '\n';
+    return 1;
+}
+
+wolvrix::lib::ingest::ParamSignatureTable signatures;
+
+wolvrix::lib::ingest::PlanKey makeKey(const std::string& signature) {
+    wolvrix::lib::ingest::PlanKey key;
+    key.paramSignature = signatures.intern(signature);
+    return key;
+}
+
+int testCostOrder() {
+    wolvrix::lib::ingest::PlanTaskQueue queue;
+    queue.reset();
+    queue.push(makeKey("small"), 10);
+    queue.push(makeKey("huge"), 5000);
+    queue.push(makeKey("medium_a"), 300);
+    queue.push(makeKey("medium_b"), 300);
+    queue.push(makeKey("unknown"), 0);
+
+    const std::vector<std::string> expected = {"huge", "medium_a", "medium_b", "small", "unknown"};
+    std::vector<std::string> popped;
+    wolvrix::lib::ingest::PlanKey key;
+    while (queue.tryPop(key)) {
+        popped.emplace_back(key.paramText());
+    }
+    if (popped != expected) {
+        return fail("Unexpected pop order for cost-ranked queue");
+    }
+    return 0;
+}
+
+int testFifoWithoutCost() {
+    wolvrix::lib::ingest::PlanTaskQueue queue;
+    queue.reset();
+    for (int i = 0; i < 8; ++i) {
+        queue.push(makeKey(std::to_string(i)));
+    }
+    wolvrix::lib::ingest::PlanKey key;
+    for (int i = 0; i < 8; ++i) {
+        if (!queue.tryPop(key) || key.paramText() != std::to_string(i)) {
+            return fail("Expected FIFO order among equal costs");
+        }
+    }
+    if (queue.size() != 0) {
+        return fail("Expected empty queue after popping all keys");
+    }
+    return 0;
+}
+
+int testCloseAndDrain() {
+    wolvrix::lib::ingest::PlanTaskQueue queue;
+    queue.reset();
+    queue.push(makeKey("a"), 1);
+    queue.push(makeKey("b"), 2);
+    if (queue.drain() != 2) {
+        return fail("Expected drain to drop two keys");
+    }
+    queue.close();
+    if (queue.tryPush(makeKey("c"), 3)) {
+        return fail("Expected push into closed queue to fail");
+    }
+    wolvrix::lib::ingest::PlanKey key;
+    if (queue.waitPop(key)) {
+        return fail("Expected waitPop on closed empty queue to return false");
+    }
+    return 0;
+}
+
+} // namespace
+
+int main() {
+    if (int result = testCostOrder(); result != 0) {
+        return result;
+    }
+    if (int result = testFifoWithoutCost(); result != 0) {
+        return result;
+    }
+    if (int result = testCloseAndDrain(); result != 0) {
+        return result;
+    }
+    return 0;
+}
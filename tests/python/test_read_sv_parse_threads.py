@@ -0,0 +1,100 @@
+"""read_sv(parse_threads=...) must not change the converted design, only how it is parsed."""
+
+import sys
+import tempfile
+from pathlib import Path
+
+import wolvrix
+
+# Each file only uses macros it defines itself: per-file compilation units (parse_threads != 1)
+# and the single unit (parse_threads == 1) must then agree.
+SOURCES = {
+    "top.sv": """
+`define TOP_WIDTH 8
+module parse_threads_top(input logic clk, input logic [`TOP_WIDTH-1:0] a, output logic [`TOP_WIDTH-1:0] y);
+  logic [`TOP_WIDTH-1:0] left_y;
+  logic [`TOP_WIDTH-1:0] right_y;
+  parse_threads_left #(.W(`TOP_WIDTH)) u_left(.clk(clk), .a(a), .y(left_y));
+  parse_threads_right u_right(.a(left_y), .y(right_y));
+  assign y = left_y ^ right_y;
+endmodule
+""",
+    "left.sv": """
+`define LEFT_STEP 3
+module parse_threads_left #(parameter int W = 4)(input logic clk, input logic [W-1:0] a, output logic [W-1:0] y);
+  always_ff @(posedge clk) y <= a + `LEFT_STEP;
+endmodule
+""",
+    "right.sv": """
+`define RIGHT_MASK 8'h5a
+module parse_threads_right(input logic [7:0] a, output logic [7:0] y);
+  assign y = a & `RIGHT_MASK;
+endmodule
+""",
+}
+
+# Uses a macro defined in another file: only the single compilation unit sees it.
+CROSS_FILE_SOURCES = {
+    "defs.sv": "`define SHARED_WIDTH 4\n",
+    "user.sv": "module parse_threads_cross(input logic [`SHARED_WIDTH-1:0] a, output logic [`SHARED_WIDTH-1:0] y);\n"
+    "  assign y = ~a;\nendmodule\n",
+}
+
+
+def fail(message: str) -> int:
+    print(f"[read-sv-parse-threads] {message}", file=sys.stderr)
+    return 1
+
+
+def write_sources(root: Path, sources: dict[str, str]) -> list[str]:
+    paths = []
+    for name, text in sources.items():
+        path = root / name
+        path.write_text(text)
+        paths.append(str(path))
+    return paths
+
+
+def convert(files: list[str], top: str, threads: int) -> str:
+    design, _ = wolvrix.read_sv(
+        None,
+        files + ["--top", top],
+        log_level="off",
+        diagnostics="warn",
+        parse_threads=threads,
+        print_diagnostics_level="off",
+    )
+    return design.to_json(mode="compact")
+
+
+def main() -> int:
+    with tempfile.TemporaryDirectory() as tmp:
+        root = Path(tmp)
+        files = write_sources(root, SOURCES)
+        serial = convert(files, "parse_threads_top", 1)
+        for threads in (0, 2, 4):
+            if convert(files, "parse_threads_top", threads) != serial:
+                return fail(f"stored JSON differs between parse_threads=1 and parse_threads={threads}")
+
+        cross_root = root / "cross"
+        cross_root.mkdir()
+        cross_files = write_sources(cross_root, CROSS_FILE_SOURCES)
+        convert(cross_files, "parse_threads_cross", 1)
+        try:
+            convert(cross_files, "parse_threads_cross", 4)
+        except Exception:
+            pass
+        else:
+            return fail("expected a macro from another file to be undefined with parse_threads=4")
+
+    try:
+        wolvrix.read_sv(None, [], parse_threads=-1)
+    except ValueError:
+        pass
+    else:
+        return fail("expected parse_threads=-1 to raise ValueError")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
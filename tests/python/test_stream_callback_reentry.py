@@ -0,0 +1,66 @@
+"""Callbacks streaming events of a run must not re-enter the design being processed."""
+
+import sys
+
+import wolvrix
+
+# One graph is enough: the stats pass reports it as an info diagnostic.
+DESIGN_JSON = """
+{
+  "graphs": [
+    {
+      "symbol": "reentry_top",
+      "declaredSymbols": [],
+      "vals": [
+        {"sym": "a", "w": 4, "sgn": false, "type": "logic", "in": true, "out": false, "inout": false, "users": [{"op": "assign0", "idx": 0}]},
+        {"sym": "y", "w": 4, "sgn": false, "type": "logic", "in": false, "out": true, "inout": false, "def": "assign0", "users": []}
+      ],
+      "ports": {"in": [{"name": "a", "val": "a"}], "out": [{"name": "y", "val": "y"}], "inout": []},
+      "ops": [{"sym": "assign0", "kind": "kAssign", "in": ["a"], "out": ["y"]}]
+    }
+  ],
+  "aliases": {},
+  "declaredSymbols": [],
+  "tops": ["reentry_top"]
+}
+"""
+
+
+def fail(message: str) -> int:
+    print(f"[stream-callback-reentry] {message}", file=sys.stderr)
+    return 1
+
+
+def main() -> int:
+    design = wolvrix.from_json_string(DESIGN_JSON)
+    other = wolvrix.from_json_string(DESIGN_JSON)
+    for dryrun in (False, True):
+        outcomes = []
+
+        def on_diagnostic(_diag: dict) -> None:
+            try:
+                design.to_json()
+            except RuntimeError:
+                outcomes.append("raised")
+            else:
+                outcomes.append("returned")
+            # Other designs stay usable from the callback.
+            other.to_json()
+
+        design.run_pass(
+            "stats",
+            dryrun=dryrun,
+            diagnostics="info",
+            log_level="off",
+            on_diagnostic=on_diagnostic,
+        )
+        if not outcomes or set(outcomes) != {"raised"}:
+            return fail(f"expected re-entry to raise RuntimeError (dryrun={dryrun}), got {outcomes}")
+
+    # The design is usable again once the streaming call has returned.
+    design.to_json()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,358 @@
+#include "core/grh.hpp"
+#include "core/load.hpp"
+#include "core/store.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace wolvrix::lib::grh;
+using namespace wolvrix::lib::load;
+using namespace wolvrix::lib::store;
+
+namespace
+{
+
+    int fail(const std::string &message)
+    {
+        std::cerr << "[store_grhb] " << message << '\n';
+        return 1;
+    }
+
+    template <typename Func>
+    bool expectThrows(Func &&func)
+    {
+        try
+        {
+            func();
+        }
+        catch (const std::exception &)
+        {
+            return true;
+        }
+        return false;
+    }
+
+    std::string storeCompact(const Design &design)
+    {
+        StoreJson store;
+        StoreOptions options;
+        options.jsonMode = JsonPrintMode::Compact;
+        auto text = store.storeToString(design, options);
+        if (!text)
+        {
+            throw std::runtime_error("StoreJson failed");
+        }
+        return *text;
+    }
+
+    SrcLoc makeSrcLoc(uint32_t line)
+    {
+        SrcLoc loc;
+        loc.file = "top.sv";
+        loc.line = line;
+        loc.column = 3;
+        loc.endLine = line;
+        loc.endColumn = 17;
+        loc.origin = "ingest";
+        loc.note = "generated";
+        return loc;
+    }
+
+    void buildLeaf(Graph &graph, bool freeze)
+    {
+        ValueId a = graph.createValue(graph.internSymbol("a"), 8, false);
+        ValueId b = graph.createValue(graph.internSymbol("b"), 8, true);
+        ValueId y = graph.createValue(graph.internSymbol("y"), 8, false);
+        ValueId scratch = graph.createValue(graph.internSymbol("scratch"), 1, false);
+        graph.bindInputPort("a", a);
+        graph.bindInputPort("b", b);
+        graph.bindOutputPort("y", y);
+        graph.setValueSrcLoc(a, makeSrcLoc(4));
+
+        ValueId ioIn = graph.createValue(graph.internSymbol("io_in"), 1, false);
+        ValueId ioOut = graph.createValue(graph.internSymbol("io_out"), 1, false);
+        ValueId ioOe = graph.createValue(graph.internSymbol("io_oe"), 1, false);
+        graph.bindInoutPort("io", ioIn, ioOut, ioOe);
+
+        OperationId add = graph.createOperation(OperationKind::kAdd, graph.internSymbol("add0"));
+        graph.addOperand(add, a);
+        graph.addOperand(add, b);
+        ValueId sum = graph.createValue(graph.internSymbol("sum"), 8, false);
+        graph.addResult(add, sum);
+        graph.setOpSrcLoc(add, makeSrcLoc(9));
+        graph.setAttr(add, "flag", AttributeValue(true));
+        graph.setAttr(add, "weight", AttributeValue(int64_t{-42}));
+        graph.setAttr(add, "ratio", AttributeValue(0.25));
+        graph.setAttr(add, "label", AttributeValue(std::string("adder")));
+        graph.setAttr(add, "mask", AttributeValue(std::vector<bool>{true, false, true}));
+        graph.setAttr(add, "widths", AttributeValue(std::vector<int64_t>{1, 2, 3}));
+        graph.setAttr(add, "scales", AttributeValue(std::vector<double>{1.5, -2.0}));
+        graph.setAttr(add, "names", AttributeValue(std::vector<std::string>{"x", "", "a"}));
+
+        OperationId dead = graph.createOperation(OperationKind::kNot, graph.internSymbol("dead0"));
+        graph.addOperand(dead, sum);
+        graph.addResult(dead, scratch);
+
+        OperationId assign = graph.createOperation(OperationKind::kAssign, graph.internSymbol("assign0"));
+        graph.addOperand(assign, sum);
+        graph.addResult(assign, y);
+
+        // Erasing leaves holes that the stored section must not expose.
+        graph.eraseOp(dead);
+        graph.eraseValue(scratch);
+        graph.addDeclaredSymbol(graph.lookupSymbol("sum"));
+        if (freeze)
+        {
+            graph.freeze();
+        }
+    }
+
+    // Large enough that its grhb image outgrows the first shared-memory mapping.
+    Design buildChainDesign(std::size_t graphCount, std::size_t opsPerGraph)
+    {
+        Design design;
+        for (std::size_t g = 0; g < graphCount; ++g)
+        {
+            Graph &graph = design.createGraph("chain" + std::to_string(g));
+            ValueId prev = graph.createValue(graph.internSymbol("in"), 32, false);
+            graph.bindInputPort("in", prev);
+            for (std::size_t i = 0; i < opsPerGraph; ++i)
+            {
+                const std::string suffix = std::to_string(i);
+                ValueId next = graph.createValue(graph.internSymbol("v" + suffix), 32, false);
+                OperationId op = graph.createOperation(OperationKind::kAssign, graph.internSymbol("a" + suffix));
+                graph.addOperand(op, prev);
+                graph.addResult(op, next);
+                prev = next;
+            }
+            graph.bindOutputPort("out", prev);
+            if (g == 0)
+            {
+                design.markAsTop(graph.symbol());
+            }
+        }
+        return design;
+    }
+
+    Design buildDesign()
+    {
+        Design design;
+        Graph &top = design.createGraph("top");
+        buildLeaf(top, false);
+        Graph &leaf = design.createGraph("leaf");
+        buildLeaf(leaf, true);
+        design.createGraph("empty");
+        design.registerGraphAlias("top_alias", top);
+        design.registerGraphAlias("leaf_alias", leaf);
+        design.addDeclaredSymbol(design.internSymbol("top"));
+        design.markAsTop("top");
+        return design;
+    }
+
+} // namespace
+
+#ifndef WOLF_SV_EMIT_ARTIFACT_DIR
+#error "WOLF_SV_EMIT_ARTIFACT_DIR must be defined"
+#endif
+
+int main()
+{
+    try
+    {
+        Design design = buildDesign();
+        const std::string expected = storeCompact(design);
+
+        // Case 1: in-memory round trip is lossless and independent of thread count.
+        StoreJson jsonStore;
+        StoreGrhb grhbStore;
+        StoreOptions serialOptions;
+        serialOptions.threadCount = 1;
+        StoreOptions parallelOptions;
+        parallelOptions.threadCount = 4;
+        const std::optional<std::string> serialBytes = grhbStore.storeToString(design, serialOptions);
+        const std::optional<std::string> parallelBytes = grhbStore.storeToString(design, parallelOptions);
+        if (!serialBytes || !parallelBytes)
+        {
+            return fail("StoreGrhb::storeToString failed");
+        }
+        if (*serialBytes != *parallelBytes)
+        {
+            return fail("grhb bytes depend on the thread count");
+        }
+        for (std::size_t threads : {std::size_t{1}, std::size_t{4}})
+        {
+            Design loaded = LoadGrhb(threads).load(*serialBytes);
+            if (storeCompact(loaded) != expected)
+            {
+                return fail("grhb round trip changed the design");
+            }
+            const Graph *leaf = loaded.findGraph("leaf");
+            if (!leaf || !leaf->frozen())
+            {
+                return fail("Loaded graphs should be frozen");
+            }
+            if (!leaf->findValue("sum").valid() || leaf->findValue("scratch").valid())
+            {
+                return fail("Loaded graph symbol index is wrong");
+            }
+            if (loaded.findGraph("leaf_alias") != leaf || loaded.topGraphs() != std::vector<std::string>{"top"})
+            {
+                return fail("Aliases or tops were not restored");
+            }
+        }
+
+        // Case 2: file store and mmap load, then edit the loaded graph.
+        StoreOptions fileOptions;
+        fileOptions.outputDir = std::string(WOLF_SV_EMIT_ARTIFACT_DIR);
+        fileOptions.outputFilename = "store_grhb.grhb";
+        StoreResult result = grhbStore.store(design, fileOptions);
+        if (!result.success || result.artifacts.empty())
+        {
+            return fail("StoreGrhb::store failed");
+        }
+        Design fromFile = LoadGrhb().loadFile(result.artifacts.front());
+        if (storeCompact(fromFile) != expected)
+        {
+            return fail("grhb file round trip changed the design");
+        }
+        Graph *top = fromFile.findGraph("top");
+        OperationId add = top->findOperation("add0");
+        top->setAttr(add, "label", AttributeValue(std::string("edited")));
+        if (storeCompact(fromFile).find("edited") == std::string::npos)
+        {
+            return fail("Loaded graph cannot be edited");
+        }
+
+        // Case 3: single graphs can be decoded without touching the others.
+        GrhbArchive archive = GrhbArchive::open(result.artifacts.front());
+        if (archive.graphCount() != 3 || archive.graphName(0) != "top")
+        {
+            return fail("grhb graph index is wrong");
+        }
+        const std::optional<std::size_t> leafIndex = archive.findGraph("leaf");
+        if (!leafIndex || archive.findGraph("missing"))
+        {
+            return fail("GrhbArchive::findGraph is wrong");
+        }
+        Design partial;
+        archive.loadGraph(partial, *leafIndex);
+        archive.loadDesignInfo(partial);
+        if (partial.graphs().size() != 1 || partial.findGraph("leaf_alias") == nullptr ||
+            partial.findGraph("top_alias") != nullptr || !partial.topGraphs().empty())
+        {
+            return fail("Partial grhb load pulled in unrelated graphs");
+        }
+        partial.markAsTop("leaf");
+        if (storeCompact(partial).find("\"adder\"") == std::string::npos)
+        {
+            return fail("Partially loaded graph lost its attributes");
+        }
+
+        // Case 4: lazy load decodes graphs on first access and stores untouched ones verbatim.
+        Design lazy = LoadGrhb().loadLazy(result.artifacts.front());
+        if (lazy.graphOrder().size() != 3 || lazy.isGraphLoaded("top") || lazy.isGraphLoaded("leaf") ||
+            lazy.topGraphs() != std::vector<std::string>{"top"} || lazy.peekGraph("leaf_alias") == nullptr)
+        {
+            return fail("Lazy load should register graphs without decoding them");
+        }
+        Design lazyClone = lazy.clone();
+        Graph *lazyTop = lazy.findGraph("top_alias");
+        if (!lazyTop || !lazy.isGraphLoaded("top") || lazy.isGraphLoaded("leaf") ||
+            lazyClone.isGraphLoaded("top"))
+        {
+            return fail("findGraph should load exactly the requested graph");
+        }
+        if (!lazyTop->findOperation("add0").valid() || lazy.unloadedGrhbSection("top"))
+        {
+            return fail("Lazily loaded graph is incomplete");
+        }
+        lazyTop->setAttr(lazyTop->findOperation("add0"), "label", AttributeValue(std::string("lazy")));
+        const std::optional<std::string> lazyBytes = grhbStore.storeToString(lazy, serialOptions);
+        if (!lazyBytes || lazy.isGraphLoaded("leaf"))
+        {
+            return fail("Storing a lazy design should not load untouched graphs");
+        }
+        const GrhbArchive lazyArchive(*lazyBytes);
+        if (lazyArchive.graphSection(*leafIndex) != archive.graphSection(*leafIndex) ||
+            lazyArchive.graphSection(0) == archive.graphSection(0))
+        {
+            return fail("Untouched graphs should be copied through verbatim");
+        }
+        const std::string lazyJson = storeCompact(lazy);
+        if (!lazy.isGraphLoaded("leaf") || lazyJson != storeCompact(LoadGrhb().load(*lazyBytes)) ||
+            lazyJson.find("\"lazy\"") == std::string::npos)
+        {
+            return fail("Lazy design differs from its stored form");
+        }
+        if (storeCompact(lazyClone) != expected || !lazyClone.isGraphLoaded("leaf"))
+        {
+            return fail("Clone of a lazy design should load from the shared archive");
+        }
+        Design lazyDelete = LoadGrhb().loadLazy(result.artifacts.front());
+        if (!lazyDelete.deleteGraph("empty") || lazyDelete.graphs().size() != 2 || !lazyDelete.isGraphLoaded("leaf"))
+        {
+            return fail("Deleting an unloaded lazy graph failed");
+        }
+
+        // Case 5: a design published in shared memory attaches lazily.
+        const std::string shmName = "/wolvrix-test-" + std::to_string(::getpid());
+        ::shm_unlink(shmName.c_str());
+        if (!grhbStore.storeToSharedMemory(design, shmName, serialOptions) ||
+            grhbStore.storeToSharedMemory(design, shmName, serialOptions))
+        {
+            ::shm_unlink(shmName.c_str());
+            return fail("storeToSharedMemory should create the object exactly once");
+        }
+        Design attached = LoadGrhb().loadLazy(GrhbArchive::openSharedMemory(shmName));
+        ::shm_unlink(shmName.c_str());
+        if (attached.isGraphLoaded("top") || storeCompact(attached) != expected)
+        {
+            return fail("Shared-memory design differs from the original");
+        }
+
+        Design chain = buildChainDesign(16, 4096);
+        const std::optional<std::string> chainBytes = grhbStore.storeToString(chain, parallelOptions);
+        if (!chainBytes || chainBytes->size() <= (std::size_t{1} << 20) ||
+            !grhbStore.storeToSharedMemory(chain, shmName, parallelOptions))
+        {
+            ::shm_unlink(shmName.c_str());
+            return fail("storeToSharedMemory failed for a multi-megabyte design");
+        }
+        Design chainAttached = LoadGrhb().loadLazy(GrhbArchive::openSharedMemory(shmName));
+        ::shm_unlink(shmName.c_str());
+        if (grhbStore.storeToString(chainAttached, parallelOptions) != chainBytes)
+        {
+            return fail("Shared-memory image differs from storeToString");
+        }
+
+        // Case 6: corrupted containers are rejected.
+        std::string badMagic = *serialBytes;
+        badMagic[0] = 'X';
+        std::string truncated = serialBytes->substr(0, serialBytes->size() - 8);
+        std::string badSection = *serialBytes;
+        badSection[64] = '\x7f';
+        if (!expectThrows([&] { LoadGrhb().load(badMagic); }) ||
+            !expectThrows([&] { LoadGrhb().load(truncated); }) ||
+            !expectThrows([&] { LoadGrhb().load(badSection); }))
+        {
+            return fail("Corrupted grhb data should throw");
+        }
+        if (!expectThrows([&] { LoadGrhb().load(std::string_view()); }))
+        {
+            return fail("Empty grhb data should throw");
+        }
+    }
+    catch (const std::exception &ex)
+    {
+        return fail(std::string("Unexpected exception: ") + ex.what());
+    }
+    return 0;
+}
@@ -4,7 +4,9 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <optional>
 #include <string>
+#include <thread>
 
 using namespace wolvrix::lib::store;
 using namespace wolvrix::lib::grh;
@@ -54,12 +56,38 @@ namespace
         return design;
     }
 
+    Design buildWideDesign(std::size_t graphCount)
+    {
+        Design design;
+        for (std::size_t i = graphCount; i-- > 0;)
+        {
+            Graph &graph = design.createGraph("g" + std::to_string(i));
+            ValueId in = graph.createValue(graph.internSymbol("in"), static_cast<int32_t>(i % 16 + 1), false);
+            graph.bindInputPort("in", in);
+            ValueId out = graph.createValue(graph.internSymbol("out"), static_cast<int32_t>(i % 16 + 1), false);
+            graph.bindOutputPort("out", out);
+            OperationId assign = graph.createOperation(OperationKind::kAssign, graph.internSymbol("assign0"));
+            graph.addOperand(assign, in);
+            graph.addResult(assign, out);
+            graph.setAttr(assign, "index", AttributeValue(static_cast<int64_t>(i)));
+            if (i == 0)
+            {
+                design.markAsTop(graph.symbol());
+            }
+        }
+        return design;
+    }
+
 } // namespace
 
 #ifndef WOLF_SV_EMIT_ARTIFACT_DIR
 #error "WOLF_SV_EMIT_ARTIFACT_DIR must be defined"
 #endif
 
+#ifndef WOLF_SV_STORE_TEST_DATA_DIR
+#error "WOLF_SV_STORE_TEST_DATA_DIR must be defined"
+#endif
+
 int main()
 {
     // Case 1: missing top graphs should fail gracefully.
@@ -162,5 +190,85 @@ int main()
         return fail("Compact JSON should not contain newlines");
     }
 
+    // Case 4: graph serialization, serial or parallel, in memory or streamed to a file, must
+    // reproduce byte for byte what the single-writer store produced before graphs were
+    // serialized separately; the golden files were written by that store.
+    Design wideDesign = buildWideDesign(37);
+    for (JsonPrintMode mode : {JsonPrintMode::Compact, JsonPrintMode::PrettyCompact})
+    {
+        const std::string golden = readFile(std::filesystem::path(WOLF_SV_STORE_TEST_DATA_DIR) /
+                                            (mode == JsonPrintMode::Compact ? "store_json_wide_compact.json"
+                                                                            : "store_json_wide_pretty_compact.json"));
+        if (golden.empty())
+        {
+            return fail("Missing golden JSON for wide design");
+        }
+        StoreOptions serialOptions;
+        serialOptions.jsonMode = mode;
+        serialOptions.threadCount = 1;
+        StoreOptions parallelOptions = serialOptions;
+        parallelOptions.threadCount = 4;
+
+        StoreJson emitterSerial;
+        StoreJson emitterParallel;
+        const std::optional<std::string> serialJson = emitterSerial.storeToString(wideDesign, serialOptions);
+        const std::optional<std::string> parallelJson = emitterParallel.storeToString(wideDesign, parallelOptions);
+        if (!serialJson || !parallelJson)
+        {
+            return fail("storeToString failed for wide design");
+        }
+        if (*serialJson != golden)
+        {
+            return fail("Serial graph serialization differs from the single-writer golden output");
+        }
+        if (*parallelJson != golden)
+        {
+            return fail("Parallel graph serialization differs from the single-writer golden output");
+        }
+
+        parallelOptions.outputDir = std::string(WOLF_SV_EMIT_ARTIFACT_DIR);
+        parallelOptions.outputFilename = "grh_wide.json";
+        StoreResult wideResult = emitterParallel.store(wideDesign, parallelOptions);
+        if (!wideResult.success || wideResult.artifacts.empty())
+        {
+            return fail("Parallel emit failed for wide design");
+        }
+        if (readFile(wideResult.artifacts.front()) != golden)
+        {
+            return fail("Streamed JSON file differs from the single-writer golden output");
+        }
+        Design reparsed = Design::fromJsonString(*serialJson);
+        if (reparsed.graphs().size() != 37 || !reparsed.findGraph("g36"))
+        {
+            return fail("Wide design did not round-trip");
+        }
+    }
+
+    // Case 5: two stores may share one edited (unfrozen) design once its lazily built graph
+    // lists are filled; this is what the Python bindings do under a shared lock.
+    {
+        const std::optional<std::string> expected = StoreJson().storeToString(buildWideDesign(37), StoreOptions{});
+        Design shared = buildWideDesign(37);
+        shared.prepareConcurrentReads();
+        std::optional<std::string> outputs[2];
+        std::thread workers[2];
+        for (std::size_t t = 0; t < 2; ++t)
+        {
+            workers[t] = std::thread([&, t]() {
+                StoreOptions options;
+                options.threadCount = 2;
+                outputs[t] = StoreJson().storeToString(shared, options);
+            });
+        }
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+        if (!expected || outputs[0] != expected || outputs[1] != expected)
+        {
+            return fail("Concurrent stores of one design differ from a single store");
+        }
+    }
+
     return 0;
 }
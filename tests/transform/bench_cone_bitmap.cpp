@@ -0,0 +1,140 @@
+#include "transform/cone_bitmap.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+
+    using wolvrix::lib::transform::detail::ConeBitmap;
+
+    int fail(const std::string &message)
+    {
+        std::cerr << "[cone-bitmap-bench] " << message << '\n';
+        return 1;
+    }
+
+    uint64_t msSince(std::chrono::steady_clock::time_point start)
+    {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    // Synthetic wide datapath: `width` lanes by `depth` stages, op (stage, lane) reads
+    // (stage - 1, lane) and (stage - 1, lane + 1). Each last-stage op is a sink, so neighbouring
+    // cones overlap heavily, as they do for a real datapath.
+    struct WideDatapath
+    {
+        std::size_t width = 0;
+        std::size_t depth = 0;
+
+        uint32_t opIndex(std::size_t stage, std::size_t lane) const
+        {
+            return static_cast<uint32_t>(stage * width + (lane % width));
+        }
+
+        std::vector<uint32_t> cone(std::size_t lane) const
+        {
+            std::vector<uint32_t> ids;
+            for (std::size_t stage = 0; stage < depth; ++stage)
+            {
+                const std::size_t span = depth - stage;
+                for (std::size_t offset = 0; offset < span && offset < width; ++offset)
+                {
+                    ids.push_back(opIndex(stage, lane + offset));
+                }
+            }
+            return ids;
+        }
+    };
+
+    int benchmarkWideDatapath()
+    {
+        const WideDatapath datapath{2048, 48};
+        const std::size_t opCount = datapath.width * datapath.depth;
+        // Eighths add up exactly, so both summation orders give the same overlap.
+        std::vector<double> weights(opCount);
+        for (std::size_t i = 0; i < opCount; ++i)
+        {
+            weights[i] = 1.0 + static_cast<double>(i % 7) / 8.0;
+        }
+
+        const auto hashStart = std::chrono::steady_clock::now();
+        std::vector<std::unordered_set<uint32_t>> hashCones(datapath.width);
+        std::size_t hashBytes = 0;
+        for (std::size_t lane = 0; lane < datapath.width; ++lane)
+        {
+            const std::vector<uint32_t> ids = datapath.cone(lane);
+            hashCones[lane].insert(ids.begin(), ids.end());
+            hashBytes += hashCones[lane].bucket_count() * sizeof(void *) +
+                         hashCones[lane].size() * (sizeof(uint32_t) + 2 * sizeof(void *));
+        }
+        std::unordered_set<uint32_t> hashA;
+        std::unordered_set<uint32_t> hashB;
+        for (std::size_t lane = 0; lane < datapath.width; ++lane)
+        {
+            auto &side = (lane % 2 == 0) ? hashA : hashB;
+            side.insert(hashCones[lane].begin(), hashCones[lane].end());
+        }
+        double hashOverlap = 0.0;
+        for (const uint32_t id : hashA)
+        {
+            if (hashB.find(id) != hashB.end())
+            {
+                hashOverlap += weights[id];
+            }
+        }
+        const uint64_t hashMs = msSince(hashStart);
+
+        const auto bitmapStart = std::chrono::steady_clock::now();
+        std::vector<ConeBitmap> bitmapCones(datapath.width);
+        std::size_t bitmapBytes = 0;
+        for (std::size_t lane = 0; lane < datapath.width; ++lane)
+        {
+            std::vector<uint32_t> ids = datapath.cone(lane);
+            std::sort(ids.begin(), ids.end());
+            bitmapCones[lane] = ConeBitmap::fromSorted(ids);
+            bitmapBytes += bitmapCones[lane].memoryBytes();
+        }
+        ConeBitmap bitmapA;
+        ConeBitmap bitmapB;
+        for (std::size_t lane = 0; lane < datapath.width; ++lane)
+        {
+            ((lane % 2 == 0) ? bitmapA : bitmapB).unionWith(bitmapCones[lane]);
+        }
+        double bitmapOverlap = 0.0;
+        bitmapA.forEachIntersection(bitmapB, [&](uint32_t id) { bitmapOverlap += weights[id]; });
+        const uint64_t bitmapMs = msSince(bitmapStart);
+
+        if (bitmapA.size() != hashA.size() || bitmapB.size() != hashB.size())
+        {
+            return fail("wide datapath: union sizes differ from the hash-set reference");
+        }
+        if (bitmapOverlap != hashOverlap)
+        {
+            return fail("wide datapath: weighted overlap differs from the hash-set reference");
+        }
+
+        std::cout << "[cone-bitmap-bench] wide_datapath lanes=" << datapath.width
+                  << " stages=" << datapath.depth
+                  << " ops=" << opCount
+                  << " overlap=" << bitmapOverlap
+                  << " hash_ms=" << hashMs
+                  << " hash_cone_bytes=" << hashBytes
+                  << " bitmap_ms=" << bitmapMs
+                  << " bitmap_cone_bytes=" << bitmapBytes << '\n';
+        return 0;
+    }
+
+} // namespace
+
+int main()
+{
+    return benchmarkWideDatapath();
+}
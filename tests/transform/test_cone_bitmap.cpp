@@ -0,0 +1,199 @@
+#include "transform/cone_bitmap.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+
+    using wolvrix::lib::transform::detail::ConeBitmap;
+
+    int fail(const std::string &message)
+    {
+        std::cerr << "[cone-bitmap-tests] " << message << '\n';
+        return 1;
+    }
+
+    std::vector<uint32_t> collectIds(const ConeBitmap &bitmap)
+    {
+        std::vector<uint32_t> out;
+        bitmap.forEach([&](uint32_t id) { out.push_back(id); });
+        return out;
+    }
+
+    // Wide datapath: `width` lanes by `depth` stages, op (stage, lane) reads (stage - 1, lane) and
+    // (stage - 1, lane + 1). Each last-stage op is a sink, so neighbouring cones overlap heavily.
+    // bench_cone_bitmap.cpp times the same shape at full size.
+    struct WideDatapath
+    {
+        std::size_t width = 0;
+        std::size_t depth = 0;
+
+        uint32_t opIndex(std::size_t stage, std::size_t lane) const
+        {
+            return static_cast<uint32_t>(stage * width + (lane % width));
+        }
+
+        std::vector<uint32_t> cone(std::size_t lane) const
+        {
+            std::vector<uint32_t> ids;
+            for (std::size_t stage = 0; stage < depth; ++stage)
+            {
+                const std::size_t span = depth - stage;
+                for (std::size_t offset = 0; offset < span && offset < width; ++offset)
+                {
+                    ids.push_back(opIndex(stage, lane + offset));
+                }
+            }
+            return ids;
+        }
+    };
+
+    // Unions even and odd lanes and compares the sizes and the overlap with a hash-set reference.
+    int checkWideDatapath()
+    {
+        const WideDatapath datapath{256, 12};
+        std::unordered_set<uint32_t> hashA;
+        std::unordered_set<uint32_t> hashB;
+        ConeBitmap bitmapA;
+        ConeBitmap bitmapB;
+        for (std::size_t lane = 0; lane < datapath.width; ++lane)
+        {
+            std::vector<uint32_t> ids = datapath.cone(lane);
+            ((lane % 2 == 0) ? hashA : hashB).insert(ids.begin(), ids.end());
+            std::sort(ids.begin(), ids.end());
+            ((lane % 2 == 0) ? bitmapA : bitmapB).unionWith(ConeBitmap::fromSorted(ids));
+        }
+        std::vector<uint32_t> hashOverlap;
+        for (const uint32_t id : hashA)
+        {
+            if (hashB.count(id) != 0)
+            {
+                hashOverlap.push_back(id);
+            }
+        }
+        std::sort(hashOverlap.begin(), hashOverlap.end());
+        std::vector<uint32_t> bitmapOverlap;
+        bitmapA.forEachIntersection(bitmapB, [&](uint32_t id) { bitmapOverlap.push_back(id); });
+        if (bitmapA.size() != hashA.size() || bitmapB.size() != hashB.size())
+        {
+            return fail("wide datapath: union sizes differ from the hash-set reference");
+        }
+        if (bitmapOverlap != hashOverlap)
+        {
+            return fail("wide datapath: overlap differs from the hash-set reference");
+        }
+        return 0;
+    }
+
+} // namespace
+
+int main()
+{
+    {
+        ConeBitmap bitmap;
+        if (!bitmap.empty() || bitmap.size() != 0)
+        {
+            return fail("new ConeBitmap should be empty");
+        }
+        if (!bitmap.insert(70000) || !bitmap.insert(3) || bitmap.insert(3))
+        {
+            return fail("insert() should report only new ids");
+        }
+        if (!bitmap.contains(3) || !bitmap.contains(70000) || bitmap.contains(4) || bitmap.contains(65539))
+        {
+            return fail("contains() mismatch across containers");
+        }
+        if (collectIds(bitmap) != std::vector<uint32_t>({3, 70000}))
+        {
+            return fail("forEach() should visit ids in ascending order");
+        }
+    }
+
+    {
+        // Crossing the array limit turns a container into words without losing ids.
+        ConeBitmap bitmap;
+        std::set<uint32_t> expected;
+        for (uint32_t i = 0; i < ConeBitmap::kArrayLimit + 100; ++i)
+        {
+            const uint32_t id = (i * 13u) % 65536u;
+            bitmap.insert(id);
+            expected.insert(id);
+        }
+        if (bitmap.size() != expected.size())
+        {
+            return fail("size() mismatch after promotion to words");
+        }
+        if (collectIds(bitmap) != std::vector<uint32_t>(expected.begin(), expected.end()))
+        {
+            return fail("forEach() mismatch after promotion to words");
+        }
+    }
+
+    {
+        std::mt19937 rng(7);
+        for (int round = 0; round < 20; ++round)
+        {
+            // Mix sparse and dense containers on both sides.
+            const uint32_t range = (round % 2 == 0) ? 200000u : 20000u;
+            const std::size_t lhsCount = (round % 3 == 0) ? 9000 : 300;
+            const std::size_t rhsCount = (round % 4 == 0) ? 12000 : 500;
+            std::uniform_int_distribution<uint32_t> dist(0, range);
+            std::set<uint32_t> lhsRef;
+            std::set<uint32_t> rhsRef;
+            while (lhsRef.size() < lhsCount)
+            {
+                lhsRef.insert(dist(rng));
+            }
+            while (rhsRef.size() < rhsCount)
+            {
+                rhsRef.insert(dist(rng));
+            }
+            ConeBitmap lhs = ConeBitmap::fromSorted(std::vector<uint32_t>(lhsRef.begin(), lhsRef.end()));
+            ConeBitmap rhs;
+            for (const uint32_t id : rhsRef)
+            {
+                rhs.insert(id);
+            }
+
+            std::vector<uint32_t> common;
+            for (const uint32_t id : lhsRef)
+            {
+                if (rhsRef.count(id) != 0)
+                {
+                    common.push_back(id);
+                }
+            }
+            std::vector<uint32_t> seen;
+            lhs.forEachIntersection(rhs, [&](uint32_t id) { seen.push_back(id); });
+            if (seen != common || lhs.intersectionSize(rhs) != common.size() ||
+                rhs.intersectionSize(lhs) != common.size())
+            {
+                return fail("intersection mismatch in round " + std::to_string(round));
+            }
+
+            std::set<uint32_t> unionRef = lhsRef;
+            unionRef.insert(rhsRef.begin(), rhsRef.end());
+            lhs.unionWith(rhs);
+            if (lhs.size() != unionRef.size() ||
+                collectIds(lhs) != std::vector<uint32_t>(unionRef.begin(), unionRef.end()))
+            {
+                return fail("union mismatch in round " + std::to_string(round));
+            }
+        }
+    }
+
+    if (const int rc = checkWideDatapath(); rc != 0)
+    {
+        return rc;
+    }
+
+    return 0;
+}
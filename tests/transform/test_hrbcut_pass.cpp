@@ -0,0 +1,176 @@
+#include "core/grh.hpp"
+#include "core/transform.hpp"
+#include "transform/hrbcut.hpp"
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace wolvrix::lib::transform;
+
+namespace
+{
+
+    int fail(const std::string &message)
+    {
+        std::cerr << "[hrbcut-tests] " << message << '\n';
+        return 1;
+    }
+
+    wolvrix::lib::grh::ValueId makeValue(wolvrix::lib::grh::Graph &graph,
+                                         const std::string &name,
+                                         int32_t width = 8,
+                                         bool isSigned = false)
+    {
+        return graph.createValue(graph.internSymbol(name), width, isSigned);
+    }
+
+    void makeBinaryOp(wolvrix::lib::grh::Graph &graph,
+                      wolvrix::lib::grh::OperationKind kind,
+                      const std::string &name,
+                      wolvrix::lib::grh::ValueId lhs,
+                      wolvrix::lib::grh::ValueId rhs,
+                      wolvrix::lib::grh::ValueId out)
+    {
+        const auto op = graph.createOperation(kind, graph.internSymbol(name));
+        graph.addOperand(op, lhs);
+        graph.addOperand(op, rhs);
+        graph.addResult(op, out);
+    }
+
+    // Latch sinks fed by short add/mul chains; neighbouring sinks share one stage so that
+    // splits have overlap to minimize.
+    void populateHrbcutDesign(wolvrix::lib::grh::Design &design, const std::string &topName, int sinkCount)
+    {
+        wolvrix::lib::grh::Graph &graph = design.createGraph(topName);
+        const auto inA = makeValue(graph, "a");
+        const auto inB = makeValue(graph, "b");
+        const auto en = makeValue(graph, "en", 1, false);
+        graph.bindInputPort("a", inA);
+        graph.bindInputPort("b", inB);
+        graph.bindInputPort("en", en);
+
+        std::vector<wolvrix::lib::grh::ValueId> stages;
+        for (int i = 0; i < sinkCount; ++i)
+        {
+            const std::string suffix = std::to_string(i);
+            const auto stage = makeValue(graph, "stage_" + suffix);
+            makeBinaryOp(graph,
+                         (i % 3 == 0) ? wolvrix::lib::grh::OperationKind::kMul : wolvrix::lib::grh::OperationKind::kAdd,
+                         "stage_op_" + suffix,
+                         inA,
+                         (i % 2 == 0) ? inB : inA,
+                         stage);
+            stages.push_back(stage);
+        }
+        for (int i = 0; i < sinkCount; ++i)
+        {
+            const std::string suffix = std::to_string(i);
+            const auto data = makeValue(graph, "wr_data_" + suffix);
+            makeBinaryOp(graph,
+                         wolvrix::lib::grh::OperationKind::kAdd,
+                         "mix_op_" + suffix,
+                         stages[i],
+                         stages[(i + 1) % sinkCount],
+                         data);
+
+            const std::string latchName = "lat_" + suffix;
+            const auto latchDecl =
+                graph.createOperation(wolvrix::lib::grh::OperationKind::kLatch, graph.internSymbol(latchName));
+            graph.setAttr(latchDecl, "width", static_cast<int64_t>(8));
+            graph.setAttr(latchDecl, "isSigned", false);
+            const auto writeOp = graph.createOperation(wolvrix::lib::grh::OperationKind::kLatchWritePort,
+                                                       graph.internSymbol(latchName + "_wr"));
+            graph.addOperand(writeOp, en);
+            graph.addOperand(writeOp, data);
+            graph.setAttr(writeOp, "latchSymbol", latchName);
+        }
+        design.markAsTop(topName);
+    }
+
+    struct HrbcutRun
+    {
+        bool success = false;
+        std::string stats;
+        std::size_t instanceCount = 0;
+    };
+
+    HrbcutRun runHrbcut(const HrbcutOptions &options, int sinkCount)
+    {
+        HrbcutRun run;
+        wolvrix::lib::grh::Design design;
+        populateHrbcutDesign(design, options.targetGraphSymbol, sinkCount);
+        PassManager manager;
+        manager.options().verbosity = PassVerbosity::Info;
+        manager.addPass(std::make_unique<HrbcutPass>(options));
+        PassDiagnostics diags;
+        const PassManagerResult result = manager.run(design, diags);
+        run.success = result.success && !diags.hasError();
+        for (const auto &diag : diags.messages())
+        {
+            if (diag.kind == PassDiagnosticKind::Info && diag.message.find("\"partition_weights\"") != std::string::npos)
+            {
+                run.stats = diag.message;
+            }
+        }
+        if (const auto *top = design.findGraph(options.targetGraphSymbol))
+        {
+            for (const auto opId : top->operations())
+            {
+                if (top->getOperation(opId).kind() == wolvrix::lib::grh::OperationKind::kInstance)
+                {
+                    ++run.instanceCount;
+                }
+            }
+        }
+        return run;
+    }
+
+} // namespace
+
+int main()
+{
+    constexpr int kSinkCount = 40;
+    HrbcutOptions options;
+    options.targetGraphSymbol = "top";
+    options.partitionCount = 3;
+    options.balanceThreshold = 0.2;
+    options.maxTrials = 16;
+    options.splitStopThreshold = 2;
+
+    // Non-power-of-two counts are split unevenly (1 + 2 parts at the root).
+    options.threads = 1;
+    const HrbcutRun serial = runHrbcut(options, kSinkCount);
+    if (!serial.success)
+    {
+        return fail("hrbcut with partition_count=3 failed");
+    }
+    if (serial.stats.find("\"partition_count\":3") == std::string::npos || serial.instanceCount != 3)
+    {
+        return fail("expected three partitions, got stats: " + serial.stats);
+    }
+
+    // The split tree and its trials run on a pool; the result must not depend on its size.
+    options.threads = 4;
+    const HrbcutRun parallel = runHrbcut(options, kSinkCount);
+    if (!parallel.success || parallel.stats != serial.stats)
+    {
+        return fail("hrbcut result differs between 1 and 4 threads:\n" + serial.stats + "\n" + parallel.stats);
+    }
+
+    options.partitionCount = 5;
+    const HrbcutRun five = runHrbcut(options, kSinkCount);
+    if (!five.success || five.instanceCount != 5)
+    {
+        return fail("expected five partitions for partition_count=5");
+    }
+
+    options.partitionCount = 0;
+    if (runHrbcut(options, kSinkCount).success)
+    {
+        return fail("expected an error for partition_count=0");
+    }
+
+    return 0;
+}
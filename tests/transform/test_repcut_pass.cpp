@@ -1,13 +1,19 @@
 #include "core/grh.hpp"
+#include "core/store.hpp"
 #include "core/transform.hpp"
 #include "transform/repcut.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <optional>
+#include <sstream>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 using namespace wolvrix::lib::transform;
@@ -93,6 +99,215 @@ namespace
         design.markAsTop(topName);
     }
 
+    // Two shared signals of very different widths: a 256-bit sum read by sinks 0-3 and a 1-bit
+    // AND read by sinks 4-7. Unit weighting gives both hyperedges weight 1; comm weighting must
+    // weigh the wide one by its 32-bit words.
+    void populateMixedWidthRepcutDesign(wolvrix::lib::grh::Design &design, const std::string &topName)
+    {
+        wolvrix::lib::grh::Graph &graph = design.createGraph(topName);
+
+        const auto wideA = makeValue(graph, "wide_a", 256);
+        const auto wideB = makeValue(graph, "wide_b", 256);
+        const auto narrowA = makeValue(graph, "narrow_a", 1);
+        const auto narrowB = makeValue(graph, "narrow_b", 1);
+        const auto en = makeValue(graph, "en", 1, false);
+        graph.bindInputPort("wide_a", wideA);
+        graph.bindInputPort("wide_b", wideB);
+        graph.bindInputPort("narrow_a", narrowA);
+        graph.bindInputPort("narrow_b", narrowB);
+        graph.bindInputPort("en", en);
+
+        const auto wideShared = makeValue(graph, "wide_shared", 256);
+        makeBinaryOp(graph, wolvrix::lib::grh::OperationKind::kAdd, "wide_shared_add", wideA, wideB, wideShared);
+        const auto narrowShared = makeValue(graph, "narrow_shared", 1);
+        makeBinaryOp(graph, wolvrix::lib::grh::OperationKind::kAnd, "narrow_shared_and", narrowA, narrowB,
+                     narrowShared);
+
+        constexpr int kSinkCount = 8;
+        for (int i = 0; i < kSinkCount; ++i)
+        {
+            const std::string suffix = std::to_string(i);
+            const bool wide = i < kSinkCount / 2;
+            const int32_t width = wide ? 256 : 1;
+            const auto datav = makeValue(graph, "wr_data_" + suffix, width);
+            makeBinaryOp(graph, (i % 2 == 0) ? wolvrix::lib::grh::OperationKind::kAdd
+                                             : wolvrix::lib::grh::OperationKind::kSub,
+                         "sink_op_" + suffix, wide ? wideShared : narrowShared, wide ? wideA : narrowA, datav);
+
+            const std::string latchName = "lat_" + suffix;
+            const auto latchDecl = graph.createOperation(wolvrix::lib::grh::OperationKind::kLatch,
+                                                         graph.internSymbol(latchName));
+            graph.setAttr(latchDecl, "width", static_cast<int64_t>(width));
+            graph.setAttr(latchDecl, "isSigned", false);
+
+            const auto writeOp = graph.createOperation(wolvrix::lib::grh::OperationKind::kLatchWritePort,
+                                                       graph.internSymbol(latchName + "_wr"));
+            graph.addOperand(writeOp, en);
+            graph.addOperand(writeOp, datav);
+            graph.setAttr(writeOp, "latchSymbol", latchName);
+        }
+
+        design.markAsTop(topName);
+    }
+
+    // A memory read feeds one node of a two-node combinational cycle: x = mem[addr] + y and
+    // y = x - a, with output ports on x and then y. The memoized walk enters the cycle at x, so
+    // y's cone does not see the memory and out_y stays out of the memory write's ASC; with
+    // complete cycle summaries it joins it. Two independent outputs keep the graph partitionable.
+    void populateCyclicMemoryRepcutDesign(wolvrix::lib::grh::Design &design, const std::string &topName)
+    {
+        wolvrix::lib::grh::Graph &graph = design.createGraph(topName);
+
+        const auto inA = makeValue(graph, "a");
+        const auto addr = makeValue(graph, "addr", 4);
+        const auto wen = makeValue(graph, "wen", 1);
+        const auto wdata = makeValue(graph, "wdata");
+        const auto mask = makeValue(graph, "mask");
+        const auto clk = makeValue(graph, "clk", 1);
+        graph.bindInputPort("a", inA);
+        graph.bindInputPort("addr", addr);
+        graph.bindInputPort("wen", wen);
+        graph.bindInputPort("wdata", wdata);
+        graph.bindInputPort("mask", mask);
+        graph.bindInputPort("clk", clk);
+
+        const auto memOp = graph.createOperation(wolvrix::lib::grh::OperationKind::kMemory,
+                                                 graph.internSymbol("mem"));
+        graph.setAttr(memOp, "width", static_cast<int64_t>(8));
+        graph.setAttr(memOp, "row", static_cast<int64_t>(16));
+        graph.setAttr(memOp, "isSigned", false);
+
+        const auto memWrite = graph.createOperation(wolvrix::lib::grh::OperationKind::kMemoryWritePort,
+                                                    graph.internSymbol("mem_write"));
+        graph.setAttr(memWrite, "memSymbol", std::string("mem"));
+        graph.setAttr(memWrite, "eventEdge", std::vector<std::string>{"posedge"});
+        graph.addOperand(memWrite, wen);
+        graph.addOperand(memWrite, addr);
+        graph.addOperand(memWrite, wdata);
+        graph.addOperand(memWrite, mask);
+        graph.addOperand(memWrite, clk);
+
+        const auto memData = makeValue(graph, "mem_data");
+        const auto memRead = graph.createOperation(wolvrix::lib::grh::OperationKind::kMemoryReadPort,
+                                                   graph.internSymbol("mem_read"));
+        graph.setAttr(memRead, "memSymbol", std::string("mem"));
+        graph.addOperand(memRead, addr);
+        graph.addResult(memRead, memData);
+
+        const auto loopX = makeValue(graph, "loop_x");
+        const auto loopY = makeValue(graph, "loop_y");
+        makeBinaryOp(graph, wolvrix::lib::grh::OperationKind::kAdd, "loop_add", memData, loopY, loopX);
+        makeBinaryOp(graph, wolvrix::lib::grh::OperationKind::kSub, "loop_sub", loopX, inA, loopY);
+        graph.bindOutputPort("out_x", loopX);
+        graph.bindOutputPort("out_y", loopY);
+
+        for (int i = 0; i < 2; ++i)
+        {
+            const auto aux = makeValue(graph, "aux_" + std::to_string(i));
+            makeBinaryOp(graph, i == 0 ? wolvrix::lib::grh::OperationKind::kAdd
+                                       : wolvrix::lib::grh::OperationKind::kXor,
+                         "aux_op_" + std::to_string(i), inA, wdata, aux);
+            graph.bindOutputPort("aux_" + std::to_string(i), aux);
+        }
+
+        design.markAsTop(topName);
+    }
+
+    struct HmetisFile
+    {
+        // {weight, pins...} per hyperedge line.
+        std::vector<std::vector<uint64_t>> edges;
+        std::vector<uint64_t> nodeWeights;
+    };
+
+    HmetisFile readHmetis(const std::filesystem::path &path)
+    {
+        std::ifstream stream(path);
+        std::string line;
+        std::size_t edgeCount = 0;
+        std::size_t nodeCount = 0;
+        HmetisFile file;
+        if (!std::getline(stream, line) || !(std::istringstream(line) >> edgeCount >> nodeCount))
+        {
+            return file;
+        }
+        while (file.edges.size() < edgeCount && std::getline(stream, line))
+        {
+            std::istringstream fields(line);
+            std::vector<uint64_t> edge;
+            for (uint64_t field = 0; fields >> field;)
+            {
+                edge.push_back(field);
+            }
+            file.edges.push_back(std::move(edge));
+        }
+        for (uint64_t weight = 0; file.nodeWeights.size() < nodeCount && stream >> weight;)
+        {
+            file.nodeWeights.push_back(weight);
+        }
+        return file;
+    }
+
+    // Enough sinks and graph nodes that every phase-b stage splits into several chunks. Each
+    // latch is fed by a two-stage chain shared with its neighbour, and a combinational cycle
+    // feeds every 64th sink so that cone summaries go through a multi-node SCC.
+    void populateLargeRepcutDesign(wolvrix::lib::grh::Design &design, const std::string &topName, int sinkCount)
+    {
+        wolvrix::lib::grh::Graph &graph = design.createGraph(topName);
+
+        const auto inA = makeValue(graph, "a");
+        const auto inB = makeValue(graph, "b");
+        const auto en = makeValue(graph, "en", 1, false);
+        graph.bindInputPort("a", inA);
+        graph.bindInputPort("b", inB);
+        graph.bindInputPort("en", en);
+
+        const auto loopX = makeValue(graph, "loop_x");
+        const auto loopY = makeValue(graph, "loop_y");
+        makeBinaryOp(graph, wolvrix::lib::grh::OperationKind::kAdd, "loop_add", inA, loopY, loopX);
+        makeBinaryOp(graph, wolvrix::lib::grh::OperationKind::kSub, "loop_sub", loopX, inB, loopY);
+
+        std::vector<wolvrix::lib::grh::ValueId> stages;
+        stages.reserve(static_cast<std::size_t>(sinkCount));
+        for (int i = 0; i < sinkCount; ++i)
+        {
+            const std::string suffix = std::to_string(i);
+            const auto stage = makeValue(graph, "stage_" + suffix);
+            makeBinaryOp(graph,
+                         (i % 3 == 0) ? wolvrix::lib::grh::OperationKind::kMul : wolvrix::lib::grh::OperationKind::kAdd,
+                         "stage_op_" + suffix,
+                         inA,
+                         (i % 64 == 0) ? loopY : ((i % 2 == 0) ? inB : inA),
+                         stage);
+            stages.push_back(stage);
+        }
+        for (int i = 0; i < sinkCount; ++i)
+        {
+            const std::string suffix = std::to_string(i);
+            const auto datav = makeValue(graph, "wr_data_" + suffix);
+            makeBinaryOp(graph,
+                         wolvrix::lib::grh::OperationKind::kAdd,
+                         "mix_op_" + suffix,
+                         stages[static_cast<std::size_t>(i)],
+                         stages[static_cast<std::size_t>((i + 1) % sinkCount)],
+                         datav);
+
+            const std::string latchName = "lat_" + suffix;
+            const auto latchDecl = graph.createOperation(wolvrix::lib::grh::OperationKind::kLatch,
+                                                         graph.internSymbol(latchName));
+            graph.setAttr(latchDecl, "width", static_cast<int64_t>(8));
+            graph.setAttr(latchDecl, "isSigned", false);
+
+            const auto writeOp = graph.createOperation(wolvrix::lib::grh::OperationKind::kLatchWritePort,
+                                                       graph.internSymbol(latchName + "_wr"));
+            graph.addOperand(writeOp, en);
+            graph.addOperand(writeOp, datav);
+            graph.setAttr(writeOp, "latchSymbol", latchName);
+        }
+
+        design.markAsTop(topName);
+    }
+
     std::filesystem::path findNativePartitionFile(const std::filesystem::path &outDir, std::string_view prefix)
     {
         std::error_code ec;
@@ -1039,6 +1254,682 @@ int main()
         return fail("expected child_repcut_part0 graph after path-mode repcut");
     }
 
+    // Sweep mode: phases a-c run once, every candidate count is scored, and the graph is left
+    // untouched unless -sweep-rebuild-best is given.
+    wolvrix::lib::grh::Design sweepDesign;
+    populateBasicRepcutDesign(sweepDesign, "top_sweep");
+    const std::filesystem::path sweepOutDir = std::filesystem::path(WOLF_SV_TEST_ARTIFACT_DIR) / "repcut_test_sweep";
+    std::filesystem::create_directories(sweepOutDir, ec);
+    if (ec)
+    {
+        return fail("failed to create output directory: " + sweepOutDir.string());
+    }
+
+    RepcutOptions sweepOptions;
+    sweepOptions.path = "top_sweep";
+    sweepOptions.imbalanceFactor = 1.0;
+    sweepOptions.workDir = sweepOutDir.string();
+    sweepOptions.partitioner = "mt-kahypar";
+    sweepOptions.sweepPartitionCounts = {3, 2};
+
+    PassManager sweepManager;
+    sweepManager.options().verbosity = PassVerbosity::Info;
+    sweepManager.addPass(std::make_unique<RepcutPass>(sweepOptions));
+    PassDiagnostics sweepDiags;
+    PassManagerResult sweepResult{};
+    try
+    {
+        sweepResult = sweepManager.run(sweepDesign, sweepDiags);
+    }
+    catch (const std::exception &ex)
+    {
+        return fail(std::string("sweep repcut exception: ") + ex.what());
+    }
+    if (!sweepResult.success || sweepDiags.hasError())
+    {
+        return fail("sweep repcut failed unexpectedly");
+    }
+    if (sweepResult.changed || hasGraphWithPrefix(sweepDesign, "top_sweep_repcut_part"))
+    {
+        return fail("sweep repcut without rebuild should not change the design");
+    }
+    std::string sweepReport;
+    for (const auto &diag : sweepDiags.messages())
+    {
+        if (diag.message.find("\"mode\":\"sweep\"") != std::string::npos)
+        {
+            sweepReport = diag.message;
+        }
+    }
+    if (sweepReport.find("\"partition_count\":2") == std::string::npos ||
+        sweepReport.find("\"partition_count\":3") == std::string::npos ||
+        sweepReport.find("\"predicted_step_cost\":") == std::string::npos ||
+        sweepReport.find("\"best_partition_count\":") == std::string::npos)
+    {
+        return fail("expected sweep report with one entry per candidate count");
+    }
+
+    wolvrix::lib::grh::Design sweepRebuildDesign;
+    populateBasicRepcutDesign(sweepRebuildDesign, "top_sweep");
+    sweepOptions.sweepRebuildBest = true;
+    PassManager sweepRebuildManager;
+    sweepRebuildManager.options().verbosity = PassVerbosity::Info;
+    sweepRebuildManager.addPass(std::make_unique<RepcutPass>(sweepOptions));
+    PassDiagnostics sweepRebuildDiags;
+    PassManagerResult sweepRebuildResult{};
+    try
+    {
+        sweepRebuildResult = sweepRebuildManager.run(sweepRebuildDesign, sweepRebuildDiags);
+    }
+    catch (const std::exception &ex)
+    {
+        return fail(std::string("sweep rebuild repcut exception: ") + ex.what());
+    }
+    if (!sweepRebuildResult.success || sweepRebuildDiags.hasError())
+    {
+        return fail("sweep rebuild repcut failed unexpectedly");
+    }
+    if (!sweepRebuildResult.changed || !hasGraphWithPrefix(sweepRebuildDesign, "top_sweep_repcut_part0"))
+    {
+        return fail("expected sweep rebuild to partition top_sweep");
+    }
+
+    // Cache: a second run on an unchanged graph goes from phase-a straight to the rebuild and
+    // must produce the same partition graphs.
+    const std::filesystem::path cacheOutDir = std::filesystem::path(WOLF_SV_TEST_ARTIFACT_DIR) / "repcut_test_cache";
+    std::filesystem::remove_all(cacheOutDir, ec);
+    std::filesystem::create_directories(cacheOutDir, ec);
+    if (ec)
+    {
+        return fail("failed to create output directory: " + cacheOutDir.string());
+    }
+    RepcutOptions cacheOptions;
+    cacheOptions.path = "top_cache";
+    cacheOptions.partitionCount = 2;
+    cacheOptions.imbalanceFactor = 1.0;
+    cacheOptions.workDir = cacheOutDir.string();
+    cacheOptions.partitioner = "mt-kahypar";
+    cacheOptions.cache = true;
+    auto runCached = [&](wolvrix::lib::grh::Design &currentDesign, std::vector<std::string> &logs) -> bool {
+        PassManager cacheManager;
+        cacheManager.options().verbosity = PassVerbosity::Info;
+        cacheManager.options().logLevel = wolvrix::lib::LogLevel::Info;
+        cacheManager.options().logSink = [&](wolvrix::lib::LogLevel, std::string_view, std::string_view message) {
+            logs.emplace_back(message);
+        };
+        cacheManager.addPass(std::make_unique<RepcutPass>(cacheOptions));
+        PassDiagnostics cacheDiags;
+        const PassManagerResult cacheResult = cacheManager.run(currentDesign, cacheDiags);
+        return cacheResult.success && cacheResult.changed && !cacheDiags.hasError();
+    };
+    wolvrix::lib::grh::Design cacheDesign1;
+    wolvrix::lib::grh::Design cacheDesign2;
+    populateBasicRepcutDesign(cacheDesign1, "top_cache");
+    populateBasicRepcutDesign(cacheDesign2, "top_cache");
+    std::vector<std::string> cacheLogs1;
+    std::vector<std::string> cacheLogs2;
+    if (!runCached(cacheDesign1, cacheLogs1) || !runCached(cacheDesign2, cacheLogs2))
+    {
+        return fail("cached repcut runs failed unexpectedly");
+    }
+    auto sawLog = [](const std::vector<std::string> &logs, std::string_view needle) {
+        for (const auto &message : logs)
+        {
+            if (message.find(needle) != std::string::npos)
+            {
+                return true;
+            }
+        }
+        return false;
+    };
+    if (!sawLog(cacheLogs1, "hit=false") || !sawLog(cacheLogs2, "hit=true") ||
+        !sawLog(cacheLogs2, "reused cached partition k=2") || sawLog(cacheLogs2, "repcut phase-b: begin build_ascs"))
+    {
+        return fail("expected the second repcut run to reuse the cached phase-b/c results");
+    }
+    if (cacheDesign1.graphOrder() != cacheDesign2.graphOrder())
+    {
+        return fail("cached repcut run produced different graphs");
+    }
+    for (const auto &graphName : cacheDesign1.graphOrder())
+    {
+        const wolvrix::lib::grh::Graph *lhs = cacheDesign1.findGraph(graphName);
+        const wolvrix::lib::grh::Graph *rhs = cacheDesign2.findGraph(graphName);
+        if (lhs == nullptr || rhs == nullptr || lhs->operations().size() != rhs->operations().size() ||
+            lhs->values().size() != rhs->values().size() ||
+            lhs->inputPorts().size() != rhs->inputPorts().size() ||
+            lhs->outputPorts().size() != rhs->outputPorts().size())
+        {
+            return fail("cached repcut run rebuilt graph differently: " + graphName);
+        }
+    }
+
+    // Cache header: magic, version, byte order mark, graph hash, node count, then the sink count
+    // and each sink as {u8 kind, u32 index, u32 generation}.
+    constexpr std::size_t kCacheMarkOffset = 4 + sizeof(uint32_t);
+    constexpr std::size_t kCacheSinkCountOffset = kCacheMarkOffset + sizeof(uint32_t) + 2 * sizeof(uint64_t);
+    constexpr std::size_t kCacheFirstSinkIndexOffset = kCacheSinkCountOffset + sizeof(uint64_t) + sizeof(uint8_t);
+    const std::filesystem::path cacheFile = cacheOutDir / "top_cache.repcut-cache";
+    const std::string cachedBytes = readFile(cacheFile);
+    uint64_t cachedSinkCount = 0;
+    if (cachedBytes.size() >= kCacheFirstSinkIndexOffset + sizeof(uint32_t))
+    {
+        std::memcpy(&cachedSinkCount, cachedBytes.data() + kCacheSinkCountOffset, sizeof(cachedSinkCount));
+    }
+    if (cachedBytes.compare(0, 4, "RCUT") != 0 || cachedSinkCount == 0 ||
+        cachedSinkCount > (cachedBytes.size() - kCacheSinkCountOffset) / 9)
+    {
+        return fail("unexpected repcut cache header in " + cacheFile.string());
+    }
+
+    // A cache written with the other byte order is not read: the run rebuilds and rewrites it.
+    {
+        std::string cacheBytes = cachedBytes;
+        std::reverse(cacheBytes.begin() + kCacheMarkOffset, cacheBytes.begin() + kCacheMarkOffset + sizeof(uint32_t));
+        std::ofstream(cacheFile, std::ios::binary | std::ios::trunc) << cacheBytes;
+        wolvrix::lib::grh::Design swappedDesign;
+        populateBasicRepcutDesign(swappedDesign, "top_cache");
+        std::vector<std::string> swappedLogs;
+        if (!runCached(swappedDesign, swappedLogs) || !sawLog(swappedLogs, "hit=false") ||
+            readFile(cacheFile) != cachedBytes)
+        {
+            return fail("expected a repcut cache with a swapped byte order mark to be rebuilt");
+        }
+    }
+
+    // A cache whose hash still matches but whose sinks no longer do must fail the run instead of
+    // rebuilding from stale pieces.
+    {
+        std::string cacheBytes = cachedBytes;
+        cacheBytes[kCacheFirstSinkIndexOffset] = static_cast<char>(cacheBytes[kCacheFirstSinkIndexOffset] + 1);
+        std::ofstream(cacheFile, std::ios::binary | std::ios::trunc) << cacheBytes;
+        wolvrix::lib::grh::Design staleDesign;
+        populateBasicRepcutDesign(staleDesign, "top_cache");
+        PassManager staleManager;
+        staleManager.addPass(std::make_unique<RepcutPass>(cacheOptions));
+        PassDiagnostics staleDiags;
+        staleManager.run(staleDesign, staleDiags);
+        if (!staleDiags.hasError() || !diagnosticsContain(staleDiags, "matches the graph hash but not the graph"))
+        {
+            return fail("expected a stale repcut cache to be rejected");
+        }
+    }
+
+    // Phase-b threads: ASCs, pieces and the hypergraph stored in the cache must not depend on
+    // how many threads built them, with either cycle summary. The design is large enough for 4
+    // threads to get work.
+    for (const bool sccCones : {false, true})
+    {
+        std::vector<std::string> threadCaches;
+        for (const std::size_t threads : {std::size_t{1}, std::size_t{4}})
+        {
+            const std::filesystem::path threadOutDir =
+                std::filesystem::path(WOLF_SV_TEST_ARTIFACT_DIR) /
+                ("repcut_test_phase_b_threads_" + std::to_string(threads) + (sccCones ? "_scc" : ""));
+            std::filesystem::remove_all(threadOutDir, ec);
+            std::filesystem::create_directories(threadOutDir, ec);
+            if (ec)
+            {
+                return fail("failed to create output directory: " + threadOutDir.string());
+            }
+            wolvrix::lib::grh::Design threadDesign;
+            populateLargeRepcutDesign(threadDesign, "top_threads", 3000);
+            RepcutOptions threadOptions = cacheOptions;
+            threadOptions.path = "top_threads";
+            threadOptions.workDir = threadOutDir.string();
+            threadOptions.phaseBThreads = threads;
+            threadOptions.phaseBSccCones = sccCones;
+            PassManager threadManager;
+            threadManager.addPass(std::make_unique<RepcutPass>(threadOptions));
+            PassDiagnostics threadDiags;
+            const PassManagerResult threadResult = threadManager.run(threadDesign, threadDiags);
+            if (!threadResult.success || threadDiags.hasError())
+            {
+                return fail("repcut with phase-b threads=" + std::to_string(threads) + " failed unexpectedly");
+            }
+            threadCaches.push_back(readFile(threadOutDir / "top_threads.repcut-cache"));
+        }
+        if (threadCaches[0].empty() || threadCaches[0] != threadCaches[1])
+        {
+            return fail("expected phase-b results to be identical across thread counts");
+        }
+    }
+
+    // Combinational cycle through a memory read: by default phase-b keeps the sink-order walk,
+    // so the hypergraph is the one the serial implementation produced before phase-b ran in
+    // parallel (4 ASCs: {mem_write, out_x}, {out_y}, {aux_0}, {aux_1}, no cut pieces). With
+    // -phase-b-scc-cones out_y sees the memory through the cycle and joins its ASC.
+    const std::pair<bool, std::string_view> cyclicCases[] = {
+        {false, "0 4 11\n3\n10\n2\n1\n"},
+        {true, "1 3 11\n1 1\n3\n2\n1\n"},
+    };
+    for (const auto &[sccCones, expectedHgr] : cyclicCases)
+    {
+        for (const std::size_t threads : {std::size_t{1}, std::size_t{4}})
+        {
+            const std::filesystem::path cyclicOutDir =
+                std::filesystem::path(WOLF_SV_TEST_ARTIFACT_DIR) /
+                ("repcut_test_cyclic_" + std::to_string(threads) + (sccCones ? "_scc" : ""));
+            std::filesystem::remove_all(cyclicOutDir, ec);
+            std::filesystem::create_directories(cyclicOutDir, ec);
+            if (ec)
+            {
+                return fail("failed to create output directory: " + cyclicOutDir.string());
+            }
+            wolvrix::lib::grh::Design cyclicDesign;
+            populateCyclicMemoryRepcutDesign(cyclicDesign, "top_cyclic");
+            RepcutOptions cyclicOptions;
+            cyclicOptions.path = "top_cyclic";
+            cyclicOptions.partitionCount = 2;
+            cyclicOptions.imbalanceFactor = 1.0;
+            cyclicOptions.workDir = cyclicOutDir.string();
+            cyclicOptions.partitioner = "mt-kahypar";
+            cyclicOptions.keepIntermediateFiles = true;
+            cyclicOptions.phaseBThreads = threads;
+            cyclicOptions.phaseBSccCones = sccCones;
+            PassManager cyclicManager;
+            cyclicManager.addPass(std::make_unique<RepcutPass>(cyclicOptions));
+            PassDiagnostics cyclicDiags;
+            const PassManagerResult cyclicResult = cyclicManager.run(cyclicDesign, cyclicDiags);
+            if (!cyclicResult.success || cyclicDiags.hasError())
+            {
+                return fail("cyclic repcut failed unexpectedly");
+            }
+            if (readFile(cyclicOutDir / "top_cyclic_repcut_k2.hgr") != expectedHgr)
+            {
+                return fail(std::string("unexpected cyclic hypergraph with phase-b-scc-cones=") +
+                            (sccCones ? "true" : "false") + " threads=" + std::to_string(threads));
+            }
+        }
+    }
+
+    // Phase-e threads: partition graphs built concurrently must match the serial rebuild.
+    std::vector<std::string> phaseEDesigns;
+    for (const std::size_t threads : {std::size_t{1}, std::size_t{4}})
+    {
+        const std::filesystem::path phaseEOutDir = std::filesystem::path(WOLF_SV_TEST_ARTIFACT_DIR) /
+                                                   ("repcut_test_phase_e_threads_" + std::to_string(threads));
+        std::filesystem::remove_all(phaseEOutDir, ec);
+        std::filesystem::create_directories(phaseEOutDir, ec);
+        if (ec)
+        {
+            return fail("failed to create output directory: " + phaseEOutDir.string());
+        }
+        wolvrix::lib::grh::Design phaseEDesign;
+        populateBasicRepcutDesign(phaseEDesign, "top_phase_e");
+        RepcutOptions phaseEOptions;
+        phaseEOptions.path = "top_phase_e";
+        phaseEOptions.partitionCount = 3;
+        phaseEOptions.imbalanceFactor = 1.0;
+        phaseEOptions.workDir = phaseEOutDir.string();
+        phaseEOptions.partitioner = "mt-kahypar";
+        phaseEOptions.phaseEThreads = threads;
+        PassManager phaseEManager;
+        phaseEManager.addPass(std::make_unique<RepcutPass>(phaseEOptions));
+        PassDiagnostics phaseEDiags;
+        const PassManagerResult phaseEResult = phaseEManager.run(phaseEDesign, phaseEDiags);
+        if (!phaseEResult.success || !phaseEResult.changed || phaseEDiags.hasError())
+        {
+            return fail("repcut with phase-e threads=" + std::to_string(threads) + " failed unexpectedly");
+        }
+        const std::optional<std::string> stored =
+            wolvrix::lib::store::StoreJson().storeToString(phaseEDesign, wolvrix::lib::store::StoreOptions{});
+        if (!stored)
+        {
+            return fail("failed to store the phase-e rebuild");
+        }
+        phaseEDesigns.push_back(*stored);
+    }
+    if (phaseEDesigns[0] != phaseEDesigns[1])
+    {
+        return fail("expected phase-e partition graphs to be identical across thread counts");
+    }
+
+    // Edge weighting: the comm weighting partitions and rebuilds like the default one, and the
+    // comparison report lists the predicted traffic of every weighting.
+    wolvrix::lib::grh::Design weightingDesign;
+    populateBasicRepcutDesign(weightingDesign, "top_weighting");
+    const std::filesystem::path weightingOutDir =
+        std::filesystem::path(WOLF_SV_TEST_ARTIFACT_DIR) / "repcut_test_weighting";
+    std::filesystem::create_directories(weightingOutDir, ec);
+    if (ec)
+    {
+        return fail("failed to create output directory: " + weightingOutDir.string());
+    }
+    RepcutOptions weightingOptions;
+    weightingOptions.path = "top_weighting";
+    weightingOptions.partitionCount = 2;
+    weightingOptions.imbalanceFactor = 1.0;
+    weightingOptions.workDir = weightingOutDir.string();
+    weightingOptions.partitioner = "mt-kahypar";
+    weightingOptions.edgeWeighting = "comm";
+    weightingOptions.compareEdgeWeighting = true;
+    PassManager weightingManager;
+    weightingManager.options().verbosity = PassVerbosity::Info;
+    weightingManager.addPass(std::make_unique<RepcutPass>(weightingOptions));
+    PassDiagnostics weightingDiags;
+    PassManagerResult weightingResult{};
+    try
+    {
+        weightingResult = weightingManager.run(weightingDesign, weightingDiags);
+    }
+    catch (const std::exception &ex)
+    {
+        return fail(std::string("edge weighting repcut exception: ") + ex.what());
+    }
+    if (!weightingResult.success || !weightingResult.changed || weightingDiags.hasError())
+    {
+        return fail("edge weighting repcut failed unexpectedly");
+    }
+    std::string weightingReport;
+    for (const auto &diag : weightingDiags.messages())
+    {
+        if (diag.message.find("\"mode\":\"edge-weighting\"") != std::string::npos)
+        {
+            weightingReport = diag.message;
+        }
+    }
+    if (weightingReport.find("\"selected\":\"comm\"") == std::string::npos ||
+        weightingReport.find("\"edge_weighting\":\"heuristic\"") == std::string::npos ||
+        weightingReport.find("\"edge_weighting\":\"unit\"") == std::string::npos ||
+        weightingReport.find("\"traffic_bytes\":") == std::string::npos)
+    {
+        return fail("expected edge weighting report with one run per weighting");
+    }
+
+    // On a design with a 256-bit and a 1-bit shared signal the weightings must give different
+    // hyperedge weights: unit leaves every edge at 1, comm weighs the wide edge by its words.
+    std::vector<std::vector<uint64_t>> unitEdges;
+    std::vector<std::vector<uint64_t>> commEdges;
+    for (const std::string_view weighting : {std::string_view("unit"), std::string_view("comm")})
+    {
+        const std::filesystem::path mixedOutDir =
+            std::filesystem::path(WOLF_SV_TEST_ARTIFACT_DIR) / ("repcut_test_weighting_" + std::string(weighting));
+        std::filesystem::remove_all(mixedOutDir, ec);
+        std::filesystem::create_directories(mixedOutDir, ec);
+        if (ec)
+        {
+            return fail("failed to create output directory: " + mixedOutDir.string());
+        }
+        wolvrix::lib::grh::Design mixedDesign;
+        populateMixedWidthRepcutDesign(mixedDesign, "top_mixed");
+        RepcutOptions mixedOptions;
+        mixedOptions.path = "top_mixed";
+        mixedOptions.partitionCount = 2;
+        mixedOptions.imbalanceFactor = 1.0;
+        mixedOptions.workDir = mixedOutDir.string();
+        mixedOptions.partitioner = "mt-kahypar";
+        mixedOptions.keepIntermediateFiles = true;
+        mixedOptions.edgeWeighting = std::string(weighting);
+        PassManager mixedManager;
+        mixedManager.addPass(std::make_unique<RepcutPass>(mixedOptions));
+        PassDiagnostics mixedDiags;
+        const PassManagerResult mixedResult = mixedManager.run(mixedDesign, mixedDiags);
+        if (!mixedResult.success || mixedDiags.hasError())
+        {
+            return fail("mixed-width repcut failed with edge weighting " + std::string(weighting));
+        }
+        (weighting == "unit" ? unitEdges : commEdges) = readHmetis(mixedOutDir / "top_mixed_repcut_k2.hgr").edges;
+    }
+    if (unitEdges.empty() || unitEdges.size() != commEdges.size())
+    {
+        return fail("expected the same hyperedges under unit and comm weighting");
+    }
+    uint64_t maxCommWeight = 0;
+    for (std::size_t i = 0; i < unitEdges.size(); ++i)
+    {
+        if (unitEdges[i].size() < 3 || unitEdges[i].front() != 1 ||
+            !std::equal(unitEdges[i].begin() + 1, unitEdges[i].end(), commEdges[i].begin() + 1, commEdges[i].end()))
+        {
+            return fail("unexpected hyperedge " + std::to_string(i) + " under unit/comm weighting");
+        }
+        maxCommWeight = std::max(maxCommWeight, commEdges[i].front());
+    }
+    if (maxCommWeight < 256 / 32)
+    {
+        return fail("expected comm weighting to weigh the 256-bit hyperedge by its words, max weight " +
+                    std::to_string(maxCommWeight));
+    }
+
+    wolvrix::lib::grh::Design badWeightingDesign;
+    populateBasicRepcutDesign(badWeightingDesign, "top_weighting");
+    weightingOptions.edgeWeighting = "bytes";
+    PassManager badWeightingManager;
+    badWeightingManager.addPass(std::make_unique<RepcutPass>(weightingOptions));
+    PassDiagnostics badWeightingDiags;
+    badWeightingManager.run(badWeightingDesign, badWeightingDiags);
+    if (!badWeightingDiags.hasError())
+    {
+        return fail("expected an error for an unknown edge weighting");
+    }
+
+    // Timing profile: the first run leaves an ASC partition map behind, and a profile of its
+    // parts then rescales the node weights of the matching ASCs in the next run.
+    const std::filesystem::path profileOutDir = std::filesystem::path(WOLF_SV_TEST_ARTIFACT_DIR) / "repcut_test_profile";
+    std::filesystem::remove_all(profileOutDir, ec);
+    std::filesystem::create_directories(profileOutDir, ec);
+    if (ec)
+    {
+        return fail("failed to create output directory: " + profileOutDir.string());
+    }
+    RepcutOptions profileOptions;
+    profileOptions.path = "top_profile";
+    profileOptions.partitionCount = 2;
+    profileOptions.imbalanceFactor = 1.0;
+    profileOptions.workDir = profileOutDir.string();
+    profileOptions.partitioner = "mt-kahypar";
+    auto runProfiled = [&](std::vector<std::string> &logs, PassDiagnostics &diags) -> bool {
+        wolvrix::lib::grh::Design profileDesign;
+        populateBasicRepcutDesign(profileDesign, "top_profile");
+        PassManager profileManager;
+        profileManager.options().verbosity = PassVerbosity::Info;
+        profileManager.options().logLevel = wolvrix::lib::LogLevel::Info;
+        profileManager.options().logSink = [&](wolvrix::lib::LogLevel, std::string_view, std::string_view message) {
+            logs.emplace_back(message);
+        };
+        profileManager.addPass(std::make_unique<RepcutPass>(profileOptions));
+        const PassManagerResult profileResult = profileManager.run(profileDesign, diags);
+        return profileResult.success && profileResult.changed && !diags.hasError();
+    };
+    auto sawWarning = [](const PassDiagnostics &diags, std::string_view needle) {
+        for (const auto &diag : diags.messages())
+        {
+            if (diag.kind == PassDiagnosticKind::Warning && diag.message.find(needle) != std::string::npos)
+            {
+                return true;
+            }
+        }
+        return false;
+    };
+    const std::filesystem::path mapPath = profileOutDir / "top_profile.repcut-asc-parts";
+    std::vector<std::string> defaultLogs;
+    PassDiagnostics defaultDiags;
+    if (!runProfiled(defaultLogs, defaultDiags))
+    {
+        return fail("repcut run before profiling failed unexpectedly");
+    }
+    if (std::filesystem::exists(mapPath))
+    {
+        return fail("expected no asc partition map unless requested");
+    }
+    profileOptions.ascPartitionMap = true;
+    profileOptions.keepIntermediateFiles = true;
+    std::vector<std::string> staticLogs;
+    PassDiagnostics staticDiags;
+    if (!runProfiled(staticLogs, staticDiags))
+    {
+        return fail("repcut run before profiling failed unexpectedly");
+    }
+    if (!std::filesystem::exists(mapPath))
+    {
+        return fail("expected repcut to write the asc partition map");
+    }
+    const std::filesystem::path profileHgrPath = profileOutDir / "top_profile_repcut_k2.hgr";
+    const std::vector<uint64_t> staticNodeWeights = readHmetis(profileHgrPath).nodeWeights;
+    // Map lines follow the ASC order, which is also the hMETIS node order.
+    std::vector<uint32_t> staticAscParts;
+    {
+        std::ifstream map(mapPath);
+        std::string line;
+        while (std::getline(map, line))
+        {
+            if (!line.empty() && line.front() != '#')
+            {
+                staticAscParts.push_back(static_cast<uint32_t>(std::stoul(line.substr(0, line.find('\t')))));
+            }
+        }
+    }
+    if (staticNodeWeights.empty() || staticAscParts.size() != staticNodeWeights.size() ||
+        std::count(staticAscParts.begin(), staticAscParts.end(), 0u) == 0 ||
+        std::count(staticAscParts.begin(), staticAscParts.end(), 1u) == 0)
+    {
+        return fail("expected the asc partition map to cover every ASC and both parts");
+    }
+    // Sum of node weights of the ASCs the static run put into `part`.
+    auto weightOfPart = [&](const std::vector<uint64_t> &weights, uint32_t part) {
+        uint64_t total = 0;
+        for (std::size_t aid = 0; aid < weights.size(); ++aid)
+        {
+            total += staticAscParts[aid] == part ? weights[aid] : 0;
+        }
+        return total;
+    };
+    {
+        std::ofstream map(mapPath, std::ios::app);
+        map << "99999999999\tbogus\n"
+            << "-1\tbogus\n";
+    }
+    const std::filesystem::path profilePath = profileOutDir / "timing.jsonl";
+    {
+        std::ofstream profile(profilePath);
+        profile << "{\"record_type\":\"step_timing_summary\",\"schema_version\":1,\"steps\":10}\n"
+                << "{\"record_type\":\"part_timing\",\"part_name\":\"part_0\",\"eval_avg_us\":\n"
+                << "{\"record_type\":\"part_timing\",\"note\":\"\\\"eval_avg_us\\\":5\",\"part_name\":\"part_1\"}\n"
+                << "{\"record_type\":\"part_timing\",\"schema_version\":1,\"part_name\":\"part_0\","
+                   "\"steps\":10,\"eval_total_ms\":1.0,\"eval_avg_us\":100.0}\n"
+                << "{\"record_type\":\"part_timing\",\"schema_version\":1,\"part_name\":\"part_1\","
+                   "\"steps\":10,\"eval_total_ms\":0.01,\"eval_avg_us\":1.0}\n";
+    }
+    profileOptions.timingProfile = profilePath.string();
+    std::vector<std::string> profileLogs;
+    PassDiagnostics profileDiags;
+    if (!runProfiled(profileLogs, profileDiags))
+    {
+        return fail("profile-guided repcut run failed unexpectedly");
+    }
+    if (!sawLog(profileLogs, "timing_profile=") || sawLog(profileLogs, "matched_ascs=0 ") ||
+        !sawLog(profileLogs, "node_weighting=profile"))
+    {
+        return fail("expected the timing profile to reweight the matched ASCs");
+    }
+    // part_0 measured 100x slower than part_1, so its ASCs must now weigh clearly more than
+    // their static share, relative to part_1's.
+    const std::vector<uint64_t> profiledNodeWeights = readHmetis(profileHgrPath).nodeWeights;
+    if (profiledNodeWeights.size() != staticNodeWeights.size() || profiledNodeWeights == staticNodeWeights ||
+        weightOfPart(profiledNodeWeights, 0) * weightOfPart(staticNodeWeights, 1) <
+            2 * weightOfPart(staticNodeWeights, 0) * weightOfPart(profiledNodeWeights, 1))
+    {
+        return fail("expected the timing profile to shift node weight towards the slow part");
+    }
+    const std::string mapLines = mapPath.string() + ":";
+    if (!sawWarning(profileDiags, "malformed asc partition map line") || !sawWarning(profileDiags, mapLines) ||
+        !sawWarning(profileDiags, "timing.jsonl:2: ") ||
+        !sawWarning(profileDiags, "timing.jsonl:3: malformed part_timing record"))
+    {
+        return fail("expected line-numbered warnings for malformed map and profile lines");
+    }
+
+    // A profile without a single usable part_timing record is rejected, not silently ignored.
+    const std::filesystem::path malformedProfilePath = profileOutDir / "malformed.jsonl";
+    {
+        std::ofstream profile(malformedProfilePath);
+        profile << "{\"record_type\":\"part_timing\",\"part_name\":\"part_0\",\"eval_avg_us\":\n"
+                << "{\"record_type\":\"part_timing\",\"part_name\":\"core0\",\"eval_avg_us\":5.0}\n";
+    }
+    profileOptions.timingProfile = malformedProfilePath.string();
+    std::vector<std::string> malformedLogs;
+    PassDiagnostics malformedDiags;
+    if (runProfiled(malformedLogs, malformedDiags) || !diagnosticsContain(malformedDiags, "no part_timing records"))
+    {
+        return fail("expected an error for a timing profile without valid part_timing records");
+    }
+
+    profileOptions.timingProfile = (profileOutDir / "missing.jsonl").string();
+    std::vector<std::string> missingLogs;
+    PassDiagnostics missingDiags;
+    if (runProfiled(missingLogs, missingDiags) || !missingDiags.hasError())
+    {
+        return fail("expected an error for a missing timing profile");
+    }
+
+    // Hierarchical NUMA mode: two domains of two parts each; every part instance records the
+    // domain its part was cut from.
+    const std::filesystem::path numaOutDir = std::filesystem::path(WOLF_SV_TEST_ARTIFACT_DIR) / "repcut_test_numa";
+    std::filesystem::remove_all(numaOutDir, ec);
+    std::filesystem::create_directories(numaOutDir, ec);
+    if (ec)
+    {
+        return fail("failed to create output directory: " + numaOutDir.string());
+    }
+    RepcutOptions numaOptions;
+    numaOptions.path = "top_numa";
+    numaOptions.partitionCount = 4;
+    numaOptions.imbalanceFactor = 1.0;
+    numaOptions.workDir = numaOutDir.string();
+    numaOptions.partitioner = "mt-kahypar";
+    numaOptions.numaDomains = 2;
+    wolvrix::lib::grh::Design numaDesign;
+    populateBasicRepcutDesign(numaDesign, "top_numa");
+    std::vector<std::string> numaLogs;
+    PassManager numaManager;
+    numaManager.options().verbosity = PassVerbosity::Info;
+    numaManager.options().logLevel = wolvrix::lib::LogLevel::Info;
+    numaManager.options().logSink = [&](wolvrix::lib::LogLevel, std::string_view, std::string_view message) {
+        numaLogs.emplace_back(message);
+    };
+    numaManager.addPass(std::make_unique<RepcutPass>(numaOptions));
+    PassDiagnostics numaDiags;
+    const PassManagerResult numaResult = numaManager.run(numaDesign, numaDiags);
+    if (!numaResult.success || numaDiags.hasError())
+    {
+        return fail("hierarchical repcut run failed unexpectedly");
+    }
+    if (!sawLog(numaLogs, "repcut phase-d numa: domain=1") || !sawLog(numaLogs, "inter_domain_bytes="))
+    {
+        return fail("expected per-domain partitioning and NUMA traffic logs");
+    }
+    const wolvrix::lib::grh::Graph *numaTop = numaDesign.findGraph("top_numa");
+    if (!numaTop)
+    {
+        return fail("top_numa graph missing after hierarchical repcut");
+    }
+    for (std::size_t part = 0; part < numaOptions.partitionCount; ++part)
+    {
+        const auto instId = findInstanceByName(*numaTop, "part_" + std::to_string(part));
+        if (!instId.valid())
+        {
+            return fail("hierarchical repcut missing instance part_" + std::to_string(part));
+        }
+        const auto domainAttr = numaTop->getOperation(instId).attr("repcutNumaDomain");
+        const auto *domain = domainAttr ? std::get_if<int64_t>(&*domainAttr) : nullptr;
+        if (domain == nullptr || *domain != static_cast<int64_t>(part / 2))
+        {
+            return fail("unexpected repcutNumaDomain on part_" + std::to_string(part));
+        }
+    }
+
+    wolvrix::lib::grh::Design badNumaDesign;
+    populateBasicRepcutDesign(badNumaDesign, "top_numa");
+    numaOptions.partitionCount = 3;
+    PassManager badNumaManager;
+    badNumaManager.addPass(std::make_unique<RepcutPass>(numaOptions));
+    PassDiagnostics badNumaDiags;
+    badNumaManager.run(badNumaDesign, badNumaDiags);
+    if (!badNumaDiags.hasError())
+    {
+        return fail("expected an error when partition_count is not a multiple of numa_domains");
+    }
+
     return 0;
 #endif
 }
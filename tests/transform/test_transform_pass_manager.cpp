@@ -430,5 +430,36 @@ int main()
         }
     }
 
+    // Case 8: a diagnostics sink receives messages as they are recorded instead of storing them
+    {
+        PassManager manager;
+        manager.options().verbosity = PassVerbosity::Debug;
+        manager.addPass(std::make_unique<VerbosityEmitter>());
+        std::vector<std::string> order;
+        PassRecord failingRecord;
+        auto failing = std::make_unique<RecordingPass>("diag-fail", failingRecord, order);
+        failing->emitDiagError = true;
+        manager.addPass(std::move(failing));
+
+        PassDiagnostics diags;
+        std::vector<PassDiagnosticKind> streamed;
+        diags.setSink([&](wolvrix::lib::diag::Diagnostic &&diag) { streamed.push_back(diag.kind); });
+        PassManagerResult result = manager.run(design, diags);
+        if (result.success || !diags.hasError())
+        {
+            return fail("Streaming diagnostics should still record errors");
+        }
+        if (!diags.messages().empty())
+        {
+            return fail("Streamed diagnostics should not be kept");
+        }
+        const std::vector<PassDiagnosticKind> expectedKinds{PassDiagnosticKind::Debug, PassDiagnosticKind::Info,
+                                                            PassDiagnosticKind::Warning, PassDiagnosticKind::Error};
+        if (streamed != expectedKinds)
+        {
+            return fail("Diagnostics sink did not receive messages in order");
+        }
+    }
+
     return 0;
 }